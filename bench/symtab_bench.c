@@ -0,0 +1,172 @@
+/**
+ * @file symtab_bench.c
+ * @author Derek Tan
+ * @brief Microbenchmark for name lookups: the open-addressed VarEnv against the old chained bucket table with the old base 3 hash.
+ * @date 2023-08-16
+ * @note Build with "make bench" and run ./bin/symtab_bench.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "backend/values/varenv.h"
+
+/// SECTION: Macros
+
+#define BENCH_LOOKUPS 2000000
+#define LEGACY_BUCKETS 8 // VAR_ENV_SIZE before tables could grow
+#define LEGACY_PRIME 3
+
+/// SECTION: Legacy chained table
+
+typedef struct st_legacy_node
+{
+    Variable *var;
+    struct st_legacy_node *next;
+} LegacyNode;
+
+typedef struct st_legacy_env
+{
+    size_t count;
+    LegacyNode **entries;
+} LegacyEnv;
+
+static size_t legacy_hash(const char *key)
+{
+    size_t key_len = strlen(key);
+    size_t base = 1;
+    size_t hash_num = 0;
+
+    for (size_t i = 0; i < key_len; i++)
+    {
+        hash_num += base * key[i];
+        base *= LEGACY_PRIME;
+    }
+
+    return hash_num;
+}
+
+static int legacy_init(LegacyEnv *env, size_t buckets)
+{
+    env->entries = calloc(buckets, sizeof(LegacyNode *));
+    env->count = buckets;
+
+    return env->entries != NULL;
+}
+
+static void legacy_destroy(LegacyEnv *env)
+{
+    LegacyNode *node = NULL;
+    LegacyNode *next_node = NULL;
+
+    for (size_t i = 0; i < env->count; i++)
+    {
+        for (node = env->entries[i]; node != NULL; node = next_node)
+        {
+            next_node = node->next;
+            free(node);
+        }
+    }
+
+    free(env->entries);
+}
+
+static int legacy_set(LegacyEnv *env, Variable *var_obj)
+{
+    LegacyNode *node = malloc(sizeof(LegacyNode));
+    LegacyNode **tail = env->entries + legacy_hash(var_obj->name) % env->count;
+
+    if (!node) return 0;
+
+    node->var = var_obj;
+    node->next = NULL;
+
+    // NOTE: the old lists appended at the tail.
+    while (*tail != NULL) tail = &(*tail)->next;
+
+    *tail = node;
+
+    return 1;
+}
+
+static Variable *legacy_get(const LegacyEnv *env, const char *name)
+{
+    const LegacyNode *node = env->entries[legacy_hash(name) % env->count];
+
+    for (; node != NULL; node = node->next)
+    {
+        if (strcmp(name, node->var->name) == 0) return node->var;
+    }
+
+    return NULL;
+}
+
+/// SECTION: Timing
+
+static double bench_now_ns(void)
+{
+    struct timespec now;
+
+    timespec_get(&now, TIME_UTC);
+
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static int bench_run(size_t name_count)
+{
+    char name_buf[32];
+    char **names = malloc(sizeof(char *) * name_count);
+    Variable **vars = malloc(sizeof(Variable *) * name_count);
+    LegacyEnv legacy;
+    VarEnv venv;
+    size_t found = 0;
+    double start_ns, legacy_ns, venv_ns;
+
+    if (!names || !vars || !legacy_init(&legacy, LEGACY_BUCKETS) || !varenv_init(&venv, VAR_ENV_SIZE)) return 0;
+
+    for (size_t i = 0; i < name_count; i++)
+    {
+        snprintf(name_buf, sizeof(name_buf), "name%zu", i);
+        names[i] = intern_cstr(name_buf);
+        vars[i] = variable_create(names[i], 0, make_int_varval(0, (int)i));
+
+        if (!names[i] || !vars[i] || !legacy_set(&legacy, vars[i]) || !varenv_set_var_ref(&venv, vars[i])) return 0;
+    }
+
+    start_ns = bench_now_ns();
+
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++)
+        found += legacy_get(&legacy, names[i % name_count]) != NULL;
+
+    legacy_ns = bench_now_ns() - start_ns;
+    start_ns = bench_now_ns();
+
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++)
+        found += varenv_get_var_ref(&venv, names[i % name_count]) != NULL;
+
+    venv_ns = bench_now_ns() - start_ns;
+
+    printf("%6zu names: chained %8.2f ns/lookup, open-addressed %6.2f ns/lookup (%zu hits)\n", name_count, legacy_ns / BENCH_LOOKUPS, venv_ns / BENCH_LOOKUPS, found);
+
+    // NOTE: both tables share the Variable objects, and the VarEnv frees them.
+    legacy_destroy(&legacy);
+    varenv_destroy(&venv);
+    free(vars);
+    free(names);
+
+    return 1;
+}
+
+/// SECTION: Driver code
+
+int main(void)
+{
+    const size_t name_counts[] = {10, 100, 10000};
+    int bench_ok = intern_pool_init();
+
+    for (size_t i = 0; i < sizeof(name_counts) / sizeof(name_counts[0]) && bench_ok; i++)
+        bench_ok = bench_run(name_counts[i]);
+
+    intern_pool_dispose();
+
+    return !bench_ok;
+}
@@ -0,0 +1,95 @@
+/* Compiled from ./tests/avg.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // avgTwo
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = "average is ";
+static StringObj aot_str_0;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 11);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 2);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, f[0], f[1], t0);
+        VarValue t1;
+        AOT_CHECK(aot_binary(OP_DIV, t0, AOT_INT(1, 2), &t1));
+        *result = t1;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_0);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue *a3 = aot_push(2);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = AOT_INT(1, 4);
+        a3[1] = AOT_INT(1, 10);
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a3, &t4));
+        aot_pop(2);
+        a2[0] = t4;
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_print, a2, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/* Compiled from ./tests/builder.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // squaresReport
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = " squared is ";
+static StringObj aot_str_0;
+static char aot_text_1[] = "; ";
+static StringObj aot_str_1;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 12);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 2);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(3, args, 1);
+    int v2 = 0;
+    (void)v2;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call_native(rubel_str_builder, NULL, 0, &t0));
+        AOT_CHECK(aot_declare(&f[1], t0, 0));
+    }
+    {
+        v2 = 1;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t1;
+        AOT_INT_COMPARE(OP_LTE, <=, AOT_INT(1, v2), f[0], t1);
+        int t2;
+        AOT_TEST(t1, t2);
+        if (!t2) break;
+        {
+            VarValue *a3 = aot_push(2);
+            if (!a3) AOT_FAIL(ERR_MEMORY);
+            a3[0] = f[1];
+            a3[1] = AOT_INT(1, v2);
+            VarValue t4;
+            AOT_CHECK(aot_call_native(rubel_str_append, a3, 2, &t4));
+            aot_pop(2);
+            AOT_CHECK(aot_assign(&f[1], t4));
+        }
+        {
+            VarValue *a5 = aot_push(2);
+            if (!a5) AOT_FAIL(ERR_MEMORY);
+            a5[0] = f[1];
+            a5[1] = make_str_varval(1, &aot_str_0);
+            VarValue t6;
+            AOT_CHECK(aot_call_native(rubel_str_append, a5, 2, &t6));
+            aot_pop(2);
+            AOT_CHECK(aot_assign(&f[1], t6));
+        }
+        {
+            VarValue *a7 = aot_push(2);
+            if (!a7) AOT_FAIL(ERR_MEMORY);
+            a7[0] = f[1];
+            a7[1] = AOT_INT(1, INT_WRAP_MUL(v2, v2));
+            VarValue t8;
+            AOT_CHECK(aot_call_native(rubel_str_append, a7, 2, &t8));
+            aot_pop(2);
+            AOT_CHECK(aot_assign(&f[1], t8));
+        }
+        {
+            VarValue *a9 = aot_push(2);
+            if (!a9) AOT_FAIL(ERR_MEMORY);
+            a9[0] = f[1];
+            a9[1] = make_str_varval(1, &aot_str_1);
+            VarValue t10;
+            AOT_CHECK(aot_call_native(rubel_str_append, a9, 2, &t10));
+            aot_pop(2);
+            AOT_CHECK(aot_assign(&f[1], t10));
+        }
+        {
+            v2 = INT_WRAP_ADD(v2, 1);
+        }
+    }
+    {
+        VarValue *a11 = aot_push(1);
+        if (!a11) AOT_FAIL(ERR_MEMORY);
+        a11[0] = f[1];
+        VarValue t12;
+        AOT_CHECK(aot_call_native(rubel_str_build, a11, 1, &t12));
+        aot_pop(1);
+        *result = t12;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        VarValue *a1 = aot_push(1);
+        if (!a1) AOT_FAIL(ERR_MEMORY);
+        a1[0] = AOT_INT(1, 5);
+        VarValue t2;
+        AOT_CHECK(aot_call(proc_0, a1, &t2));
+        aot_pop(1);
+        a0[0] = t2;
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
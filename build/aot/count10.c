@@ -0,0 +1,98 @@
+/* Compiled from ./tests/count10.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // countTen
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = ", ";
+static StringObj aot_str_0;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 2);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 0);
+    int v0 = 0;
+    (void)v0;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v0 = 0;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        if (!(v0 <= 10)) break;
+        {
+            VarValue *a0 = aot_push(1);
+            if (!a0) AOT_FAIL(ERR_MEMORY);
+            a0[0] = AOT_INT(1, v0);
+            VarValue t1;
+            AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+            aot_pop(1);
+        }
+        {
+            VarValue *a2 = aot_push(1);
+            if (!a2) AOT_FAIL(ERR_MEMORY);
+            a2[0] = make_str_varval(1, &aot_str_0);
+            VarValue t3;
+            AOT_CHECK(aot_call_native(rubel_print, a2, 1, &t3));
+            aot_pop(1);
+        }
+        {
+            v0 = INT_WRAP_ADD(v0, 1);
+        }
+    }
+    {
+        *result = AOT_INT(1, v0);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_0, NULL, &t0));
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
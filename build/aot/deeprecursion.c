@@ -0,0 +1,130 @@
+/* Compiled from ./tests/deeprecursion.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // countDown
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = "never printed";
+static StringObj aot_str_0;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 13);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_COMPARE(OP_EQ, ==, f[0], AOT_INT(1, 0), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (t1)
+        {
+            {
+                *result = AOT_INT(1, 0);
+                goto done;
+            }
+        }
+    }
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue t3;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[0], AOT_INT(1, 1), t3);
+        a2[0] = t3;
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a2, &t4));
+        aot_pop(1);
+        VarValue t5;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, AOT_INT(1, 1), t4, t5);
+        *result = t5;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        VarValue *a1 = aot_push(1);
+        if (!a1) AOT_FAIL(ERR_MEMORY);
+        a1[0] = AOT_INT(1, 100);
+        VarValue t2;
+        AOT_CHECK(aot_call(proc_0, a1, &t2));
+        aot_pop(1);
+        a0[0] = t2;
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        VarValue *a5 = aot_push(1);
+        if (!a5) AOT_FAIL(ERR_MEMORY);
+        a5[0] = AOT_INT(1, 200000);
+        VarValue t6;
+        AOT_CHECK(aot_call(proc_0, a5, &t6));
+        aot_pop(1);
+        a4[0] = t6;
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        a8[0] = make_str_varval(1, &aot_str_0);
+        VarValue t9;
+        AOT_CHECK(aot_call_native(rubel_println, a8, 1, &t9));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
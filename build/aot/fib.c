@@ -0,0 +1,121 @@
+/* Compiled from ./tests/fib.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // fib
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = "fib of 20 is ";
+static StringObj aot_str_0;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 13);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_COMPARE(OP_LT, <, f[0], AOT_INT(1, 2), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (t1)
+        {
+            {
+                *result = f[0];
+                goto done;
+            }
+        }
+    }
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue t3;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[0], AOT_INT(1, 1), t3);
+        a2[0] = t3;
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a2, &t4));
+        aot_pop(1);
+        VarValue *a5 = aot_push(1);
+        if (!a5) AOT_FAIL(ERR_MEMORY);
+        VarValue t6;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[0], AOT_INT(1, 2), t6);
+        a5[0] = t6;
+        VarValue t7;
+        AOT_CHECK(aot_call(proc_0, a5, &t7));
+        aot_pop(1);
+        VarValue t8;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t4, t7, t8);
+        *result = t8;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_0);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue *a3 = aot_push(1);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = AOT_INT(1, 20);
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a3, &t4));
+        aot_pop(1);
+        a2[0] = t4;
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/* Compiled from ./tests/foldedges.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // never
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = "hello";
+static StringObj aot_str_0;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 5);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        int t0 = (-1);
+        if (t0 == 0) AOT_FAIL(ERR_NULL_VAL);
+        *result = AOT_INT(1, INT_WRAP_DIV((-2147483647 - 1), t0));
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = AOT_INT(1, (-2147483647 - 1));
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        a2[0] = AOT_INT(1, 2147483647);
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        a4[0] = AOT_INT(1, 7);
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a6 = aot_push(1);
+        if (!a6) AOT_FAIL(ERR_MEMORY);
+        a6[0] = AOT_INT(1, (-2147483647 - 1));
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_println, a6, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        a8[0] = make_str_varval(1, &aot_str_0);
+        VarValue t9;
+        AOT_CHECK(aot_call_native(rubel_println, a8, 1, &t9));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
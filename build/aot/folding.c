@@ -0,0 +1,192 @@
+/* Compiled from ./tests/folding.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // area
+static RunStatus proc_1(VarValue *args, VarValue *result); // pick
+static AotProc proc_defs[2]; // set once each proc's declaration runs
+static char aot_text_0[] = "area is ";
+static StringObj aot_str_0;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 8);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, AOT_INT(1, 24), aot_globals[3], t0);
+        *result = t0;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 1);
+    int v1 = 0;
+    (void)v1;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[0], AOT_INT(1, 2), t0);
+        v1 = t0.data.int_val.value;
+    }
+    {
+        VarValue *a1 = aot_push(1);
+        if (!a1) AOT_FAIL(ERR_MEMORY);
+        a1[0] = AOT_INT(1, v1);
+        VarValue t2;
+        AOT_CHECK(aot_call_native(rubel_println, a1, 1, &t2));
+        aot_pop(1);
+    }
+    {
+        VarValue t3;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, f[0], AOT_INT(1, 5), t3);
+        *result = AOT_INT(1, INT_WRAP_SUB(t3.data.int_val.value, 3));
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    {
+        aot_globals[0] = AOT_INT(1, 6);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        aot_globals[1] = AOT_INT(1, 4);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[2], make_str_varval(1, &aot_str_0), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        aot_globals[3] = AOT_INT(0, 2);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_0);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue t3;
+        AOT_CHECK(aot_call(proc_0, NULL, &t3));
+        a2[0] = t3;
+        VarValue t4;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t4));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 9;
+    {
+        VarValue *a5 = aot_push(1);
+        if (!a5) AOT_FAIL(ERR_MEMORY);
+        VarValue *a6 = aot_push(1);
+        if (!a6) AOT_FAIL(ERR_MEMORY);
+        a6[0] = AOT_INT(1, 3);
+        VarValue t7;
+        AOT_CHECK(aot_call(proc_1, a6, &t7));
+        aot_pop(1);
+        a5[0] = t7;
+        VarValue t8;
+        AOT_CHECK(aot_call_native(rubel_println, a5, 1, &t8));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 10;
+    {
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        a9[0] = AOT_INT(1, 5);
+        VarValue t10;
+        AOT_CHECK(aot_call_native(rubel_println, a9, 1, &t10));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 11;
+    {
+        VarValue *a11 = aot_push(1);
+        if (!a11) AOT_FAIL(ERR_MEMORY);
+        a11[0] = AOT_BOOL(1, 1);
+        VarValue t12;
+        AOT_CHECK(aot_call_native(rubel_println, a11, 1, &t12));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(4) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+/* Compiled from ./tests/garbage.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // churn
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = "kept sum is ";
+static StringObj aot_str_0;
+static char aot_text_1[] = "last label is ";
+static StringObj aot_str_1;
+static ListObj *aot_list_2 = NULL;
+static char aot_text_3[] = "churned total is ";
+static StringObj aot_str_3;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 12);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 14);
+    aot_list_2 = create_list_obj();
+
+    if (!aot_list_2) return 0;
+
+    heap_pin(&aot_list_2->gc);
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 4))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 2))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 6))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 8))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 7))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 2))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 8))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 4))) return 0;
+
+    init_pinned_str_obj(&aot_str_3, aot_text_3, 17);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(5, args, 1);
+    int v2 = 0;
+    int v4 = 0;
+    (void)v2;
+    (void)v4;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue *a0 = aot_push(2);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = aot_globals[0];
+        a0[1] = AOT_INT(1, 2);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_list_scale, a0, 2, &t1));
+        aot_pop(2);
+        AOT_CHECK(aot_declare(&f[1], t1, 0));
+    }
+    {
+        v2 = 0;
+    }
+    {
+        VarValue t2;
+        AOT_CHECK(aot_call_native(rubel_str_builder, NULL, 0, &t2));
+        AOT_CHECK(aot_declare(&f[3], t2, 0));
+    }
+    {
+        v4 = 0;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t3;
+        AOT_INT_COMPARE(OP_LT, <, AOT_INT(1, v4), f[0], t3);
+        int t4;
+        AOT_TEST(t3, t4);
+        if (!t4) break;
+        {
+            int t5 = v2;
+            VarValue *a6 = aot_push(1);
+            if (!a6) AOT_FAIL(ERR_MEMORY);
+            VarValue *a7 = aot_push(2);
+            if (!a7) AOT_FAIL(ERR_MEMORY);
+            a7[0] = aot_globals[0];
+            a7[1] = AOT_INT(1, v4);
+            VarValue t8;
+            AOT_CHECK(aot_call_native(rubel_list_scale, a7, 2, &t8));
+            aot_pop(2);
+            a6[0] = t8;
+            VarValue t9;
+            AOT_CHECK(aot_call_native(rubel_list_sum, a6, 1, &t9));
+            aot_pop(1);
+            VarValue t10;
+            AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, AOT_INT(1, t5), t9, t10);
+            AOT_CHECK(aot_expect(t10, INT_TYPE));
+            v2 = t10.data.int_val.value;
+        }
+        {
+            VarValue *a11 = aot_push(2);
+            if (!a11) AOT_FAIL(ERR_MEMORY);
+            VarValue t12;
+            AOT_CHECK(aot_call_native(rubel_str_builder, NULL, 0, &t12));
+            a11[0] = t12;
+            a11[1] = AOT_INT(1, v4);
+            VarValue t13;
+            AOT_CHECK(aot_call_native(rubel_str_append, a11, 2, &t13));
+            aot_pop(2);
+            AOT_CHECK(aot_assign(&f[3], t13));
+        }
+        {
+            v4 = INT_WRAP_ADD(v4, 1);
+        }
+    }
+    {
+        VarValue *a14 = aot_push(1);
+        if (!a14) AOT_FAIL(ERR_MEMORY);
+        a14[0] = make_str_varval(1, &aot_str_0);
+        VarValue t15;
+        AOT_CHECK(aot_call_native(rubel_print, a14, 1, &t15));
+        aot_pop(1);
+    }
+    {
+        VarValue *a16 = aot_push(1);
+        if (!a16) AOT_FAIL(ERR_MEMORY);
+        VarValue *a17 = aot_push(1);
+        if (!a17) AOT_FAIL(ERR_MEMORY);
+        a17[0] = f[1];
+        VarValue t18;
+        AOT_CHECK(aot_call_native(rubel_list_sum, a17, 1, &t18));
+        aot_pop(1);
+        a16[0] = t18;
+        VarValue t19;
+        AOT_CHECK(aot_call_native(rubel_println, a16, 1, &t19));
+        aot_pop(1);
+    }
+    {
+        VarValue *a20 = aot_push(1);
+        if (!a20) AOT_FAIL(ERR_MEMORY);
+        a20[0] = make_str_varval(1, &aot_str_1);
+        VarValue t21;
+        AOT_CHECK(aot_call_native(rubel_print, a20, 1, &t21));
+        aot_pop(1);
+    }
+    {
+        VarValue *a22 = aot_push(1);
+        if (!a22) AOT_FAIL(ERR_MEMORY);
+        VarValue *a23 = aot_push(1);
+        if (!a23) AOT_FAIL(ERR_MEMORY);
+        a23[0] = f[3];
+        VarValue t24;
+        AOT_CHECK(aot_call_native(rubel_str_build, a23, 1, &t24));
+        aot_pop(1);
+        a22[0] = t24;
+        VarValue t25;
+        AOT_CHECK(aot_call_native(rubel_println, a22, 1, &t25));
+        aot_pop(1);
+    }
+    {
+        *result = AOT_INT(1, v2);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[0], make_list_varval(1, aot_list_2), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = AOT_INT(1, 2000);
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_0, a0, &t1));
+        aot_pop(1);
+        AOT_CHECK(aot_declare(&aot_globals[1], t1, 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        a2[0] = make_str_varval(1, &aot_str_3);
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_print, a2, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        a4[0] = aot_globals[1];
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(2) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,316 @@
+/* Compiled from ./tests/intwrap.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // divide
+static RunStatus proc_1(VarValue *args, VarValue *result); // grow
+static RunStatus proc_2(VarValue *args, VarValue *result); // negate
+static RunStatus proc_3(VarValue *args, VarValue *result); // divideOften
+static RunStatus proc_4(VarValue *args, VarValue *result); // stepPast
+static AotProc proc_defs[5]; // set once each proc's declaration runs
+
+static int init_literals()
+{
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 2);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_binary(OP_DIV, f[0], f[1], &t0));
+        *result = t0;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 2);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[0], f[1], t0);
+        VarValue t1;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, f[0], t1);
+        VarValue t2;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, t1, f[1], t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_2(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, AOT_INT(1, 0), f[0], t0);
+        *result = t0;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_3(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(4, args, 2);
+    int v2 = 0;
+    int v3 = 0;
+    (void)v2;
+    (void)v3;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v2 = 0;
+    }
+    {
+        v3 = 0;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        if (!(v2 < 1500)) break;
+        {
+            VarValue *a0 = aot_push(2);
+            if (!a0) AOT_FAIL(ERR_MEMORY);
+            a0[0] = f[0];
+            a0[1] = f[1];
+            VarValue t1;
+            AOT_CHECK(aot_call(proc_0, a0, &t1));
+            aot_pop(2);
+            AOT_CHECK(aot_expect(t1, INT_TYPE));
+            v3 = t1.data.int_val.value;
+        }
+        {
+            v2 = INT_WRAP_ADD(v2, 1);
+        }
+    }
+    {
+        *result = AOT_INT(1, v3);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_4(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        AOT_CHECK(aot_declare(&f[1], f[0], 0));
+    }
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, f[1], AOT_INT(1, 1), t0);
+        AOT_CHECK(aot_assign(&f[1], t0));
+    }
+    {
+        *result = f[1];
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    {
+        aot_globals[0] = AOT_INT(1, (-2147483647 - 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    proc_defs[2] = proc_2;
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    proc_defs[3] = proc_3;
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    proc_defs[4] = proc_4;
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        VarValue *a1 = aot_push(2);
+        if (!a1) AOT_FAIL(ERR_MEMORY);
+        a1[0] = AOT_INT(1, (-2147483647 - 1));
+        a1[1] = AOT_INT(1, (-1));
+        VarValue t2;
+        AOT_CHECK(aot_call(proc_3, a1, &t2));
+        aot_pop(2);
+        a0[0] = t2;
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        VarValue *a5 = aot_push(2);
+        if (!a5) AOT_FAIL(ERR_MEMORY);
+        a5[0] = AOT_INT(1, (-2147483647 - 1));
+        a5[1] = AOT_INT(1, (-1));
+        VarValue t6;
+        AOT_CHECK(aot_call(proc_0, a5, &t6));
+        aot_pop(2);
+        VarValue t7;
+        AOT_INT_COMPARE(OP_EQ, ==, t6, AOT_INT(1, (-2147483647 - 1)), t7);
+        a4[0] = t7;
+        VarValue t8;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t8));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 9;
+    {
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        VarValue *a10 = aot_push(2);
+        if (!a10) AOT_FAIL(ERR_MEMORY);
+        a10[0] = AOT_INT(1, 65536);
+        a10[1] = AOT_INT(1, 65536);
+        VarValue t11;
+        AOT_CHECK(aot_call(proc_1, a10, &t11));
+        aot_pop(2);
+        a9[0] = t11;
+        VarValue t12;
+        AOT_CHECK(aot_call_native(rubel_println, a9, 1, &t12));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 10;
+    {
+        VarValue *a13 = aot_push(1);
+        if (!a13) AOT_FAIL(ERR_MEMORY);
+        VarValue *a14 = aot_push(2);
+        if (!a14) AOT_FAIL(ERR_MEMORY);
+        a14[0] = AOT_INT(1, 2147483647);
+        a14[1] = AOT_INT(1, 2);
+        VarValue t15;
+        AOT_CHECK(aot_call(proc_1, a14, &t15));
+        aot_pop(2);
+        a13[0] = t15;
+        VarValue t16;
+        AOT_CHECK(aot_call_native(rubel_println, a13, 1, &t16));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 11;
+    {
+        VarValue *a17 = aot_push(1);
+        if (!a17) AOT_FAIL(ERR_MEMORY);
+        VarValue *a18 = aot_push(1);
+        if (!a18) AOT_FAIL(ERR_MEMORY);
+        a18[0] = AOT_INT(1, (-2147483647 - 1));
+        VarValue t19;
+        AOT_CHECK(aot_call(proc_2, a18, &t19));
+        aot_pop(1);
+        a17[0] = t19;
+        VarValue t20;
+        AOT_CHECK(aot_call_native(rubel_println, a17, 1, &t20));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 12;
+    {
+        VarValue *a21 = aot_push(1);
+        if (!a21) AOT_FAIL(ERR_MEMORY);
+        VarValue *a22 = aot_push(1);
+        if (!a22) AOT_FAIL(ERR_MEMORY);
+        a22[0] = AOT_INT(1, 2147483647);
+        VarValue t23;
+        AOT_CHECK(aot_call(proc_4, a22, &t23));
+        aot_pop(1);
+        a21[0] = t23;
+        VarValue t24;
+        AOT_CHECK(aot_call_native(rubel_println, a21, 1, &t24));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(1) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,359 @@
+/* Compiled from ./tests/jit.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // clamp
+static RunStatus proc_1(VarValue *args, VarValue *result); // mix
+static RunStatus proc_2(VarValue *args, VarValue *result); // scaled
+static RunStatus proc_3(VarValue *args, VarValue *result); // twice
+static RunStatus proc_4(VarValue *args, VarValue *result); // driver
+static AotProc proc_defs[5]; // set once each proc's declaration runs
+
+static int init_literals()
+{
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(3, args, 3);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, aot_globals[0], AOT_INT(1, 1), t0);
+        AOT_CHECK(aot_assign(&aot_globals[0], t0));
+    }
+    {
+        VarValue t1;
+        AOT_INT_COMPARE(OP_LT, <, f[0], f[1], t1);
+        int t2;
+        AOT_TEST(t1, t2);
+        if (t2)
+        {
+            {
+                *result = f[1];
+                goto done;
+            }
+        }
+    }
+    {
+        VarValue t3;
+        AOT_INT_COMPARE(OP_GT, >, f[0], f[2], t3);
+        int t4;
+        AOT_TEST(t3, t4);
+        if (t4)
+        {
+            {
+                *result = f[2];
+                goto done;
+            }
+        }
+    }
+    {
+        *result = f[0];
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 2);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[0], AOT_REAL(1, 0x1.8p-1f), t0);
+        VarValue t1;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[1], AOT_REAL(1, 0x1p-2f), t1);
+        *result = AOT_REAL(1, (t0.data.real_val.value + t1.data.real_val.value));
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_2(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[0], AOT_INT(1, 3), t0);
+        VarValue t1;
+        AOT_CHECK(aot_binary(OP_DIV, f[0], AOT_INT(1, 2), &t1));
+        *result = AOT_INT(1, INT_WRAP_SUB(t0.data.int_val.value, t1.data.int_val.value));
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_3(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, f[0], f[0], t0);
+        *result = t0;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_4(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(5, args, 1);
+    int v1 = 0;
+    float v2 = 0;
+    int v3 = 0;
+    int v4 = 0;
+    (void)v1;
+    (void)v2;
+    (void)v3;
+    (void)v4;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v1 = 0;
+    }
+    {
+        v2 = 0x0p+0f;
+    }
+    {
+        v3 = 0;
+    }
+    {
+        v4 = 0;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t0;
+        AOT_INT_COMPARE(OP_LT, <, AOT_INT(1, v4), f[0], t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (!t1) break;
+        {
+            int t2 = v1;
+            VarValue *a3 = aot_push(3);
+            if (!a3) AOT_FAIL(ERR_MEMORY);
+            a3[0] = AOT_INT(1, INT_WRAP_SUB(v4, 500));
+            a3[1] = AOT_INT(1, (-100));
+            a3[2] = AOT_INT(1, 100);
+            VarValue t4;
+            AOT_CHECK(aot_call(proc_0, a3, &t4));
+            aot_pop(3);
+            VarValue t5;
+            AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, AOT_INT(1, t2), t4, t5);
+            AOT_CHECK(aot_expect(t5, INT_TYPE));
+            v1 = t5.data.int_val.value;
+        }
+        {
+            VarValue *a6 = aot_push(2);
+            if (!a6) AOT_FAIL(ERR_MEMORY);
+            a6[0] = AOT_REAL(1, v2);
+            a6[1] = AOT_REAL(1, 0x1p+3f);
+            VarValue t7;
+            AOT_CHECK(aot_call(proc_1, a6, &t7));
+            aot_pop(2);
+            AOT_CHECK(aot_expect(t7, REAL_TYPE));
+            v2 = t7.data.real_val.value;
+        }
+        {
+            int t8 = v1;
+            VarValue *a9 = aot_push(1);
+            if (!a9) AOT_FAIL(ERR_MEMORY);
+            a9[0] = AOT_INT(1, v4);
+            VarValue t10;
+            AOT_CHECK(aot_call(proc_2, a9, &t10));
+            aot_pop(1);
+            VarValue t11;
+            AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, AOT_INT(1, t8), t10, t11);
+            AOT_CHECK(aot_expect(t11, INT_TYPE));
+            v1 = t11.data.int_val.value;
+        }
+        {
+            VarValue *a12 = aot_push(1);
+            if (!a12) AOT_FAIL(ERR_MEMORY);
+            a12[0] = AOT_INT(1, v4);
+            VarValue t13;
+            AOT_CHECK(aot_call(proc_3, a12, &t13));
+            aot_pop(1);
+            AOT_CHECK(aot_expect(t13, INT_TYPE));
+            v3 = t13.data.int_val.value;
+        }
+        {
+            v4 = INT_WRAP_ADD(v4, 1);
+        }
+    }
+    {
+        VarValue *a14 = aot_push(1);
+        if (!a14) AOT_FAIL(ERR_MEMORY);
+        a14[0] = AOT_REAL(1, v2);
+        VarValue t15;
+        AOT_CHECK(aot_call_native(rubel_println, a14, 1, &t15));
+        aot_pop(1);
+    }
+    {
+        VarValue *a16 = aot_push(1);
+        if (!a16) AOT_FAIL(ERR_MEMORY);
+        a16[0] = AOT_INT(1, v3);
+        VarValue t17;
+        AOT_CHECK(aot_call_native(rubel_println, a16, 1, &t17));
+        aot_pop(1);
+    }
+    {
+        VarValue *a18 = aot_push(1);
+        if (!a18) AOT_FAIL(ERR_MEMORY);
+        VarValue *a19 = aot_push(1);
+        if (!a19) AOT_FAIL(ERR_MEMORY);
+        a19[0] = AOT_REAL(1, 0x1.4p+0f);
+        VarValue t20;
+        AOT_CHECK(aot_call(proc_3, a19, &t20));
+        aot_pop(1);
+        a18[0] = t20;
+        VarValue t21;
+        AOT_CHECK(aot_call_native(rubel_println, a18, 1, &t21));
+        aot_pop(1);
+    }
+    {
+        VarValue *a22 = aot_push(1);
+        if (!a22) AOT_FAIL(ERR_MEMORY);
+        VarValue *a23 = aot_push(1);
+        if (!a23) AOT_FAIL(ERR_MEMORY);
+        VarValue t24;
+        AOT_CHECK(aot_negate(f[0], &t24));
+        a23[0] = t24;
+        VarValue t25;
+        AOT_CHECK(aot_call(proc_3, a23, &t25));
+        aot_pop(1);
+        VarValue t26;
+        AOT_INT_COMPARE(OP_LT, <, t25, AOT_INT(1, (-5000)), t26);
+        a22[0] = t26;
+        VarValue t27;
+        AOT_CHECK(aot_call_native(rubel_println, a22, 1, &t27));
+        aot_pop(1);
+    }
+    {
+        *result = AOT_INT(1, v1);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    {
+        aot_globals[0] = AOT_INT(0, 0);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    proc_defs[2] = proc_2;
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    proc_defs[3] = proc_3;
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    proc_defs[4] = proc_4;
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        VarValue *a1 = aot_push(1);
+        if (!a1) AOT_FAIL(ERR_MEMORY);
+        a1[0] = AOT_INT(1, 3000);
+        VarValue t2;
+        AOT_CHECK(aot_call(proc_4, a1, &t2));
+        aot_pop(1);
+        a0[0] = t2;
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        a4[0] = aot_globals[0];
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(1) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,474 @@
+/* Compiled from ./tests/listmath.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static ListObj *aot_list_0 = NULL;
+static ListObj *aot_list_1 = NULL;
+static char aot_text_2[] = "three";
+static StringObj aot_str_2;
+static ListObj *aot_list_3 = NULL;
+static char aot_text_4[] = "sum is ";
+static StringObj aot_str_4;
+static char aot_text_5[] = "min and max are ";
+static StringObj aot_str_5;
+static char aot_text_6[] = ", ";
+static StringObj aot_str_6;
+static char aot_text_7[] = "index of 7 is ";
+static StringObj aot_str_7;
+static char aot_text_8[] = "index of 42 is ";
+static StringObj aot_str_8;
+static char aot_text_9[] = "dot of nums with itself is ";
+static StringObj aot_str_9;
+static char aot_text_10[] = "tripled sum is ";
+static StringObj aot_str_10;
+static char aot_text_11[] = "weights sum is ";
+static StringObj aot_str_11;
+static char aot_text_12[] = "heaviest weight is ";
+static StringObj aot_str_12;
+static char aot_text_13[] = "halved weights sum is ";
+static StringObj aot_str_13;
+static char aot_text_14[] = "index of three in mixed is ";
+static StringObj aot_str_14;
+static char aot_text_15[] = "three";
+static StringObj aot_str_15;
+
+static int init_literals()
+{
+    aot_list_0 = create_list_obj();
+
+    if (!aot_list_0) return 0;
+
+    heap_pin(&aot_list_0->gc);
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 4))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 2))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 6))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 8))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 7))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 2))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 8))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 4))) return 0;
+
+    aot_list_1 = create_list_obj();
+
+    if (!aot_list_1) return 0;
+
+    heap_pin(&aot_list_1->gc);
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1p-1f))) return 0;
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1.8p+0f))) return 0;
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1p+1f))) return 0;
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1p-2f))) return 0;
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1p+2f))) return 0;
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1p+0f))) return 0;
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1.4p+1f))) return 0;
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1.8p-1f))) return 0;
+    if (!append_list_obj(aot_list_1, make_real_varval(0, 0x1.8p+1f))) return 0;
+
+    init_pinned_str_obj(&aot_str_2, aot_text_2, 5);
+    aot_list_3 = create_list_obj();
+
+    if (!aot_list_3) return 0;
+
+    heap_pin(&aot_list_3->gc);
+    if (!append_list_obj(aot_list_3, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_3, make_real_varval(0, 0x1.4p+1f))) return 0;
+    if (!append_list_obj(aot_list_3, make_str_varval(0, &aot_str_2))) return 0;
+    if (!append_list_obj(aot_list_3, make_bool_varval(0, 1))) return 0;
+
+    init_pinned_str_obj(&aot_str_4, aot_text_4, 7);
+    init_pinned_str_obj(&aot_str_5, aot_text_5, 16);
+    init_pinned_str_obj(&aot_str_6, aot_text_6, 2);
+    init_pinned_str_obj(&aot_str_7, aot_text_7, 14);
+    init_pinned_str_obj(&aot_str_8, aot_text_8, 15);
+    init_pinned_str_obj(&aot_str_9, aot_text_9, 27);
+    init_pinned_str_obj(&aot_str_10, aot_text_10, 15);
+    init_pinned_str_obj(&aot_str_11, aot_text_11, 15);
+    init_pinned_str_obj(&aot_str_12, aot_text_12, 19);
+    init_pinned_str_obj(&aot_str_13, aot_text_13, 22);
+    init_pinned_str_obj(&aot_str_14, aot_text_14, 27);
+    init_pinned_str_obj(&aot_str_15, aot_text_15, 5);
+    return 1;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[0], make_list_varval(1, aot_list_0), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[1], make_list_varval(1, aot_list_1), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[2], make_list_varval(1, aot_list_3), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_4);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue *a3 = aot_push(1);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = aot_globals[0];
+        VarValue t4;
+        AOT_CHECK(aot_call_native(rubel_list_sum, a3, 1, &t4));
+        aot_pop(1);
+        a2[0] = t4;
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a6 = aot_push(1);
+        if (!a6) AOT_FAIL(ERR_MEMORY);
+        a6[0] = make_str_varval(1, &aot_str_5);
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_print, a6, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        a9[0] = aot_globals[0];
+        VarValue t10;
+        AOT_CHECK(aot_call_native(rubel_list_min, a9, 1, &t10));
+        aot_pop(1);
+        a8[0] = t10;
+        VarValue t11;
+        AOT_CHECK(aot_call_native(rubel_print, a8, 1, &t11));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 9;
+    {
+        VarValue *a12 = aot_push(1);
+        if (!a12) AOT_FAIL(ERR_MEMORY);
+        a12[0] = make_str_varval(1, &aot_str_6);
+        VarValue t13;
+        AOT_CHECK(aot_call_native(rubel_print, a12, 1, &t13));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 10;
+    {
+        VarValue *a14 = aot_push(1);
+        if (!a14) AOT_FAIL(ERR_MEMORY);
+        VarValue *a15 = aot_push(1);
+        if (!a15) AOT_FAIL(ERR_MEMORY);
+        a15[0] = aot_globals[0];
+        VarValue t16;
+        AOT_CHECK(aot_call_native(rubel_list_max, a15, 1, &t16));
+        aot_pop(1);
+        a14[0] = t16;
+        VarValue t17;
+        AOT_CHECK(aot_call_native(rubel_println, a14, 1, &t17));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 11;
+    {
+        VarValue *a18 = aot_push(1);
+        if (!a18) AOT_FAIL(ERR_MEMORY);
+        a18[0] = make_str_varval(1, &aot_str_7);
+        VarValue t19;
+        AOT_CHECK(aot_call_native(rubel_print, a18, 1, &t19));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 12;
+    {
+        VarValue *a20 = aot_push(1);
+        if (!a20) AOT_FAIL(ERR_MEMORY);
+        VarValue *a21 = aot_push(2);
+        if (!a21) AOT_FAIL(ERR_MEMORY);
+        a21[0] = aot_globals[0];
+        a21[1] = AOT_INT(1, 7);
+        VarValue t22;
+        AOT_CHECK(aot_call_native(rubel_list_index_of, a21, 2, &t22));
+        aot_pop(2);
+        a20[0] = t22;
+        VarValue t23;
+        AOT_CHECK(aot_call_native(rubel_println, a20, 1, &t23));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 13;
+    {
+        VarValue *a24 = aot_push(1);
+        if (!a24) AOT_FAIL(ERR_MEMORY);
+        a24[0] = make_str_varval(1, &aot_str_8);
+        VarValue t25;
+        AOT_CHECK(aot_call_native(rubel_print, a24, 1, &t25));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 14;
+    {
+        VarValue *a26 = aot_push(1);
+        if (!a26) AOT_FAIL(ERR_MEMORY);
+        VarValue *a27 = aot_push(2);
+        if (!a27) AOT_FAIL(ERR_MEMORY);
+        a27[0] = aot_globals[0];
+        a27[1] = AOT_INT(1, 42);
+        VarValue t28;
+        AOT_CHECK(aot_call_native(rubel_list_index_of, a27, 2, &t28));
+        aot_pop(2);
+        a26[0] = t28;
+        VarValue t29;
+        AOT_CHECK(aot_call_native(rubel_println, a26, 1, &t29));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 15;
+    {
+        VarValue *a30 = aot_push(1);
+        if (!a30) AOT_FAIL(ERR_MEMORY);
+        a30[0] = make_str_varval(1, &aot_str_9);
+        VarValue t31;
+        AOT_CHECK(aot_call_native(rubel_print, a30, 1, &t31));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 16;
+    {
+        VarValue *a32 = aot_push(1);
+        if (!a32) AOT_FAIL(ERR_MEMORY);
+        VarValue *a33 = aot_push(2);
+        if (!a33) AOT_FAIL(ERR_MEMORY);
+        a33[0] = aot_globals[0];
+        a33[1] = aot_globals[0];
+        VarValue t34;
+        AOT_CHECK(aot_call_native(rubel_list_dot, a33, 2, &t34));
+        aot_pop(2);
+        a32[0] = t34;
+        VarValue t35;
+        AOT_CHECK(aot_call_native(rubel_println, a32, 1, &t35));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 17;
+    {
+        VarValue *a36 = aot_push(1);
+        if (!a36) AOT_FAIL(ERR_MEMORY);
+        a36[0] = make_str_varval(1, &aot_str_10);
+        VarValue t37;
+        AOT_CHECK(aot_call_native(rubel_print, a36, 1, &t37));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 18;
+    {
+        VarValue *a38 = aot_push(1);
+        if (!a38) AOT_FAIL(ERR_MEMORY);
+        VarValue *a39 = aot_push(1);
+        if (!a39) AOT_FAIL(ERR_MEMORY);
+        VarValue *a40 = aot_push(2);
+        if (!a40) AOT_FAIL(ERR_MEMORY);
+        a40[0] = aot_globals[0];
+        a40[1] = AOT_INT(1, 3);
+        VarValue t41;
+        AOT_CHECK(aot_call_native(rubel_list_scale, a40, 2, &t41));
+        aot_pop(2);
+        a39[0] = t41;
+        VarValue t42;
+        AOT_CHECK(aot_call_native(rubel_list_sum, a39, 1, &t42));
+        aot_pop(1);
+        a38[0] = t42;
+        VarValue t43;
+        AOT_CHECK(aot_call_native(rubel_println, a38, 1, &t43));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 19;
+    {
+        VarValue *a44 = aot_push(1);
+        if (!a44) AOT_FAIL(ERR_MEMORY);
+        a44[0] = make_str_varval(1, &aot_str_11);
+        VarValue t45;
+        AOT_CHECK(aot_call_native(rubel_print, a44, 1, &t45));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 20;
+    {
+        VarValue *a46 = aot_push(1);
+        if (!a46) AOT_FAIL(ERR_MEMORY);
+        VarValue *a47 = aot_push(1);
+        if (!a47) AOT_FAIL(ERR_MEMORY);
+        a47[0] = aot_globals[1];
+        VarValue t48;
+        AOT_CHECK(aot_call_native(rubel_list_sum, a47, 1, &t48));
+        aot_pop(1);
+        a46[0] = t48;
+        VarValue t49;
+        AOT_CHECK(aot_call_native(rubel_println, a46, 1, &t49));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 21;
+    {
+        VarValue *a50 = aot_push(1);
+        if (!a50) AOT_FAIL(ERR_MEMORY);
+        a50[0] = make_str_varval(1, &aot_str_12);
+        VarValue t51;
+        AOT_CHECK(aot_call_native(rubel_print, a50, 1, &t51));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 22;
+    {
+        VarValue *a52 = aot_push(1);
+        if (!a52) AOT_FAIL(ERR_MEMORY);
+        VarValue *a53 = aot_push(1);
+        if (!a53) AOT_FAIL(ERR_MEMORY);
+        a53[0] = aot_globals[1];
+        VarValue t54;
+        AOT_CHECK(aot_call_native(rubel_list_max, a53, 1, &t54));
+        aot_pop(1);
+        a52[0] = t54;
+        VarValue t55;
+        AOT_CHECK(aot_call_native(rubel_println, a52, 1, &t55));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 23;
+    {
+        VarValue *a56 = aot_push(1);
+        if (!a56) AOT_FAIL(ERR_MEMORY);
+        a56[0] = make_str_varval(1, &aot_str_13);
+        VarValue t57;
+        AOT_CHECK(aot_call_native(rubel_print, a56, 1, &t57));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 24;
+    {
+        VarValue *a58 = aot_push(1);
+        if (!a58) AOT_FAIL(ERR_MEMORY);
+        VarValue *a59 = aot_push(1);
+        if (!a59) AOT_FAIL(ERR_MEMORY);
+        VarValue *a60 = aot_push(2);
+        if (!a60) AOT_FAIL(ERR_MEMORY);
+        a60[0] = aot_globals[1];
+        a60[1] = AOT_REAL(1, 0x1p-1f);
+        VarValue t61;
+        AOT_CHECK(aot_call_native(rubel_list_scale, a60, 2, &t61));
+        aot_pop(2);
+        a59[0] = t61;
+        VarValue t62;
+        AOT_CHECK(aot_call_native(rubel_list_sum, a59, 1, &t62));
+        aot_pop(1);
+        a58[0] = t62;
+        VarValue t63;
+        AOT_CHECK(aot_call_native(rubel_println, a58, 1, &t63));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 25;
+    {
+        VarValue *a64 = aot_push(1);
+        if (!a64) AOT_FAIL(ERR_MEMORY);
+        a64[0] = make_str_varval(1, &aot_str_14);
+        VarValue t65;
+        AOT_CHECK(aot_call_native(rubel_print, a64, 1, &t65));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 26;
+    {
+        VarValue *a66 = aot_push(1);
+        if (!a66) AOT_FAIL(ERR_MEMORY);
+        VarValue *a67 = aot_push(2);
+        if (!a67) AOT_FAIL(ERR_MEMORY);
+        a67[0] = aot_globals[2];
+        a67[1] = make_str_varval(1, &aot_str_15);
+        VarValue t68;
+        AOT_CHECK(aot_call_native(rubel_list_index_of, a67, 2, &t68));
+        aot_pop(2);
+        a66[0] = t68;
+        VarValue t69;
+        AOT_CHECK(aot_call_native(rubel_println, a66, 1, &t69));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(3) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+/* Compiled from ./tests/lists.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // sumList
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static ListObj *aot_list_0 = NULL;
+static ListObj *aot_list_1 = NULL;
+static ListObj *aot_list_2 = NULL;
+static ListObj *aot_list_3 = NULL;
+static ListObj *aot_list_4 = NULL;
+static char aot_text_5[] = "sum is ";
+static StringObj aot_str_5;
+static char aot_text_6[] = "middle row sum is ";
+static StringObj aot_str_6;
+
+static int init_literals()
+{
+    aot_list_0 = create_list_obj();
+
+    if (!aot_list_0) return 0;
+
+    heap_pin(&aot_list_0->gc);
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 4))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 2))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 6))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 8))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 7))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 9))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 2))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 8))) return 0;
+    if (!append_list_obj(aot_list_0, make_int_varval(0, 4))) return 0;
+
+    aot_list_1 = create_list_obj();
+
+    if (!aot_list_1) return 0;
+
+    heap_pin(&aot_list_1->gc);
+    if (!append_list_obj(aot_list_1, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_1, make_int_varval(0, 2))) return 0;
+
+    aot_list_2 = create_list_obj();
+
+    if (!aot_list_2) return 0;
+
+    heap_pin(&aot_list_2->gc);
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_2, make_int_varval(0, 4))) return 0;
+
+    aot_list_3 = create_list_obj();
+
+    if (!aot_list_3) return 0;
+
+    heap_pin(&aot_list_3->gc);
+    if (!append_list_obj(aot_list_3, make_int_varval(0, 5))) return 0;
+    if (!append_list_obj(aot_list_3, make_int_varval(0, 6))) return 0;
+
+    aot_list_4 = create_list_obj();
+
+    if (!aot_list_4) return 0;
+
+    heap_pin(&aot_list_4->gc);
+    if (!append_list_obj(aot_list_4, make_list_varval(0, aot_list_1))) return 0;
+    if (!append_list_obj(aot_list_4, make_list_varval(0, aot_list_2))) return 0;
+    if (!append_list_obj(aot_list_4, make_list_varval(0, aot_list_3))) return 0;
+
+    init_pinned_str_obj(&aot_str_5, aot_text_5, 7);
+    init_pinned_str_obj(&aot_str_6, aot_text_6, 18);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(4, args, 1);
+    int v1 = 0;
+    int v2 = 0;
+    (void)v1;
+    (void)v2;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v1 = 0;
+    }
+    {
+        v2 = 0;
+    }
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = f[0];
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_list_len, a0, 1, &t1));
+        aot_pop(1);
+        AOT_CHECK(aot_declare(&f[3], t1, 0));
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t2;
+        AOT_INT_COMPARE(OP_LT, <, AOT_INT(1, v2), f[3], t2);
+        int t3;
+        AOT_TEST(t2, t3);
+        if (!t3) break;
+        {
+            int t4 = v1;
+            VarValue *a5 = aot_push(2);
+            if (!a5) AOT_FAIL(ERR_MEMORY);
+            a5[0] = f[0];
+            a5[1] = AOT_INT(1, v2);
+            VarValue t6;
+            AOT_CHECK(aot_call_native(rubel_list_at, a5, 2, &t6));
+            aot_pop(2);
+            VarValue t7;
+            AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, AOT_INT(1, t4), t6, t7);
+            AOT_CHECK(aot_expect(t7, INT_TYPE));
+            v1 = t7.data.int_val.value;
+        }
+        {
+            v2 = INT_WRAP_ADD(v2, 1);
+        }
+    }
+    {
+        *result = AOT_INT(1, v1);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[0], make_list_varval(1, aot_list_0), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[1], make_list_varval(1, aot_list_4), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_5);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue *a3 = aot_push(1);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = aot_globals[0];
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a3, &t4));
+        aot_pop(1);
+        a2[0] = t4;
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a6 = aot_push(1);
+        if (!a6) AOT_FAIL(ERR_MEMORY);
+        a6[0] = make_str_varval(1, &aot_str_6);
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_print, a6, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        VarValue *a10 = aot_push(2);
+        if (!a10) AOT_FAIL(ERR_MEMORY);
+        a10[0] = aot_globals[1];
+        a10[1] = AOT_INT(1, 1);
+        VarValue t11;
+        AOT_CHECK(aot_call_native(rubel_list_at, a10, 2, &t11));
+        aot_pop(2);
+        a9[0] = t11;
+        VarValue t12;
+        AOT_CHECK(aot_call(proc_0, a9, &t12));
+        aot_pop(1);
+        a8[0] = t12;
+        VarValue t13;
+        AOT_CHECK(aot_call_native(rubel_println, a8, 1, &t13));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(2) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+/* Compiled from ./tests/nonedecl.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // nothing
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = "ran nothing";
+static StringObj aot_str_0;
+static char aot_text_1[] = "before";
+static StringObj aot_str_1;
+static char aot_text_2[] = "after";
+static StringObj aot_str_2;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 11);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 6);
+    init_pinned_str_obj(&aot_str_2, aot_text_2, 5);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_0);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t1));
+        aot_pop(1);
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_1);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue t2;
+        AOT_CHECK(aot_call(proc_0, NULL, &t2));
+        AOT_CHECK(aot_declare(&aot_globals[0], t2, 0));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        VarValue *a3 = aot_push(1);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = make_str_varval(1, &aot_str_2);
+        VarValue t4;
+        AOT_CHECK(aot_call_native(rubel_println, a3, 1, &t4));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(1) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
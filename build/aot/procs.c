@@ -0,0 +1,392 @@
+/* Compiled from ./tests/procs.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // one
+static RunStatus proc_1(VarValue *args, VarValue *result); // two
+static RunStatus proc_2(VarValue *args, VarValue *result); // three
+static RunStatus proc_3(VarValue *args, VarValue *result); // four
+static RunStatus proc_4(VarValue *args, VarValue *result); // five
+static RunStatus proc_5(VarValue *args, VarValue *result); // six
+static RunStatus proc_6(VarValue *args, VarValue *result); // seven
+static RunStatus proc_7(VarValue *args, VarValue *result); // eight
+static RunStatus proc_8(VarValue *args, VarValue *result); // nine
+static RunStatus proc_9(VarValue *args, VarValue *result); // ten
+static AotProc proc_defs[10]; // set once each proc's declaration runs
+static char aot_text_0[] = "sum of one to ten is ";
+static StringObj aot_str_0;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 21);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        *result = AOT_INT(1, 1);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_0, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_0, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_2(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_1, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_0, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_3(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_1, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_1, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_4(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_3, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_0, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_5(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_2, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_2, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_6(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_5, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_0, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_7(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_3, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_3, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_8(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_7, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_0, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_9(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(0, args, 0);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call(proc_4, NULL, &t0));
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_4, NULL, &t1));
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, t1, t2);
+        *result = t2;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    proc_defs[2] = proc_2;
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    proc_defs[3] = proc_3;
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    proc_defs[4] = proc_4;
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    proc_defs[5] = proc_5;
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    proc_defs[6] = proc_6;
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    proc_defs[7] = proc_7;
+    aot_collect_garbage();
+
+    aot_stmt_num = 9;
+    proc_defs[8] = proc_8;
+    aot_collect_garbage();
+
+    aot_stmt_num = 10;
+    proc_defs[9] = proc_9;
+    aot_collect_garbage();
+
+    aot_stmt_num = 11;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_0);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 12;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue t3;
+        AOT_CHECK(aot_call(proc_0, NULL, &t3));
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_1, NULL, &t4));
+        VarValue t5;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t3, t4, t5);
+        VarValue t6;
+        AOT_CHECK(aot_call(proc_2, NULL, &t6));
+        VarValue t7;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t5, t6, t7);
+        VarValue t8;
+        AOT_CHECK(aot_call(proc_3, NULL, &t8));
+        VarValue t9;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t7, t8, t9);
+        VarValue t10;
+        AOT_CHECK(aot_call(proc_4, NULL, &t10));
+        VarValue t11;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t9, t10, t11);
+        VarValue t12;
+        AOT_CHECK(aot_call(proc_5, NULL, &t12));
+        VarValue t13;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t11, t12, t13);
+        VarValue t14;
+        AOT_CHECK(aot_call(proc_6, NULL, &t14));
+        VarValue t15;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t13, t14, t15);
+        VarValue t16;
+        AOT_CHECK(aot_call(proc_7, NULL, &t16));
+        VarValue t17;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t15, t16, t17);
+        VarValue t18;
+        AOT_CHECK(aot_call(proc_8, NULL, &t18));
+        VarValue t19;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t17, t18, t19);
+        VarValue t20;
+        AOT_CHECK(aot_call(proc_9, NULL, &t20));
+        VarValue t21;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t19, t20, t21);
+        a2[0] = t21;
+        VarValue t22;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t22));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
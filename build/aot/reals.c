@@ -0,0 +1,132 @@
+/* Compiled from ./tests/reals.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // circleArea
+static AotProc proc_defs[1]; // set once each proc's declaration runs
+static char aot_text_0[] = "area of radius 2.0 is ";
+static StringObj aot_str_0;
+static char aot_text_1[] = "negated is ";
+static StringObj aot_str_1;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 22);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 11);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 1);
+    float v1 = 0;
+    (void)v1;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v1 = 0x1.91eb86p+1f;
+    }
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, AOT_REAL(1, v1), f[0], t0);
+        VarValue t1;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, t0, f[0], t1);
+        *result = t1;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_0);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue *a3 = aot_push(1);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = AOT_REAL(1, 0x1p+1f);
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a3, &t4));
+        aot_pop(1);
+        a2[0] = t4;
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        VarValue *a6 = aot_push(1);
+        if (!a6) AOT_FAIL(ERR_MEMORY);
+        a6[0] = make_str_varval(1, &aot_str_1);
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_print, a6, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        a9[0] = AOT_REAL(1, 0x1.8p+0f);
+        VarValue t10;
+        AOT_CHECK(aot_call(proc_0, a9, &t10));
+        aot_pop(1);
+        VarValue t11;
+        AOT_CHECK(aot_negate(t10, &t11));
+        a8[0] = t11;
+        VarValue t12;
+        AOT_CHECK(aot_call_native(rubel_println, a8, 1, &t12));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/* Compiled from ./tests/recursion.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // countdown
+static RunStatus proc_1(VarValue *args, VarValue *result); // pow
+static AotProc proc_defs[2]; // set once each proc's declaration runs
+static char aot_text_0[] = "countdown from 3000 is ";
+static StringObj aot_str_0;
+static char aot_text_1[] = "two to the 30 is ";
+static StringObj aot_str_1;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 23);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 17);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_COMPARE(OP_EQ, ==, f[0], AOT_INT(1, 0), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (t1)
+        {
+            {
+                *result = aot_globals[0];
+                goto done;
+            }
+        }
+    }
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue t3;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[0], AOT_INT(1, 1), t3);
+        a2[0] = t3;
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a2, &t4));
+        aot_pop(1);
+        AOT_CHECK(aot_declare(&f[1], t4, 0));
+    }
+    {
+        VarValue t5;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, f[1], AOT_INT(1, 1), t5);
+        *result = t5;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 2);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_COMPARE(OP_EQ, ==, f[1], AOT_INT(1, 0), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (t1)
+        {
+            {
+                *result = AOT_INT(1, 1);
+                goto done;
+            }
+        }
+    }
+    {
+        VarValue t2 = f[0];
+        VarValue *a3 = aot_push(2);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = f[0];
+        VarValue t4;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[1], AOT_INT(1, 1), t4);
+        a3[1] = t4;
+        VarValue t5;
+        AOT_CHECK(aot_call(proc_1, a3, &t5));
+        aot_pop(2);
+        VarValue t6;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, t2, t5, t6);
+        *result = t6;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    {
+        aot_globals[0] = AOT_INT(0, 7);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_0);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue *a3 = aot_push(1);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = AOT_INT(1, 3000);
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a3, &t4));
+        aot_pop(1);
+        a2[0] = t4;
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a6 = aot_push(1);
+        if (!a6) AOT_FAIL(ERR_MEMORY);
+        a6[0] = make_str_varval(1, &aot_str_1);
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_print, a6, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        VarValue *a9 = aot_push(2);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        a9[0] = AOT_INT(1, 2);
+        a9[1] = AOT_INT(1, 30);
+        VarValue t10;
+        AOT_CHECK(aot_call(proc_1, a9, &t10));
+        aot_pop(2);
+        a8[0] = t10;
+        VarValue t11;
+        AOT_CHECK(aot_call_native(rubel_println, a8, 1, &t11));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(1) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
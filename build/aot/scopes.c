@@ -0,0 +1,185 @@
+/* Compiled from ./tests/scopes.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // addSteps
+static RunStatus proc_1(VarValue *args, VarValue *result); // shadow
+static AotProc proc_defs[2]; // set once each proc's declaration runs
+static char aot_text_0[] = "total is ";
+static StringObj aot_str_0;
+static char aot_text_1[] = "shadowed total is ";
+static StringObj aot_str_1;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 9);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 18);
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(3, args, 1);
+    int v1 = 0;
+    (void)v1;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v1 = 0;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t0;
+        AOT_INT_COMPARE(OP_LT, <, AOT_INT(1, v1), f[0], t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (!t1) break;
+        {
+            f[2] = AOT_INT(0, INT_WRAP_MUL(v1, 2));
+        }
+        {
+            VarValue t2;
+            AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, aot_globals[0], f[2], t2);
+            AOT_CHECK(aot_assign(&aot_globals[0], t2));
+        }
+        {
+            v1 = INT_WRAP_ADD(v1, 1);
+        }
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, f[0], AOT_INT(1, 1), t0);
+        *result = t0;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    {
+        aot_globals[0] = AOT_INT(0, 0);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        aot_globals[1] = AOT_INT(1, 2);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = AOT_INT(1, 5);
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_0, a0, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        a2[0] = make_str_varval(1, &aot_str_0);
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_print, a2, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        a4[0] = aot_globals[0];
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    {
+        VarValue *a6 = aot_push(1);
+        if (!a6) AOT_FAIL(ERR_MEMORY);
+        a6[0] = make_str_varval(1, &aot_str_1);
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_print, a6, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 9;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        a9[0] = AOT_INT(1, 41);
+        VarValue t10;
+        AOT_CHECK(aot_call(proc_1, a9, &t10));
+        aot_pop(1);
+        a8[0] = t10;
+        VarValue t11;
+        AOT_CHECK(aot_call_native(rubel_println, a8, 1, &t11));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(2) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
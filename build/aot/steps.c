@@ -0,0 +1,248 @@
+/* Compiled from ./tests/steps.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // countdown
+static RunStatus proc_1(VarValue *args, VarValue *result); // evens
+static RunStatus proc_2(VarValue *args, VarValue *result); // shrink
+static AotProc proc_defs[3]; // set once each proc's declaration runs
+
+static int init_literals()
+{
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(3, args, 1);
+    int v2 = 0;
+    (void)v2;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        AOT_CHECK(aot_declare(&f[1], f[0], 0));
+    }
+    {
+        v2 = 0;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t0;
+        AOT_INT_COMPARE(OP_GT, >, f[1], AOT_INT(1, 0), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (!t1) break;
+        {
+            VarValue t2;
+            AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[1], AOT_INT(1, 3), t2);
+            AOT_CHECK(aot_assign(&f[1], t2));
+        }
+        {
+            v2 = INT_WRAP_ADD(1, v2);
+        }
+    }
+    {
+        *result = AOT_INT(1, v2);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(3, args, 1);
+    int v1 = 0;
+    int v2 = 0;
+    (void)v1;
+    (void)v2;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v1 = 0;
+    }
+    {
+        v2 = 0;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t0;
+        AOT_INT_COMPARE(OP_LTE, <=, AOT_INT(1, v1), f[0], t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (!t1) break;
+        {
+            VarValue t2;
+            AOT_INT_COMPARE(OP_EQ, ==, AOT_INT(1, v1), f[0], t2);
+            int t3;
+            AOT_TEST(t2, t3);
+            if (t3)
+            {
+                {
+                    v2 = INT_WRAP_ADD(v2, 100);
+                }
+            }
+        }
+        {
+            v1 = INT_WRAP_ADD(v1, 2);
+        }
+        {
+            v2 = INT_WRAP_ADD(v2, 1);
+        }
+    }
+    {
+        *result = AOT_INT(1, v2);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_2(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        AOT_CHECK(aot_declare(&f[1], f[0], 0));
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t0;
+        AOT_INT_COMPARE(OP_GTE, >=, f[1], AOT_REAL(1, 0x1p+0f), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (!t1) break;
+        {
+            VarValue t2;
+            AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[1], AOT_REAL(1, 0x1p-1f), t2);
+            AOT_CHECK(aot_assign(&f[1], t2));
+        }
+    }
+    {
+        *result = f[1];
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    proc_defs[2] = proc_2;
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        VarValue *a1 = aot_push(1);
+        if (!a1) AOT_FAIL(ERR_MEMORY);
+        a1[0] = AOT_INT(1, 10);
+        VarValue t2;
+        AOT_CHECK(aot_call(proc_0, a1, &t2));
+        aot_pop(1);
+        a0[0] = t2;
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        VarValue *a5 = aot_push(1);
+        if (!a5) AOT_FAIL(ERR_MEMORY);
+        a5[0] = AOT_INT(1, 20);
+        VarValue t6;
+        AOT_CHECK(aot_call(proc_1, a5, &t6));
+        aot_pop(1);
+        a4[0] = t6;
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        a9[0] = AOT_REAL(1, 0x1.8p+2f);
+        VarValue t10;
+        AOT_CHECK(aot_call(proc_2, a9, &t10));
+        aot_pop(1);
+        a8[0] = t10;
+        VarValue t11;
+        AOT_CHECK(aot_call_native(rubel_println, a8, 1, &t11));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        VarValue *a12 = aot_push(1);
+        if (!a12) AOT_FAIL(ERR_MEMORY);
+        a12[0] = AOT_BOOL(1, 0);
+        VarValue t13;
+        AOT_CHECK(aot_call_native(rubel_println, a12, 1, &t13));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
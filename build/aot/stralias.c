@@ -0,0 +1,196 @@
+/* Compiled from ./tests/stralias.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static char aot_text_0[] = "a long enough text to leave the inline buffer";
+static StringObj aot_str_0;
+static char aot_text_1[] = "XYZ";
+static StringObj aot_str_1;
+static char aot_text_2[] = "plain";
+static StringObj aot_str_2;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 45);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 3);
+    init_pinned_str_obj(&aot_str_2, aot_text_2, 5);
+    return 1;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        VarValue t0;
+        AOT_CHECK(aot_call_native(rubel_str_builder, NULL, 0, &t0));
+        AOT_CHECK(aot_declare(&aot_globals[0], t0, 0));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue *a1 = aot_push(2);
+        if (!a1) AOT_FAIL(ERR_MEMORY);
+        a1[0] = aot_globals[0];
+        a1[1] = make_str_varval(1, &aot_str_0);
+        VarValue t2;
+        AOT_CHECK(aot_call_native(rubel_str_append, a1, 2, &t2));
+        aot_pop(2);
+        AOT_CHECK(aot_assign(&aot_globals[0], t2));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        VarValue *a3 = aot_push(2);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = aot_globals[0];
+        a3[1] = aot_globals[0];
+        VarValue t4;
+        AOT_CHECK(aot_call_native(rubel_str_append, a3, 2, &t4));
+        aot_pop(2);
+        AOT_CHECK(aot_assign(&aot_globals[0], t4));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a5 = aot_push(1);
+        if (!a5) AOT_FAIL(ERR_MEMORY);
+        a5[0] = aot_globals[0];
+        VarValue t6;
+        AOT_CHECK(aot_call_native(rubel_println, a5, 1, &t6));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a7 = aot_push(1);
+        if (!a7) AOT_FAIL(ERR_MEMORY);
+        a7[0] = aot_globals[0];
+        VarValue t8;
+        AOT_CHECK(aot_call_native(rubel_str_build, a7, 1, &t8));
+        aot_pop(1);
+        AOT_CHECK(aot_declare(&aot_globals[1], t8, 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[2], aot_globals[1], 0));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    {
+        VarValue *a9 = aot_push(2);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        a9[0] = aot_globals[2];
+        a9[1] = make_str_varval(1, &aot_str_1);
+        VarValue t10;
+        AOT_CHECK(aot_call_native(rubel_str_append, a9, 2, &t10));
+        aot_pop(2);
+        AOT_CHECK(aot_declare(&aot_globals[3], t10, 0));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 9;
+    {
+        VarValue *a11 = aot_push(1);
+        if (!a11) AOT_FAIL(ERR_MEMORY);
+        a11[0] = aot_globals[1];
+        VarValue t12;
+        AOT_CHECK(aot_call_native(rubel_println, a11, 1, &t12));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 10;
+    {
+        VarValue *a13 = aot_push(1);
+        if (!a13) AOT_FAIL(ERR_MEMORY);
+        a13[0] = aot_globals[2];
+        VarValue t14;
+        AOT_CHECK(aot_call_native(rubel_println, a13, 1, &t14));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 11;
+    {
+        VarValue *a15 = aot_push(1);
+        if (!a15) AOT_FAIL(ERR_MEMORY);
+        a15[0] = aot_globals[3];
+        VarValue t16;
+        AOT_CHECK(aot_call_native(rubel_println, a15, 1, &t16));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 12;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[4], make_str_varval(1, &aot_str_2), 0));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 13;
+    {
+        VarValue *a17 = aot_push(2);
+        if (!a17) AOT_FAIL(ERR_MEMORY);
+        a17[0] = aot_globals[4];
+        a17[1] = AOT_INT(1, 42);
+        VarValue t18;
+        AOT_CHECK(aot_call_native(rubel_str_append, a17, 2, &t18));
+        aot_pop(2);
+        AOT_CHECK(aot_declare(&aot_globals[5], t18, 0));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 14;
+    {
+        VarValue *a19 = aot_push(1);
+        if (!a19) AOT_FAIL(ERR_MEMORY);
+        a19[0] = aot_globals[4];
+        VarValue t20;
+        AOT_CHECK(aot_call_native(rubel_println, a19, 1, &t20));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 15;
+    {
+        VarValue *a21 = aot_push(1);
+        if (!a21) AOT_FAIL(ERR_MEMORY);
+        a21[0] = aot_globals[5];
+        VarValue t22;
+        AOT_CHECK(aot_call_native(rubel_println, a21, 1, &t22));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(6) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
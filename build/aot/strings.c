@@ -0,0 +1,193 @@
+/* Compiled from ./tests/strings.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // greet
+static RunStatus proc_1(VarValue *args, VarValue *result); // greetAll
+static AotProc proc_defs[2]; // set once each proc's declaration runs
+static char aot_text_0[] = ", ";
+static StringObj aot_str_0;
+static char aot_text_1[] = "hello";
+static StringObj aot_str_1;
+static char aot_text_2[] = "ada";
+static StringObj aot_str_2;
+static char aot_text_3[] = "grace";
+static StringObj aot_str_3;
+static char aot_text_4[] = "linus";
+static StringObj aot_str_4;
+static ListObj *aot_list_5 = NULL;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 2);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 5);
+    init_pinned_str_obj(&aot_str_2, aot_text_2, 3);
+    init_pinned_str_obj(&aot_str_3, aot_text_3, 5);
+    init_pinned_str_obj(&aot_str_4, aot_text_4, 5);
+    aot_list_5 = create_list_obj();
+
+    if (!aot_list_5) return 0;
+
+    heap_pin(&aot_list_5->gc);
+    if (!append_list_obj(aot_list_5, make_str_varval(0, &aot_str_2))) return 0;
+    if (!append_list_obj(aot_list_5, make_str_varval(0, &aot_str_3))) return 0;
+    if (!append_list_obj(aot_list_5, make_str_varval(0, &aot_str_4))) return 0;
+
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 2);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = f[0];
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        a2[0] = make_str_varval(1, &aot_str_0);
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_print, a2, 1, &t3));
+        aot_pop(1);
+    }
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        a4[0] = f[1];
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t5));
+        aot_pop(1);
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(4, args, 2);
+    int v2 = 0;
+    (void)v2;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v2 = 0;
+    }
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = f[1];
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_list_len, a0, 1, &t1));
+        aot_pop(1);
+        AOT_CHECK(aot_declare(&f[3], t1, 0));
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        VarValue t2;
+        AOT_INT_COMPARE(OP_LT, <, AOT_INT(1, v2), f[3], t2);
+        int t3;
+        AOT_TEST(t2, t3);
+        if (!t3) break;
+        {
+            VarValue *a4 = aot_push(2);
+            if (!a4) AOT_FAIL(ERR_MEMORY);
+            a4[0] = f[0];
+            VarValue *a5 = aot_push(2);
+            if (!a5) AOT_FAIL(ERR_MEMORY);
+            a5[0] = f[1];
+            a5[1] = AOT_INT(1, v2);
+            VarValue t6;
+            AOT_CHECK(aot_call_native(rubel_list_at, a5, 2, &t6));
+            aot_pop(2);
+            a4[1] = t6;
+            VarValue t7;
+            AOT_CHECK(aot_call(proc_0, a4, &t7));
+            aot_pop(2);
+        }
+        {
+            v2 = INT_WRAP_ADD(v2, 1);
+        }
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[0], make_str_varval(1, &aot_str_1), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        AOT_CHECK(aot_declare(&aot_globals[1], make_list_varval(1, aot_list_5), 1));
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    {
+        VarValue *a0 = aot_push(2);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_1);
+        a0[1] = aot_globals[1];
+        VarValue t1;
+        AOT_CHECK(aot_call(proc_1, a0, &t1));
+        aot_pop(2);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(2) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
@@ -0,0 +1,412 @@
+/* Compiled from ./tests/tailcalls.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // sumTo
+static RunStatus proc_1(VarValue *args, VarValue *result); // isEven
+static RunStatus proc_2(VarValue *args, VarValue *result); // isOdd
+static RunStatus proc_3(VarValue *args, VarValue *result); // spread
+static RunStatus proc_4(VarValue *args, VarValue *result); // relay
+static RunStatus proc_5(VarValue *args, VarValue *result); // total
+static AotProc proc_defs[6]; // set once each proc's declaration runs
+static char aot_text_0[] = "sum to 60000 is ";
+static StringObj aot_str_0;
+static char aot_text_1[] = "is 77777 even\? ";
+static StringObj aot_str_1;
+static char aot_text_2[] = "relayed spread is ";
+static StringObj aot_str_2;
+static char aot_text_3[] = "native tail call gives ";
+static StringObj aot_str_3;
+static ListObj *aot_list_4 = NULL;
+
+static int init_literals()
+{
+    init_pinned_str_obj(&aot_str_0, aot_text_0, 16);
+    init_pinned_str_obj(&aot_str_1, aot_text_1, 15);
+    init_pinned_str_obj(&aot_str_2, aot_text_2, 18);
+    init_pinned_str_obj(&aot_str_3, aot_text_3, 23);
+    aot_list_4 = create_list_obj();
+
+    if (!aot_list_4) return 0;
+
+    heap_pin(&aot_list_4->gc);
+    if (!append_list_obj(aot_list_4, make_int_varval(0, 1))) return 0;
+    if (!append_list_obj(aot_list_4, make_int_varval(0, 2))) return 0;
+    if (!append_list_obj(aot_list_4, make_int_varval(0, 3))) return 0;
+    if (!append_list_obj(aot_list_4, make_int_varval(0, 4))) return 0;
+
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(2, args, 2);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_COMPARE(OP_EQ, ==, f[0], AOT_INT(1, 0), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (t1)
+        {
+            {
+                *result = f[1];
+                goto done;
+            }
+        }
+    }
+    {
+        VarValue *a2 = aot_push(2);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue t3;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[0], AOT_INT(1, 1), t3);
+        a2[0] = t3;
+        VarValue t4;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, f[1], f[0], t4);
+        a2[1] = t4;
+        status = aot_tail(proc_0, a2, 2);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_COMPARE(OP_EQ, ==, f[0], AOT_INT(1, 0), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (t1)
+        {
+            {
+                *result = AOT_BOOL(1, 1);
+                goto done;
+            }
+        }
+    }
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue t3;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[0], AOT_INT(1, 1), t3);
+        a2[0] = t3;
+        if (proc_defs[2] != NULL)
+        {
+            status = aot_tail(proc_2, a2, 1);
+            goto done;
+        }
+        VarValue t4;
+        if (proc_defs[2] != NULL)
+        {
+            AOT_CHECK(aot_call(proc_2, a2, &t4));
+        }
+        else
+        {
+            AOT_FAIL(ERR_NULL_VAL);
+        }
+        aot_pop(1);
+        *result = t4;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_2(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_COMPARE(OP_EQ, ==, f[0], AOT_INT(1, 0), t0);
+        int t1;
+        AOT_TEST(t0, t1);
+        if (t1)
+        {
+            {
+                *result = AOT_BOOL(1, 0);
+                goto done;
+            }
+        }
+    }
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue t3;
+        AOT_INT_MATH(OP_SUB, INT_WRAP_SUB, f[0], AOT_INT(1, 1), t3);
+        a2[0] = t3;
+        status = aot_tail(proc_1, a2, 1);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_3(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(4, args, 3);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, f[0], f[1], t0);
+        VarValue t1;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, t0, f[2], t1);
+        AOT_CHECK(aot_declare(&f[3], t1, 0));
+    }
+    {
+        *result = f[3];
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_4(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue *a0 = aot_push(3);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = f[0];
+        VarValue t1;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[0], AOT_INT(1, 2), t1);
+        a0[1] = t1;
+        VarValue t2;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[0], AOT_INT(1, 3), t2);
+        a0[2] = t2;
+        status = aot_tail(proc_3, a0, 3);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_5(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(1, args, 1);
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = f[0];
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_list_sum, a0, 1, &t1));
+        aot_pop(1);
+        *result = t1;
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    proc_defs[2] = proc_2;
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    proc_defs[3] = proc_3;
+    aot_collect_garbage();
+
+    aot_stmt_num = 6;
+    proc_defs[4] = proc_4;
+    aot_collect_garbage();
+
+    aot_stmt_num = 7;
+    proc_defs[5] = proc_5;
+    aot_collect_garbage();
+
+    aot_stmt_num = 8;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        a0[0] = make_str_varval(1, &aot_str_0);
+        VarValue t1;
+        AOT_CHECK(aot_call_native(rubel_print, a0, 1, &t1));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 9;
+    {
+        VarValue *a2 = aot_push(1);
+        if (!a2) AOT_FAIL(ERR_MEMORY);
+        VarValue *a3 = aot_push(2);
+        if (!a3) AOT_FAIL(ERR_MEMORY);
+        a3[0] = AOT_INT(1, 60000);
+        a3[1] = AOT_INT(1, 0);
+        VarValue t4;
+        AOT_CHECK(aot_call(proc_0, a3, &t4));
+        aot_pop(2);
+        a2[0] = t4;
+        VarValue t5;
+        AOT_CHECK(aot_call_native(rubel_println, a2, 1, &t5));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 10;
+    {
+        VarValue *a6 = aot_push(1);
+        if (!a6) AOT_FAIL(ERR_MEMORY);
+        a6[0] = make_str_varval(1, &aot_str_1);
+        VarValue t7;
+        AOT_CHECK(aot_call_native(rubel_print, a6, 1, &t7));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 11;
+    {
+        VarValue *a8 = aot_push(1);
+        if (!a8) AOT_FAIL(ERR_MEMORY);
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        a9[0] = AOT_INT(1, 77777);
+        VarValue t10;
+        AOT_CHECK(aot_call(proc_1, a9, &t10));
+        aot_pop(1);
+        a8[0] = t10;
+        VarValue t11;
+        AOT_CHECK(aot_call_native(rubel_println, a8, 1, &t11));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 12;
+    {
+        VarValue *a12 = aot_push(1);
+        if (!a12) AOT_FAIL(ERR_MEMORY);
+        a12[0] = make_str_varval(1, &aot_str_2);
+        VarValue t13;
+        AOT_CHECK(aot_call_native(rubel_print, a12, 1, &t13));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 13;
+    {
+        VarValue *a14 = aot_push(1);
+        if (!a14) AOT_FAIL(ERR_MEMORY);
+        VarValue *a15 = aot_push(1);
+        if (!a15) AOT_FAIL(ERR_MEMORY);
+        a15[0] = AOT_INT(1, 5);
+        VarValue t16;
+        AOT_CHECK(aot_call(proc_4, a15, &t16));
+        aot_pop(1);
+        a14[0] = t16;
+        VarValue t17;
+        AOT_CHECK(aot_call_native(rubel_println, a14, 1, &t17));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 14;
+    {
+        VarValue *a18 = aot_push(1);
+        if (!a18) AOT_FAIL(ERR_MEMORY);
+        a18[0] = make_str_varval(1, &aot_str_3);
+        VarValue t19;
+        AOT_CHECK(aot_call_native(rubel_print, a18, 1, &t19));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 15;
+    {
+        VarValue *a20 = aot_push(1);
+        if (!a20) AOT_FAIL(ERR_MEMORY);
+        VarValue *a21 = aot_push(1);
+        if (!a21) AOT_FAIL(ERR_MEMORY);
+        a21[0] = make_list_varval(1, aot_list_4);
+        VarValue t22;
+        AOT_CHECK(aot_call(proc_5, a21, &t22));
+        aot_pop(1);
+        a20[0] = t22;
+        VarValue t23;
+        AOT_CHECK(aot_call_native(rubel_println, a20, 1, &t23));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
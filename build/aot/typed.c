@@ -0,0 +1,211 @@
+/* Compiled from ./tests/typed.rubel by rubel --emit-c. */
+
+#include <math.h>
+#include "backend/runner/aotrt.h"
+
+static RunStatus proc_0(VarValue *args, VarValue *result); // mixer
+static RunStatus proc_1(VarValue *args, VarValue *result); // halves
+static AotProc proc_defs[2]; // set once each proc's declaration runs
+
+static int init_literals()
+{
+    return 1;
+}
+
+static RunStatus proc_0(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(5, args, 1);
+    int v1 = 0;
+    float v2 = 0;
+    int v3 = 0;
+    (void)v1;
+    (void)v2;
+    (void)v3;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v1 = 0;
+    }
+    {
+        v2 = 0x1.8p+0f;
+    }
+    {
+        v3 = 1;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        if (!(v3 <= 10)) break;
+        {
+            int t0 = 2;
+            if (t0 == 0) AOT_FAIL(ERR_NULL_VAL);
+            v1 = INT_WRAP_SUB(INT_WRAP_ADD(v1, INT_WRAP_MUL(v3, v3)), INT_WRAP_DIV(v3, t0));
+        }
+        {
+            if (0x1.8p+1f == 0) AOT_FAIL(ERR_NULL_VAL);
+            v2 = ((v2 * 0x1.8p+0f) - (v2 / 0x1.8p+1f));
+        }
+        {
+            v3 = INT_WRAP_ADD(v3, 1);
+        }
+    }
+    {
+        if ((v1 > 300))
+        {
+            {
+                int t1 = 4;
+                if (t1 == 0) AOT_FAIL(ERR_NULL_VAL);
+                f[4] = AOT_INT(0, INT_WRAP_DIV(v1, t1));
+            }
+            {
+                v1 = INT_WRAP_ADD(v1, f[4].data.int_val.value);
+            }
+        }
+    }
+    {
+        VarValue t2;
+        AOT_INT_MATH(OP_ADD, INT_WRAP_ADD, AOT_INT(1, v1), f[0], t2);
+        AOT_CHECK(aot_expect(t2, INT_TYPE));
+        v1 = t2.data.int_val.value;
+    }
+    {
+        *result = AOT_INT(1, v1);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus proc_1(VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    AotMark mark = aot_mark();
+    VarValue *f = aot_enter(3, args, 1);
+    int v1 = 0;
+    float v2 = 0;
+    (void)v1;
+    (void)v2;
+
+    if (!f) AOT_FAIL(ERR_MEMORY);
+
+    *result = make_none_varval();
+    {
+        v1 = 0;
+    }
+    {
+        VarValue t0;
+        AOT_INT_MATH(OP_MUL, INT_WRAP_MUL, f[0], AOT_REAL(1, 0x1p+0f), t0);
+        v2 = t0.data.real_val.value;
+    }
+    while (1)
+    {
+        aot_collect_garbage();
+        if (!(v2 > 0x1p+0f)) break;
+        {
+            if (0x1p+1f == 0) AOT_FAIL(ERR_NULL_VAL);
+            v2 = (v2 / 0x1p+1f);
+        }
+        {
+            v1 = INT_WRAP_ADD(v1, 1);
+        }
+    }
+    {
+        *result = AOT_INT(1, v1);
+        goto done;
+    }
+    goto done;
+done:
+    aot_release(mark);
+    return status;
+}
+
+static RunStatus run_script()
+{
+    RunStatus status = OK_RAN_CMD;
+
+    aot_stmt_num = 0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 1;
+    proc_defs[0] = proc_0;
+    aot_collect_garbage();
+
+    aot_stmt_num = 2;
+    proc_defs[1] = proc_1;
+    aot_collect_garbage();
+
+    aot_stmt_num = 3;
+    {
+        VarValue *a0 = aot_push(1);
+        if (!a0) AOT_FAIL(ERR_MEMORY);
+        VarValue *a1 = aot_push(1);
+        if (!a1) AOT_FAIL(ERR_MEMORY);
+        a1[0] = AOT_INT(1, 5);
+        VarValue t2;
+        AOT_CHECK(aot_call(proc_0, a1, &t2));
+        aot_pop(1);
+        a0[0] = t2;
+        VarValue t3;
+        AOT_CHECK(aot_call_native(rubel_println, a0, 1, &t3));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 4;
+    {
+        VarValue *a4 = aot_push(1);
+        if (!a4) AOT_FAIL(ERR_MEMORY);
+        VarValue *a5 = aot_push(1);
+        if (!a5) AOT_FAIL(ERR_MEMORY);
+        a5[0] = AOT_INT(1, (-5));
+        VarValue t6;
+        AOT_CHECK(aot_call(proc_0, a5, &t6));
+        aot_pop(1);
+        VarValue t7;
+        AOT_INT_COMPARE(OP_EQ, ==, t6, AOT_INT(1, 445), t7);
+        a4[0] = t7;
+        VarValue t8;
+        AOT_CHECK(aot_call_native(rubel_println, a4, 1, &t8));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    aot_stmt_num = 5;
+    {
+        VarValue *a9 = aot_push(1);
+        if (!a9) AOT_FAIL(ERR_MEMORY);
+        VarValue *a10 = aot_push(1);
+        if (!a10) AOT_FAIL(ERR_MEMORY);
+        a10[0] = AOT_REAL(1, 0x1.9p+6f);
+        VarValue t11;
+        AOT_CHECK(aot_call(proc_1, a10, &t11));
+        aot_pop(1);
+        a9[0] = t11;
+        VarValue t12;
+        AOT_CHECK(aot_call_native(rubel_println, a9, 1, &t12));
+        aot_pop(1);
+    }
+    aot_collect_garbage();
+
+    goto done;
+done:
+    return status;
+}
+
+int main()
+{
+    RunStatus status = ERR_MEMORY;
+
+    if (aot_init(0) && init_literals()) status = run_script();
+
+    aot_log_err(status);
+    aot_dispose();
+
+    return 0;
+}
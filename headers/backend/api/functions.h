@@ -8,6 +8,7 @@
 
 #define FUNC_ARGV_MIN_SZ 4
 #define FUNC_ARGV_MAX_SZ 32
+#define FUNC_GROUP_SIZE 8
 
 /// SECTION: Type Decls.
 
@@ -15,35 +16,26 @@ typedef enum en_function_type
 {
     FUNC_NATIVE,  // wrapper for C function
     FUNC_NORMAL,  // wrapper for AST nodes to traverse
-    FUNC_UNKNOWN  // reserved for bytecode usage??
+    FUNC_BYTECODE // wrapper for a compiled proc run by the VM
 } FuncType;
 
 /// SECTION: Func Args Impl.
 
+/**
+ * @brief Borrowed view of a call's argument values. The caller owns the value array, e.g. a C array on its stack or the VM's registers.
+ */
 typedef struct st_func_args
 {
     unsigned short argc;
-    VarValue **args;
+    VarValue *args;
 } FuncArgs;
 
-typedef VarValue *(*NativeFunc)(struct st_func_args *args);
-
-FuncArgs *funcargs_create(unsigned short argc);
-
-/**
- * @brief Unbinds referencing ptrs to arg values.
- * @param argv
- */
-void funcargs_dispose(FuncArgs *argv);
-
 /**
- * @brief Frees up memory of stored referencing ptrs to arg values.
- * @param argv 
- * @note Use only when there is no interpreter scope (native func calls!)
+ * @brief Native functions return their result by value. A NONE_TYPE result means no value or a failed call.
  */
-void funcargs_destroy(FuncArgs *argv);
+typedef VarValue (*NativeFunc)(struct st_func_args *args);
 
-int funcargs_set_at(FuncArgs *argv, unsigned short index, VarValue *arg);
+void funcargs_init(FuncArgs *argv, unsigned short argc, VarValue *args);
 
 VarValue *funcargs_get_at(const FuncArgs *argv, unsigned short index);
 
@@ -76,6 +68,8 @@ Variable *funcparams_get(FuncParams *params, unsigned short index);
 
 /// SECTION: Function Decl.
 
+struct st_bc_proc; // see compiler/bytecode.h
+
 /**
  * @brief Function object managed by interpreter. Memory in ptrs is usually unbound before freeing of the structure.
  * @note Don't free content ptrs as Script manages AST ptrs. and func ptrs. are static!
@@ -84,21 +78,25 @@ typedef struct st_function
 {
     FuncType type; // function content type
     int arity; // accepted arg count
+    unsigned short frame_size; // slots for params and locals of AST functions
     char *name; // function name
     Expression **param_exprs; // reference ptr to AST node's parameters
     union
     {
         NativeFunc fn_ptr; // native C function reference ptr
         Statement *fn_ast; // AST stmts reference ptr
+        const struct st_bc_proc *fn_code; // compiled proc reference ptr
     } content;
 } FuncObj;
 
 FuncObj *func_native_create(char *name, int arity, NativeFunc fn_ptr);
 
-FuncObj *func_ast_create(char *name, int arity, Expression **param_exprs, Statement *fn_ast);
+FuncObj *func_ast_create(char *name, int arity, unsigned short frame_size, Expression **param_exprs, Statement *fn_ast);
+
+FuncObj *func_bytecode_create(char *name, int arity, const struct st_bc_proc *fn_code);
 
 /**
- * @brief Unbinds the AST subtree or function address of the function's content. However, the name string is freed.
+ * @brief Unbinds the name and the AST subtree or function address of the function's content. Names are interned, so they are never freed here.
  * @param fn_obj
  */
 void func_dispose(FuncObj *fn_obj);
@@ -106,21 +104,22 @@ void func_dispose(FuncObj *fn_obj);
 /// SECTION: Function Storage
 
 /**
- * @brief Crude named dictionary for functions of an imported module.
+ * @brief Named dictionary for functions of an imported module. It is open-addressed like VarEnv: a power of two capacity with linear probing, doubled before it is 3/4 full.
  * @note The 1st FuncGroup is always the script's function module (grouping).
  */
 typedef struct st_func_group
 {
     int used;
     char *name;
+    unsigned int capacity;
     unsigned int count;
-    FuncObj **fn_buckets;
+    FuncObj **fn_buckets; // NULL marks a free slot
 } FuncGroup;
 
 FuncGroup *funcgroup_create(char *name, unsigned int buckets);
 
 /**
- * @brief Cleans up this function dictionary, but its name string is static- cannot be freed. FuncObj has its names and contents unbound before freeing. Finally the outer bucket array is freed.
+ * @brief Cleans up this function dictionary, but its name string is interned- cannot be freed. FuncObj has its names and contents unbound before freeing. Finally the outer bucket array is freed.
  * @param fn_group
  */
 void funcgroup_dispose(FuncGroup *fn_group);
@@ -129,26 +128,60 @@ void funcgroup_mark_used(FuncGroup *fn_group, int flag);
 
 int funcgroup_is_used(const FuncGroup *fn_group);
 
+/**
+ * @brief Adds a function, growing the group when needed.
+ * @return int 1 on success, 0 if the name is taken or allocation failed.
+ */
 int funcgroup_put(FuncGroup *fn_group, FuncObj *fn_obj);
 
 const FuncObj *funcgroup_get(const FuncGroup *fn_group, const char *fn_name);
 
 /**
  * @brief A crude vector of FuncGroup objects. Used as the function specific environment during execution of other functions.
+ * @note The index merges the names of all used groups, so a call is resolved with one probe. Earlier groups win name clashes, so script procs shadow natives.
  */
 typedef struct st_func_env
 {
     unsigned int count;
     unsigned int capacity;
     FuncGroup **func_groups;
+    unsigned int index_capacity;
+    unsigned int index_count;
+    const FuncObj **index; // borrowed FuncObj ptrs, NULL marks a free slot
+    unsigned int generation; // bumped whenever the visible functions change, so call site caches know to resolve again
 } FuncEnv;
 
 FuncEnv *funcenv_create(unsigned int capacity); 
 
 void funcenv_dispose(FuncEnv *fenv);
 
+/**
+ * @brief Appends a group. The index is rebuilt if that group is already used.
+ */
 int funcenv_append(FuncEnv *fenv, FuncGroup *fn_group_obj);
 
 FuncGroup *funcenv_fetch(const FuncEnv *fenv, const char *group_name);
 
+/**
+ * @brief Refills the merged index from every used group in order.
+ * @return int 1 on success, 0 on a failed allocation.
+ */
+int funcenv_rebuild_index(FuncEnv *fenv);
+
+/**
+ * @brief Marks a group as used and merges its names into the index.
+ */
+int funcenv_use_group(FuncEnv *fenv, FuncGroup *fn_group);
+
+/**
+ * @brief Puts a script proc into the 1st group and indexes it over any native of the same name.
+ * @return int 1 on success, 0 on a redefinition or failed allocation.
+ */
+int funcenv_define(FuncEnv *fenv, FuncObj *fn_obj);
+
+/**
+ * @brief Resolves a called name with a single probe of the merged index.
+ */
+const FuncObj *funcenv_lookup(const FuncEnv *fenv, const char *fn_name);
+
 #endif
\ No newline at end of file
@@ -3,25 +3,63 @@
 
 #include <stdio.h>
 #include "backend/api/functions.h"
+#include "backend/values/listkernels.h"
+#include "backend/values/heap.h"
 
 /// SECTION: macros
 
 #define RUBEL_INPUT_READ_MAX 32
+#define RUBEL_FORMAT_BUF_SZ 32 // room for a printed int or real
 
 /// SECTION: module "io" natives
 
-VarValue *rubel_print(FuncArgs *args);
+VarValue rubel_print(FuncArgs *args);
 
-VarValue *rubel_println(FuncArgs *args);
+VarValue rubel_println(FuncArgs *args);
 
-VarValue *rubel_input(FuncArgs *args);
+VarValue rubel_input(FuncArgs *args);
 
 /// SECTION: module "lists" natives
 
-VarValue *rubel_list_len(FuncArgs *args);
+VarValue rubel_list_len(FuncArgs *args);
 
-VarValue *rubel_list_at(FuncArgs *args);
+VarValue rubel_list_at(FuncArgs *args);
 
-// VarValue *rubel_list_set(FuncArgs *args); // TODO!
+/// NOTE: the math natives below run vector kernels over packed int or real lists. Mixed lists give NONE, except for indexOf which searches them item by item.
+
+VarValue rubel_list_sum(FuncArgs *args);
+
+VarValue rubel_list_min(FuncArgs *args);
+
+VarValue rubel_list_max(FuncArgs *args);
+
+VarValue rubel_list_index_of(FuncArgs *args);
+
+VarValue rubel_list_dot(FuncArgs *args);
+
+/**
+ * @brief Makes a new list of each item times the factor, which must have the list's item type.
+ */
+VarValue rubel_list_scale(FuncArgs *args);
+
+// VarValue rubel_list_set(FuncArgs *args); // TODO!
+
+/// SECTION: module "strings" natives
+
+/**
+ * @brief Makes an empty string for appending to. Its buffer grows geometrically, so building a long string takes amortized O(1) per append.
+ */
+VarValue rubel_str_builder(FuncArgs *args);
+
+/**
+ * @brief Appends a string, int, real or boolean to a builder. Builders grow in place, so every alias of one sees the append, but appending to any other string makes a new one.
+ * @return VarValue The builder to keep using, which may be a new string.
+ */
+VarValue rubel_str_append(FuncArgs *args);
+
+/**
+ * @brief Copies the built text into a new string that later appends cannot change.
+ */
+VarValue rubel_str_build(FuncArgs *args);
 
 #endif
\ No newline at end of file
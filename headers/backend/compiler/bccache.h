@@ -0,0 +1,120 @@
+#ifndef BCCACHE_H
+#define BCCACHE_H
+
+/**
+ * @file bccache.h
+ * @author Derek Tan
+ * @brief Precompiled script cache. A compiled BcProgram is saved next to its source as a .rubelc image, so later runs of the same source skip parsing and compiling. Images hold offsets instead of pointers, and loading maps one in place: proc code and string text are used from the mapping without copies.
+ * @note An image records its format version, the hash of the source it came from, and a checksum of its payload. The loader rejects it on any mismatch, and the driver then compiles the script as usual.
+ */
+
+#include <stdint.h>
+#include "backend/compiler/bytecode.h"
+
+/// SECTION: Macros
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BCCACHE_MMAP
+#endif
+
+#define BCCACHE_KNOB "RUBEL_NO_CACHE" // env variable that turns off reading and writing caches
+#define BCCACHE_SOURCE_EXT ".rubel"
+#define BCCACHE_EXT ".rubelc"
+#define BCCACHE_PATH_MAX 4096
+#define BCCACHE_MAGIC "RUBELBC" // 7 chars and the NUL fill the magic field
+#define BCCACHE_VERSION 2         // NOTE: bump this whenever the opcodes or this layout change!
+#define BCCACHE_NO_NAME UINT32_MAX
+#define BCCACHE_ALIGN 8
+#define BCCACHE_BUFFER_MIN_SZ 256
+
+/// SECTION: Image layout
+
+/**
+ * @brief Payload parts of an image. They follow the header in this order, each padded to BCCACHE_ALIGN bytes.
+ */
+typedef enum en_bccache_section
+{
+    BCCACHE_PROCS,   // BcCacheProc records
+    BCCACHE_CODE,    // BcInstr arrays of all procs
+    BCCACHE_CONSTS,  // BcCacheValue records, one per constant
+    BCCACHE_LISTS,   // BcCacheList records, nested lists before the lists holding them
+    BCCACHE_ITEMS,   // BcCacheValue records of list items
+    BCCACHE_STRINGS, // BcCacheText records of string constants and items
+    BCCACHE_NAMES,   // BcCacheText records of callee and module names
+    BCCACHE_TEXT,    // NUL terminated chars of all strings and names
+    BCCACHE_SECTION_COUNT
+} BcCacheSection;
+
+typedef struct st_bccache_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t instr_size;   // sizeof(BcInstr), so images from other builds are rejected
+    uint64_t source_hash;
+    uint64_t checksum;     // hash of every byte after the header
+    uint64_t image_size;
+    uint32_t global_count;
+    uint32_t stmt_count;
+    uint32_t section_sizes[BCCACHE_SECTION_COUNT]; // in bytes with padding
+} BcCacheHeader;
+
+typedef struct st_bccache_text
+{
+    uint32_t offset; // into the text section
+    uint32_t length;
+} BcCacheText;
+
+typedef struct st_bccache_proc
+{
+    BcCacheText name;    // offset is BCCACHE_NO_NAME for the script's code
+    uint32_t code_start; // first instruction in the code section
+    uint32_t code_count;
+    uint16_t arity;
+    uint16_t reg_count;
+    uint32_t padding;
+} BcCacheProc;
+
+/**
+ * @brief A constant or list item. Strings and lists are indexes into their sections.
+ */
+typedef struct st_bccache_value
+{
+    uint8_t type;     // DataType
+    uint8_t is_const;
+    uint16_t padding;
+    uint32_t bits;    // int, float bits, bool flag, or index
+} BcCacheValue;
+
+typedef struct st_bccache_list
+{
+    uint32_t item_start;
+    uint32_t item_count;
+} BcCacheList;
+
+/// SECTION: Cache files
+
+/**
+ * @brief Writes the cache path of a source into path: "x.rubel" gives "x.rubelc", and other names get BCCACHE_EXT appended.
+ * @note Callers must also skip sources that are not regular files, which load_source reports as streams.
+ * @return int 1 on success, or 0 if the path does not fit or the source is under /dev or /proc.
+ */
+int bccache_path_for(const char *source_path, char *path, size_t path_size);
+
+/**
+ * @brief Saves a compiled program and the counts ctx_init needs. The image goes to a temporary file renamed over the old one, so readers never see half of it.
+ * @return int 1 on success. Failing to save is harmless, as the next run just compiles again.
+ */
+int bccache_save(const BcProgram *program, const char *cache_path, uint64_t source_hash, unsigned short global_count, unsigned int stmt_count);
+
+/**
+ * @brief Loads a program from the image at cache_path if it is intact, current and made from a source with this hash. Names are interned and list constants are made pinned in the heap, which must be ready.
+ * @return int 1 on success with the program owning the image, or 0 with the program left disposed.
+ */
+int bccache_load(BcProgram *program, const char *name, const char *cache_path, uint64_t source_hash, unsigned short *global_count, unsigned int *stmt_count);
+
+/**
+ * @brief Drops a loaded program's image and the procs' borrowed code, so bcprogram_dispose can run after. Programs not loaded from a cache are left as is.
+ */
+void bccache_unload(BcProgram *program);
+
+#endif
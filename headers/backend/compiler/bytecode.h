@@ -0,0 +1,168 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+/**
+ * @file bytecode.h
+ * @author Derek Tan
+ * @brief Register bytecode format: opcodes, instructions, compiled procs, and the program's constant pool.
+ */
+
+#include "backend/values/vartypes.h"
+
+/// SECTION: Macros
+
+#define BC_CODE_MIN_SZ 16
+#define BC_PROCS_MIN_SZ 4
+#define BC_CONSTS_MIN_SZ 8
+#define BC_NAMES_MIN_SZ 8
+#define BC_OPERAND_MAX 65535
+#define BC_IMM_MIN (-32768) // signed range of a BC_ADDI step
+#define BC_IMM_MAX 32767
+
+/// SECTION: Opcodes
+
+/**
+ * @brief Register machine opcodes. Operands are a, b, c. Unless noted, a is the destination register and b, c are source registers.
+ */
+typedef enum en_bc_opcode
+{
+    BC_NOP,
+    BC_STMT,       // b: top-level statement number for error reports
+    BC_LOADK,      // a = consts[b]
+    BC_MOVE,       // a = b
+    BC_ASSIGN,     // a = b, but fails on a type change like "set"
+    BC_GETGLOBAL,  // a = globals[b]
+    BC_SETGLOBAL,  // globals[a] = b, fails on a type change like "set"
+    BC_CHECKVAL,   // fails if a is none, like a "let" of a proc that returns nothing
+    BC_NEG,        // a = -b
+    BC_ADD,        // a = b + c
+    BC_SUB,
+    BC_MUL,
+    BC_DIV,
+    BC_ADDI,       // a += (short)b in place for an int a, like "set a = a + b"
+    BC_IADD,       // a = b + c for operands the typer proved to be ints
+    BC_ISUB,
+    BC_IMUL,
+    BC_IDIV,       // NOTE: typed divisions still fail on zero.
+    BC_RADD,       // a = b + c for operands the typer proved to be reals
+    BC_RSUB,
+    BC_RMUL,
+    BC_RDIV,
+    BC_EQ,         // a = b == c
+    BC_NEQ,
+    BC_LT,
+    BC_LTE,
+    BC_GT,
+    BC_GTE,
+    BC_JMP,        // pc = b
+    BC_JMPF,       // if !a then pc = b
+    BC_EQJMPF,     // if !(a == c) then pc = b, where c is consts[c] if aux is 1
+    BC_NEQJMPF,    // NOTE: the compare-jumps keep the order of BC_EQ to BC_GTE.
+    BC_LTJMPF,
+    BC_LTEJMPF,
+    BC_GTJMPF,
+    BC_GTEJMPF,
+    BC_IEQJMPF,    // like BC_EQJMPF to BC_GTEJMPF for operands the typer proved to be ints
+    BC_INEQJMPF,
+    BC_ILTJMPF,
+    BC_ILTEJMPF,
+    BC_IGTJMPF,
+    BC_IGTEJMPF,
+    BC_CALL,       // a = call names[b] with aux args from a...a + aux - 1
+    BC_TAILCALL,   // like BC_CALL, but a proc callee takes over the frame. Natives go on to the BC_RET a that follows.
+    BC_RET,        // return a
+    BC_RETNONE,    // return without a value
+    BC_DEFPROC,    // bind procs[b] into the script's function group
+    BC_USE,        // mark module names[b] as used
+    BC_HALT
+} BcOpCode;
+
+/**
+ * @brief One fixed size (8 byte) register instruction.
+ */
+typedef struct st_bc_instr
+{
+    unsigned char op;    // BcOpCode
+    unsigned char aux;   // small immediate e.g. call argc
+    unsigned short a;
+    unsigned short b;
+    unsigned short c;
+} BcInstr;
+
+/// SECTION: Compiled Procs
+
+/**
+ * @brief A compiled proc. Its frame is a window of reg_count registers whose first arity registers hold the arguments.
+ * @note The name string is borrowed from the AST, so it is not freed here.
+ */
+typedef struct st_bc_proc
+{
+    char *name;
+    unsigned short arity;
+    unsigned short reg_count;
+    unsigned int index; // spot in the program's procs
+    unsigned int count;
+    unsigned int capacity;
+    BcInstr *code;
+} BcProc;
+
+BcProc *bcproc_create(char *name, unsigned short arity);
+
+void bcproc_dispose(BcProc *proc);
+
+/**
+ * @brief Appends an instruction, doubling the code vector when full.
+ * @return unsigned int The new instruction's index or BC_OPERAND_MAX + 1 on failure.
+ */
+unsigned int bcproc_emit(BcProc *proc, BcOpCode op, unsigned char aux, unsigned short a, unsigned short b, unsigned short c);
+
+/// SECTION: Program
+
+/**
+ * @brief A whole compiled script. procs[0] is always the script's top-level code, and its registers are the globals.
+ * @note Constants borrow string and list objects from the AST literals. Names (callees, modules) also borrow AST strings. A program loaded from a cache borrows its code and string text from the cache image instead, see bccache.h.
+ */
+typedef struct st_bc_program
+{
+    const char *name;
+    void *image;           // mapped cache image or NULL if compiled this run
+    size_t image_size;
+    StringObj *image_strs; // pinned strings over the image's text
+    unsigned int proc_count;
+    unsigned int proc_capacity;
+    BcProc **procs;
+    unsigned int const_count;
+    unsigned int const_capacity;
+    VarValue *consts;
+    unsigned int name_count;
+    unsigned int name_capacity;
+    char **names;
+} BcProgram;
+
+int bcprogram_init(BcProgram *program, const char *name);
+
+void bcprogram_dispose(BcProgram *program);
+
+/**
+ * @return int The new proc's index or -1 on failure.
+ */
+int bcprogram_add_proc(BcProgram *program, BcProc *proc);
+
+/**
+ * @brief Appends a constant to the pool. Ints, reals, and bools are reused when an equal one exists.
+ * @return int The constant's index or -1 on failure.
+ */
+int bcprogram_add_const(BcProgram *program, VarValue value);
+
+/**
+ * @brief Appends a callee or module name, reusing an equal one if present.
+ * @return int The name's index or -1 on failure.
+ */
+int bcprogram_add_name(BcProgram *program, char *name);
+
+/**
+ * @brief Prints a listing of all procs for debugging.
+ */
+void bcprogram_dump(const BcProgram *program);
+
+#endif
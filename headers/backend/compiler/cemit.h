@@ -0,0 +1,111 @@
+#ifndef CEMIT_H
+#define CEMIT_H
+
+/**
+ * @file cemit.h
+ * @author Derek Tan
+ * @brief Ahead-of-time compiler from a typed Script to one C translation unit, see --emit-c. Procs become C functions over the aotrt runtime, and locals the typer proved to be numbers or booleans become plain C variables.
+ * @note The generated program keeps the walker's semantics: the same errors at the same top-level statements, the same call resolution, and collections at the same safe points.
+ */
+
+#include <stdio.h>
+#include "frontend/ast.h"
+
+/// SECTION: Macros
+
+#define CEMIT_TEXT_SZ 160 // longest C expression kept in a CValue before it goes to a temporary
+#define CEMIT_TABLE_MIN_SZ 8
+
+/// SECTION: Emitted values
+
+typedef enum en_cvalue_kind
+{
+    CVAL_BOXED, // a VarValue
+    CVAL_INT,   // a C int
+    CVAL_REAL,  // a C float
+    CVAL_BOOL   // a C int holding 0 or 1
+} CValueKind;
+
+/**
+ * @brief A side-effect free C expression for an evaluated Rubel expression. Any code it needed is already emitted.
+ */
+typedef struct st_cvalue
+{
+    CValueKind kind;
+    int reads_vars; // 1 if a later call could change what the text gives
+    char text[CEMIT_TEXT_SZ];
+} CValue;
+
+/**
+ * @brief First declaration of a proc name. Later ones fail at runtime, so only this one gets a C function.
+ */
+typedef struct st_cproc_entry
+{
+    const char *name;
+    unsigned short arity;
+    unsigned int stmt_num; // top-level statement declaring it
+} CProcEntry;
+
+/**
+ * @brief String or list literal already given a static object, since folded constants share one object between uses.
+ */
+typedef struct st_cliteral_entry
+{
+    const void *obj;
+    unsigned int id;
+} CLiteralEntry;
+
+/// SECTION: Emitter
+
+typedef struct st_cemitter
+{
+    FILE *out;
+    FILE *decls;           // literal storage and proc prototypes
+    FILE *inits;           // body of the literal setup function
+    FILE *code;            // proc and script functions
+    int in_proc;           // 0 while emitting top-level code
+    int error_count;
+    unsigned int stmt_num; // top-level statement number for messages
+    unsigned int defined_below; // procs declared before this top-level statement surely exist
+    const char *proc_name;
+    int indent;
+    int loop_depth;
+    unsigned int temp_count;
+    unsigned int literal_count;
+    unsigned short frame_size;
+    DataType *local_kinds; // type of each local kept in a C variable, NONE_TYPE if it stays in the frame
+    unsigned int proc_count;
+    unsigned int proc_capacity;
+    CProcEntry *procs;
+    unsigned int literal_entry_count;
+    unsigned int literal_entry_capacity;
+    CLiteralEntry *literals;
+} CEmitter;
+
+/**
+ * @brief Prepares an emitter writing to out. The sections of the unit are buffered in temporary files until cemit_script puts them together.
+ */
+int cemitter_init(CEmitter *emitter, FILE *out);
+
+void cemitter_dispose(CEmitter *emitter);
+
+void cemitter_log_err(CEmitter *emitter, const char *msg);
+
+/// SECTION: Emitting
+
+/**
+ * @brief Emits code computing an expression's value, which is then given as a C expression.
+ */
+int cemit_expr(CEmitter *emitter, const Expression *expr, CValue *result);
+
+int cemit_block(CEmitter *emitter, const Statement *stmt);
+
+int cemit_stmt(CEmitter *emitter, const Statement *stmt);
+
+/**
+ * @brief Emits the whole program for a script that passed resolving, folding and typing.
+ * @return int 1 on success, 0 if any construct could not be emitted.
+ */
+int cemit_script(CEmitter *emitter, const Script *script);
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+/**
+ * @file compiler.h
+ * @author Derek Tan
+ * @brief Lowers a resolved Script into register bytecode. Each variable's resolver slot is its register, so name lookups never happen while running.
+ */
+
+#include <stdio.h>
+#include "frontend/ast.h"
+#include "backend/compiler/bytecode.h"
+
+/// SECTION: Macros
+
+#define COMPILER_PATCHES_MIN_SZ 4
+#define COMPILER_NO_REG 0xFFFF
+
+/// SECTION: Compiler
+
+typedef struct st_compiler
+{
+    BcProgram *program;
+    BcProc *proc;            // proc receiving code
+    int in_proc;             // 0 while compiling top-level code
+    int error_count;
+    unsigned int stmt_num;   // top-level statement number for messages
+    unsigned short frame_size; // registers taken by the frame's variables
+    unsigned short next_reg; // first free temporary register
+    int loop_depth;
+    unsigned int patch_count;
+    unsigned int patch_capacity;
+    unsigned int *break_patches; // pending jumps out of the innermost loops
+} Compiler;
+
+int compiler_init(Compiler *compiler, BcProgram *program);
+
+void compiler_dispose(Compiler *compiler);
+
+void compiler_log_err(Compiler *compiler, const char *msg);
+
+/// SECTION: Expression Compiling
+
+/**
+ * @brief Gets a register holding the expression's value. Variables give their own register, but other expressions are put into a new temporary.
+ * @return unsigned short The register or COMPILER_NO_REG on errors.
+ */
+unsigned short compile_operand(Compiler *compiler, Expression *expr);
+
+int compile_literal(Compiler *compiler, Expression *expr, unsigned short dest);
+
+int compile_var_usage(Compiler *compiler, Expression *expr, unsigned short dest);
+
+int compile_call(Compiler *compiler, Expression *expr, unsigned short dest);
+
+int compile_unary(Compiler *compiler, Expression *expr, unsigned short dest);
+
+int compile_binary(Compiler *compiler, Expression *expr, unsigned short dest);
+
+int compile_expr(Compiler *compiler, Expression *expr, unsigned short dest);
+
+/// SECTION: Statement Compiling
+
+int compile_var_decl(Compiler *compiler, Statement *stmt);
+
+int compile_var_assign(Compiler *compiler, Statement *stmt);
+
+int compile_func_decl(Compiler *compiler, Statement *stmt);
+
+int compile_while(Compiler *compiler, Statement *stmt);
+
+int compile_ifotherwise(Compiler *compiler, Statement *stmt);
+
+int compile_break(Compiler *compiler, Statement *stmt);
+
+int compile_return(Compiler *compiler, Statement *stmt);
+
+int compile_block(Compiler *compiler, Statement *stmt);
+
+int compile_stmt(Compiler *compiler, Statement *stmt);
+
+/**
+ * @brief Compiles all top-level statements into procs[0] and each proc into its own BcProc.
+ * @note The script must be resolved first, see resolver.h.
+ * @return int 1 on success, 0 if any compile error was reported.
+ */
+int compile_script(Compiler *compiler, Script *script);
+
+#endif
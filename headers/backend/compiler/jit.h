@@ -0,0 +1,46 @@
+#ifndef JIT_H
+#define JIT_H
+
+/**
+ * @file jit.h
+ * @author Derek Tan
+ * @brief Baseline template JIT: turns a numeric proc's bytecode into x86-64 code that works on the VM's registers in place.
+ * @note Native code keeps the VM's frame layout, so a failed type guard just returns the pc to resume at, and the VM runs the rest of the call, errors included. Other platforms never compile anything.
+ */
+
+#include "backend/compiler/bytecode.h"
+
+/// SECTION: Macros
+
+#if defined(__x86_64__) && defined(__linux__)
+#define JIT_X64_LINUX
+#endif
+
+#define JIT_CALLS_KNOB "RUBEL_JIT_CALLS" // env variable to override JIT_HOT_CALLS
+#define JIT_HOT_CALLS 1000 // calls before a proc is compiled
+#define JIT_RETURNED -1    // entry result when the proc ran to its return
+#define JIT_CODE_MIN_SZ 256
+
+/// SECTION: Native code
+
+/**
+ * @brief Native code of a proc. It gets the callee's register window and the globals, then gives JIT_RETURNED with the result in regs[0] like BC_RET, or the pc the VM must resume at.
+ */
+typedef int (*JitEntry)(VarValue *regs, VarValue *globals);
+
+typedef struct st_jit_code
+{
+    JitEntry entry;
+    void *pages;       // executable mapping that holds the code
+    size_t page_bytes;
+} JitCode;
+
+/**
+ * @brief Compiles a proc made only of moves, int or real math, compares, jumps and returns. Calls and other opcodes are left to the VM.
+ * @return JitCode* The native code or NULL if the proc is not supported here.
+ */
+JitCode *jit_compile(const BcProc *proc, const VarValue *consts);
+
+void jit_code_dispose(JitCode *code);
+
+#endif
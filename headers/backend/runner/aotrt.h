@@ -0,0 +1,159 @@
+#ifndef AOTRT_H
+#define AOTRT_H
+
+/**
+ * @file aotrt.h
+ * @author Derek Tan
+ * @brief Runtime support for scripts compiled to C by --emit-c. Generated programs link it with the interpreter's value, heap and native objects, so they behave like the engines do.
+ * @note Boxed variables and call arguments live in windows of a value stack that collections mark, like the VM's registers. Windows never move, since the stack grows by adding chunks.
+ */
+
+#include "backend/runner/runctx.h"
+
+/// SECTION: Macros
+
+#define AOT_CHUNK_MIN_SZ 1024 // value slots per stack chunk unless a window needs more
+#define AOT_CHUNKS_MIN_SZ 4
+
+/**
+ * @brief Runs a step that gives a RunStatus and leaves the generated function through its "done" label on errors.
+ * @note Generated functions keep their status in a local named status.
+ */
+#define AOT_CHECK(step) do { status = (step); if (status != OK_RAN_CMD) goto done; } while (0)
+#define AOT_FAIL(error) do { status = (error); goto done; } while (0)
+
+/**
+ * @brief Boxes a C value like make_int_varval and friends, but without a call.
+ */
+#define AOT_INT(const_flag, x) ((VarValue){.type = INT_TYPE, .is_const = (const_flag), .data.int_val.value = (x)})
+#define AOT_REAL(const_flag, x) ((VarValue){.type = REAL_TYPE, .is_const = (const_flag), .data.real_val.value = (x)})
+#define AOT_BOOL(const_flag, x) ((VarValue){.type = BOOL_TYPE, .is_const = (const_flag), .data.bool_val.flag = (x)})
+
+/**
+ * @brief Runs an unproven operator inline through an INT_WRAP macro when both operands are ints, else through aot_binary. Division always takes the call for its divisor check.
+ * @note The operands are evaluated more than once, so they must be side-effect free.
+ */
+#define AOT_INT_MATH(op, wrap_op, left, right, dest) do { \
+    if ((left).type == INT_TYPE && (right).type == INT_TYPE) (dest) = AOT_INT(1, wrap_op((left).data.int_val.value, (right).data.int_val.value)); \
+    else AOT_CHECK(aot_binary(op, left, right, &(dest))); \
+} while (0)
+
+#define AOT_INT_COMPARE(op, c_op, left, right, dest) do { \
+    if ((left).type == INT_TYPE && (right).type == INT_TYPE) (dest) = AOT_BOOL(1, (left).data.int_val.value c_op (right).data.int_val.value); \
+    else AOT_CHECK(aot_binary(op, left, right, &(dest))); \
+} while (0)
+
+#define AOT_TEST(condition, dest) do { \
+    if ((condition).type == BOOL_TYPE) (dest) = (condition).data.bool_val.flag; \
+    else AOT_CHECK(aot_test(condition, &(dest))); \
+} while (0)
+
+/// SECTION: Value stack
+
+typedef struct st_aot_chunk
+{
+    size_t capacity;
+    size_t top;
+    VarValue *slots;
+} AotChunk;
+
+typedef struct st_aot_stack
+{
+    unsigned int count;    // chunks made so far
+    unsigned int capacity;
+    unsigned int current;  // chunk holding the newest window
+    AotChunk *chunks;
+} AotStack;
+
+/**
+ * @brief Position of the stack's top, so an error exit can drop every window pushed after it.
+ */
+typedef struct st_aot_mark
+{
+    unsigned int chunk;
+    size_t top;
+} AotMark;
+
+/**
+ * @brief Gives a window of count slots above all others with each set to NONE, or NULL on failure.
+ */
+VarValue *aot_push(size_t count);
+
+/**
+ * @brief Drops the newest window, which must have count slots.
+ */
+void aot_pop(size_t count);
+
+AotMark aot_mark();
+
+void aot_release(AotMark mark);
+
+/**
+ * @brief Makes a proc's frame: its params are copied from the caller's argument window and the rest stay NONE. A due collection runs after, like at the walker's calls.
+ * @return VarValue* The frame or NULL on failure.
+ */
+VarValue *aot_enter(size_t frame_size, const VarValue *args, unsigned short argc);
+
+/**
+ * @brief Safe point of compiled code: runs a due collection with every window as roots.
+ */
+void aot_collect_garbage();
+
+/// SECTION: Running
+
+/**
+ * @brief Compiled proc. It reads its args from a window the caller owns and writes its result, or it returns OK_CTRL_RETURN after aot_tail.
+ */
+typedef RunStatus (*AotProc)(VarValue *args, VarValue *result);
+
+extern VarValue *aot_globals;
+
+extern unsigned int aot_stmt_num; // current top-level statement for error reports
+
+/**
+ * @brief Sets up the heap and the globals' window. RUBEL_NURSERY_KB sets the nursery size as for the rubel driver.
+ */
+int aot_init(unsigned short global_count);
+
+void aot_dispose();
+
+/**
+ * @brief Calls a proc, then any procs it tail calls in turn, so the C stack does not grow for them.
+ */
+RunStatus aot_call(AotProc proc, VarValue *args, VarValue *result);
+
+/**
+ * @brief Leaves a tail call for aot_call to run once the calling proc returned. The args are copied out first.
+ * @return RunStatus OK_CTRL_RETURN for the calling proc to give back.
+ */
+RunStatus aot_tail(AotProc proc, const VarValue *args, unsigned short argc);
+
+RunStatus aot_call_native(NativeFunc native, VarValue *args, unsigned short argc, VarValue *result);
+
+/// SECTION: Boxed operations
+/// NOTE: these give the errors eval_unary, eval_binary and ctx_update_var do for values of unproven types.
+
+RunStatus aot_negate(VarValue operand, VarValue *result);
+
+RunStatus aot_binary(OpType op, VarValue left, VarValue right, VarValue *result);
+
+/**
+ * @brief Reads an if or while condition.
+ */
+RunStatus aot_test(VarValue condition, int *flag);
+
+RunStatus aot_declare(VarValue *dest, VarValue src, int is_const);
+
+RunStatus aot_assign(VarValue *dest, VarValue src);
+
+/**
+ * @brief Checks that a value may be stored in a typed local of the given type.
+ */
+RunStatus aot_expect(VarValue value, DataType type);
+
+/**
+ * @brief Reports a failed run like the interpreter does.
+ */
+void aot_log_err(RunStatus status);
+
+#endif
@@ -1,7 +1,12 @@
 #ifndef INTERPRETER_H
 #define INTERPRETER_H
 
-#include "backend/runner/runctx.h"
+#include "frontend/resolver.h"
+#include "frontend/folder.h"
+#include "frontend/typer.h"
+#include "backend/runner/vm.h"
+#include "backend/compiler/compiler.h"
+#include "backend/compiler/bccache.h"
 
 /**
  * @brief Interpreter object. Tracks scopes and other execution state while walking the AST.
@@ -10,13 +15,37 @@
  * @todo Move configuration logic to component within the Interpreter structure.
  */
 
+/**
+ * @brief Picks the execution engine. The tree walker is kept for comparing against the VM.
+ */
+typedef enum en_run_mode
+{
+    RUN_BYTECODE,
+    RUN_TREE_WALK
+} RunMode;
+
 typedef struct st_interpreter
 {
+    RunMode mode;
     RunnerContext context;
-    Script *script_ref;
+    RubelVM vm;
+    BcProgram program;
+    Script *script_ref;  // NULL when the program came from a cache
+    Folder folder;     // kept for its counters, see --dump-ast
+    Typer typer;       // same
 } Interpreter;
 
-int interpreter_init(Interpreter *runner, Script *program);
+/**
+ * @brief Resolves the script's variables, folds its constants, proves its operand types, and prepares the run context. In bytecode mode, the script is also compiled here. Resolve, type or compile errors make this fail.
+ * @return int 1 on success.
+ */
+int interpreter_init(Interpreter *runner, Script *program, RunMode mode);
+
+/**
+ * @brief Prepares a bytecode run from a program cached by an earlier run of the same source, so nothing is parsed or compiled. See bccache_load.
+ * @return int 1 on success, or 0 if the cache is missing, stale or broken.
+ */
+int interpreter_init_cached(Interpreter *runner, const char *name, const char *cache_path, uint64_t source_hash);
 
 /**
  * @brief Invokes clean up functions to destroy the program AST, clean up interpreter state, and free most other dynamic memory except the source code C-String. The source code should be freed just after the Script object is made. 
@@ -4,6 +4,11 @@
 #include "backend/api/natives/nativefuncs.h"
 #include "backend/values/scope.h"
 
+/// SECTION: Macros
+
+#define CTX_ARGS_MIN_SZ 32
+#define CTX_CALL_DEPTH_MAX 5000 // proc calls the walker nests before failing, since each one also recurses in C
+
 /**
  * @brief Marks status of RunnerContext for specific error messages.
  */
@@ -19,9 +24,19 @@ typedef enum en_run_status
     ERR_NULL_VAL,
     ERR_MEMORY,
     ERR_NO_IMPL,
+    ERR_DEPTH,   // too many nested proc calls, in any engine
     ERR_GENERAL
 } RunStatus;
 
+/**
+ * @brief Counts how often either engine ran a loop pattern by its fused path.
+ */
+typedef struct st_fused_stats
+{
+    size_t incr_count;     // "set x = x + k" steps done in the variable's slot
+    size_t cmp_jump_count; // conditions compared and branched on without a bool temporary
+} FusedStats;
+
 /**
  * @brief Stores important state for the interpreter run.
  */
@@ -29,52 +44,76 @@ typedef struct st_runner_ctx
 {
     RunStatus status;  // error status
     FuncEnv *function_env; // actually the function "scope"
-    ScopeStack scopes; // stack of scopes
+    FrameStack frames; // variable slots of the globals and each running proc
+    size_t arg_count;    // pending call arguments, which are GC roots like the frames
+    size_t arg_capacity;
+    VarValue *arg_stack;
+    const FuncObj *tail_callee; // proc a tail call left to run in the returning frame, or NULL
+    size_t tail_arg_base;       // where that call's args begin on the arg stack
+    FusedStats fused;
 } RunnerContext;
 
 /// SECTION: Context utils
 
 int ctx_init(RunnerContext *ctx, Script *program);
 
+/**
+ * @brief Like ctx_init, but takes only the sizes it reads from a Script, e.g. when a cached program runs without one.
+ */
+int ctx_init_sized(RunnerContext *ctx, unsigned short global_count, unsigned int stmt_count);
+
 void ctx_destroy(RunnerContext *ctx);
 
-inline void ctx_set_status(RunnerContext *ctx, RunStatus status);
+void ctx_set_status(RunnerContext *ctx, RunStatus status);
 
 int ctx_load_funcgroup(RunnerContext *ctx, FuncGroup *module);
 
+/**
+ * @brief Safe point of the walker: runs a due collection with every frame slot and pending argument as roots.
+ * @note Only call this between statements, since values in C locals of the evaluators are not roots.
+ */
+void ctx_collect_garbage(RunnerContext *ctx);
+
 /// SECTION: Function helpers
 
 const FuncObj *ctx_get_func(const RunnerContext *ctx, const char *fn_name);
 
-VarValue *ctx_call_func(RunnerContext *ctx, unsigned short argc, const char *fn_name, FuncArgs *args);
+/**
+ * @brief Calls a resolved native or AST function with borrowed argument values. AST functions get copies of them as parameters.
+ * @note Tail calls made by the proc reuse its frame here instead of nesting another call.
+ * @return VarValue The result, or a NONE_TYPE value if there was no result. Errors are set in the context status.
+ */
+VarValue ctx_call_func(RunnerContext *ctx, const FuncObj *callee_ref, unsigned short argc, VarValue *args);
 
 /// SECTION: Variable helpers
 
-Variable *ctx_get_var(const RunnerContext *ctx, const char *var_name);
-
-int ctx_create_var(RunnerContext *ctx, char *var_name, int is_const, VarValue *var_val);
+/**
+ * @brief Gets a variable's slot from the (depth, slot) pair the resolver gave its node.
+ */
+VarValue *ctx_get_var(const RunnerContext *ctx, unsigned short depth, unsigned short slot);
 
-int ctx_update_var(RunnerContext *ctx, Variable *var_ref, VarValue *var_val);
+int ctx_update_var(RunnerContext *ctx, VarValue *var_ref, const VarValue *var_val);
 
 /// SECTION: Expr helpers
+/// NOTE: these evaluate to values by copy, so primitives never touch the heap. On failure, they give a NONE_TYPE value and set an error status.
 
-VarValue *eval_literal(RunnerContext *ctx, Expression *expr);
+VarValue eval_literal(RunnerContext *ctx, Expression *expr);
 
-VarValue *eval_var_usage(RunnerContext *ctx, Expression *expr);
+VarValue eval_var_usage(RunnerContext *ctx, Expression *expr);
 
-VarValue *eval_call(RunnerContext *ctx, Expression *expr);
+VarValue eval_call(RunnerContext *ctx, Expression *expr);
 
-VarValue *eval_unary(RunnerContext *ctx, Expression *expr);
+VarValue eval_unary(RunnerContext *ctx, Expression *expr);
 
-int compare_primitives(OpType op, VarValue *left_val, VarValue *right_val);
+int compare_primitives(OpType op, const VarValue *left_val, const VarValue *right_val);
 
-VarValue *math_primitives(OpType op, VarValue *left_val, VarValue *right_val);
+VarValue math_primitives(OpType op, const VarValue *left_val, const VarValue *right_val);
 
-VarValue *eval_comparison(RunnerContext *ctx, OpType op, VarValue *left_val, VarValue *right_val);
+VarValue eval_comparison(RunnerContext *ctx, OpType op, const VarValue *left_val, const VarValue *right_val);
 
-VarValue *eval_binary(RunnerContext *ctx, Expression *expr);
+VarValue eval_binary(RunnerContext *ctx, Expression *expr);
 
-VarValue *eval_expr(RunnerContext *ctx, Expression *expr);
+VarValue eval_expr(RunnerContext *ctx, Expression *expr);
 
 /// SECTION: Stmt helpers
 
@@ -94,15 +133,20 @@ RunStatus exec_var_assign(RunnerContext *ctx, Statement *stmt);
 
 RunStatus exec_func_decl(RunnerContext *ctx, Statement *stmt);
 
-VarValue *exec_while(RunnerContext *ctx, Statement *stmt);
+/// NOTE: block-like helpers give the return value of a proc only when the status becomes OK_CTRL_RETURN.
+
+VarValue exec_while(RunnerContext *ctx, Statement *stmt);
 
-VarValue *exec_block(RunnerContext *ctx, Statement *stmt);
+VarValue exec_block(RunnerContext *ctx, Statement *stmt);
 
-VarValue *exec_ifotherwise(RunnerContext *ctx, Statement *stmt);
+VarValue exec_ifotherwise(RunnerContext *ctx, Statement *stmt);
 
 RunStatus exec_break(RunnerContext *ctx, Statement *stmt);
 
-VarValue *exec_return(RunnerContext *ctx, Statement *stmt);
+/**
+ * @brief Evaluates a return. A tail call to a proc only has its args evaluated, and the call is left for ctx_call_func to run in place.
+ */
+VarValue exec_return(RunnerContext *ctx, Statement *stmt);
 
 RunStatus exec_expr_stmt(RunnerContext *ctx, Statement *stmt);
 
@@ -0,0 +1,88 @@
+#ifndef VM_H
+#define VM_H
+
+/**
+ * @file vm.h
+ * @author Derek Tan
+ * @brief Register based virtual machine for compiled Rubel scripts. It shares the RunnerContext's function environment with the tree walker.
+ */
+
+#include "backend/runner/runctx.h"
+#include "backend/compiler/bytecode.h"
+#include "backend/compiler/jit.h"
+
+/// SECTION: Macros
+
+#define VM_STACK_MIN_SZ 256
+#define VM_FRAMES_MIN_SZ 16
+#define VM_CALL_DEPTH_MAX 100000
+
+/// SECTION: Frames
+
+/**
+ * @brief Activation record of a running proc. Its registers are a window of the VM's value stack starting at base.
+ */
+typedef struct st_bc_frame
+{
+    const BcProc *proc;
+    const BcInstr *ip; // next instruction to resume at
+    size_t base;
+} BcFrame;
+
+/**
+ * @brief Callee cache for a name called by the program. Like the walker's call site caches, it is valid while its generation matches the FuncEnv's.
+ */
+typedef struct st_bc_call_cache
+{
+    unsigned int generation;
+    const FuncObj *callee;
+} BcCallCache;
+
+/**
+ * @brief Tier-up state of a compiled proc, kept by its index in the program.
+ */
+typedef struct st_bc_jit_slot
+{
+    unsigned int call_count;
+    int rejected;  // 1 if the JIT cannot compile the proc
+    JitCode *code; // native code once the proc is hot
+} BcJitSlot;
+
+typedef struct st_jit_stats
+{
+    size_t compiled_count;
+    size_t rejected_count;
+    size_t native_calls;
+    size_t deopt_count; // native calls that went back to the VM before returning
+} JitStats;
+
+/// SECTION: VM
+
+typedef struct st_rubel_vm
+{
+    RunnerContext *ctx; // shared function environment
+    const BcProgram *program;
+    unsigned int stmt_num; // current top-level statement for error reports
+    size_t stack_capacity;
+    VarValue *stack; // register windows of all frames
+    int frame_count;
+    int frame_capacity;
+    BcFrame *frames;
+    BcCallCache *call_cache; // one entry per program name, as calls name their callee by index
+    BcJitSlot *jit_slots;    // one entry per program proc
+    int jit_enabled;
+    unsigned int jit_hot_calls; // calls before a proc gets compiled
+    JitStats jit_stats;
+} RubelVM;
+
+int vm_init(RubelVM *vm, RunnerContext *ctx, const BcProgram *program);
+
+void vm_dispose(RubelVM *vm);
+
+/**
+ * @brief Runs the program's top-level code until it halts or fails.
+ * @return RunStatus OK_ENDED on success or the error status.
+ */
+RunStatus vm_run(RubelVM *vm);
+
+#endif
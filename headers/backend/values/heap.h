@@ -0,0 +1,111 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+/**
+ * @file heap.h
+ * @author Derek Tan
+ * @brief Generational tracing collector for heap strings and lists. New values start in a nursery which minor collections sweep, and survivors are promoted to an old space that only major collections sweep.
+ * @note Like the intern pool, there is one heap per run, so natives can allocate without a context. Runners collect at their own safe points, where all live values are in their frames.
+ */
+
+#include <time.h>
+#include "utils/pool.h"
+#include "backend/values/vartypes.h"
+
+/// SECTION: Macros
+
+#define GC_NURSERY_SZ (256 * 1024)   // default nursery bytes before a minor collection
+#define GC_OLD_MIN_SZ (1024 * 1024)  // old space bytes before the first major collection
+#define GC_PROMOTE_AGE 2             // minor collections a value survives before promotion
+#define GC_NURSERY_KNOB "RUBEL_NURSERY_KB" // environment variable to tune the nursery size
+
+/// SECTION: Heap
+
+typedef enum en_gc_cycle
+{
+    GC_CYCLE_NONE,
+    GC_CYCLE_MINOR,
+    GC_CYCLE_MAJOR
+} GcCycle;
+
+typedef struct st_gc_stats
+{
+    size_t minor_count;
+    size_t major_count;
+    size_t objects_freed;
+    size_t bytes_freed;
+    size_t bytes_promoted;
+    double total_pause_ms;
+    double max_pause_ms;
+} GcStats;
+
+typedef struct st_gc_heap
+{
+    int ready;
+    GcObject *young;
+    GcObject *old;
+    GcObject *pinned;
+    size_t young_bytes;
+    size_t old_bytes;
+    size_t nursery_limit;
+    size_t old_limit;      // doubles with the live old bytes after each major collection
+    GcCycle cycle;         // collection being marked, or GC_CYCLE_NONE
+    struct timespec began;
+    GcStats stats;
+    Pool str_pool;         // StringObj headers, SSO text included
+    Pool list_pool;        // ListObj headers, their item buffers still use malloc
+} GcHeap;
+
+/**
+ * @brief Starts tracking new strings and lists. A nursery_limit of 0 uses GC_NURSERY_SZ.
+ */
+int heap_init(size_t nursery_limit);
+
+/**
+ * @brief Frees every tracked value, including pinned ones.
+ */
+void heap_dispose();
+
+/// NOTE: these are no-ops before heap_init, so table code and benches can use values without a heap.
+
+/**
+ * @brief Gets room for a new StringObj or ListObj from the heap's pools, or from malloc before heap_init. Either way, heap_track must follow.
+ */
+void *heap_alloc(GcKind kind);
+
+void heap_track(GcObject *obj, GcKind kind, size_t bytes);
+
+/**
+ * @brief Updates a value's size after its buffer grew, which counts towards the next collection.
+ */
+void heap_resize(GcObject *obj, size_t bytes);
+
+/**
+ * @brief Keeps a value until the heap is disposed.
+ */
+void heap_pin(GcObject *obj);
+
+/// SECTION: Collection
+
+/**
+ * @brief Tells which collection is due. Runners check this at safe points and skip the root scan if none is.
+ */
+GcCycle heap_wants_collect();
+
+void heap_begin_collect();
+
+/**
+ * @brief Marks a root and all values it reaches.
+ */
+void heap_mark_value(const VarValue *value);
+
+/**
+ * @brief Frees unmarked values and promotes old enough survivors.
+ */
+void heap_finish_collect();
+
+const GcStats *heap_get_stats();
+
+size_t heap_live_bytes();
+
+#endif
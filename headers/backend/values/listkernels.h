@@ -0,0 +1,62 @@
+#ifndef LISTKERNELS_H
+#define LISTKERNELS_H
+
+/**
+ * @file listkernels.h
+ * @author Derek Tan
+ * @brief Vector kernels over packed list buffers for the "lists" natives. Each kernel has an AVX2 body picked at runtime on x86-64 and a scalar fallback.
+ * @note Int kernels wrap around on overflow like two's complement math. Real sums and dot products have no AVX2 body, so they round like a left to right loop on every CPU.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// SECTION: Macros
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIST_KERNELS_AVX2 1
+#else
+#define LIST_KERNELS_AVX2 0
+#endif
+
+/**
+ * @brief Tells if the AVX2 kernels are used on this machine. The check is done once.
+ */
+int kernels_have_avx2();
+
+/// SECTION: Reductions
+
+int32_t kernel_sum_i32(const int32_t *data, size_t count);
+
+float kernel_sum_f32(const float *data, size_t count);
+
+/// NOTE: min and max need count > 0.
+
+int32_t kernel_min_i32(const int32_t *data, size_t count);
+
+int32_t kernel_max_i32(const int32_t *data, size_t count);
+
+float kernel_min_f32(const float *data, size_t count);
+
+float kernel_max_f32(const float *data, size_t count);
+
+int32_t kernel_dot_i32(const int32_t *left, const int32_t *right, size_t count);
+
+float kernel_dot_f32(const float *left, const float *right, size_t count);
+
+/// SECTION: Search
+
+/**
+ * @return long The first index holding target or -1.
+ */
+long kernel_index_i32(const int32_t *data, size_t count, int32_t target);
+
+long kernel_index_f32(const float *data, size_t count, float target);
+
+/// SECTION: Maps
+
+void kernel_scale_i32(int32_t *dest, const int32_t *src, size_t count, int32_t factor);
+
+void kernel_scale_f32(float *dest, const float *src, size_t count, float factor);
+
+#endif
@@ -1,48 +1,55 @@
 #ifndef SCOPE_H
 #define SCOPE_H
 
-#include "backend/values/varenv.h"
+#include "backend/values/vartypes.h"
 
 /// SECTION: Macros
 
-#define SCOPE_IS_GLOBAL(scope_ptr) scope_ptr->parent == NULL
-#define SCOPE_STACK_SIZE 24
+#define FRAME_STACK_MIN_SZ 64 // slots reserved before any frame is pushed
 
-/// SECTION: Scopes
+/// SECTION: Frame Stack
 
-typedef struct st_scope
+/**
+ * @brief One growable array of variable slots for the tree walker. The globals come first, then each proc call opens a window of slots on top. The resolver decides each variable's slot, so no names are kept here.
+ * @note Slots move when the array grows, so slot pointers are only good until the next push.
+ */
+typedef struct st_frame_stack
 {
-    struct st_scope *parent;
-    VarEnv venv;
-} RubelScope;
-
-RubelScope *scope_create(RubelScope *parent);
-
-void scope_destroy(RubelScope *scope);
-
-Variable *scope_get_var_ref(const RubelScope *scope, const char *var_name);
-
-int scope_put_var(RubelScope *scope, Variable *var_obj);
-
-/// SECTION: Static Scope Stack (For nested blocks or maybe recursion.)
-
-typedef struct st_scope_stack
-{
-    int stack_ptr;
-    int capacity;
-    RubelScope **scopes;
-} ScopeStack;
-
-int scopestack_init(ScopeStack *stack, int capacity);
-
-void scopestack_destroy(ScopeStack *stack);
-
-int scopestack_is_full(const ScopeStack *stack);
-
-int scopestack_is_empty(const ScopeStack *stack);
-
-int scopestack_push_scope(ScopeStack *stack, RubelScope *scope);
-
-RubelScope *scopestack_pop_scope(ScopeStack *stack);
-
-#endif
\ No newline at end of file
+    VarValue *slots;
+    size_t capacity;
+    size_t base;           // first slot of the running frame
+    size_t top;            // first slot past the running frame
+    unsigned short global_count;
+    unsigned int depth;    // proc frames above the globals
+} FrameStack;
+
+/**
+ * @brief Reserves the slots and opens the global frame with global_count NONE_TYPE slots.
+ */
+int framestack_init(FrameStack *stack, unsigned short global_count);
+
+void framestack_dispose(FrameStack *stack);
+
+/**
+ * @brief Opens a frame of slot_count NONE_TYPE slots above the running one. Globals stay visible at depth 1.
+ * @param old_base Gets the caller's frame base, which framestack_pop needs back.
+ */
+int framestack_push(FrameStack *stack, unsigned short slot_count, size_t *old_base);
+
+/**
+ * @brief Resizes the running frame to slot_count NONE_TYPE slots for a tail call. The caller's frames are kept as they are.
+ */
+int framestack_reuse(FrameStack *stack, unsigned short slot_count);
+
+/**
+ * @brief Drops the running frame by moving the frame bounds back. Its slots are not cleared since values in them are borrowed.
+ */
+void framestack_pop(FrameStack *stack, size_t old_base);
+
+/**
+ * @brief Gets a variable's value slot from the running frame (depth 0) or the globals (depth 1 inside a proc).
+ * @return VarValue* The slot or NULL if the indexes are out of range.
+ */
+VarValue *framestack_get_slot(const FrameStack *stack, unsigned short depth, unsigned short slot);
+
+#endif
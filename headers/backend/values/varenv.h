@@ -2,7 +2,7 @@
 #define VARENV_H
 
 #include "backend/values/vartypes.h"
-#include "utils/hashing.h"
+#include "utils/intern.h"
 
 /// SECTION: Macros
 
@@ -10,58 +10,48 @@
 
 /// SECTION: Variable
 
+/**
+ * @brief Named variable holding its value inline. The name is an interned string, so tables compare names by pointer.
+ * @note The resolver only uses the name, constness, and frame slot of these.
+ */
 typedef struct st_variable
 {
     char *name;
     int is_const;
-    VarValue *value;
+    unsigned short slot;
+    VarValue value;
 } Variable;
 
-Variable *variable_create(char *var_name, int is_const, VarValue *var_value);
+Variable *variable_create(char *var_name, int is_const, VarValue var_value);
 
 void variable_destroy(Variable *var_obj);
 
-/// SECTION: Variable Table Bucket List
-
-typedef struct st_bucklist_node
-{
-    Variable *var;
-    struct st_bucklist_node *next;
-} EnvBuckListNode;
-
-EnvBuckListNode *bucklistnode_create(Variable *var_obj, EnvBuckListNode *next_ptr);
-
-void bucklistnode_destroy(EnvBuckListNode *node);
-
-typedef struct st_env_bucklist
-{
-    size_t count;
-    EnvBuckListNode *head;
-    EnvBuckListNode *last;
-} EnvBuckList;
-
-EnvBuckList *envbucklist_create();
-
-void envbucklist_destroy(EnvBuckList *bucklist);
-
-const EnvBuckListNode *envbucklist_fetch(const EnvBuckList *bucklist, const char *var_name);
-
-int envbucklist_append(EnvBuckList *bucklist, EnvBuckListNode *node);
-
 /// SECTION: Variable Environment
 
+/**
+ * @brief Open-addressed name table with linear probing. The capacity is a power of two, and the table doubles before it is 3/4 full.
+ * @note Names must be interned since slots are matched by address.
+ */
 typedef struct st_varenv
 {
+    size_t capacity;
     size_t count;
-    EnvBuckList **entries;
+    Variable **entries; // NULL marks a free slot
 } VarEnv;
 
 int varenv_init(VarEnv *venv, size_t buckets);
 
+/**
+ * @brief Frees the Variable objects and the slot array.
+ */
 void varenv_destroy(VarEnv *venv);
 
 Variable *varenv_get_var_ref(const VarEnv *venv, const char *var_name);
 
+/**
+ * @brief Adds a variable, growing the table when needed. The caller checks for an existing name first.
+ * @return int 1 on success, 0 on a failed allocation.
+ */
 int varenv_set_var_ref(VarEnv *venv, Variable *var_obj);
 
 #endif
\ No newline at end of file
@@ -1,20 +1,62 @@
 #ifndef VARTYPES_H
 #define VARTYPES_H
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+/// SECTION: Macros
+
+#define LIST_OBJ_MIN_SZ 4
+#define STR_OBJ_SSO_CAP 22 // longest string kept inside its StringObj
+
+/// NOTE: int math wraps around like two's complement in every engine and in the folder, so folding never changes a result. INT_MIN / -1 wraps to INT_MIN instead of trapping, and b must not be 0.
+#define INT_WRAP_ADD(a, b) ((int)((uint32_t)(a) + (uint32_t)(b)))
+#define INT_WRAP_SUB(a, b) ((int)((uint32_t)(a) - (uint32_t)(b)))
+#define INT_WRAP_MUL(a, b) ((int)((uint32_t)(a) * (uint32_t)(b)))
+#define INT_WRAP_DIV(a, b) (((b) == -1) ? INT_WRAP_SUB(0, (a)) : (a) / (b))
+
 typedef enum en_data_type
 {
     BOOL_TYPE,
     INT_TYPE,
     REAL_TYPE,
     STR_TYPE,
-    LIST_TYPE
+    LIST_TYPE,
+    NONE_TYPE // marks a missing value e.g. from a proc without a return, never visible to scripts
 } DataType;
 
+/// SECTION: GC headers
+
+typedef enum en_gc_space
+{
+    GC_UNTRACKED, // not made by the heap e.g. arena literals, never collected
+    GC_YOUNG,     // nursery object since its last few collections
+    GC_OLD,       // promoted object, only scanned by major collections
+    GC_PINNED     // kept until the heap is disposed e.g. list literals in the AST
+} GcSpace;
+
+typedef enum en_gc_kind
+{
+    GC_KIND_STR,
+    GC_KIND_LIST
+} GcKind;
+
 /**
- * @brief Hybrid structure to represent literal or variable values.
+ * @brief Header of each heap value. It is the first member of StringObj and ListObj, so the collector can go from a header to its object.
+ */
+typedef struct st_gc_object
+{
+    struct st_gc_object *next; // next object of the same space
+    size_t bytes;              // object and buffer sizes for the heap's counters
+    unsigned char kind;
+    unsigned char space;
+    unsigned char marked;
+    unsigned char age;         // minor collections survived
+} GcObject;
+
+/**
+ * @brief Hybrid structure to represent literal or variable values. It is a small tagged struct passed by value, so primitives need no heap memory while strings and lists point to their heap objects.
  */
 typedef struct var
 {
@@ -50,63 +92,144 @@ typedef struct var
     } data;
 } VarValue;
 
-VarValue *create_bool_varval(int is_const, int flag);
+/// NOTE: the make_* helpers build immediate values by copy.
+
+VarValue make_bool_varval(int is_const, int flag);
 
-VarValue *create_int_varval(int is_const, int value);
+VarValue make_int_varval(int is_const, int value);
 
-VarValue *create_real_varval(int is_const, float value);
+VarValue make_real_varval(int is_const, float value);
 
-VarValue *create_str_varval(int is_const, struct st_str_obj *value);
+VarValue make_str_varval(int is_const, struct st_str_obj *value);
 
-VarValue *create_list_varval(int is_const, struct st_list_obj *value);
+VarValue make_list_varval(int is_const, struct st_list_obj *value);
 
-void varval_destroy(VarValue *value);
+VarValue make_none_varval();
 
 DataType varval_get_type(const VarValue *variable);
 
 int varval_is_const(const VarValue *variable);
 
+/// NOTE: refs of a string owned by something else e.g. a literal in the AST arena. It is never counted or freed.
+#define STR_OBJ_PINNED 0
+
+/**
+ * @brief Reference counted string. Holders that outlive an expression, like lists, retain it, while values passed around by copy just borrow it. Only builders are changed in place, since borrowed copies are not counted and any other string may have aliases.
+ * @note The heap frees strings it tracks, so their counts only decide copy-on-write and never drop below one.
+ * @note Short strings live in inline_buf, so they cost one allocation instead of two. source then points into the object itself, so a StringObj must never be copied by value.
+ */
 typedef struct st_str_obj
 {
+    GcObject gc;
     size_t length;
+    size_t capacity; // chars the buffer holds before it must grow
+    unsigned int refs;
+    int is_builder; // made by the strings builder native, so appends may grow it in place
     char *source;
+    char inline_buf[STR_OBJ_SSO_CAP + 1];
 } StringObj;
 
+/**
+ * @brief Counters of heap string work since startup, so reads can be checked to not allocate.
+ */
+typedef struct st_str_obj_stats
+{
+    size_t allocs;
+    size_t frees;
+    size_t copies;           // strings made by copying another one
+    size_t appends_in_place; // concats that reused the target's buffer
+    size_t inline_strings;   // strings made without a separate char buffer
+} StrObjStats;
+
+/**
+ * @brief Wraps a heap buffer as a string with one reference. The string owns the buffer from now on.
+ */
 StringObj *create_str_obj(char *source);
 
+/**
+ * @brief Makes a string of length chars copied from text. Short ones are stored inline.
+ */
+StringObj *create_str_obj_n(const char *text, size_t length);
+
+/**
+ * @brief Makes an empty string that appends grow in place. Every alias of a builder sees those appends.
+ */
+StringObj *create_str_builder();
+
+/**
+ * @brief Sets up a string over a buffer owned by something else e.g. the AST arena. It is pinned, so it is never counted or freed.
+ */
+void init_pinned_str_obj(StringObj *str, char *source, size_t length);
+
+/**
+ * @brief Frees the string's buffer only. Use release_str_obj for counted strings.
+ */
 void destroy_str_obj(StringObj *str);
 
-StringObj *copy_str_obj(const StringObj *str);
+StringObj *retain_str_obj(StringObj *str);
 
-StringObj *index_str_obj(StringObj *str, size_t index);
+/**
+ * @brief Drops a reference, freeing the string after its last one.
+ */
+void release_str_obj(StringObj *str);
 
-StringObj *concat_str_obj(StringObj *str, StringObj *other);
+StringObj *copy_str_obj(const StringObj *str);
 
-typedef struct st_list_node_obj
-{
-    VarValue *value;
-    struct st_list_node_obj *next;
-} ListNodeObj;
+/**
+ * @brief Gets the char at index as a string. These come from a table of pinned one char strings, so nothing is allocated.
+ */
+StringObj *index_str_obj(const StringObj *str, size_t index);
 
-ListNodeObj *create_listnode_obj(VarValue *data, ListNodeObj *next);
+/**
+ * @brief Appends other to str, reusing str's buffer if it is a builder. Otherwise the result is a new string and str is left as it was.
+ * @note Builder buffers grow to at least twice their capacity, so repeated appends to one builder are amortized O(1). other may be str itself.
+ * @return StringObj* The builder or a new string with one reference, or NULL on failure.
+ */
+StringObj *concat_str_obj(StringObj *str, const StringObj *other);
 
-void destroy_listnode_obj(ListNodeObj *node);
+const StrObjStats *get_str_obj_stats();
 
+/**
+ * @brief Storage layout of a list. A list stays packed while all of its items are ints or all are reals, and falls back to boxed VarValues on the first item of another type.
+ */
+typedef enum en_list_kind
+{
+    LIST_EMPTY,  // no items yet, so the first append picks the layout
+    LIST_INTS,   // packed int32_t buffer
+    LIST_REALS,  // packed float buffer
+    LIST_MIXED   // boxed VarValue buffer
+} ListKind;
+
+/**
+ * @brief Growable vector of list items. Capacity doubles when full, so appends are amortized O(1) and indexing is O(1). Packed layouts let the "lists" natives run vector kernels over the raw buffer.
+ */
 typedef struct st_list_obj
 {
+    GcObject gc;
+    ListKind kind;
     size_t count;
-    ListNodeObj *head; // for fast prepend and destroying
-    ListNodeObj *last; // for fast append
+    size_t capacity; // in items of the current layout
+    union
+    {
+        VarValue *items;
+        int32_t *ints;
+        float *reals;
+    } store;
 } ListObj;
 
 ListObj *create_list_obj();
 
+/**
+ * @brief Frees the item buffer and untracked nested lists, and releases the strings the list retained. Nested lists made by the heap are left to it.
+ */
 void destroy_list_obj(ListObj *list);
 
-int append_list_obj(ListObj *list, VarValue *data);
+int append_list_obj(ListObj *list, VarValue data);
 
-// VarValue *pop_list_obj(ListObj *list);
-
-VarValue *get_at_list_obj(const ListObj *list, size_t index);
+/**
+ * @brief Copies the item at index into item, boxing packed items.
+ * @return int 1 on success or 0 if the index is out of range.
+ */
+int get_at_list_obj(const ListObj *list, size_t index, VarValue *item);
 
 #endif
\ No newline at end of file
@@ -5,10 +5,15 @@
  * @file ast.h
  * @author Derek Tan
  * @brief Parts are enums, Expression, Statement, and Script. 1 is the true success return value.
+ * @note All nodes, their vectors, and string literals are allocated from the owning Script's arena. Names are interned instead.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include "backend/values/vartypes.h"
+#include "utils/arena.h"
+
+struct st_function; // see api/functions.h
 
 typedef enum en_optype
 {
@@ -93,6 +98,8 @@ typedef struct st_expression
         struct
         {
             int is_lvalue;
+            unsigned short depth; // frames to go outwards, set by the resolver
+            unsigned short slot;  // index in that frame, set by the resolver
             char *var_name;
         } variable;
 
@@ -101,6 +108,8 @@ typedef struct st_expression
             char *func_name;
             unsigned int cap;
             unsigned int argc;
+            unsigned int cache_gen;              // FuncEnv generation of the cached callee, 0 if unset
+            const struct st_function *cached_fn; // callee found by the last run of this call site
             struct st_expression **args;
         } fn_call;
 
@@ -113,49 +122,32 @@ typedef struct st_expression
         struct
         {
             OpType op;
+            DataType operand_type; // type of both operands if the typer proved it, else NONE_TYPE
             struct st_expression *left;
             struct st_expression *right;
         } binary_op;
     } syntax;
 } Expression;
 
-Expression *create_bool(int flag);
-
-Expression *create_int(int val);
-
-Expression *create_real(float val);
+Expression *create_bool(Arena *arena, int flag);
 
-Expression *create_str(StringObj *str_obj);
+Expression *create_int(Arena *arena, int val);
 
-Expression *create_list(ListObj *list_val);
+Expression *create_real(Arena *arena, float val);
 
-Expression *create_var(int is_lvalue, char *name);
+Expression *create_str(Arena *arena, StringObj *str_obj);
 
-Expression *create_call(char *fn_name);
+Expression *create_list(Arena *arena, ListObj *list_val);
 
-int add_arg_call(Expression *call_expr, Expression *arg_expr);
-
-/**
- * @brief Downsizes the memory taken by this Expression. Arg vector capacity is shrunk to its count.
- * @param call_expr
- */
-int pack_mem_call(Expression *call_expr);
+Expression *create_var(Arena *arena, int is_lvalue, char *name);
 
-/**
- * @brief Clears the internal Expression vector. Names are unbound instead, as they are managed by the interpreter context.
- * @param call_expr 
- */
-int clear_mem_call(Expression *call_expr);
+Expression *create_call(Arena *arena, char *fn_name);
 
-Expression *create_unary(OpType op, Expression *expr);
+int add_arg_call(Arena *arena, Expression *call_expr, Expression *arg_expr);
 
-Expression *create_binary(OpType op, Expression *left, Expression *right);
+Expression *create_unary(Arena *arena, OpType op, Expression *expr);
 
-/**
- * @brief Deallocates wrapper Expressions, but names are unbound instead since they are managed by the interpreter context.
- * @param expr 
- */
-void destroy_expr(Expression *expr);
+Expression *create_binary(Arena *arena, OpType op, Expression *left, Expression *right);
 
 /**
  * @brief AST node for side-effect commands.
@@ -185,12 +177,16 @@ typedef struct st_statement
         struct
         {
             int is_const;
+            unsigned short slot; // always in the current frame
+            DataType value_type; // type of the rvalue if the typer proved it, else NONE_TYPE
             char *var_name;
             struct st_expression *rvalue;
         } var_decl;
 
         struct
         {
+            unsigned short depth;
+            unsigned short slot;
             char *var_name;
             struct st_expression *rvalue;
         } var_assign;
@@ -200,6 +196,7 @@ typedef struct st_statement
             char *func_name;
             unsigned int cap;
             unsigned int argc;
+            unsigned short frame_size; // params and locals count, set by the resolver
             struct st_expression **func_params;
             struct st_statement *stmts;
         } func_decl;
@@ -229,6 +226,7 @@ typedef struct st_statement
 
         struct
         {
+            int is_tail_call; // set by the resolver when a proc returns a call's result as is
             struct st_expression *result;
         } return_stmt;
 
@@ -239,70 +237,61 @@ typedef struct st_statement
     } syntax;
 } Statement;
 
-Statement *create_block_stmt();
+Statement *create_block_stmt(Arena *arena);
 
 /**
- * @brief Resizes the internal statement ptr array like a vector when count reaches capacity. Capacity is then doubled.
+ * @brief Resizes the internal statement ptr array like a vector when count reaches capacity. Capacity is then doubled, and the old array is left in the arena.
  * @param stmt
  */
-int grow_block_stmt(Statement *block_stmt, Statement *new_stmt);
+int grow_block_stmt(Arena *arena, Statement *block_stmt, Statement *new_stmt);
 
-int pack_block_stmt(Statement *block_stmt); // TODO: later use!
+Statement *create_module_def(Arena *arena, char *name);
 
-int clear_block_stmt(Statement *block_stmt);
+Statement *create_module_usage(Arena *arena, char *name);
 
-Statement *create_module_def(char *name);
+Statement *create_var_decl(Arena *arena, int is_const, char *var_name, Expression *rvalue);
 
-Statement *create_module_usage(char *name);
+Statement *create_var_assign(Arena *arena, char *var_name, Expression *rvalue);
 
-Statement *create_var_decl(int is_const, char *var_name, Expression *rvalue);
+Statement *create_func_stmt(Arena *arena, char *fn_name, Statement *block);
 
-Statement *create_var_assign(char *var_name, Expression *rvalue);
+int put_arg_func_stmt(Arena *arena, Statement *fn_decl, Expression *arg_expr);
 
-Statement *create_func_stmt(char *fn_name, Statement *block);
+Statement *create_while_stmt(Arena *arena, Expression *conditional, Statement *block);
 
-int put_arg_func_stmt(Statement *fn_decl, Expression *arg_expr);
+Statement *create_if_stmt(Arena *arena, Expression *conditional, Statement *first, Statement *other);
 
-int pack_args_func_stmt(Statement *fn_decl); // TODO: later use!
+Statement *create_otherwise_stmt(Arena *arena, Statement *block);
 
-void clear_func_stmt(Statement *fn_decl);
+Statement *create_break_stmt(Arena *arena, int depth);
 
-Statement *create_while_stmt(Expression *conditional, Statement *block);
+Statement *create_return_stmt(Arena *arena, Expression *result);
 
-Statement *create_if_stmt(Expression *conditional, Statement *first, Statement *other);
-
-Statement *create_otherwise_stmt(Statement *block);
-
-Statement *create_break_stmt(int depth);
-
-Statement *create_return_stmt(Expression *result);
-
-Statement *create_expr_stmt(Expression *expr);
-
-/**
- * @brief Unbinds any dynamic data pointer within a Statement structure since the interpreter context stores name-data mappings.
- * 
- * @param stmt 
- */
-void destroy_stmt(Statement *stmt);
+Statement *create_expr_stmt(Arena *arena, Expression *expr);
 
 typedef struct st_script
 {
     const char *name;
     unsigned int capacity;
     unsigned int count;
+    unsigned short global_count; // top-level variable count, set by the resolver
     Statement **stmts;
+    Arena arena;                 // owns every node, vector, and string literal of the script
 } Script;
 
 void init_script(Script *script, const char *name, unsigned int old_count);
 
-void grow_script(Script *script, Statement *stmt_obj);
+int grow_script(Script *script, Statement *stmt_obj);
 
 /**
- * @brief Unbinds any dynamic memory ptrs since names to entity mappings are managed by the interpreter context. Wrappers get deallocated on the outer level.
- * @note block statements recursively have their entity ptrs unbound before deallocation.
+ * @brief Frees the whole AST by disposing the script's arena. Function objects borrow its nodes, so this goes after them.
  * @param script
  */
 void dispose_script(Script *script);
 
+/**
+ * @brief Prints the script's statements as an indented tree with expressions in prefix form, e.g. for --dump-ast.
+ */
+void print_script(const Script *script);
+
 #endif
\ No newline at end of file
@@ -4,6 +4,35 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-char *load_file(const char *file_path);
+/// SECTION: Macros
 
-#endif
\ No newline at end of file
+#if defined(__unix__) || defined(__APPLE__)
+#define FILELOAD_MMAP
+#endif
+
+#define FILELOAD_STDIN_NAME "-" // file name that reads the script from stdin
+#define FILELOAD_CHUNK_SZ 4096
+
+/// SECTION: Source text
+
+/**
+ * @brief Text of a script. Regular files are mapped read-only instead of copied, and other inputs are read into a buffer. Either way, a NUL follows the last char, so the lexer can stop on it.
+ * @note The lexer and parser only keep (begin, span) slices of the text, so it must outlive parsing. Values that need their own strings copy them out.
+ */
+typedef struct st_source_text
+{
+    char *text;      // never written when mapped
+    size_t length;
+    size_t map_size; // bytes mapped, or 0 for a malloc'd buffer
+    int is_stream;   // 1 for stdin or pipes, which have no file to keep a cache by
+} SourceText;
+
+/**
+ * @brief Loads a script file, or stdin for FILELOAD_STDIN_NAME.
+ * @return int 1 on success.
+ */
+int load_source(SourceText *source, const char *file_path);
+
+void unload_source(SourceText *source);
+
+#endif
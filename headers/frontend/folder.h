@@ -0,0 +1,54 @@
+#ifndef FOLDER_H
+#define FOLDER_H
+
+/**
+ * @file folder.h
+ * @author Derek Tan
+ * @brief Static pass after the resolver that folds operators over literals, puts the literal values of const globals into their uses, and drops if branches decided by literal conditions.
+ * @note Nodes are rewritten in place, and spliced blocks get new statement vectors from the script's arena. Anything that would fail while running is left alone, so both engines still report the same errors.
+ */
+
+#include "frontend/ast.h"
+
+/// SECTION: Folder
+
+typedef struct st_folder
+{
+    Arena *arena;
+    int in_proc;                  // 0 while folding top-level code
+    unsigned short global_count;
+    Expression **const_globals;   // literal of each const global declared so far, or NULL
+    unsigned int folded_count;    // operators turned into literals
+    unsigned int propagated_count; // const global uses turned into literals
+    unsigned int pruned_count;    // if and while statements dropped or flattened
+} Folder;
+
+/**
+ * @brief Prepares a folder for a resolved script, since it needs the global slot count.
+ */
+int folder_init(Folder *folder, Script *script);
+
+void folder_dispose(Folder *folder);
+
+/// SECTION: Folding
+
+/**
+ * @brief Folds an expression's operands first, then the expression itself if they became literals.
+ */
+void fold_expr(Folder *folder, Expression *expr);
+
+/**
+ * @brief Folds each statement of a block. Decided ifs and never running whiles are replaced by the statements that would run.
+ * @return int 0 if a new statement vector could not be allocated.
+ */
+int fold_block(Folder *folder, Statement *stmt);
+
+int fold_stmt(Folder *folder, Statement *stmt);
+
+/**
+ * @brief Folds all top-level statements in order, so const globals only reach code after their declarations.
+ * @return int 1 on success.
+ */
+int fold_script(Folder *folder, Script *script);
+
+#endif
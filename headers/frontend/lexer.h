@@ -9,15 +9,18 @@
 #define IS_NUMERIC(c) (c >= '0' && c <= '9')
 #define IS_OP_CHAR(c) c == '=' || c == '!' || c == '<' || c == '>' || c == '+' || c == '-' || c == '*' || c == '/' || c == '&' || c == '|'
 
+/**
+ * @brief Lexer over source text that ends in a NUL. Tokens are (begin, span) slices of it, so no lexeme is copied here.
+ */
 typedef struct st_lexer
 {
-    char *src;
+    const char *src;
     size_t pos;
     size_t limit;
     size_t line;
 } Lexer;
 
-void lexer_init(Lexer *lexer, char *source);
+void lexer_init(Lexer *lexer, const char *source, size_t length);
 
 Token lexer_lex_wspace(Lexer *lexer);
 
@@ -4,17 +4,20 @@
 #include "frontend/lexer.h"
 #include "frontend/ast.h"
 #include "frontend/fileload.h"
+#include "utils/intern.h"
+#include "backend/values/heap.h"
 
 typedef struct
 {
-    char *src_copy_ptr;
+    const char *src_copy_ptr; // source text, e.g. a file mapping, that must outlive parsing
+    Arena *arena; // the arena of the script being parsed
     int ready_flag;
     Lexer lexer;
     Token previous;
     Token current;
 } Parser;
 
-void parser_init(Parser *parser, char *src);
+void parser_init(Parser *parser, const char *src, size_t length);
 
 int parser_at_end(Parser *parser);
 
@@ -28,8 +31,21 @@ void parser_consume(Parser *parser, TokenType type, const char *err_msg);
 
 void parser_log_err(Parser *parser, size_t line, const char *msg);
 
+/**
+ * @brief Copies the token's text into the script's arena.
+ */
 char *parser_stringify_token(Parser *parser, Token *token_ptr);
 
+/**
+ * @brief Gets the interned copy of an identifier token's text.
+ */
+char *parser_intern_token(Parser *parser, Token *token_ptr);
+
+/**
+ * @brief Checks if the token's text is exactly word without copying it. Used for keywords and operators.
+ */
+int parser_match_lexeme(Parser *parser, const Token *token_ptr, const char *word);
+
 /// SECTION: Expression Parsing
 
 Expression *parse_primitive(Parser *parser);
@@ -0,0 +1,61 @@
+#ifndef RESOLVER_H
+#define RESOLVER_H
+
+/**
+ * @file resolver.h
+ * @author Derek Tan
+ * @brief Static pass that binds each variable node to a (depth, slot) pair, so neither the walker nor the compiler looks up names while running.
+ * @note Depth 0 is the current frame. Inside a proc, depth 1 is the global frame.
+ * @note Scoping is lexical, so a proc cannot read its caller's locals as it could when the walker chained call scopes.
+ */
+
+#include <stdio.h>
+#include "frontend/ast.h"
+#include "backend/values/varenv.h"
+
+/// SECTION: Macros
+
+#define RESOLVER_SLOT_MAX 0xFFFF
+#define RESOLVE_DEPTH_LOCAL 0
+#define RESOLVE_DEPTH_GLOBAL 1
+
+/// SECTION: Resolver
+
+typedef struct st_resolver
+{
+    int in_proc;               // 0 while resolving top-level code
+    int error_count;
+    unsigned int stmt_num;     // top-level statement number for messages
+    const char *proc_name;
+    unsigned short local_count;
+    VarEnv globals;            // top-level names to their slots
+    VarEnv locals;             // names in the current proc, reset per proc
+} Resolver;
+
+int resolver_init(Resolver *resolver);
+
+void resolver_dispose(Resolver *resolver);
+
+void resolver_log_err(Resolver *resolver, const char *msg);
+
+/// SECTION: Resolving
+
+int resolve_expr(Resolver *resolver, Expression *expr);
+
+int resolve_var_decl(Resolver *resolver, Statement *stmt);
+
+int resolve_var_assign(Resolver *resolver, Statement *stmt);
+
+int resolve_func_decl(Resolver *resolver, Statement *stmt);
+
+int resolve_block(Resolver *resolver, Statement *stmt);
+
+int resolve_stmt(Resolver *resolver, Statement *stmt);
+
+/**
+ * @brief Annotates all variable nodes of the script. Top-level variables get their slots first, so procs declared before them can still use them.
+ * @return int 1 on success, 0 if any error was reported e.g. an undefined variable.
+ */
+int resolve_script(Resolver *resolver, Script *script);
+
+#endif
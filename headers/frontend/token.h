@@ -24,6 +24,9 @@ typedef enum en_token_type
     UNKNOWN
 } TokenType;
 
+/**
+ * @brief A lexeme as a slice of the source text, so tokens are never copied out of it.
+ */
 typedef struct st_token
 {
     TokenType type;
@@ -34,6 +37,4 @@ typedef struct st_token
 
 void token_init(Token *token, TokenType type, size_t begin, size_t span, size_t line);
 
-char *token_as_txt(Token *token, const char *source);
-
 #endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef TYPER_H
+#define TYPER_H
+
+/**
+ * @file typer.h
+ * @author Derek Tan
+ * @brief Static pass after folding that proves variable and operand types, so both engines can run int-only or real-only operators without checks. Operators whose operand types are proven wrong are reported before anything runs.
+ * @note A variable's type is set by its declaration, since "set" cannot change it. It is only proven where the declaration surely ran, which is why the pass follows the statement order.
+ */
+
+#include <stdio.h>
+#include "frontend/ast.h"
+
+/// SECTION: Typer
+
+typedef struct st_typer
+{
+    int in_proc;                   // 0 while typing top-level code
+    int error_count;
+    unsigned int stmt_num;         // top-level statement number for messages
+    const char *proc_name;
+    unsigned short global_count;
+    unsigned short local_count;    // frame size of the current proc
+    unsigned short decl_mark;      // slots below this were declared by code typed so far
+    DataType *global_types;        // proven type of each global, NONE_TYPE if unproven
+    DataType *local_types;         // same for the current proc's frame
+    unsigned int specialized_count; // operators given an operand type
+} Typer;
+
+/**
+ * @brief Prepares a typer for a resolved script, since it needs the global slot count.
+ */
+int typer_init(Typer *typer, const Script *script);
+
+void typer_dispose(Typer *typer);
+
+void typer_log_err(Typer *typer, const char *msg);
+
+/// SECTION: Typing
+
+/**
+ * @brief Proves the type of an expression's value, marking specialized operators on the way.
+ * @return DataType The type or NONE_TYPE if it is only known while running.
+ */
+DataType type_expr(Typer *typer, Expression *expr);
+
+int type_block(Typer *typer, Statement *stmt);
+
+int type_stmt(Typer *typer, Statement *stmt);
+
+/**
+ * @brief Types all top-level statements in order. Procs are typed where they are declared, but they never rely on global types since they may run before a global is set.
+ * @return int 1 on success, 0 if any type error was reported.
+ */
+int type_script(Typer *typer, Script *script);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+/**
+ * @file arena.h
+ * @author Derek Tan
+ * @brief Bump pointer arena made of linked chunks. Everything allocated from it is freed at once by arena_dispose.
+ * @note The counters are kept for sizing ARENA_CHUNK_SZ against real scripts.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+/// SECTION: Macros
+
+#define ARENA_CHUNK_SZ 4096
+#define ARENA_ALIGN 8
+
+/// SECTION: Arena
+
+typedef struct st_arena_chunk
+{
+    struct st_arena_chunk *next;
+    size_t used;
+    size_t capacity;
+    unsigned char data[];
+} ArenaChunk;
+
+typedef struct st_arena
+{
+    ArenaChunk *head;      // newest chunk, the only one still bumped
+    size_t chunk_size;
+    size_t bytes_used;     // handed out bytes including alignment padding
+    size_t bytes_reserved; // chunk bytes taken from malloc
+    unsigned int chunk_count;
+    unsigned int node_count; // allocations made by arena_alloc_node
+} Arena;
+
+void arena_init(Arena *arena, size_t chunk_size);
+
+void arena_dispose(Arena *arena);
+
+/**
+ * @brief Bumps out size bytes aligned to ARENA_ALIGN. Requests bigger than a chunk get their own chunk.
+ * @return void* The memory or NULL on a failed chunk allocation.
+ */
+void *arena_alloc(Arena *arena, size_t size);
+
+/**
+ * @brief Same as arena_alloc, but counted as a node e.g an AST node.
+ */
+void *arena_alloc_node(Arena *arena, size_t size);
+
+/**
+ * @brief Copies a string of length chars into the arena with a NUL ending.
+ */
+char *arena_strndup(Arena *arena, const char *str, size_t length);
+
+#endif
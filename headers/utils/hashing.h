@@ -1,11 +1,28 @@
 #ifndef HASHING_H
 #define HASHING_H
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define THE_HASHING_PRIME 3
+/// SECTION: Macros
 
+#define HASH_FNV_OFFSET 0xcbf29ce484222325ULL
+#define HASH_FNV_PRIME 0x100000001b3ULL
+
+/**
+ * @brief FNV-1a over the key's chars followed by a 64-bit mixer, so short similar names spread over all bits. Tables can mask the low bits safely.
+ */
 size_t hash_key(const char *key);
 
-#endif
\ No newline at end of file
+/**
+ * @brief Hashes length chars of key, which may not be NUL terminated e.g a token in the source.
+ */
+size_t hash_key_n(const char *key, size_t length);
+
+/**
+ * @brief Rounds count up to a power of two, which the open-addressed tables need for masking.
+ */
+size_t hash_capacity_for(size_t count);
+
+#endif
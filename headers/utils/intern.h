@@ -0,0 +1,57 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+/**
+ * @file intern.h
+ * @author Derek Tan
+ * @brief Global pool of unique name strings. Equal names share one interned pointer, so symbol tables compare them by address and reuse the stored hash.
+ * @note Interned strings live until intern_pool_dispose, so they outlive every Script and runtime table.
+ */
+
+#include <stddef.h>
+#include "utils/hashing.h"
+
+/// SECTION: Macros
+
+#define INTERN_POOL_SIZE 64
+
+/// SECTION: Intern Pool
+
+typedef struct st_intern_entry
+{
+    struct st_intern_entry *next;
+    size_t hash;
+    size_t length;
+    char text[]; // NUL terminated name, the pointer handed out
+} InternEntry;
+
+typedef struct st_intern_pool
+{
+    size_t capacity;
+    size_t count;
+    InternEntry **buckets;
+} InternPool;
+
+int intern_pool_init(void);
+
+void intern_pool_dispose(void);
+
+/**
+ * @brief Finds or adds the name made of length chars at str.
+ * @return char* The unique copy or NULL on a failed allocation.
+ */
+char *intern_string(const char *str, size_t length);
+
+char *intern_cstr(const char *str);
+
+/**
+ * @brief Gets the hash stored with an interned name. The name must have come from this pool.
+ */
+size_t intern_hash(const char *interned);
+
+/**
+ * @brief Gets how many unique names are in the pool.
+ */
+size_t intern_count(void);
+
+#endif
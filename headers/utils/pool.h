@@ -0,0 +1,63 @@
+#ifndef POOL_H
+#define POOL_H
+
+/**
+ * @file pool.h
+ * @author Derek Tan
+ * @brief Fixed size object pool made of slabs. Freed items go on a free list, so hot objects like call frames and heap values are reused without malloc.
+ * @note Building with RUBEL_NO_POOLS makes every pool call plain malloc and free, so ASan can see each object by itself.
+ */
+
+#include <stdlib.h>
+
+/// SECTION: Macros
+
+#define POOL_SLAB_ITEMS 64
+#define POOL_ALIGN 8
+
+/// SECTION: Pool
+
+typedef struct st_pool_slab
+{
+    struct st_pool_slab *next;
+    unsigned char data[];
+} PoolSlab;
+
+typedef struct st_pool_item
+{
+    struct st_pool_item *next;
+} PoolItem;
+
+typedef struct st_pool
+{
+    size_t item_size;   // aligned to POOL_ALIGN and never smaller than a PoolItem
+    size_t slab_items;
+    PoolSlab *slabs;
+    PoolItem *free_list;
+    unsigned char *bump;     // next unused item of the newest slab
+    unsigned char *bump_end;
+    size_t live_count;  // items handed out and not freed yet
+    unsigned int slab_count;
+} Pool;
+
+/**
+ * @brief Prepares an empty pool. A slab_items of 0 uses POOL_SLAB_ITEMS. No slab is made until the first allocation.
+ */
+void pool_init(Pool *pool, size_t item_size, size_t slab_items);
+
+/**
+ * @brief Frees every slab at once, so items still in use become invalid.
+ */
+void pool_dispose(Pool *pool);
+
+/**
+ * @return void* An uninitialized item or NULL on a failed slab allocation.
+ */
+void *pool_alloc(Pool *pool);
+
+/**
+ * @brief Gives an item back for reuse. The item must come from this pool.
+ */
+void pool_free(Pool *pool, void *item);
+
+#endif
@@ -0,0 +1,332 @@
+/**
+ * @file aotrt.c
+ * @author Derek Tan
+ * @brief Implements the runtime support of compiled scripts.
+ * @date 2023-08-22
+ */
+
+#include "backend/runner/aotrt.h"
+#include "backend/runner/interpreter.h"
+
+/// SECTION: Value stack
+
+static AotStack the_stack;
+
+// NOTE: a tail call's args wait here between the returning proc and its callee, so they are roots too.
+static AotProc tail_proc = NULL;
+static unsigned short tail_argc = 0;
+static VarValue tail_args[FUNC_ARGV_MAX_SZ];
+
+static unsigned int call_depth = 0;
+
+VarValue *aot_globals = NULL;
+
+unsigned int aot_stmt_num = 0;
+
+static int aot_add_chunk(size_t capacity)
+{
+    AotChunk *temp_chunks = NULL;
+    VarValue *slots = NULL;
+
+    if (the_stack.count == the_stack.capacity)
+    {
+        temp_chunks = realloc(the_stack.chunks, sizeof(AotChunk) * (the_stack.capacity << 1));
+
+        if (!temp_chunks) return 0;
+
+        the_stack.chunks = temp_chunks;
+        the_stack.capacity <<= 1;
+    }
+
+    slots = malloc(sizeof(VarValue) * capacity);
+
+    if (!slots) return 0;
+
+    the_stack.chunks[the_stack.count] = (AotChunk){.capacity = capacity, .top = 0, .slots = slots};
+    the_stack.count++;
+
+    return 1;
+}
+
+VarValue *aot_push(size_t count)
+{
+    AotChunk *chunk = the_stack.chunks + the_stack.current;
+    size_t window_base = chunk->top;
+
+    if (chunk->top + count > chunk->capacity)
+    {
+        // NOTE: a window never spans chunks, so a full chunk is left as is and the next one is used.
+        if (the_stack.current + 1 == the_stack.count && !aot_add_chunk((count > AOT_CHUNK_MIN_SZ) ? count : AOT_CHUNK_MIN_SZ)) return NULL;
+
+        the_stack.current++;
+        chunk = the_stack.chunks + the_stack.current;
+
+        // NOTE: a spare chunk from an earlier call may be too small for this window.
+        if (chunk->capacity < count)
+        {
+            VarValue *temp_slots = realloc(chunk->slots, sizeof(VarValue) * count);
+
+            if (!temp_slots)
+            {
+                the_stack.current--;
+                return NULL;
+            }
+
+            chunk->slots = temp_slots;
+            chunk->capacity = count;
+        }
+
+        window_base = 0;
+    }
+
+    chunk->top = window_base + count;
+
+    // NOTE: a collection may run before every slot is filled, so none may hold stale values.
+    for (size_t i = window_base; i < chunk->top; i++) chunk->slots[i] = make_none_varval();
+
+    return chunk->slots + window_base;
+}
+
+void aot_pop(size_t count)
+{
+    AotChunk *chunk = the_stack.chunks + the_stack.current;
+
+    if (count == 0) return;
+
+    chunk->top -= count;
+
+    if (chunk->top == 0 && the_stack.current > 0) the_stack.current--;
+}
+
+AotMark aot_mark()
+{
+    return (AotMark){.chunk = the_stack.current, .top = the_stack.chunks[the_stack.current].top};
+}
+
+void aot_release(AotMark mark)
+{
+    the_stack.current = mark.chunk;
+    the_stack.chunks[mark.chunk].top = mark.top;
+}
+
+VarValue *aot_enter(size_t frame_size, const VarValue *args, unsigned short argc)
+{
+    VarValue *frame = aot_push(frame_size);
+
+    if (!frame) return NULL;
+
+    for (unsigned short i = 0; i < argc && i < frame_size; i++) frame[i] = args[i];
+
+    aot_collect_garbage();
+
+    return frame;
+}
+
+void aot_collect_garbage()
+{
+    const AotChunk *chunk = NULL;
+
+    if (heap_wants_collect() == GC_CYCLE_NONE) return;
+
+    heap_begin_collect();
+
+    for (unsigned int i = 0; i <= the_stack.current; i++)
+    {
+        chunk = the_stack.chunks + i;
+
+        for (size_t j = 0; j < chunk->top; j++) heap_mark_value(chunk->slots + j);
+    }
+
+    for (unsigned short i = 0; i < tail_argc; i++) heap_mark_value(tail_args + i);
+
+    heap_finish_collect();
+}
+
+/// SECTION: Running
+
+int aot_init(unsigned short global_count)
+{
+    const char *nursery_knob = getenv(GC_NURSERY_KNOB);
+
+    the_stack.chunks = malloc(sizeof(AotChunk) * AOT_CHUNKS_MIN_SZ);
+    the_stack.count = 0;
+    the_stack.capacity = AOT_CHUNKS_MIN_SZ;
+    the_stack.current = 0;
+
+    if (!the_stack.chunks || !aot_add_chunk(AOT_CHUNK_MIN_SZ))
+    {
+        aot_dispose();
+        return 0;
+    }
+
+    if (!heap_init((nursery_knob != NULL) ? strtoul(nursery_knob, NULL, 10) * 1024 : GC_NURSERY_SZ))
+    {
+        aot_dispose();
+        return 0;
+    }
+
+    aot_globals = aot_push(global_count);
+
+    return aot_globals != NULL;
+}
+
+void aot_dispose()
+{
+    for (unsigned int i = 0; i < the_stack.count; i++) free(the_stack.chunks[i].slots);
+
+    free(the_stack.chunks);
+    the_stack.chunks = NULL;
+    the_stack.count = 0;
+    the_stack.capacity = 0;
+    the_stack.current = 0;
+    aot_globals = NULL;
+
+    heap_dispose();
+}
+
+RunStatus aot_call(AotProc proc, VarValue *args, VarValue *result)
+{
+    RunStatus status = OK_RAN_CMD;
+    VarValue *window = NULL;
+    unsigned short argc = 0;
+
+    // NOTE: compiled procs recurse in C like the walker's, so they share its depth limit.
+    if (call_depth >= CTX_CALL_DEPTH_MAX) return ERR_DEPTH;
+
+    call_depth++;
+    status = proc(args, result);
+
+    while (status == OK_CTRL_RETURN)
+    {
+        proc = tail_proc;
+        argc = tail_argc;
+        window = aot_push(argc);
+
+        if (!window)
+        {
+            status = ERR_MEMORY;
+            break;
+        }
+
+        for (unsigned short i = 0; i < argc; i++) window[i] = tail_args[i];
+
+        tail_argc = 0;
+        status = proc(window, result);
+        aot_pop(argc);
+    }
+
+    call_depth--;
+
+    return status;
+}
+
+RunStatus aot_tail(AotProc proc, const VarValue *args, unsigned short argc)
+{
+    for (unsigned short i = 0; i < argc; i++) tail_args[i] = args[i];
+
+    tail_proc = proc;
+    tail_argc = argc;
+
+    return OK_CTRL_RETURN;
+}
+
+RunStatus aot_call_native(NativeFunc native, VarValue *args, unsigned short argc, VarValue *result)
+{
+    FuncArgs native_args;
+
+    funcargs_init(&native_args, argc, args);
+    *result = native(&native_args);
+
+    return OK_RAN_CMD;
+}
+
+/// SECTION: Boxed operations
+
+RunStatus aot_negate(VarValue operand, VarValue *result)
+{
+    switch (operand.type)
+    {
+    case INT_TYPE:
+        *result = make_int_varval(1, INT_WRAP_SUB(0, operand.data.int_val.value));
+        return OK_RAN_CMD;
+    case REAL_TYPE:
+        *result = make_real_varval(1, 0 - operand.data.real_val.value);
+        return OK_RAN_CMD;
+    case NONE_TYPE:
+        return ERR_NULL_VAL;
+    default:
+        return ERR_TYPE;
+    }
+}
+
+RunStatus aot_binary(OpType op, VarValue left, VarValue right, VarValue *result)
+{
+    int flag = 0;
+
+    if (left.type == NONE_TYPE || right.type == NONE_TYPE) return ERR_NULL_VAL;
+
+    if (left.type != right.type) return ERR_TYPE;
+
+    if (op == OP_EQ || op == OP_NEQ || op == OP_GT || op == OP_GTE || op == OP_LT || op == OP_LTE)
+    {
+        flag = compare_primitives(op, &left, &right);
+
+        if (flag < 0) return ERR_TYPE;
+
+        *result = make_bool_varval(1, flag);
+
+        return OK_RAN_CMD;
+    }
+
+    if (op != OP_ADD && op != OP_SUB && op != OP_MUL && op != OP_DIV) return ERR_NO_IMPL;
+
+    *result = math_primitives(op, &left, &right);
+
+    // NOTE: numbers only fail here on division by zero.
+    if (result->type == NONE_TYPE) return (left.type == INT_TYPE || left.type == REAL_TYPE) ? ERR_NULL_VAL : ERR_TYPE;
+
+    return OK_RAN_CMD;
+}
+
+RunStatus aot_test(VarValue condition, int *flag)
+{
+    if (condition.type != BOOL_TYPE) return (condition.type == NONE_TYPE) ? ERR_NULL_VAL : ERR_TYPE;
+
+    *flag = condition.data.bool_val.flag;
+
+    return OK_RAN_CMD;
+}
+
+RunStatus aot_declare(VarValue *dest, VarValue src, int is_const)
+{
+    if (src.type == NONE_TYPE) return ERR_NULL_VAL;
+
+    *dest = src;
+    dest->is_const = is_const;
+
+    return OK_RAN_CMD;
+}
+
+RunStatus aot_assign(VarValue *dest, VarValue src)
+{
+    if (src.type == NONE_TYPE) return ERR_NULL_VAL;
+
+    if (dest->type != src.type) return ERR_TYPE;
+
+    dest->data = src.data;
+
+    return OK_RAN_CMD;
+}
+
+RunStatus aot_expect(VarValue value, DataType type)
+{
+    if (value.type == NONE_TYPE) return ERR_NULL_VAL;
+
+    return (value.type == type) ? OK_RAN_CMD : ERR_TYPE;
+}
+
+void aot_log_err(RunStatus status)
+{
+    // NOTE: the messages do not depend on the interpreter, so none is passed.
+    interpreter_log_err(NULL, aot_stmt_num, status);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file arena.c
+ * @author Derek Tan
+ * @brief Implements the bump pointer arena.
+ * @date 2023-08-14
+ */
+
+#include "utils/arena.h"
+
+/// SECTION: Arena utils
+
+void arena_init(Arena *arena, size_t chunk_size)
+{
+    arena->head = NULL;
+    arena->chunk_size = (chunk_size > 0) ? chunk_size : ARENA_CHUNK_SZ;
+    arena->bytes_used = 0;
+    arena->bytes_reserved = 0;
+    arena->chunk_count = 0;
+    arena->node_count = 0;
+}
+
+void arena_dispose(Arena *arena)
+{
+    ArenaChunk *chunk = arena->head;
+    ArenaChunk *next_chunk = NULL;
+
+    while (chunk != NULL)
+    {
+        next_chunk = chunk->next;
+        free(chunk);
+        chunk = next_chunk;
+    }
+
+    arena->head = NULL;
+    arena->bytes_used = 0;
+    arena->bytes_reserved = 0;
+    arena->chunk_count = 0;
+    arena->node_count = 0;
+}
+
+static ArenaChunk *arena_add_chunk(Arena *arena, size_t capacity)
+{
+    ArenaChunk *chunk = malloc(sizeof(ArenaChunk) + capacity);
+
+    if (!chunk) return NULL;
+
+    chunk->used = 0;
+    chunk->capacity = capacity;
+
+    // NOTE: an oversized chunk goes behind the head, so the head's free space is not lost.
+    if (capacity > arena->chunk_size && arena->head != NULL)
+    {
+        chunk->next = arena->head->next;
+        arena->head->next = chunk;
+    }
+    else
+    {
+        chunk->next = arena->head;
+        arena->head = chunk;
+    }
+
+    arena->bytes_reserved += capacity;
+    arena->chunk_count++;
+
+    return chunk;
+}
+
+/// SECTION: Allocation
+
+void *arena_alloc(Arena *arena, size_t size)
+{
+    ArenaChunk *chunk = arena->head;
+    size_t aligned_size = (size + (ARENA_ALIGN - 1)) & ~((size_t)ARENA_ALIGN - 1);
+    void *result = NULL;
+
+    if (!chunk || chunk->capacity - chunk->used < aligned_size)
+    {
+        chunk = arena_add_chunk(arena, (aligned_size > arena->chunk_size) ? aligned_size : arena->chunk_size);
+
+        if (!chunk) return NULL;
+    }
+
+    result = chunk->data + chunk->used;
+    chunk->used += aligned_size;
+    arena->bytes_used += aligned_size;
+
+    return result;
+}
+
+void *arena_alloc_node(Arena *arena, size_t size)
+{
+    void *node = arena_alloc(arena, size);
+
+    if (node != NULL) arena->node_count++;
+
+    return node;
+}
+
+char *arena_strndup(Arena *arena, const char *str, size_t length)
+{
+    char *copy = arena_alloc(arena, length + 1);
+
+    if (copy != NULL)
+    {
+        memcpy(copy, str, length);
+        copy[length] = '\0';
+    }
+
+    return copy;
+}
@@ -7,11 +7,30 @@
 
 #include "frontend/ast.h"
 
+/// SECTION: Vector utils
+
+/**
+ * @brief Copies a node pointer vector into a bigger arena block. The old block stays in the arena until the Script is disposed.
+ */
+static void *ast_grow_ptrs(Arena *arena, void *old_items, size_t count, size_t new_capacity)
+{
+    void **raw_block = arena_alloc(arena, sizeof(void *) * new_capacity);
+
+    if (!raw_block) return NULL;
+
+    if (count > 0) memcpy(raw_block, old_items, sizeof(void *) * count);
+
+    for (size_t i = count; i < new_capacity; i++)
+        raw_block[i] = NULL;
+
+    return raw_block;
+}
+
 /// SECTION: Expression funcs
 
-Expression *create_bool(int flag)
+Expression *create_bool(Arena *arena, int flag)
 {
-    Expression *expr = malloc(sizeof(Expression));
+    Expression *expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (expr != NULL)
     {
@@ -22,9 +41,9 @@ Expression *create_bool(int flag)
     return expr;
 }
 
-Expression *create_int(int val)
+Expression *create_int(Arena *arena, int val)
 {
-    Expression *expr = malloc(sizeof(Expression));
+    Expression *expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (expr != NULL)
     {
@@ -35,9 +54,9 @@ Expression *create_int(int val)
     return expr;
 }
 
-Expression *create_real(float val)
+Expression *create_real(Arena *arena, float val)
 {
-    Expression *expr = malloc(sizeof(Expression));
+    Expression *expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (expr != NULL)
     {
@@ -48,9 +67,9 @@ Expression *create_real(float val)
     return expr;
 }
 
-Expression *create_str(StringObj *str_obj)
+Expression *create_str(Arena *arena, StringObj *str_obj)
 {
-    Expression *expr = malloc(sizeof(Expression));
+    Expression *expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (expr != NULL)
     {
@@ -61,9 +80,9 @@ Expression *create_str(StringObj *str_obj)
     return expr;
 }
 
-Expression *create_list(ListObj *list_val)
+Expression *create_list(Arena *arena, ListObj *list_val)
 {
-    Expression *expr = malloc(sizeof(Expression));
+    Expression *expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (expr != NULL)
     {
@@ -74,23 +93,25 @@ Expression *create_list(ListObj *list_val)
     return expr;
 }
 
-Expression *create_var(int is_lvalue, char *name)
+Expression *create_var(Arena *arena, int is_lvalue, char *name)
 {
-    Expression *expr = malloc(sizeof(Expression));
+    Expression *expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (expr != NULL)
     {
         expr->type = VAR_USAGE;
         expr->syntax.variable.is_lvalue = is_lvalue;
+        expr->syntax.variable.depth = 0;
+        expr->syntax.variable.slot = 0;
         expr->syntax.variable.var_name = name;
     }
 
     return expr;
 }
 
-Expression *create_call(char *fn_name)
+Expression *create_call(Arena *arena, char *fn_name)
 {
-    Expression *expr = malloc(sizeof(Expression));
+    Expression *expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (expr != NULL)
     {
@@ -98,7 +119,9 @@ Expression *create_call(char *fn_name)
         expr->syntax.fn_call.func_name = fn_name;
         expr->syntax.fn_call.argc = 0;
         expr->syntax.fn_call.cap = 4;
-        expr->syntax.fn_call.args = malloc(sizeof(Expression *) * 4);
+        expr->syntax.fn_call.cache_gen = 0;
+        expr->syntax.fn_call.cached_fn = NULL;
+        expr->syntax.fn_call.args = arena_alloc(arena, sizeof(Expression *) * 4);
 
         if (!expr->syntax.fn_call.args)
             expr->syntax.fn_call.cap = 0;
@@ -107,27 +130,24 @@ Expression *create_call(char *fn_name)
     return expr;
 }
 
-int add_arg_call(Expression *call_expr, Expression *arg_expr)
+int add_arg_call(Arena *arena, Expression *call_expr, Expression *arg_expr)
 {
     size_t next_spot = call_expr->syntax.fn_call.argc;
     size_t old_capacity = call_expr->syntax.fn_call.cap;
-    size_t new_capacity = old_capacity << 1;
+    size_t new_capacity = (old_capacity > 0) ? old_capacity << 1 : 4;
 
-    if (next_spot <= old_capacity - 1)
+    if (next_spot < old_capacity)
     {
         call_expr->syntax.fn_call.args[next_spot] = arg_expr;
         call_expr->syntax.fn_call.argc++;
         return 1;
     }
 
-    Expression **raw_block = realloc(call_expr->syntax.fn_call.args, sizeof(Expression *) * new_capacity);
+    Expression **raw_block = ast_grow_ptrs(arena, call_expr->syntax.fn_call.args, next_spot, new_capacity);
 
     if (raw_block != NULL)
     {
-        for (size_t i = old_capacity; i < new_capacity; i++)
-            raw_block[i] = NULL;
-        
-        call_expr->syntax.fn_call.args[next_spot] = arg_expr;
+        raw_block[next_spot] = arg_expr;
         call_expr->syntax.fn_call.args = raw_block;
         call_expr->syntax.fn_call.argc++;
         call_expr->syntax.fn_call.cap = new_capacity;
@@ -138,56 +158,9 @@ int add_arg_call(Expression *call_expr, Expression *arg_expr)
     return 0;
 }
 
-int pack_mem_call(Expression *call_expr)
-{
-    size_t curr_capacity = call_expr->syntax.fn_call.cap;
-    size_t curr_count = call_expr->syntax.fn_call.argc;
-
-    if (curr_capacity <= curr_count) return 1;
-
-    Expression **raw_args = realloc(call_expr->syntax.fn_call.args, sizeof(Expression *) * curr_count);
-
-    if (raw_args != NULL)
-    {
-        call_expr->syntax.fn_call.args = raw_args;
-        return 1;
-    }
-
-    return 0;
-}
-
-int clear_mem_call(Expression *call_expr)
+Expression *create_unary(Arena *arena, OpType op, Expression *expr)
 {
-    size_t target_count = call_expr->syntax.fn_call.argc;
-    Expression **args_cursor = call_expr->syntax.fn_call.args;
-    Expression *target = NULL;
-
-    if (!args_cursor)
-        return 0;
-
-    for (size_t i = 0; i < target_count; i++)
-    {
-        target = *args_cursor;
-
-        if (target != NULL)
-        {
-            destroy_expr(target);
-            free(target);
-            target = NULL;
-        }
-
-        args_cursor++;
-    }
-
-    free(call_expr->syntax.fn_call.args);
-    call_expr->syntax.fn_call.func_name = NULL;
-
-    return 1;
-}
-
-Expression *create_unary(OpType op, Expression *expr)
-{
-    Expression *unary_expr = malloc(sizeof(Expression));
+    Expression *unary_expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (unary_expr != NULL)
     {
@@ -199,14 +172,15 @@ Expression *create_unary(OpType op, Expression *expr)
     return unary_expr;
 }
 
-Expression *create_binary(OpType op, Expression *left, Expression *right)
+Expression *create_binary(Arena *arena, OpType op, Expression *left, Expression *right)
 {
-    Expression *expr = malloc(sizeof(Expression));
+    Expression *expr = arena_alloc_node(arena, sizeof(Expression));
 
     if (expr != NULL)
     {
         expr->type = BINARY_OP;
         expr->syntax.binary_op.op = op;
+        expr->syntax.binary_op.operand_type = NONE_TYPE;
         expr->syntax.binary_op.left = left;
         expr->syntax.binary_op.right = right;
     }
@@ -214,69 +188,17 @@ Expression *create_binary(OpType op, Expression *left, Expression *right)
     return expr;
 }
 
-void destroy_expr(Expression *expr)
-{
-    if (expr->type == STR_LITERAL)
-    {
-        expr->syntax.str_literal.str_obj = NULL;
-    }
-    else if (expr->type == LIST_LITERAL)
-    {
-        expr->syntax.list_literal.list_obj = NULL;
-    }
-    else if (expr->type == VAR_USAGE)
-    {
-        expr->syntax.variable.var_name = NULL;
-    }
-    else if (expr->type == FUNC_CALL)
-    {
-        Expression **cursor = expr->syntax.fn_call.args;
-        Expression *temp = NULL;
-        size_t target_count = expr->syntax.fn_call.argc;
-
-        for (size_t i = 0; i < target_count; i++)
-        {
-            temp = *cursor;
-
-            if (temp != NULL)
-            {
-                destroy_expr(temp);
-                temp = NULL;
-            }
 
-            cursor++;
-        }
-
-        free(cursor);
-        expr->syntax.fn_call.args = NULL;
-
-        // NOTE: free func name since only its hash is needed for running.
-        free(expr->syntax.fn_call.func_name);
-        expr->syntax.fn_call.func_name = NULL;
-    }
-    else if (expr->type == UNARY_OP)
-    {
-        destroy_expr(expr->syntax.unary_op.expr);
-    }
-    else if (expr->type == BINARY_OP)
-    {
-        destroy_expr(expr->syntax.binary_op.left);
-        destroy_expr(expr->syntax.binary_op.right);
-    }
-}
-
-/// SECTION: Statement funcs
-
-Statement *create_block_stmt()
+Statement *create_block_stmt(Arena *arena)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
         stmt->type = BLOCK_STMT;
         stmt->syntax.block.capacity = 4;
         stmt->syntax.block.count = 0;
-        stmt->syntax.block.stmts = malloc(sizeof(Statement *) * 4);
+        stmt->syntax.block.stmts = arena_alloc(arena, sizeof(Statement *) * 4);
 
         if (!stmt->syntax.block.stmts) stmt->syntax.block.capacity = 0; // NOTE: do not resize invalid vector memory.
     }
@@ -284,29 +206,26 @@ Statement *create_block_stmt()
     return stmt;
 }
 
-int grow_block_stmt(Statement *block_stmt, Statement *new_stmt)
+int grow_block_stmt(Arena *arena, Statement *block_stmt, Statement *new_stmt)
 {
     if (!new_stmt)
         return 0;
 
     size_t next_spot = block_stmt->syntax.block.count;
     size_t old_capacity = block_stmt->syntax.block.capacity;
-    size_t new_capacity = old_capacity << 1;
+    size_t new_capacity = (old_capacity > 0) ? old_capacity << 1 : 4;
 
-    if (next_spot <= old_capacity - 1)
+    if (next_spot < old_capacity)
     {
         block_stmt->syntax.block.stmts[next_spot] = new_stmt;
         block_stmt->syntax.block.count++;
         return 1;
     }
 
-    Statement **raw_block = realloc(block_stmt->syntax.block.stmts, sizeof(Statement *) * new_capacity);
+    Statement **raw_block = ast_grow_ptrs(arena, block_stmt->syntax.block.stmts, next_spot, new_capacity);
 
     if (raw_block != NULL)
     {
-        for (size_t i = next_spot; i < new_capacity; i++)
-            raw_block[i] = NULL;
-        
         raw_block[next_spot] = new_stmt;
         block_stmt->syntax.block.stmts = raw_block;
         block_stmt->syntax.block.count++;
@@ -318,53 +237,9 @@ int grow_block_stmt(Statement *block_stmt, Statement *new_stmt)
     return 0;
 }
 
-int pack_block_stmt(Statement *block_stmt)
-{
-    size_t curr_capacity = block_stmt->syntax.block.capacity;
-    size_t curr_count = block_stmt->syntax.block.count;
-
-    if (curr_capacity <= curr_count) return 1;
-
-    Statement **raw_block = realloc(block_stmt->syntax.block.stmts, sizeof(Statement *) * curr_count);
-
-    if (raw_block != NULL)
-    {
-        block_stmt->syntax.block.stmts = raw_block;
-        return 1;
-    }
-
-    return 0;
-}
-
-int clear_block_stmt(Statement *block_stmt)
-{
-    size_t target_count = block_stmt->syntax.block.count;
-    Statement **raw_block = block_stmt->syntax.block.stmts;  // cursor for array of Statment ptrs.
-    Statement *target = NULL;
-
-    if (!raw_block)
-        return 0;
-
-    for (size_t i = 0; i < target_count; i++)
-    {
-        target = *raw_block;
-
-        if (target != NULL)
-        {
-            destroy_stmt(target);
-            free(target);
-            target = NULL;
-        }
-
-        raw_block++;
-    }
-
-    return 1;
-}
-
-Statement *create_module_def(char *name)
+Statement *create_module_def(Arena *arena, char *name)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
@@ -375,9 +250,9 @@ Statement *create_module_def(char *name)
     return stmt;
 }
 
-Statement *create_module_usage(char *name)
+Statement *create_module_usage(Arena *arena, char *name)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
@@ -388,14 +263,16 @@ Statement *create_module_usage(char *name)
     return stmt;
 }
 
-Statement *create_var_decl(int is_const, char *var_name, Expression *rvalue)
+Statement *create_var_decl(Arena *arena, int is_const, char *var_name, Expression *rvalue)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
         stmt->type = VAR_DECL;
         stmt->syntax.var_decl.is_const = is_const;
+        stmt->syntax.var_decl.slot = 0;
+        stmt->syntax.var_decl.value_type = NONE_TYPE;
         stmt->syntax.var_decl.var_name = var_name;
         stmt->syntax.var_decl.rvalue = rvalue;
     }
@@ -403,13 +280,15 @@ Statement *create_var_decl(int is_const, char *var_name, Expression *rvalue)
     return stmt;
 }
 
-Statement *create_var_assign(char *var_name, Expression *rvalue)
+Statement *create_var_assign(Arena *arena, char *var_name, Expression *rvalue)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
         stmt->type = VAR_ASSIGN;
+        stmt->syntax.var_assign.depth = 0;
+        stmt->syntax.var_assign.slot = 0;
         stmt->syntax.var_assign.var_name = var_name;
         stmt->syntax.var_assign.rvalue = rvalue;
     }
@@ -417,9 +296,9 @@ Statement *create_var_assign(char *var_name, Expression *rvalue)
     return stmt;
 }
 
-Statement *create_func_stmt(char *fn_name, Statement *block)
+Statement *create_func_stmt(Arena *arena, char *fn_name, Statement *block)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
@@ -427,7 +306,8 @@ Statement *create_func_stmt(char *fn_name, Statement *block)
         stmt->syntax.func_decl.func_name = fn_name;
         stmt->syntax.func_decl.argc = 0;
         stmt->syntax.func_decl.cap = 4;
-        stmt->syntax.func_decl.func_params = malloc(sizeof(Expression *) * 4);
+        stmt->syntax.func_decl.frame_size = 0;
+        stmt->syntax.func_decl.func_params = arena_alloc(arena, sizeof(Expression *) * 4);
         stmt->syntax.func_decl.stmts = block;
 
         if (!stmt->syntax.func_decl.func_params)
@@ -437,29 +317,26 @@ Statement *create_func_stmt(char *fn_name, Statement *block)
     return stmt;
 }
 
-int put_arg_func_stmt(Statement *fn_decl, Expression *arg_expr)
+int put_arg_func_stmt(Arena *arena, Statement *fn_decl, Expression *arg_expr)
 {
     size_t next_spot = fn_decl->syntax.func_decl.argc;
     size_t old_capacity = fn_decl->syntax.func_decl.cap;
-    size_t new_capacity = old_capacity << 1;
+    size_t new_capacity = (old_capacity > 0) ? old_capacity << 1 : 4;
 
-    if (next_spot <= old_capacity - 1)
+    if (next_spot < old_capacity)
     {
         fn_decl->syntax.func_decl.func_params[next_spot] = arg_expr;
         fn_decl->syntax.func_decl.argc++;
         return 1;
     }
 
-    Expression **raw_params = realloc(fn_decl->syntax.func_decl.func_params, sizeof(Expression *) * new_capacity);
+    Expression **raw_params = ast_grow_ptrs(arena, fn_decl->syntax.func_decl.func_params, next_spot, new_capacity);
 
     if (raw_params != NULL)
     {
-        for (size_t i = next_spot; i < new_capacity; i++)
-            raw_params[i] = NULL;
-
-        fn_decl->syntax.func_decl.func_params[next_spot] = arg_expr;
-        fn_decl->syntax.func_decl.argc++;
+        raw_params[next_spot] = arg_expr;
         fn_decl->syntax.func_decl.func_params = raw_params;
+        fn_decl->syntax.func_decl.argc++;
         fn_decl->syntax.func_decl.cap = new_capacity;
 
         return 1;
@@ -468,52 +345,9 @@ int put_arg_func_stmt(Statement *fn_decl, Expression *arg_expr)
     return 0;
 }
 
-int pack_args_func_stmt(Statement *fn_decl)
-{
-    size_t curr_capacity = fn_decl->syntax.func_decl.cap;
-    size_t curr_count = fn_decl->syntax.func_decl.argc;
-
-    if (curr_capacity <= curr_count) return 1;
-
-    Expression **raw_args = realloc(fn_decl->syntax.func_decl.func_params, sizeof(Expression *) * curr_count);
-
-    if (raw_args != NULL)
-    {
-        fn_decl->syntax.func_decl.func_params = raw_args;
-        return 1;
-    }
-
-    return 0;
-}
-
-void clear_func_stmt(Statement *fn_decl)
-{
-    // 1. Free memory for argument objects.
-    Expression **args_cursor = fn_decl->syntax.func_decl.func_params;
-    Expression *target = NULL;
-    size_t arg_count = fn_decl->syntax.func_decl.argc;
-
-    for (size_t i = 0; i < arg_count; i++)
-    {
-        target = *args_cursor;
-
-        if (target != NULL)
-        {
-            destroy_expr(target);
-            free(target);
-            target = NULL;
-        }
-
-        args_cursor++;
-    }
-
-    // 2. Free memory for statement objects.
-    destroy_stmt(fn_decl->syntax.func_decl.stmts);
-}
-
-Statement *create_while_stmt(Expression *conditional, Statement *block)
+Statement *create_while_stmt(Arena *arena, Expression *conditional, Statement *block)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
@@ -525,9 +359,9 @@ Statement *create_while_stmt(Expression *conditional, Statement *block)
     return stmt;
 }
 
-Statement *create_if_stmt(Expression *conditional, Statement *first, Statement *other)
+Statement *create_if_stmt(Arena *arena, Expression *conditional, Statement *first, Statement *other)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
@@ -540,9 +374,9 @@ Statement *create_if_stmt(Expression *conditional, Statement *first, Statement *
     return stmt;
 }
 
-Statement *create_otherwise_stmt(Statement *block)
+Statement *create_otherwise_stmt(Arena *arena, Statement *block)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
@@ -553,9 +387,9 @@ Statement *create_otherwise_stmt(Statement *block)
     return stmt;
 }
 
-Statement *create_break_stmt(int depth)
+Statement *create_break_stmt(Arena *arena, int depth)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
@@ -566,22 +400,23 @@ Statement *create_break_stmt(int depth)
     return stmt;
 }
 
-Statement *create_return_stmt(Expression *result)
+Statement *create_return_stmt(Arena *arena, Expression *result)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
         stmt->type = RETURN_STMT;
+        stmt->syntax.return_stmt.is_tail_call = 0;
         stmt->syntax.return_stmt.result = result;
     }
 
     return stmt;
 }
 
-Statement *create_expr_stmt(Expression *expr)
+Statement *create_expr_stmt(Arena *arena, Expression *expr)
 {
-    Statement *stmt = malloc(sizeof(Statement));
+    Statement *stmt = arena_alloc_node(arena, sizeof(Statement));
 
     if (stmt != NULL)
     {
@@ -592,115 +427,215 @@ Statement *create_expr_stmt(Expression *expr)
     return stmt;
 }
 
-/// TODO: add extra checks for null ptrs.
-void destroy_stmt(Statement *stmt)
-{
-    if (stmt->type == BLOCK_STMT)
-    {
-        clear_block_stmt(stmt);
-    }
-    else if (stmt->type == FUNC_DECL)
-    {
-        clear_block_stmt(stmt->syntax.func_decl.stmts);
-        stmt->syntax.func_decl.func_name = NULL;
-    }
-    else if (stmt->type == VAR_DECL)
-    {
-        destroy_expr(stmt->syntax.var_decl.rvalue);
-        stmt->syntax.var_decl.var_name = NULL;
-    }
-    else if (stmt->type == VAR_ASSIGN)
-    {
-        destroy_expr(stmt->syntax.var_assign.rvalue);
-        stmt->syntax.var_assign.var_name = NULL;
-    }
-    else if (stmt->type == WHILE_STMT)
-    {
-        destroy_expr(stmt->syntax.while_stmt.condition);
-        clear_block_stmt(stmt->syntax.while_stmt.stmts);
-    }
-    else if (stmt->type == IF_STMT)
-    {
-        destroy_expr(stmt->syntax.if_stmt.condition);
-        clear_block_stmt(stmt->syntax.if_stmt.first);
-        clear_block_stmt(stmt->syntax.if_stmt.other);
-    }
-    else if (stmt->type == OTHERWISE_STMT)
-    {
-        clear_block_stmt(stmt->syntax.otherwise_stmt.stmts);
-    }
-    else if (stmt->type == RETURN_STMT)
-    {
-        destroy_expr(stmt->syntax.return_stmt.result);
-    }
-}
-
 /// SECTION: Script
 
 void init_script(Script *script, const char *name, unsigned int old_count)
 {
+    arena_init(&script->arena, ARENA_CHUNK_SZ);
+
     script->name = name;
     script->count = 0;  // "highest" last slot index before capacity
+    script->global_count = 0;
     script->capacity = old_count;
-    script->stmts = malloc(sizeof(Statement*) * old_count);
+    script->stmts = arena_alloc(&script->arena, sizeof(Statement*) * old_count);
 
     if (!script->stmts) script->capacity = 0; // NOTE: do not resize invalid vector memory.
-
-    for (size_t i = 0; i < script->count; i++)
-        script->stmts[i] = NULL;
 }
 
-void grow_script(Script *script, Statement *stmt_obj)
+int grow_script(Script *script, Statement *stmt_obj)
 {
     size_t next_slot = script->count;
     size_t old_capacity = script->capacity;
-    size_t new_capacity = old_capacity << 1;
+    size_t new_capacity = (old_capacity > 0) ? old_capacity << 1 : 4;
 
-    if (next_slot < old_capacity - 1)
+    if (next_slot < old_capacity)
     {
         script->stmts[next_slot] = stmt_obj;
         script->count++;
-        return;
+        return 1;
     }
 
-    Statement **raw_block = realloc(script->stmts, sizeof(Statement *) * new_capacity);
+    Statement **raw_block = ast_grow_ptrs(&script->arena, script->stmts, next_slot, new_capacity);
 
-    if (raw_block != NULL)
-    {
-        for (size_t i = next_slot; i < new_capacity; i++)
-            raw_block[i] = NULL;
+    if (!raw_block) return 0;
 
-        raw_block[next_slot] = stmt_obj;
-        script->stmts = raw_block;
+    raw_block[next_slot] = stmt_obj;
+    script->stmts = raw_block;
+    script->count++;
+    script->capacity = new_capacity;
 
-        script->count++;
-        script->capacity = new_capacity;
-    }
+    return 1;
 }
 
 void dispose_script(Script *script)
 {
     if (!script)
         return;
-    
-    size_t stmt_count = script->count;
-    Statement *target = NULL;
-    Statement **cursor = script->stmts;
 
-    for (size_t i = 0; i < stmt_count; i++)
+    // NOTE: all nodes, vectors, and lexemes are in the arena, so they go in one call.
+    arena_dispose(&script->arena);
+
+    script->stmts = NULL;
+    script->count = 0;
+    script->capacity = 0;
+
+    // NOTE: unbind script file name since it's a static c-string passed by argv!
+    script->name = NULL;
+}
+
+/// SECTION: Printing
+
+static const char *op_names[] = {"and", "or", "==", "!=", ">", ">=", "<", "<=", "+", "-", "*", "/", "-", "[]"};
+
+static void print_expr(const Expression *expr)
+{
+    switch (expr->type)
+    {
+    case BOOL_LITERAL:
+        printf("%s", (expr->syntax.bool_literal.flag) ? "$T" : "$F");
+        break;
+    case INT_LITERAL:
+        printf("%i", expr->syntax.int_literal.value);
+        break;
+    case REAL_LITERAL:
+        printf("%f", expr->syntax.real_literal.value);
+        break;
+    case STR_LITERAL:
+        printf("\"%s\"", expr->syntax.str_literal.str_obj->source);
+        break;
+    case LIST_LITERAL:
+        printf("[list of %zu]", expr->syntax.list_literal.list_obj->count);
+        break;
+    case VAR_USAGE:
+        printf("%s", expr->syntax.variable.var_name);
+        break;
+    case FUNC_CALL:
+        printf("(%s", expr->syntax.fn_call.func_name);
+
+        for (unsigned int i = 0; i < expr->syntax.fn_call.argc; i++)
+        {
+            putchar(' ');
+            print_expr(expr->syntax.fn_call.args[i]);
+        }
+
+        putchar(')');
+        break;
+    case UNARY_OP:
+        printf("(%s ", op_names[expr->syntax.unary_op.op]);
+        print_expr(expr->syntax.unary_op.expr);
+        putchar(')');
+        break;
+    case BINARY_OP:
+        // NOTE: ops the typer specialized are marked with their operand type.
+        if (expr->syntax.binary_op.operand_type == INT_TYPE) printf("(%s:int ", op_names[expr->syntax.binary_op.op]);
+        else if (expr->syntax.binary_op.operand_type == REAL_TYPE) printf("(%s:real ", op_names[expr->syntax.binary_op.op]);
+        else printf("(%s ", op_names[expr->syntax.binary_op.op]);
+        print_expr(expr->syntax.binary_op.left);
+        putchar(' ');
+        print_expr(expr->syntax.binary_op.right);
+        putchar(')');
+        break;
+    default:
+        printf("(?)");
+        break;
+    }
+}
+
+static void print_stmt(const Statement *stmt, int indent);
+
+static void print_block(const Statement *stmt, int indent)
+{
+    if (!stmt) return;
+
+    if (stmt->type != BLOCK_STMT)
     {
-        target = *cursor;
+        print_stmt(stmt, indent);
+        return;
+    }
 
-        if (target != NULL)
+    for (unsigned int i = 0; i < stmt->syntax.block.count; i++) print_stmt(stmt->syntax.block.stmts[i], indent);
+}
+
+static void print_stmt(const Statement *stmt, int indent)
+{
+    if (!stmt) return;
+
+    printf("%*s", indent * 2, "");
+
+    switch (stmt->type)
+    {
+    case MODULE_DEF:
+        printf("module %s\n", stmt->syntax.module_def.module_name);
+        break;
+    case MODULE_USE:
+        printf("use %s\n", stmt->syntax.module_usage.module_name);
+        break;
+    case EXPR_STMT:
+        print_expr(stmt->syntax.expr_stmt.expr);
+        putchar('\n');
+        break;
+    case VAR_DECL:
+        printf("%s %s = ", (stmt->syntax.var_decl.is_const) ? "const" : "let", stmt->syntax.var_decl.var_name);
+        print_expr(stmt->syntax.var_decl.rvalue);
+        putchar('\n');
+        break;
+    case VAR_ASSIGN:
+        printf("set %s = ", stmt->syntax.var_assign.var_name);
+        print_expr(stmt->syntax.var_assign.rvalue);
+        putchar('\n');
+        break;
+    case BLOCK_STMT:
+        puts("block");
+        print_block(stmt, indent + 1);
+        break;
+    case FUNC_DECL:
+        printf("proc %s(", stmt->syntax.func_decl.func_name);
+
+        for (unsigned int i = 0; i < stmt->syntax.func_decl.argc; i++)
         {
-            destroy_stmt(target);
-            free(target);
-            target = NULL;
+            if (i > 0) printf(", ");
+
+            print_expr(stmt->syntax.func_decl.func_params[i]);
         }
 
-        cursor++;
+        puts(")");
+        print_block(stmt->syntax.func_decl.stmts, indent + 1);
+        break;
+    case WHILE_STMT:
+        printf("while ");
+        print_expr(stmt->syntax.while_stmt.condition);
+        putchar('\n');
+        print_block(stmt->syntax.while_stmt.stmts, indent + 1);
+        break;
+    case IF_STMT:
+        printf("if ");
+        print_expr(stmt->syntax.if_stmt.condition);
+        putchar('\n');
+        print_block(stmt->syntax.if_stmt.first, indent + 1);
+
+        if (stmt->syntax.if_stmt.other != NULL)
+        {
+            printf("%*sotherwise\n", indent * 2, "");
+            print_block(stmt->syntax.if_stmt.other->syntax.otherwise_stmt.stmts, indent + 1);
+        }
+        break;
+    case BREAK_STMT:
+        puts("break");
+        break;
+    case RETURN_STMT:
+        printf((stmt->syntax.return_stmt.is_tail_call) ? "return tail " : "return ");
+        print_expr(stmt->syntax.return_stmt.result);
+        putchar('\n');
+        break;
+    default:
+        puts("(?)");
+        break;
     }
+}
 
-    // NOTE: unbind script file name since it's a static c-string passed by argv!
-    script->name = NULL;
+void print_script(const Script *script)
+{
+    printf("script \"%s\" (%u stmts):\n", script->name, script->count);
+
+    for (unsigned int i = 0; i < script->count; i++) print_stmt(script->stmts[i], 1);
 }
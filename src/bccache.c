@@ -0,0 +1,675 @@
+/**
+ * @file bccache.c
+ * @author Derek Tan
+ * @brief Implements saving and mapping precompiled script images.
+ * @date 2023-08-23
+ */
+
+#define _DEFAULT_SOURCE // mmap under -std=c11
+
+#include <stdio.h>
+#include "backend/compiler/bccache.h"
+#include "backend/values/heap.h"
+#include "utils/hashing.h"
+#include "utils/intern.h"
+
+#ifdef BCCACHE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// SECTION: Image writer
+
+typedef struct st_bccache_buffer
+{
+    size_t count; // in bytes
+    size_t capacity;
+    unsigned char *bytes;
+} BcCacheBuffer;
+
+typedef struct st_bccache_writer
+{
+    BcCacheBuffer sections[BCCACHE_SECTION_COUNT];
+    BcCacheBuffer list_keys; // ListObj pointers of the saved lists, by list index
+    int failed;
+} BcCacheWriter;
+
+static void bccache_put(BcCacheWriter *writer, BcCacheBuffer *buffer, const void *data, size_t size)
+{
+    size_t new_capacity = (buffer->capacity > 0) ? buffer->capacity : BCCACHE_BUFFER_MIN_SZ;
+    unsigned char *temp_bytes = NULL;
+
+    if (writer->failed || size == 0) return;
+
+    while (new_capacity < buffer->count + size) new_capacity <<= 1;
+
+    if (new_capacity != buffer->capacity)
+    {
+        temp_bytes = realloc(buffer->bytes, new_capacity);
+
+        if (!temp_bytes)
+        {
+            writer->failed = 1;
+            return;
+        }
+
+        buffer->bytes = temp_bytes;
+        buffer->capacity = new_capacity;
+    }
+
+    memcpy(buffer->bytes + buffer->count, data, size);
+    buffer->count += size;
+}
+
+static BcCacheText bccache_put_text(BcCacheWriter *writer, const char *text, size_t length)
+{
+    BcCacheBuffer *buffer = writer->sections + BCCACHE_TEXT;
+    BcCacheText entry = {.offset = (uint32_t)buffer->count, .length = (uint32_t)length};
+
+    // NOTE: offsets are 32-bit, so a bigger image is never saved.
+    if (buffer->count + length + 1 >= UINT32_MAX) writer->failed = 1;
+
+    bccache_put(writer, buffer, text, length);
+    bccache_put(writer, buffer, "", 1);
+
+    return entry;
+}
+
+static uint32_t bccache_put_list(BcCacheWriter *writer, const ListObj *list);
+
+static BcCacheValue bccache_value_of(BcCacheWriter *writer, const VarValue *value)
+{
+    BcCacheValue record = {.type = (uint8_t)value->type, .is_const = (uint8_t)(value->is_const != 0), .padding = 0, .bits = 0};
+    const StringObj *str_obj = NULL;
+    BcCacheText text;
+
+    switch (value->type)
+    {
+    case BOOL_TYPE:
+        record.bits = (uint32_t)(value->data.bool_val.flag != 0);
+        break;
+    case INT_TYPE:
+        memcpy(&record.bits, &value->data.int_val.value, sizeof(record.bits));
+        break;
+    case REAL_TYPE:
+        memcpy(&record.bits, &value->data.real_val.value, sizeof(record.bits));
+        break;
+    case STR_TYPE:
+        // NOTE: literal strings are never changed in place, so equal ones may be saved twice without a difference.
+        str_obj = value->data.str_type.value;
+        text = bccache_put_text(writer, str_obj->source, str_obj->length);
+        record.bits = (uint32_t)(writer->sections[BCCACHE_STRINGS].count / sizeof(BcCacheText));
+        bccache_put(writer, writer->sections + BCCACHE_STRINGS, &text, sizeof(BcCacheText));
+        break;
+    case LIST_TYPE:
+        record.bits = bccache_put_list(writer, value->data.list_type.value);
+        break;
+    default:
+        break;
+    }
+
+    return record;
+}
+
+static uint32_t bccache_put_list(BcCacheWriter *writer, const ListObj *list)
+{
+    const ListObj **saved_lists = (const ListObj **)writer->list_keys.bytes;
+    size_t saved_count = writer->list_keys.count / sizeof(const ListObj *);
+    BcCacheValue *items = NULL;
+    BcCacheList record;
+    VarValue item;
+
+    // NOTE: folded constants may share one list, and must still share it after loading.
+    for (size_t i = 0; i < saved_count; i++)
+    {
+        if (saved_lists[i] == list) return (uint32_t)i;
+    }
+
+    items = malloc(sizeof(BcCacheValue) * ((list->count > 0) ? list->count : 1));
+
+    if (!items)
+    {
+        writer->failed = 1;
+        return 0;
+    }
+
+    // NOTE: nested lists are saved before this one, so the loader always makes them first.
+    for (size_t i = 0; i < list->count; i++)
+    {
+        get_at_list_obj(list, i, &item);
+        items[i] = bccache_value_of(writer, &item);
+    }
+
+    record.item_start = (uint32_t)(writer->sections[BCCACHE_ITEMS].count / sizeof(BcCacheValue));
+    record.item_count = (uint32_t)list->count;
+    bccache_put(writer, writer->sections + BCCACHE_ITEMS, items, sizeof(BcCacheValue) * list->count);
+    free(items);
+
+    bccache_put(writer, &writer->list_keys, &list, sizeof(const ListObj *));
+    bccache_put(writer, writer->sections + BCCACHE_LISTS, &record, sizeof(BcCacheList));
+
+    return (uint32_t)(writer->sections[BCCACHE_LISTS].count / sizeof(BcCacheList) - 1);
+}
+
+static void bccache_put_proc(BcCacheWriter *writer, const BcProc *proc)
+{
+    BcCacheProc record = {
+        .name = {.offset = BCCACHE_NO_NAME, .length = 0},
+        .code_start = (uint32_t)(writer->sections[BCCACHE_CODE].count / sizeof(BcInstr)),
+        .code_count = proc->count,
+        .arity = proc->arity,
+        .reg_count = proc->reg_count,
+        .padding = 0
+    };
+
+    if (proc->name != NULL) record.name = bccache_put_text(writer, proc->name, strlen(proc->name));
+
+    bccache_put(writer, writer->sections + BCCACHE_CODE, proc->code, sizeof(BcInstr) * proc->count);
+    bccache_put(writer, writer->sections + BCCACHE_PROCS, &record, sizeof(BcCacheProc));
+}
+
+static int bccache_in_special_tree(const char *path)
+{
+    return strcmp(path, "/dev") == 0 || strcmp(path, "/proc") == 0 || strncmp(path, "/dev/", 5) == 0 || strncmp(path, "/proc/", 6) == 0;
+}
+
+/**
+ * @brief Checks if a source sits in /dev or /proc, where its cache would go. e.g. /dev/stdin redirected from a file is regular, so load_source alone lets it through.
+ * @note The source's directory is resolved instead of the source, since links like /dev/stdin resolve to the redirected file.
+ */
+static int bccache_is_special_path(const char *source_path)
+{
+#ifdef BCCACHE_MMAP
+    char dir_path[BCCACHE_PATH_MAX];
+    const char *last_slash = strrchr(source_path, '/');
+    size_t dir_len = (last_slash != NULL) ? (size_t)(last_slash - source_path) : 0;
+    char *real_dir = NULL;
+    int is_special = bccache_in_special_tree(source_path);
+
+    if (is_special || dir_len >= sizeof(dir_path)) return is_special;
+
+    if (!last_slash) strcpy(dir_path, ".");
+    else if (dir_len == 0) strcpy(dir_path, "/");
+    else snprintf(dir_path, sizeof(dir_path), "%.*s", (int)dir_len, source_path);
+
+    real_dir = realpath(dir_path, NULL);
+
+    if (real_dir != NULL)
+    {
+        is_special = bccache_in_special_tree(real_dir);
+        free(real_dir);
+    }
+
+    return is_special;
+#else
+    return bccache_in_special_tree(source_path);
+#endif
+}
+
+int bccache_path_for(const char *source_path, char *path, size_t path_size)
+{
+    size_t path_len = strlen(source_path);
+    size_t ext_len = strlen(BCCACHE_SOURCE_EXT);
+    int written = 0;
+
+    // NOTE: no cache goes next to devices or proc files, since those trees are not the script's home.
+    if (bccache_is_special_path(source_path)) return 0;
+
+    if (path_len >= ext_len && strcmp(source_path + path_len - ext_len, BCCACHE_SOURCE_EXT) == 0)
+        written = snprintf(path, path_size, "%.*s%s", (int)(path_len - ext_len), source_path, BCCACHE_EXT);
+    else
+        written = snprintf(path, path_size, "%s%s", source_path, BCCACHE_EXT);
+
+    return written > 0 && (size_t)written < path_size;
+}
+
+/**
+ * @brief Opens a new temp file next to the cache, writing its path into temp_path.
+ */
+static FILE *bccache_open_temp(const char *cache_path, char *temp_path, size_t temp_size)
+{
+#ifdef BCCACHE_MMAP
+    FILE *fwriter = NULL;
+    int fd = -1;
+
+    if (snprintf(temp_path, temp_size, "%s.XXXXXX", cache_path) >= (int)temp_size) return NULL;
+
+    // NOTE: each run gets its own temp file, so runs saving at once never write into the same image.
+    fd = mkstemp(temp_path);
+
+    if (fd < 0) return NULL;
+
+    // mkstemp makes owner only files, but the cache is as readable as one fopen would make.
+    fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    fwriter = fdopen(fd, "wb");
+
+    if (!fwriter)
+    {
+        close(fd);
+        remove(temp_path);
+    }
+
+    return fwriter;
+#else
+    if (snprintf(temp_path, temp_size, "%s.tmp", cache_path) >= (int)temp_size) return NULL;
+
+    return fopen(temp_path, "wb");
+#endif
+}
+
+int bccache_save(const BcProgram *program, const char *cache_path, uint64_t source_hash, unsigned short global_count, unsigned int stmt_count)
+{
+    static const unsigned char padding[BCCACHE_ALIGN] = {0};
+    char temp_path[BCCACHE_PATH_MAX + 8];
+    BcCacheWriter writer;
+    BcCacheBuffer payload = {.count = 0, .capacity = 0, .bytes = NULL};
+    BcCacheBuffer *section = NULL;
+    BcCacheHeader header;
+    BcCacheValue value;
+    BcCacheText name;
+    FILE *fwriter = NULL;
+    int save_ok = 0;
+
+    memset(&writer, 0, sizeof(BcCacheWriter));
+    memset(&header, 0, sizeof(BcCacheHeader));
+
+    for (unsigned int i = 0; i < program->proc_count; i++) bccache_put_proc(&writer, program->procs[i]);
+
+    for (unsigned int i = 0; i < program->const_count; i++)
+    {
+        value = bccache_value_of(&writer, program->consts + i);
+        bccache_put(&writer, writer.sections + BCCACHE_CONSTS, &value, sizeof(BcCacheValue));
+    }
+
+    for (unsigned int i = 0; i < program->name_count; i++)
+    {
+        name = bccache_put_text(&writer, program->names[i], strlen(program->names[i]));
+        bccache_put(&writer, writer.sections + BCCACHE_NAMES, &name, sizeof(BcCacheText));
+    }
+
+    memcpy(header.magic, BCCACHE_MAGIC, sizeof(BCCACHE_MAGIC));
+    header.version = BCCACHE_VERSION;
+    header.instr_size = sizeof(BcInstr);
+    header.source_hash = source_hash;
+    header.global_count = global_count;
+    header.stmt_count = stmt_count;
+
+    // NOTE: padded sections keep every record aligned in the mapping.
+    for (int i = 0; i < BCCACHE_SECTION_COUNT; i++)
+    {
+        section = writer.sections + i;
+        bccache_put(&writer, section, padding, (BCCACHE_ALIGN - section->count % BCCACHE_ALIGN) % BCCACHE_ALIGN);
+        bccache_put(&writer, &payload, section->bytes, section->count);
+        header.section_sizes[i] = (uint32_t)section->count;
+
+        if (section->count >= UINT32_MAX) writer.failed = 1;
+    }
+
+    header.image_size = sizeof(BcCacheHeader) + payload.count;
+    header.checksum = hash_key_n((const char *)payload.bytes, payload.count);
+
+    if (!writer.failed) fwriter = bccache_open_temp(cache_path, temp_path, sizeof(temp_path));
+
+    if (fwriter != NULL)
+    {
+        save_ok = fwrite(&header, sizeof(BcCacheHeader), 1, fwriter) == 1 && fwrite(payload.bytes, 1, payload.count, fwriter) == payload.count;
+        save_ok = (fclose(fwriter) == 0) && save_ok;
+        save_ok = save_ok && rename(temp_path, cache_path) == 0;
+
+        if (!save_ok) remove(temp_path);
+    }
+
+    for (int i = 0; i < BCCACHE_SECTION_COUNT; i++) free(writer.sections[i].bytes);
+
+    free(writer.list_keys.bytes);
+    free(payload.bytes);
+
+    return save_ok;
+}
+
+/// SECTION: Image reader
+
+/**
+ * @brief Sections of a mapped image with their record counts, plus the lists made from it so far.
+ */
+typedef struct st_bccache_reader
+{
+    const BcCacheProc *procs;
+    size_t proc_count;
+    const BcInstr *code;
+    size_t code_count;
+    const BcCacheValue *consts;
+    size_t const_count;
+    const BcCacheList *lists;
+    size_t list_count;
+    const BcCacheValue *items;
+    size_t item_count;
+    const BcCacheText *strings;
+    size_t string_count;
+    const BcCacheText *names;
+    size_t name_count;
+    const char *text;
+    size_t text_size;
+    ListObj **list_objs;
+} BcCacheReader;
+
+static void *bccache_map(const char *cache_path, size_t *image_size)
+{
+#ifdef BCCACHE_MMAP
+    struct stat file_info;
+    void *image = NULL;
+    int fd = open(cache_path, O_RDONLY);
+
+    if (fd < 0) return NULL;
+
+    if (fstat(fd, &file_info) != 0 || file_info.st_size < (off_t)sizeof(BcCacheHeader))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    // NOTE: the mapping stays valid after closing, and private pages never write back to the cache.
+    image = mmap(NULL, (size_t)file_info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (image == MAP_FAILED) return NULL;
+
+    *image_size = (size_t)file_info.st_size;
+
+    return image;
+#else
+    FILE *freader = fopen(cache_path, "rb");
+    long file_len = 0;
+    void *image = NULL;
+
+    if (!freader) return NULL;
+
+    fseek(freader, 0, SEEK_END);
+    file_len = ftell(freader);
+    fseek(freader, 0, SEEK_SET);
+
+    if (file_len >= (long)sizeof(BcCacheHeader)) image = malloc((size_t)file_len);
+
+    if (image != NULL && fread(image, 1, (size_t)file_len, freader) != (size_t)file_len)
+    {
+        free(image);
+        image = NULL;
+    }
+
+    fclose(freader);
+    *image_size = (size_t)file_len;
+
+    return image;
+#endif
+}
+
+static void bccache_unmap(void *image, size_t image_size)
+{
+#ifdef BCCACHE_MMAP
+    munmap(image, image_size);
+#else
+    (void)image_size;
+    free(image);
+#endif
+}
+
+/**
+ * @brief Checks an image against this build and the source's hash, then finds its sections.
+ */
+static int bccache_check(BcCacheReader *reader, const unsigned char *image, size_t image_size, uint64_t source_hash)
+{
+    const BcCacheHeader *header = (const BcCacheHeader *)image;
+    const unsigned char *sections[BCCACHE_SECTION_COUNT];
+    size_t offset = sizeof(BcCacheHeader);
+
+    if (memcmp(header->magic, BCCACHE_MAGIC, sizeof(BCCACHE_MAGIC)) != 0 || header->version != BCCACHE_VERSION || header->instr_size != sizeof(BcInstr)) return 0;
+
+    if (header->source_hash != source_hash || header->image_size != image_size) return 0;
+
+    for (int i = 0; i < BCCACHE_SECTION_COUNT; i++)
+    {
+        if (header->section_sizes[i] % BCCACHE_ALIGN != 0 || header->section_sizes[i] > image_size - offset) return 0;
+
+        sections[i] = image + offset;
+        offset += header->section_sizes[i];
+    }
+
+    if (offset != image_size || header->section_sizes[BCCACHE_PROCS] % sizeof(BcCacheProc) != 0) return 0;
+
+    // NOTE: a torn or edited image fails here, before anything trusts its offsets.
+    if (header->checksum != hash_key_n((const char *)image + sizeof(BcCacheHeader), image_size - sizeof(BcCacheHeader))) return 0;
+
+    reader->procs = (const BcCacheProc *)sections[BCCACHE_PROCS];
+    reader->proc_count = header->section_sizes[BCCACHE_PROCS] / sizeof(BcCacheProc);
+    reader->code = (const BcInstr *)sections[BCCACHE_CODE];
+    reader->code_count = header->section_sizes[BCCACHE_CODE] / sizeof(BcInstr);
+    reader->consts = (const BcCacheValue *)sections[BCCACHE_CONSTS];
+    reader->const_count = header->section_sizes[BCCACHE_CONSTS] / sizeof(BcCacheValue);
+    reader->lists = (const BcCacheList *)sections[BCCACHE_LISTS];
+    reader->list_count = header->section_sizes[BCCACHE_LISTS] / sizeof(BcCacheList);
+    reader->items = (const BcCacheValue *)sections[BCCACHE_ITEMS];
+    reader->item_count = header->section_sizes[BCCACHE_ITEMS] / sizeof(BcCacheValue);
+    reader->strings = (const BcCacheText *)sections[BCCACHE_STRINGS];
+    reader->string_count = header->section_sizes[BCCACHE_STRINGS] / sizeof(BcCacheText);
+    reader->names = (const BcCacheText *)sections[BCCACHE_NAMES];
+    reader->name_count = header->section_sizes[BCCACHE_NAMES] / sizeof(BcCacheText);
+    reader->text = (const char *)sections[BCCACHE_TEXT];
+    reader->text_size = header->section_sizes[BCCACHE_TEXT];
+    reader->list_objs = NULL;
+
+    return reader->proc_count > 0;
+}
+
+/**
+ * @return const char* The NUL terminated text or NULL if the entry is out of range.
+ */
+static const char *bccache_text_at(const BcCacheReader *reader, BcCacheText entry)
+{
+    if (entry.offset >= reader->text_size || entry.length >= reader->text_size - entry.offset) return NULL;
+
+    return (reader->text[entry.offset + entry.length] == '\0') ? reader->text + entry.offset : NULL;
+}
+
+/**
+ * @param list_limit Lists below this index are already made.
+ */
+static int bccache_read_value(const BcCacheReader *reader, const BcProgram *program, const BcCacheValue *record, size_t list_limit, VarValue *value)
+{
+    value->type = (DataType)record->type;
+    value->is_const = record->is_const;
+
+    switch (record->type)
+    {
+    case BOOL_TYPE:
+        value->data.bool_val.flag = (int)record->bits;
+        return 1;
+    case INT_TYPE:
+        memcpy(&value->data.int_val.value, &record->bits, sizeof(record->bits));
+        return 1;
+    case REAL_TYPE:
+        memcpy(&value->data.real_val.value, &record->bits, sizeof(record->bits));
+        return 1;
+    case STR_TYPE:
+        if (record->bits >= reader->string_count) return 0;
+
+        value->data.str_type.value = program->image_strs + record->bits;
+        return 1;
+    case LIST_TYPE:
+        if (record->bits >= list_limit) return 0;
+
+        value->data.list_type.value = reader->list_objs[record->bits];
+        return 1;
+    case NONE_TYPE:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static int bccache_read_program(BcCacheReader *reader, BcProgram *program)
+{
+    const char *text = NULL;
+    const BcCacheList *list_record = NULL;
+    const BcCacheProc *proc_record = NULL;
+    BcProc *proc = NULL;
+    VarValue item;
+
+    if (reader->string_count > 0) program->image_strs = malloc(sizeof(StringObj) * reader->string_count);
+
+    if (reader->list_count > 0) reader->list_objs = malloc(sizeof(ListObj *) * reader->list_count);
+
+    if ((reader->string_count > 0 && !program->image_strs) || (reader->list_count > 0 && !reader->list_objs)) return 0;
+
+    // NOTE: string literals are pinned, so nothing writes through their sources into the read-only mapping.
+    for (size_t i = 0; i < reader->string_count; i++)
+    {
+        text = bccache_text_at(reader, reader->strings[i]);
+
+        if (!text) return 0;
+
+        init_pinned_str_obj(program->image_strs + i, (char *)text, reader->strings[i].length);
+    }
+
+    // NOTE: list literals are heap objects like the parser's, so they are made here and pinned. A failed load leaves them to heap_dispose.
+    for (size_t i = 0; i < reader->list_count; i++)
+    {
+        list_record = reader->lists + i;
+
+        if (list_record->item_start > reader->item_count || list_record->item_count > reader->item_count - list_record->item_start) return 0;
+
+        reader->list_objs[i] = create_list_obj();
+
+        if (!reader->list_objs[i]) return 0;
+
+        heap_pin(&reader->list_objs[i]->gc);
+
+        for (uint32_t j = 0; j < list_record->item_count; j++)
+        {
+            if (!bccache_read_value(reader, program, reader->items + list_record->item_start + j, i, &item) || !append_list_obj(reader->list_objs[i], item)) return 0;
+        }
+    }
+
+    // NOTE: indexes are kept as saved, so constants are not merged again like bcprogram_add_const would.
+    if (reader->const_count > program->const_capacity)
+    {
+        VarValue *temp_consts = realloc(program->consts, sizeof(VarValue) * reader->const_count);
+
+        if (!temp_consts) return 0;
+
+        program->consts = temp_consts;
+        program->const_capacity = reader->const_count;
+    }
+
+    for (size_t i = 0; i < reader->const_count; i++)
+    {
+        if (!bccache_read_value(reader, program, reader->consts + i, reader->list_count, program->consts + i)) return 0;
+
+        program->const_count++;
+    }
+
+    // NOTE: symbol tables compare names by address, so every name goes through the intern pool.
+    if (reader->name_count > program->name_capacity)
+    {
+        char **temp_names = realloc(program->names, sizeof(char *) * reader->name_count);
+
+        if (!temp_names) return 0;
+
+        program->names = temp_names;
+        program->name_capacity = reader->name_count;
+    }
+
+    for (size_t i = 0; i < reader->name_count; i++)
+    {
+        text = bccache_text_at(reader, reader->names[i]);
+        program->names[i] = (text != NULL) ? intern_string(text, reader->names[i].length) : NULL;
+
+        if (!program->names[i]) return 0;
+
+        program->name_count++;
+    }
+
+    for (size_t i = 0; i < reader->proc_count; i++)
+    {
+        proc_record = reader->procs + i;
+
+        if (proc_record->code_start > reader->code_count || proc_record->code_count > reader->code_count - proc_record->code_start) return 0;
+
+        proc = malloc(sizeof(BcProc));
+
+        if (!proc) return 0;
+
+        // NOTE: the VM and JIT only read code, so procs run it straight from the mapping.
+        proc->name = NULL;
+        proc->arity = proc_record->arity;
+        proc->reg_count = proc_record->reg_count;
+        proc->index = 0;
+        proc->count = proc_record->code_count;
+        proc->capacity = proc_record->code_count;
+        proc->code = (BcInstr *)(reader->code + proc_record->code_start);
+
+        if (proc_record->name.offset != BCCACHE_NO_NAME)
+        {
+            text = bccache_text_at(reader, proc_record->name);
+            proc->name = (text != NULL) ? intern_string(text, proc_record->name.length) : NULL;
+        }
+
+        if ((proc_record->name.offset != BCCACHE_NO_NAME && !proc->name) || bcprogram_add_proc(program, proc) < 0)
+        {
+            free(proc);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int bccache_load(BcProgram *program, const char *name, const char *cache_path, uint64_t source_hash, unsigned short *global_count, unsigned int *stmt_count)
+{
+    BcCacheReader reader;
+    size_t image_size = 0;
+    unsigned char *image = bccache_map(cache_path, &image_size);
+    int read_ok = 0;
+
+    if (!image) return 0;
+
+    if (!bccache_check(&reader, image, image_size, source_hash) || !bcprogram_init(program, name))
+    {
+        bccache_unmap(image, image_size);
+        return 0;
+    }
+
+    program->image = image;
+    program->image_size = image_size;
+
+    read_ok = bccache_read_program(&reader, program);
+    free(reader.list_objs);
+
+    if (!read_ok)
+    {
+        bccache_unload(program);
+        bcprogram_dispose(program);
+        return 0;
+    }
+
+    *global_count = (unsigned short)((const BcCacheHeader *)image)->global_count;
+    *stmt_count = ((const BcCacheHeader *)image)->stmt_count;
+
+    return 1;
+}
+
+void bccache_unload(BcProgram *program)
+{
+    if (!program->image) return;
+
+    // NOTE: the procs' code is in the image, so bcprogram_dispose must not free it.
+    for (unsigned int i = 0; i < program->proc_count; i++) program->procs[i]->code = NULL;
+
+    free(program->image_strs);
+    bccache_unmap(program->image, program->image_size);
+
+    program->image = NULL;
+    program->image_size = 0;
+    program->image_strs = NULL;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file bytecode.c
+ * @author Derek Tan
+ * @brief Implements compiled proc and program storage for the bytecode VM.
+ * @date 2023-08-12
+ */
+
+#include <stdio.h>
+#include "backend/compiler/bytecode.h"
+
+/// SECTION: Debug names
+
+static const char *opcode_names[] = {
+    "NOP",
+    "STMT",
+    "LOADK",
+    "MOVE",
+    "ASSIGN",
+    "GETGLOBAL",
+    "SETGLOBAL",
+    "CHECKVAL",
+    "NEG",
+    "ADD",
+    "SUB",
+    "MUL",
+    "DIV",
+    "ADDI",
+    "IADD",
+    "ISUB",
+    "IMUL",
+    "IDIV",
+    "RADD",
+    "RSUB",
+    "RMUL",
+    "RDIV",
+    "EQ",
+    "NEQ",
+    "LT",
+    "LTE",
+    "GT",
+    "GTE",
+    "JMP",
+    "JMPF",
+    "EQJMPF",
+    "NEQJMPF",
+    "LTJMPF",
+    "LTEJMPF",
+    "GTJMPF",
+    "GTEJMPF",
+    "IEQJMPF",
+    "INEQJMPF",
+    "ILTJMPF",
+    "ILTEJMPF",
+    "IGTJMPF",
+    "IGTEJMPF",
+    "CALL",
+    "TAILCALL",
+    "RET",
+    "RETNONE",
+    "DEFPROC",
+    "USE",
+    "HALT"
+};
+
+/// SECTION: BcProc
+
+BcProc *bcproc_create(char *name, unsigned short arity)
+{
+    BcProc *proc = malloc(sizeof(BcProc));
+
+    if (!proc) return NULL;
+
+    proc->code = malloc(sizeof(BcInstr) * BC_CODE_MIN_SZ);
+
+    if (!proc->code)
+    {
+        free(proc);
+        return NULL;
+    }
+
+    proc->name = name;
+    proc->arity = arity;
+    proc->reg_count = arity;
+    proc->index = 0;
+    proc->count = 0;
+    proc->capacity = BC_CODE_MIN_SZ;
+
+    return proc;
+}
+
+void bcproc_dispose(BcProc *proc)
+{
+    if (proc->code != NULL)
+    {
+        free(proc->code);
+        proc->code = NULL;
+    }
+
+    proc->name = NULL; // NOTE: unbind name since the AST or FuncObj owns it.
+    proc->count = 0;
+    proc->capacity = 0;
+}
+
+unsigned int bcproc_emit(BcProc *proc, BcOpCode op, unsigned char aux, unsigned short a, unsigned short b, unsigned short c)
+{
+    unsigned int next_spot = proc->count;
+    unsigned int new_capacity = proc->capacity << 1;
+
+    // NOTE: jump targets are 16-bit, so reject procs too long to address.
+    if (next_spot > BC_OPERAND_MAX) return BC_OPERAND_MAX + 1;
+
+    if (next_spot == proc->capacity)
+    {
+        BcInstr *temp_code = realloc(proc->code, sizeof(BcInstr) * new_capacity);
+
+        if (!temp_code) return BC_OPERAND_MAX + 1;
+
+        proc->code = temp_code;
+        proc->capacity = new_capacity;
+    }
+
+    proc->code[next_spot] = (BcInstr){.op = op, .aux = aux, .a = a, .b = b, .c = c};
+    proc->count++;
+
+    return next_spot;
+}
+
+/// SECTION: BcProgram
+
+int bcprogram_init(BcProgram *program, const char *name)
+{
+    program->name = name;
+    program->image = NULL;
+    program->image_size = 0;
+    program->image_strs = NULL;
+    program->procs = malloc(sizeof(BcProc *) * BC_PROCS_MIN_SZ);
+    program->consts = malloc(sizeof(VarValue) * BC_CONSTS_MIN_SZ);
+    program->names = malloc(sizeof(char *) * BC_NAMES_MIN_SZ);
+    program->proc_count = 0;
+    program->const_count = 0;
+    program->name_count = 0;
+    program->proc_capacity = BC_PROCS_MIN_SZ;
+    program->const_capacity = BC_CONSTS_MIN_SZ;
+    program->name_capacity = BC_NAMES_MIN_SZ;
+
+    if (!program->procs || !program->consts || !program->names)
+    {
+        bcprogram_dispose(program);
+        return 0;
+    }
+
+    return 1;
+}
+
+void bcprogram_dispose(BcProgram *program)
+{
+    for (unsigned int i = 0; i < program->proc_count; i++)
+    {
+        bcproc_dispose(program->procs[i]);
+        free(program->procs[i]);
+    }
+
+    // NOTE: constants and names are borrowed from AST literals, so only the arrays are freed.
+    free(program->procs);
+    free(program->consts);
+    free(program->names);
+
+    program->procs = NULL;
+    program->consts = NULL;
+    program->names = NULL;
+    program->proc_count = 0;
+    program->const_count = 0;
+    program->name_count = 0;
+    program->proc_capacity = 0;
+    program->const_capacity = 0;
+    program->name_capacity = 0;
+}
+
+int bcprogram_add_proc(BcProgram *program, BcProc *proc)
+{
+    unsigned int next_spot = program->proc_count;
+    unsigned int new_capacity = program->proc_capacity << 1;
+
+    if (!proc || next_spot > BC_OPERAND_MAX) return -1;
+
+    if (next_spot == program->proc_capacity)
+    {
+        BcProc **temp_procs = realloc(program->procs, sizeof(BcProc *) * new_capacity);
+
+        if (!temp_procs) return -1;
+
+        program->procs = temp_procs;
+        program->proc_capacity = new_capacity;
+    }
+
+    proc->index = next_spot;
+    program->procs[next_spot] = proc;
+    program->proc_count++;
+
+    return next_spot;
+}
+
+int bcprogram_add_const(BcProgram *program, VarValue value)
+{
+    unsigned int next_spot = program->const_count;
+    unsigned int new_capacity = program->const_capacity << 1;
+    VarValue *old_const = NULL;
+
+    // reuse equal primitive constants to keep the pool small
+    for (unsigned int i = 0; i < next_spot; i++)
+    {
+        old_const = program->consts + i;
+
+        if (old_const->type != value.type) continue;
+
+        if (value.type == BOOL_TYPE && old_const->data.bool_val.flag == value.data.bool_val.flag) return i;
+        if (value.type == INT_TYPE && old_const->data.int_val.value == value.data.int_val.value) return i;
+        if (value.type == REAL_TYPE && old_const->data.real_val.value == value.data.real_val.value) return i;
+    }
+
+    if (next_spot > BC_OPERAND_MAX) return -1;
+
+    if (next_spot == program->const_capacity)
+    {
+        VarValue *temp_consts = realloc(program->consts, sizeof(VarValue) * new_capacity);
+
+        if (!temp_consts) return -1;
+
+        program->consts = temp_consts;
+        program->const_capacity = new_capacity;
+    }
+
+    program->consts[next_spot] = value;
+    program->const_count++;
+
+    return next_spot;
+}
+
+int bcprogram_add_name(BcProgram *program, char *name)
+{
+    unsigned int next_spot = program->name_count;
+    unsigned int new_capacity = program->name_capacity << 1;
+
+    if (!name) return -1;
+
+    for (unsigned int i = 0; i < next_spot; i++)
+    {
+        if (program->names[i] == name) return i; // NOTE: names are interned.
+    }
+
+    if (next_spot > BC_OPERAND_MAX) return -1;
+
+    if (next_spot == program->name_capacity)
+    {
+        char **temp_names = realloc(program->names, sizeof(char *) * new_capacity);
+
+        if (!temp_names) return -1;
+
+        program->names = temp_names;
+        program->name_capacity = new_capacity;
+    }
+
+    program->names[next_spot] = name;
+    program->name_count++;
+
+    return next_spot;
+}
+
+void bcprogram_dump(const BcProgram *program)
+{
+    const BcProc *proc = NULL;
+    const BcInstr *instr = NULL;
+
+    for (unsigned int i = 0; i < program->proc_count; i++)
+    {
+        proc = program->procs[i];
+
+        printf("proc #%u \"%s\" (arity %u, regs %u):\n", i, (proc->name != NULL) ? proc->name : "<script>", proc->arity, proc->reg_count);
+
+        for (unsigned int pc = 0; pc < proc->count; pc++)
+        {
+            instr = proc->code + pc;
+            printf("  %4u  %-10s aux=%u a=%u b=%u c=%u\n", pc, opcode_names[instr->op], instr->aux, instr->a, instr->b, instr->c);
+        }
+    }
+}
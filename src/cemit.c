@@ -0,0 +1,1195 @@
+/**
+ * @file cemit.c
+ * @author Derek Tan
+ * @brief Implements the AST to C ahead-of-time compiler.
+ * @date 2023-08-22
+ */
+
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "backend/compiler/cemit.h"
+#include "backend/api/functions.h"
+#include "frontend/resolver.h"
+
+/// SECTION: Tables
+
+/**
+ * @brief Native callable from compiled code by its C name.
+ */
+typedef struct st_cnative_entry
+{
+    const char *name;
+    unsigned short arity;
+    const char *symbol;
+} CNativeEntry;
+
+// NOTE: these must match the modules the rubel driver loads. It marks them all as used at startup, so "use" only checks the name.
+static const CNativeEntry cemit_natives[] = {
+    {"print", 1, "rubel_print"},
+    {"println", 1, "rubel_println"},
+    {"input", 0, "rubel_input"},
+    {"at", 2, "rubel_list_at"},
+    {"length", 1, "rubel_list_len"},
+    {"sum", 1, "rubel_list_sum"},
+    {"min", 1, "rubel_list_min"},
+    {"max", 1, "rubel_list_max"},
+    {"indexOf", 2, "rubel_list_index_of"},
+    {"dot", 2, "rubel_list_dot"},
+    {"scale", 2, "rubel_list_scale"},
+    {"builder", 0, "rubel_str_builder"},
+    {"append", 2, "rubel_str_append"},
+    {"build", 1, "rubel_str_build"}
+};
+
+static const char *const cemit_modules[] = {"io", "lists", "strings"};
+
+// NOTE: both are indexed by OpType.
+static const char *const cemit_op_names[] = {"OP_AND", "OP_OR", "OP_EQ", "OP_NEQ", "OP_GT", "OP_GTE", "OP_LT", "OP_LTE", "OP_ADD", "OP_SUB", "OP_MUL", "OP_DIV", "OP_NEG", "OP_INDEX"};
+static const char *const cemit_c_ops[] = {NULL, NULL, "==", "!=", ">", ">=", "<", "<=", "+", "-", "*", "/", NULL, NULL};
+static const char *const cemit_int_wraps[] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, "INT_WRAP_ADD", "INT_WRAP_SUB", "INT_WRAP_MUL", "INT_WRAP_DIV", NULL, NULL};
+
+/// SECTION: Emitter utils
+
+int cemitter_init(CEmitter *emitter, FILE *out)
+{
+    emitter->out = out;
+    emitter->decls = tmpfile();
+    emitter->inits = tmpfile();
+    emitter->code = tmpfile();
+    emitter->in_proc = 0;
+    emitter->error_count = 0;
+    emitter->stmt_num = 0;
+    emitter->defined_below = 0;
+    emitter->proc_name = NULL;
+    emitter->indent = 0;
+    emitter->loop_depth = 0;
+    emitter->temp_count = 0;
+    emitter->literal_count = 0;
+    emitter->frame_size = 0;
+    emitter->local_kinds = NULL;
+    emitter->proc_count = 0;
+    emitter->proc_capacity = CEMIT_TABLE_MIN_SZ;
+    emitter->procs = malloc(sizeof(CProcEntry) * CEMIT_TABLE_MIN_SZ);
+    emitter->literal_entry_count = 0;
+    emitter->literal_entry_capacity = CEMIT_TABLE_MIN_SZ;
+    emitter->literals = malloc(sizeof(CLiteralEntry) * CEMIT_TABLE_MIN_SZ);
+
+    if (!emitter->decls || !emitter->inits || !emitter->code || !emitter->procs || !emitter->literals)
+    {
+        cemitter_dispose(emitter);
+        return 0;
+    }
+
+    return 1;
+}
+
+void cemitter_dispose(CEmitter *emitter)
+{
+    if (emitter->decls != NULL) fclose(emitter->decls);
+
+    if (emitter->inits != NULL) fclose(emitter->inits);
+
+    if (emitter->code != NULL) fclose(emitter->code);
+
+    emitter->decls = NULL;
+    emitter->inits = NULL;
+    emitter->code = NULL;
+
+    free(emitter->procs);
+    free(emitter->literals);
+    free(emitter->local_kinds);
+    emitter->procs = NULL;
+    emitter->literals = NULL;
+    emitter->local_kinds = NULL;
+    emitter->proc_count = 0;
+    emitter->literal_entry_count = 0;
+
+    // NOTE: the output stream is owned by the caller.
+    emitter->out = NULL;
+}
+
+void cemitter_log_err(CEmitter *emitter, const char *msg)
+{
+    emitter->error_count++;
+
+    if (emitter->in_proc)
+        fprintf(stderr, "EmitError at stmt %u in proc %s: %s\n", emitter->stmt_num, emitter->proc_name, msg);
+    else
+        fprintf(stderr, "EmitError at stmt %u: %s\n", emitter->stmt_num, msg);
+}
+
+static void cemit_line(CEmitter *emitter, const char *format, ...)
+{
+    va_list args;
+
+    // NOTE: blank lines get no indent.
+    for (int i = 0; i < emitter->indent && format[0] != '\0'; i++) fputs("    ", emitter->code);
+
+    va_start(args, format);
+    vfprintf(emitter->code, format, args);
+    va_end(args);
+
+    fputc('\n', emitter->code);
+}
+
+static void cemit_open(CEmitter *emitter)
+{
+    cemit_line(emitter, "{");
+    emitter->indent++;
+}
+
+static void cemit_close(CEmitter *emitter)
+{
+    emitter->indent--;
+    cemit_line(emitter, "}");
+}
+
+static void cemit_copy_stream(FILE *from, FILE *to)
+{
+    char buffer[4096];
+    size_t count = 0;
+
+    rewind(from);
+
+    while ((count = fread(buffer, 1, sizeof(buffer), from)) > 0) fwrite(buffer, 1, count, to);
+}
+
+static int cemit_add_proc(CEmitter *emitter, const Statement *stmt, unsigned int stmt_num)
+{
+    CProcEntry *temp_procs = NULL;
+
+    if (emitter->proc_count == emitter->proc_capacity)
+    {
+        temp_procs = realloc(emitter->procs, sizeof(CProcEntry) * (emitter->proc_capacity << 1));
+
+        if (!temp_procs) return 0;
+
+        emitter->procs = temp_procs;
+        emitter->proc_capacity <<= 1;
+    }
+
+    emitter->procs[emitter->proc_count] = (CProcEntry){.name = stmt->syntax.func_decl.func_name, .arity = stmt->syntax.func_decl.argc, .stmt_num = stmt_num};
+    emitter->proc_count++;
+
+    return 1;
+}
+
+static const CProcEntry *cemit_find_proc(const CEmitter *emitter, const char *name, unsigned int *index)
+{
+    for (unsigned int i = 0; i < emitter->proc_count; i++)
+    {
+        if (strcmp(emitter->procs[i].name, name) == 0)
+        {
+            *index = i;
+            return emitter->procs + i;
+        }
+    }
+
+    return NULL;
+}
+
+static const CNativeEntry *cemit_find_native(const char *name)
+{
+    for (size_t i = 0; i < sizeof(cemit_natives) / sizeof(cemit_natives[0]); i++)
+    {
+        if (strcmp(cemit_natives[i].name, name) == 0) return cemit_natives + i;
+    }
+
+    return NULL;
+}
+
+/// SECTION: Value helpers
+
+static CValueKind cemit_kind_of(DataType type)
+{
+    switch (type)
+    {
+    case INT_TYPE: return CVAL_INT;
+    case REAL_TYPE: return CVAL_REAL;
+    case BOOL_TYPE: return CVAL_BOOL;
+    default: return CVAL_BOXED;
+    }
+}
+
+static const char *cemit_c_type(CValueKind kind)
+{
+    switch (kind)
+    {
+    case CVAL_INT: return "int";
+    case CVAL_REAL: return "float";
+    case CVAL_BOOL: return "int";
+    default: return "VarValue";
+    }
+}
+
+static int cemit_set_text(CValue *value, CValueKind kind, int reads_vars, const char *format, ...)
+{
+    va_list args;
+    int length = 0;
+
+    value->kind = kind;
+    value->reads_vars = reads_vars;
+
+    va_start(args, format);
+    length = vsnprintf(value->text, CEMIT_TEXT_SZ, format, args);
+    va_end(args);
+
+    return length >= 0 && length < CEMIT_TEXT_SZ;
+}
+
+/**
+ * @brief Writes a value as a VarValue expression into text, which needs room for CEMIT_TEXT_SZ + 32 chars.
+ */
+static void cemit_box(const CValue *value, int is_const, char *text)
+{
+    switch (value->kind)
+    {
+    case CVAL_INT:
+        sprintf(text, "AOT_INT(%d, %s)", is_const, value->text);
+        break;
+    case CVAL_REAL:
+        sprintf(text, "AOT_REAL(%d, %s)", is_const, value->text);
+        break;
+    case CVAL_BOOL:
+        sprintf(text, "AOT_BOOL(%d, %s)", is_const, value->text);
+        break;
+    default:
+        strcpy(text, value->text);
+        break;
+    }
+}
+
+/**
+ * @brief Writes a value as a C scalar of the given kind. Boxed values must be proven to have that type.
+ */
+static void cemit_unbox(const CValue *value, CValueKind kind, char *text)
+{
+    if (value->kind != CVAL_BOXED)
+    {
+        strcpy(text, value->text);
+        return;
+    }
+
+    switch (kind)
+    {
+    case CVAL_INT:
+        sprintf(text, "%s.data.int_val.value", value->text);
+        break;
+    case CVAL_REAL:
+        sprintf(text, "%s.data.real_val.value", value->text);
+        break;
+    default:
+        sprintf(text, "%s.data.bool_val.flag", value->text);
+        break;
+    }
+}
+
+/**
+ * @brief Evaluates a value into a new temporary, so later code cannot change it.
+ */
+static void cemit_to_temp(CEmitter *emitter, CValue *value)
+{
+    unsigned int temp = emitter->temp_count++;
+
+    cemit_line(emitter, "%s t%u = %s;", cemit_c_type(value->kind), temp, value->text);
+    cemit_set_text(value, value->kind, 0, "t%u", temp);
+}
+
+/**
+ * @brief Emits a failure where the walker would fail for sure. The placeholder result keeps the dead code after it valid C.
+ */
+static void cemit_fail(CEmitter *emitter, const char *status, CValue *result)
+{
+    cemit_line(emitter, "AOT_FAIL(%s);", status);
+    cemit_set_text(result, CVAL_BOXED, 0, "make_none_varval()");
+}
+
+static int cemit_has_call(const Expression *expr)
+{
+    switch (expr->type)
+    {
+    case FUNC_CALL:
+        return 1;
+    case UNARY_OP:
+        return cemit_has_call(expr->syntax.unary_op.expr);
+    case BINARY_OP:
+        return cemit_has_call(expr->syntax.binary_op.left) || cemit_has_call(expr->syntax.binary_op.right);
+    default:
+        return 0;
+    }
+}
+
+/// SECTION: Literals
+
+static int cemit_find_literal(const CEmitter *emitter, const void *obj, unsigned int *id)
+{
+    for (unsigned int i = 0; i < emitter->literal_entry_count; i++)
+    {
+        if (emitter->literals[i].obj == obj)
+        {
+            *id = emitter->literals[i].id;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int cemit_add_literal(CEmitter *emitter, const void *obj, unsigned int *id)
+{
+    CLiteralEntry *temp_literals = NULL;
+
+    if (emitter->literal_entry_count == emitter->literal_entry_capacity)
+    {
+        temp_literals = realloc(emitter->literals, sizeof(CLiteralEntry) * (emitter->literal_entry_capacity << 1));
+
+        if (!temp_literals) return 0;
+
+        emitter->literals = temp_literals;
+        emitter->literal_entry_capacity <<= 1;
+    }
+
+    *id = emitter->literal_count++;
+    emitter->literals[emitter->literal_entry_count] = (CLiteralEntry){.obj = obj, .id = *id};
+    emitter->literal_entry_count++;
+
+    return 1;
+}
+
+static void cemit_int_text(int value, char *text)
+{
+    // NOTE: -2147483648 would be a negated long in C, so the smallest int is spelled out.
+    if (value == INT_MIN) strcpy(text, "(-2147483647 - 1)");
+    else if (value < 0) sprintf(text, "(%d)", value);
+    else sprintf(text, "%d", value);
+}
+
+static void cemit_real_text(float value, char *text)
+{
+    // NOTE: hex floats keep every bit of the literal.
+    if (isnan(value)) strcpy(text, "NAN");
+    else if (isinf(value)) strcpy(text, (value > 0) ? "HUGE_VALF" : "(-HUGE_VALF)");
+    else if (signbit(value)) sprintf(text, "(%af)", value);
+    else sprintf(text, "%af", value);
+}
+
+static int cemit_str_literal(CEmitter *emitter, const StringObj *str, unsigned int *id)
+{
+    unsigned char c = '\0';
+
+    if (cemit_find_literal(emitter, str, id)) return 1;
+
+    if (!cemit_add_literal(emitter, str, id)) return 0;
+
+    fprintf(emitter->decls, "static char aot_text_%u[] = \"", *id);
+
+    for (size_t i = 0; i < str->length; i++)
+    {
+        c = (unsigned char)str->source[i];
+
+        // NOTE: octal escapes always get 3 digits, so a digit after one is never read into it.
+        if (c == '\\' || c == '"' || c == '?') fprintf(emitter->decls, "\\%c", c);
+        else if (c >= 0x20 && c < 0x7f) fputc(c, emitter->decls);
+        else fprintf(emitter->decls, "\\%03o", c);
+    }
+
+    fprintf(emitter->decls, "\";\nstatic StringObj aot_str_%u;\n", *id);
+    fprintf(emitter->inits, "    init_pinned_str_obj(&aot_str_%u, aot_text_%u, %zu);\n", *id, *id, str->length);
+
+    return 1;
+}
+
+static int cemit_list_literal(CEmitter *emitter, const ListObj *list, unsigned int *id)
+{
+    VarValue item;
+    unsigned int *item_ids = NULL;
+    char text[CEMIT_TEXT_SZ];
+    int emit_ok = 1;
+
+    if (cemit_find_literal(emitter, list, id)) return 1;
+
+    item_ids = malloc(sizeof(unsigned int) * ((list->count > 0) ? list->count : 1));
+
+    if (!item_ids) return 0;
+
+    // NOTE: nested strings and lists are set up first, so the list can append them.
+    for (size_t i = 0; i < list->count && emit_ok; i++)
+    {
+        get_at_list_obj(list, i, &item);
+
+        if (item.type == STR_TYPE) emit_ok = cemit_str_literal(emitter, item.data.str_type.value, item_ids + i);
+        else if (item.type == LIST_TYPE) emit_ok = cemit_list_literal(emitter, item.data.list_type.value, item_ids + i);
+    }
+
+    if (!emit_ok || !cemit_add_literal(emitter, list, id))
+    {
+        free(item_ids);
+        return 0;
+    }
+
+    fprintf(emitter->decls, "static ListObj *aot_list_%u = NULL;\n", *id);
+    fprintf(emitter->inits, "    aot_list_%u = create_list_obj();\n\n    if (!aot_list_%u) return 0;\n\n    heap_pin(&aot_list_%u->gc);\n", *id, *id, *id);
+
+    // NOTE: items are appended as the parser does, so packed lists stay packed.
+    for (size_t i = 0; i < list->count; i++)
+    {
+        get_at_list_obj(list, i, &item);
+
+        switch (item.type)
+        {
+        case BOOL_TYPE:
+            fprintf(emitter->inits, "    if (!append_list_obj(aot_list_%u, make_bool_varval(0, %d))) return 0;\n", *id, item.data.bool_val.flag != 0);
+            break;
+        case INT_TYPE:
+            cemit_int_text(item.data.int_val.value, text);
+            fprintf(emitter->inits, "    if (!append_list_obj(aot_list_%u, make_int_varval(0, %s))) return 0;\n", *id, text);
+            break;
+        case REAL_TYPE:
+            cemit_real_text(item.data.real_val.value, text);
+            fprintf(emitter->inits, "    if (!append_list_obj(aot_list_%u, make_real_varval(0, %s))) return 0;\n", *id, text);
+            break;
+        case STR_TYPE:
+            fprintf(emitter->inits, "    if (!append_list_obj(aot_list_%u, make_str_varval(0, &aot_str_%u))) return 0;\n", *id, item_ids[i]);
+            break;
+        case LIST_TYPE:
+            fprintf(emitter->inits, "    if (!append_list_obj(aot_list_%u, make_list_varval(0, aot_list_%u))) return 0;\n", *id, item_ids[i]);
+            break;
+        default:
+            fprintf(emitter->inits, "    if (!append_list_obj(aot_list_%u, make_none_varval())) return 0;\n", *id);
+            break;
+        }
+    }
+
+    fputc('\n', emitter->inits);
+    free(item_ids);
+
+    return 1;
+}
+
+/// SECTION: Expression emitting
+
+/**
+ * @brief Gives a variable's storage: globals and unproven locals live in value stack windows, and proven outer-block locals are C variables.
+ */
+static void cemit_var(const CEmitter *emitter, unsigned short depth, unsigned short slot, CValue *result)
+{
+    // NOTE: top-level code runs in the globals' frame, so its locals are globals.
+    if (!emitter->in_proc || depth != RESOLVE_DEPTH_LOCAL)
+        cemit_set_text(result, CVAL_BOXED, 1, "aot_globals[%u]", slot);
+    else if (slot < emitter->frame_size && emitter->local_kinds[slot] != NONE_TYPE)
+        cemit_set_text(result, cemit_kind_of(emitter->local_kinds[slot]), 1, "v%u", slot);
+    else
+        cemit_set_text(result, CVAL_BOXED, 1, "f[%u]", slot);
+}
+
+/**
+ * @brief Emits a call with the walker's resolution: a proc whose declaration ran, else a native, else ERR_NULL_VAL. Arity mismatches give ERR_NO_IMPL once the args are evaluated.
+ * @param tailed Set to 1 if a tail call always left through aot_tail, so there is no result. Only tail calls pass it.
+ */
+static int cemit_call(CEmitter *emitter, const Expression *expr, int *tailed, CValue *result)
+{
+    unsigned short argc = (unsigned short)(expr->syntax.fn_call.argc);
+    unsigned int proc_index = 0;
+    const CProcEntry *proc = cemit_find_proc(emitter, expr->syntax.fn_call.func_name, &proc_index);
+    const CNativeEntry *native = cemit_find_native(expr->syntax.fn_call.func_name);
+    int proc_exists = proc != NULL && proc->stmt_num < emitter->defined_below; // procs declared before this code runs are surely defined
+    int proc_calls = proc != NULL && proc->arity == argc;
+    int native_calls = !proc_exists && native != NULL && native->arity == argc;
+    unsigned int window = 0;
+    unsigned int temp = 0;
+    char window_text[16] = "NULL";
+    char boxed[CEMIT_TEXT_SZ + 32];
+    CValue arg;
+
+    if (expr->syntax.fn_call.argc > FUNC_ARGV_MAX_SZ)
+    {
+        cemit_fail(emitter, "ERR_GENERAL", result);
+        return 1;
+    }
+
+    // NOTE: args are stored in a window as soon as they are evaluated, so collections in later args see them.
+    if (argc > 0)
+    {
+        window = emitter->temp_count++;
+        sprintf(window_text, "a%u", window);
+        cemit_line(emitter, "VarValue *a%u = aot_push(%u);", window, argc);
+        cemit_line(emitter, "if (!a%u) AOT_FAIL(ERR_MEMORY);", window);
+    }
+
+    for (unsigned short i = 0; i < argc; i++)
+    {
+        if (!cemit_expr(emitter, expr->syntax.fn_call.args[i], &arg)) return 0;
+
+        cemit_box(&arg, 1, boxed);
+        cemit_line(emitter, "a%u[%u] = %s;", window, i, boxed);
+    }
+
+    // NOTE: like exec_return, only procs of matching arity are tail called. Natives and bad calls just run here.
+    if (tailed != NULL && proc_calls)
+    {
+        if (!proc_exists)
+        {
+            cemit_line(emitter, "if (proc_defs[%u] != NULL)", proc_index);
+            cemit_open(emitter);
+        }
+
+        cemit_line(emitter, "status = aot_tail(proc_%u, %s, %u);", proc_index, window_text, argc);
+        cemit_line(emitter, "goto done;");
+
+        if (proc_exists)
+        {
+            *tailed = 1;
+            return 1;
+        }
+
+        cemit_close(emitter);
+    }
+
+    // NOTE: a call that fails on every path gets no result temporary, which would be unused.
+    if (proc_calls || native_calls)
+    {
+        temp = emitter->temp_count++;
+        cemit_line(emitter, "VarValue t%u;", temp);
+        cemit_set_text(result, CVAL_BOXED, 0, "t%u", temp);
+    }
+    else
+    {
+        cemit_set_text(result, CVAL_BOXED, 0, "make_none_varval()");
+    }
+
+    if (proc != NULL && !proc_exists)
+    {
+        cemit_line(emitter, "if (proc_defs[%u] != NULL)", proc_index);
+        cemit_open(emitter);
+    }
+
+    if (proc_calls) cemit_line(emitter, "AOT_CHECK(aot_call(proc_%u, %s, &t%u));", proc_index, window_text, temp);
+    else if (proc != NULL) cemit_line(emitter, "AOT_FAIL(ERR_NO_IMPL);");
+
+    if (proc != NULL && !proc_exists)
+    {
+        cemit_close(emitter);
+        cemit_line(emitter, "else");
+        cemit_open(emitter);
+    }
+
+    if (native_calls) cemit_line(emitter, "AOT_CHECK(aot_call_native(%s, %s, %u, &t%u));", native->symbol, window_text, argc, temp);
+    else if (!proc_exists && native != NULL) cemit_line(emitter, "AOT_FAIL(ERR_NO_IMPL);");
+    else if (!proc_exists) cemit_line(emitter, "AOT_FAIL(ERR_NULL_VAL);");
+
+    if (proc != NULL && !proc_exists) cemit_close(emitter);
+
+    if (argc > 0) cemit_line(emitter, "aot_pop(%u);", argc);
+
+    return 1;
+}
+
+static int cemit_unary(CEmitter *emitter, const Expression *expr, CValue *result)
+{
+    CValue operand;
+    unsigned int temp = 0;
+
+    if (expr->syntax.unary_op.op != OP_NEG)
+    {
+        cemit_fail(emitter, "ERR_GENERAL", result);
+        return 1;
+    }
+
+    if (!cemit_expr(emitter, expr->syntax.unary_op.expr, &operand)) return 0;
+
+    switch (operand.kind)
+    {
+    case CVAL_INT:
+    case CVAL_REAL:
+        // NOTE: like the walker, this subtracts from 0, so reals never become -0 and ints wrap.
+        if (!cemit_set_text(result, operand.kind, operand.reads_vars, (operand.kind == CVAL_INT) ? "INT_WRAP_SUB(0, %s)" : "(0 - %s)", operand.text))
+        {
+            cemit_to_temp(emitter, &operand);
+            cemit_set_text(result, operand.kind, 0, (operand.kind == CVAL_INT) ? "INT_WRAP_SUB(0, %s)" : "(0 - %s)", operand.text);
+        }
+        break;
+    case CVAL_BOOL:
+        cemit_fail(emitter, "ERR_TYPE", result);
+        break;
+    default:
+        temp = emitter->temp_count++;
+        cemit_line(emitter, "VarValue t%u;", temp);
+        cemit_line(emitter, "AOT_CHECK(aot_negate(%s, &t%u));", operand.text, temp);
+        cemit_set_text(result, CVAL_BOXED, 0, "t%u", temp);
+        break;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Emits an operator the typer specialized as plain C, so only division checks its divisor.
+ */
+static void cemit_typed_binary(CEmitter *emitter, OpType op, CValueKind kind, const CValue *left, const CValue *right, CValue *result)
+{
+    int is_compare = op == OP_EQ || op == OP_NEQ || op == OP_GT || op == OP_GTE || op == OP_LT || op == OP_LTE;
+    CValueKind result_kind = (is_compare) ? CVAL_BOOL : kind;
+    char left_text[CEMIT_TEXT_SZ + 32];
+    char right_text[CEMIT_TEXT_SZ + 32];
+    unsigned int temp = 0;
+    CValue divisor = *right;
+
+    // NOTE: the folder leaves constant int divisions that trap, so their divisor goes through a temporary the C compiler does not fold.
+    if (op == OP_DIV && kind == CVAL_INT && divisor.kind == CVAL_INT && !divisor.reads_vars) cemit_to_temp(emitter, &divisor);
+
+    cemit_unbox(left, kind, left_text);
+    cemit_unbox(&divisor, kind, right_text);
+
+    if (op == OP_DIV) cemit_line(emitter, "if (%s == 0) AOT_FAIL(ERR_NULL_VAL);", right_text);
+
+    // NOTE: int math goes through the INT_WRAP macros, so it wraps like the VM's.
+    if (kind == CVAL_INT && cemit_int_wraps[op] != NULL)
+    {
+        if (cemit_set_text(result, result_kind, left->reads_vars || right->reads_vars, "%s(%s, %s)", cemit_int_wraps[op], left_text, right_text)) return;
+
+        temp = emitter->temp_count++;
+        cemit_line(emitter, "int t%u = %s(%s, %s);", temp, cemit_int_wraps[op], left_text, right_text);
+        cemit_set_text(result, result_kind, 0, "t%u", temp);
+        return;
+    }
+
+    if (cemit_set_text(result, result_kind, left->reads_vars || right->reads_vars, "(%s %s %s)", left_text, cemit_c_ops[op], right_text)) return;
+
+    // NOTE: long expressions are split at temporaries, so their text is never cut.
+    temp = emitter->temp_count++;
+    cemit_line(emitter, "%s t%u = %s %s %s;", cemit_c_type(result_kind), temp, left_text, cemit_c_ops[op], right_text);
+    cemit_set_text(result, result_kind, 0, "t%u", temp);
+}
+
+static int cemit_binary(CEmitter *emitter, const Expression *expr, CValue *result)
+{
+    OpType op = expr->syntax.binary_op.op;
+    DataType operand_type = expr->syntax.binary_op.operand_type;
+    char left_text[CEMIT_TEXT_SZ + 32];
+    char right_text[CEMIT_TEXT_SZ + 32];
+    unsigned int temp = 0;
+    CValue left, right;
+
+    if (!cemit_expr(emitter, expr->syntax.binary_op.left, &left)) return 0;
+
+    // NOTE: the walker reads the left value before calls on the right run, and they may set a global it read.
+    if (left.reads_vars && cemit_has_call(expr->syntax.binary_op.right)) cemit_to_temp(emitter, &left);
+
+    if (!cemit_expr(emitter, expr->syntax.binary_op.right, &right)) return 0;
+
+    if ((operand_type == INT_TYPE || operand_type == REAL_TYPE) && cemit_c_ops[op] != NULL)
+    {
+        cemit_typed_binary(emitter, op, cemit_kind_of(operand_type), &left, &right, result);
+        return 1;
+    }
+
+    cemit_box(&left, 1, left_text);
+    cemit_box(&right, 1, right_text);
+    temp = emitter->temp_count++;
+    cemit_line(emitter, "VarValue t%u;", temp);
+
+    // NOTE: unproven operands are most often ints, so those get an inline path.
+    if (op == OP_ADD || op == OP_SUB || op == OP_MUL)
+        cemit_line(emitter, "AOT_INT_MATH(%s, %s, %s, %s, t%u);", cemit_op_names[op], cemit_int_wraps[op], left_text, right_text, temp);
+    else if (op == OP_EQ || op == OP_NEQ || op == OP_GT || op == OP_GTE || op == OP_LT || op == OP_LTE)
+        cemit_line(emitter, "AOT_INT_COMPARE(%s, %s, %s, %s, t%u);", cemit_op_names[op], cemit_c_ops[op], left_text, right_text, temp);
+    else
+        cemit_line(emitter, "AOT_CHECK(aot_binary(%s, %s, %s, &t%u));", cemit_op_names[op], left_text, right_text, temp);
+
+    cemit_set_text(result, CVAL_BOXED, 0, "t%u", temp);
+
+    return 1;
+}
+
+int cemit_expr(CEmitter *emitter, const Expression *expr, CValue *result)
+{
+    char text[CEMIT_TEXT_SZ];
+    unsigned int id = 0;
+
+    switch (expr->type)
+    {
+    case BOOL_LITERAL:
+        cemit_set_text(result, CVAL_BOOL, 0, "%d", expr->syntax.bool_literal.flag != 0);
+        return 1;
+    case INT_LITERAL:
+        cemit_int_text(expr->syntax.int_literal.value, text);
+        cemit_set_text(result, CVAL_INT, 0, "%s", text);
+        return 1;
+    case REAL_LITERAL:
+        cemit_real_text(expr->syntax.real_literal.value, text);
+        cemit_set_text(result, CVAL_REAL, 0, "%s", text);
+        return 1;
+    case STR_LITERAL:
+        if (!cemit_str_literal(emitter, expr->syntax.str_literal.str_obj, &id)) break;
+
+        cemit_set_text(result, CVAL_BOXED, 0, "make_str_varval(1, &aot_str_%u)", id);
+        return 1;
+    case LIST_LITERAL:
+        if (!cemit_list_literal(emitter, expr->syntax.list_literal.list_obj, &id)) break;
+
+        cemit_set_text(result, CVAL_BOXED, 0, "make_list_varval(1, aot_list_%u)", id);
+        return 1;
+    case VAR_USAGE:
+        cemit_var(emitter, expr->syntax.variable.depth, expr->syntax.variable.slot, result);
+        return 1;
+    case FUNC_CALL:
+        return cemit_call(emitter, expr, NULL, result);
+    case UNARY_OP:
+        return cemit_unary(emitter, expr, result);
+    case BINARY_OP:
+        return cemit_binary(emitter, expr, result);
+    default:
+        cemitter_log_err(emitter, "Unknown expression.");
+        return 0;
+    }
+
+    cemitter_log_err(emitter, "Out of memory for a literal.");
+
+    return 0;
+}
+
+/// SECTION: Statement emitting
+
+static int cemit_var_decl(CEmitter *emitter, const Statement *stmt)
+{
+    int is_const = stmt->syntax.var_decl.is_const;
+    char text[CEMIT_TEXT_SZ + 32];
+    CValue value, place;
+
+    if (!cemit_expr(emitter, stmt->syntax.var_decl.rvalue, &value)) return 0;
+
+    cemit_var(emitter, RESOLVE_DEPTH_LOCAL, stmt->syntax.var_decl.slot, &place);
+
+    if (place.kind != CVAL_BOXED)
+    {
+        // NOTE: only declarations of proven types get C variables, so the value needs no check.
+        cemit_unbox(&value, place.kind, text);
+        cemit_line(emitter, "%s = %s;", place.text, text);
+    }
+    else if (value.kind != CVAL_BOXED)
+    {
+        cemit_box(&value, is_const, text);
+        cemit_line(emitter, "%s = %s;", place.text, text);
+    }
+    else
+    {
+        cemit_line(emitter, "AOT_CHECK(aot_declare(&%s, %s, %d));", place.text, value.text, is_const);
+    }
+
+    return 1;
+}
+
+static int cemit_var_assign(CEmitter *emitter, const Statement *stmt)
+{
+    static const char *const type_names[] = {"NONE_TYPE", "INT_TYPE", "REAL_TYPE", "BOOL_TYPE"}; // indexed by CValueKind
+    char text[CEMIT_TEXT_SZ + 32];
+    CValue value, place;
+
+    if (!cemit_expr(emitter, stmt->syntax.var_assign.rvalue, &value)) return 0;
+
+    cemit_var(emitter, stmt->syntax.var_assign.depth, stmt->syntax.var_assign.slot, &place);
+
+    if (place.kind == CVAL_BOXED)
+    {
+        cemit_box(&value, 1, text);
+        cemit_line(emitter, "AOT_CHECK(aot_assign(&%s, %s));", place.text, text);
+        return 1;
+    }
+
+    // NOTE: a C variable keeps its declared type, so other values get the errors ctx_update_var gives.
+    if (value.kind == CVAL_BOXED) cemit_line(emitter, "AOT_CHECK(aot_expect(%s, %s));", value.text, type_names[place.kind]);
+    else if (value.kind != place.kind) cemit_line(emitter, "AOT_FAIL(ERR_TYPE);");
+
+    cemit_unbox(&value, place.kind, text);
+    cemit_line(emitter, "%s = %s;", place.text, text);
+
+    return 1;
+}
+
+/**
+ * @brief Emits an if or while condition, giving a C expression for its flag in text.
+ */
+static int cemit_condition(CEmitter *emitter, const Expression *condition, char *text)
+{
+    unsigned int temp = 0;
+    CValue value;
+
+    if (!cemit_expr(emitter, condition, &value)) return 0;
+
+    switch (value.kind)
+    {
+    case CVAL_BOOL:
+        strcpy(text, value.text);
+        break;
+    case CVAL_BOXED:
+        temp = emitter->temp_count++;
+        cemit_line(emitter, "int t%u;", temp);
+        cemit_line(emitter, "AOT_TEST(%s, t%u);", value.text, temp);
+        sprintf(text, "t%u", temp);
+        break;
+    default:
+        cemit_line(emitter, "AOT_FAIL(ERR_TYPE);");
+        strcpy(text, "0");
+        break;
+    }
+
+    return 1;
+}
+
+static int cemit_while(CEmitter *emitter, const Statement *stmt)
+{
+    char text[CEMIT_TEXT_SZ + 32];
+    int emit_ok = 1;
+
+    // NOTE: like exec_while, each check is a safe point for collections.
+    cemit_line(emitter, "while (1)");
+    cemit_open(emitter);
+    cemit_line(emitter, "aot_collect_garbage();");
+
+    if (!cemit_condition(emitter, stmt->syntax.while_stmt.condition, text)) return 0;
+
+    cemit_line(emitter, "if (!%s) break;", text);
+
+    emitter->loop_depth++;
+    emit_ok = cemit_block(emitter, stmt->syntax.while_stmt.stmts);
+    emitter->loop_depth--;
+
+    cemit_close(emitter);
+
+    return emit_ok;
+}
+
+static int cemit_ifotherwise(CEmitter *emitter, const Statement *stmt)
+{
+    const Statement *other_stmt = stmt->syntax.if_stmt.other;
+    char text[CEMIT_TEXT_SZ + 32];
+    int emit_ok = 1;
+
+    cemit_open(emitter);
+
+    if (!cemit_condition(emitter, stmt->syntax.if_stmt.condition, text)) return 0;
+
+    cemit_line(emitter, "if (%s)", text);
+    cemit_open(emitter);
+    emit_ok = cemit_block(emitter, stmt->syntax.if_stmt.first);
+    cemit_close(emitter);
+
+    if (other_stmt != NULL)
+    {
+        cemit_line(emitter, "else");
+        cemit_open(emitter);
+        emit_ok = cemit_block(emitter, other_stmt->syntax.otherwise_stmt.stmts) && emit_ok;
+        cemit_close(emitter);
+    }
+
+    cemit_close(emitter);
+
+    return emit_ok;
+}
+
+static int cemit_return(CEmitter *emitter, const Statement *stmt)
+{
+    const Expression *result_expr = stmt->syntax.return_stmt.result;
+    char text[CEMIT_TEXT_SZ + 32];
+    int tailed = 0;
+    CValue value;
+
+    if (!result_expr)
+    {
+        cemit_line(emitter, "goto done;");
+        return 1;
+    }
+
+    cemit_open(emitter);
+
+    if (stmt->syntax.return_stmt.is_tail_call && result_expr->type == FUNC_CALL)
+    {
+        if (!cemit_call(emitter, result_expr, &tailed, &value)) return 0;
+    }
+    else if (!cemit_expr(emitter, result_expr, &value))
+    {
+        return 0;
+    }
+
+    if (!tailed)
+    {
+        cemit_box(&value, 1, text);
+        cemit_line(emitter, "*result = %s;", text);
+        cemit_line(emitter, "goto done;");
+    }
+
+    cemit_close(emitter);
+
+    return 1;
+}
+
+/**
+ * @brief Emits a top-level proc declaration, which defines the proc like exec_func_decl.
+ */
+static int cemit_func_decl(CEmitter *emitter, const Statement *stmt)
+{
+    unsigned int proc_index = 0;
+    const CProcEntry *proc = cemit_find_proc(emitter, stmt->syntax.func_decl.func_name, &proc_index);
+
+    // NOTE: the first declaration of a name surely ran before a later one, so the later one always fails.
+    if (proc->stmt_num != emitter->stmt_num) cemit_line(emitter, "AOT_FAIL(ERR_MEMORY);");
+    else cemit_line(emitter, "proc_defs[%u] = proc_%u;", proc_index, proc_index);
+
+    return 1;
+}
+
+int cemit_block(CEmitter *emitter, const Statement *stmt)
+{
+    int emit_ok = 1;
+
+    if (!stmt) return 1;
+
+    if (stmt->type != BLOCK_STMT) return cemit_stmt(emitter, stmt);
+
+    for (unsigned int i = 0; i < stmt->syntax.block.count && emit_ok; i++)
+    {
+        if (stmt->syntax.block.stmts[i] != NULL) emit_ok = cemit_stmt(emitter, stmt->syntax.block.stmts[i]);
+    }
+
+    return emit_ok;
+}
+
+int cemit_stmt(CEmitter *emitter, const Statement *stmt)
+{
+    const char *module_name = NULL;
+    int emit_ok = 1;
+    CValue value;
+
+    // NOTE: the walker's top-level loop only runs simple statements, so the others fail there like in exec_stmt.
+    if (!emitter->in_proc && (stmt->type == WHILE_STMT || stmt->type == IF_STMT || stmt->type == RETURN_STMT || stmt->type == BREAK_STMT))
+    {
+        cemit_line(emitter, "AOT_FAIL(ERR_GENERAL);");
+        return 1;
+    }
+
+    switch (stmt->type)
+    {
+    case EXPR_STMT:
+        // NOTE: other expression statements are never evaluated, as their values are unused.
+        if (stmt->syntax.expr_stmt.expr->type != FUNC_CALL) break;
+
+        cemit_open(emitter);
+        emit_ok = cemit_call(emitter, stmt->syntax.expr_stmt.expr, NULL, &value);
+        cemit_close(emitter);
+        break;
+    case VAR_DECL:
+        cemit_open(emitter);
+        emit_ok = cemit_var_decl(emitter, stmt);
+        cemit_close(emitter);
+        break;
+    case VAR_ASSIGN:
+        cemit_open(emitter);
+        emit_ok = cemit_var_assign(emitter, stmt);
+        cemit_close(emitter);
+        break;
+    case FUNC_DECL:
+        if (emitter->in_proc)
+        {
+            cemitter_log_err(emitter, "Procs may only be declared at top-level.");
+            return 0;
+        }
+
+        emit_ok = cemit_func_decl(emitter, stmt);
+        break;
+    case WHILE_STMT:
+        emit_ok = cemit_while(emitter, stmt);
+        break;
+    case IF_STMT:
+        emit_ok = cemit_ifotherwise(emitter, stmt);
+        break;
+    case BREAK_STMT:
+        // NOTE: a break outside of loops ends the proc with no result, as the walker's call would.
+        cemit_line(emitter, (emitter->loop_depth > 0) ? "break;" : "goto done;");
+        break;
+    case RETURN_STMT:
+        emit_ok = cemit_return(emitter, stmt);
+        break;
+    case MODULE_USE:
+        module_name = stmt->syntax.module_usage.module_name;
+
+        for (size_t i = 0; i < sizeof(cemit_modules) / sizeof(cemit_modules[0]); i++)
+        {
+            if (strcmp(cemit_modules[i], module_name) == 0) return 1;
+        }
+
+        cemit_line(emitter, "AOT_FAIL(ERR_NO_IMPL);");
+        break;
+    case MODULE_DEF:
+        cemit_line(emitter, "AOT_FAIL(ERR_NO_IMPL);");
+        break;
+    default:
+        cemit_line(emitter, "AOT_FAIL(ERR_GENERAL);");
+        break;
+    }
+
+    return emit_ok;
+}
+
+/// SECTION: Program emitting
+
+/**
+ * @brief Emits a proc as a C function. Params stay in the frame since callers may pass any type.
+ */
+static int cemit_proc(CEmitter *emitter, const Statement *stmt, unsigned int proc_index)
+{
+    unsigned short frame_size = stmt->syntax.func_decl.frame_size;
+    unsigned short arity = stmt->syntax.func_decl.argc;
+    const Statement *body = stmt->syntax.func_decl.stmts;
+    const Statement *local_stmt = NULL;
+    int emit_ok = 1;
+
+    emitter->local_kinds = malloc(sizeof(DataType) * ((frame_size > 0) ? frame_size : 1));
+
+    if (!emitter->local_kinds)
+    {
+        cemitter_log_err(emitter, "Out of memory for local types.");
+        return 0;
+    }
+
+    for (unsigned short i = 0; i < frame_size; i++) emitter->local_kinds[i] = NONE_TYPE;
+
+    // NOTE: a declaration in the proc's outer block runs before any use of its slot, and "set" cannot change its type, so a proven type holds for the whole call.
+    for (unsigned int i = 0; body != NULL && body->type == BLOCK_STMT && i < body->syntax.block.count; i++)
+    {
+        local_stmt = body->syntax.block.stmts[i];
+
+        if (!local_stmt || local_stmt->type != VAR_DECL || local_stmt->syntax.var_decl.slot < arity || local_stmt->syntax.var_decl.slot >= frame_size) continue;
+
+        if (cemit_kind_of(local_stmt->syntax.var_decl.value_type) != CVAL_BOXED) emitter->local_kinds[local_stmt->syntax.var_decl.slot] = local_stmt->syntax.var_decl.value_type;
+    }
+
+    emitter->in_proc = 1;
+    emitter->proc_name = stmt->syntax.func_decl.func_name;
+    emitter->frame_size = frame_size;
+    emitter->temp_count = 0;
+    emitter->loop_depth = 0;
+    emitter->indent = 0;
+
+    cemit_line(emitter, "static RunStatus proc_%u(VarValue *args, VarValue *result)", proc_index);
+    cemit_open(emitter);
+    cemit_line(emitter, "RunStatus status = OK_RAN_CMD;");
+    cemit_line(emitter, "AotMark mark = aot_mark();");
+    cemit_line(emitter, "VarValue *f = aot_enter(%u, args, %u);", frame_size, arity);
+
+    for (unsigned short i = 0; i < frame_size; i++)
+    {
+        if (emitter->local_kinds[i] != NONE_TYPE) cemit_line(emitter, "%s v%u = 0;", cemit_c_type(cemit_kind_of(emitter->local_kinds[i])), i);
+    }
+
+    for (unsigned short i = 0; i < frame_size; i++)
+    {
+        if (emitter->local_kinds[i] != NONE_TYPE) cemit_line(emitter, "(void)v%u;", i);
+    }
+
+    cemit_line(emitter, "");
+    cemit_line(emitter, "if (!f) AOT_FAIL(ERR_MEMORY);");
+    cemit_line(emitter, "");
+    cemit_line(emitter, "*result = make_none_varval();");
+
+    emit_ok = cemit_block(emitter, body);
+
+    cemit_line(emitter, "goto done;");
+    emitter->indent--;
+    cemit_line(emitter, "done:");
+    emitter->indent++;
+    cemit_line(emitter, "aot_release(mark);");
+    cemit_line(emitter, "return status;");
+    cemit_close(emitter);
+    cemit_line(emitter, "");
+
+    free(emitter->local_kinds);
+    emitter->local_kinds = NULL;
+    emitter->in_proc = 0;
+    emitter->proc_name = NULL;
+    emitter->frame_size = 0;
+
+    return emit_ok;
+}
+
+/**
+ * @brief Emits the top-level statements in order. Like interpreter_run, each one is a safe point after it runs and the first error stops the script.
+ */
+static int cemit_top_level(CEmitter *emitter, const Script *script)
+{
+    int emit_ok = 1;
+
+    emitter->temp_count = 0;
+    emitter->indent = 0;
+
+    cemit_line(emitter, "static RunStatus run_script()");
+    cemit_open(emitter);
+    cemit_line(emitter, "RunStatus status = OK_RAN_CMD;");
+
+    for (unsigned int i = 0; i < script->count && emit_ok; i++)
+    {
+        if (!script->stmts[i]) continue;
+
+        emitter->stmt_num = i;
+        emitter->defined_below = i;
+
+        cemit_line(emitter, "");
+        cemit_line(emitter, "aot_stmt_num = %u;", i);
+        emit_ok = cemit_stmt(emitter, script->stmts[i]);
+        cemit_line(emitter, "aot_collect_garbage();");
+    }
+
+    cemit_line(emitter, "");
+    cemit_line(emitter, "goto done;");
+    emitter->indent--;
+    cemit_line(emitter, "done:");
+    emitter->indent++;
+    cemit_line(emitter, "return status;");
+    cemit_close(emitter);
+
+    return emit_ok;
+}
+
+int cemit_script(CEmitter *emitter, const Script *script)
+{
+    const Statement *stmt = NULL;
+    unsigned int proc_index = 0;
+
+    for (unsigned int i = 0; i < script->count; i++)
+    {
+        stmt = script->stmts[i];
+
+        if (!stmt || stmt->type != FUNC_DECL || cemit_find_proc(emitter, stmt->syntax.func_decl.func_name, &proc_index)) continue;
+
+        if (!cemit_add_proc(emitter, stmt, i))
+        {
+            cemitter_log_err(emitter, "Out of memory for procs.");
+            return 0;
+        }
+    }
+
+    for (unsigned int i = 0; i < emitter->proc_count; i++) fprintf(emitter->decls, "static RunStatus proc_%u(VarValue *args, VarValue *result); // %s\n", i, emitter->procs[i].name);
+
+    if (emitter->proc_count > 0) fprintf(emitter->decls, "static AotProc proc_defs[%u]; // set once each proc's declaration runs\n", emitter->proc_count);
+
+    for (unsigned int i = 0; i < emitter->proc_count; i++)
+    {
+        emitter->stmt_num = emitter->procs[i].stmt_num;
+        emitter->defined_below = emitter->procs[i].stmt_num + 1;
+
+        if (!cemit_proc(emitter, script->stmts[emitter->procs[i].stmt_num], i)) return 0;
+    }
+
+    if (!cemit_top_level(emitter, script) || emitter->error_count > 0) return 0;
+
+    fprintf(emitter->out, "/* Compiled from %s by rubel --emit-c. */\n\n#include <math.h>\n#include \"backend/runner/aotrt.h\"\n\n", script->name);
+    cemit_copy_stream(emitter->decls, emitter->out);
+    fputs("\nstatic int init_literals()\n{\n", emitter->out);
+    cemit_copy_stream(emitter->inits, emitter->out);
+    fputs("    return 1;\n}\n\n", emitter->out);
+    cemit_copy_stream(emitter->code, emitter->out);
+    fprintf(emitter->out, "\nint main()\n{\n    RunStatus status = ERR_MEMORY;\n\n    if (aot_init(%u) && init_literals()) status = run_script();\n\n    aot_log_err(status);\n    aot_dispose();\n\n    return 0;\n}\n", script->global_count);
+
+    return 1;
+}
@@ -0,0 +1,751 @@
+/**
+ * @file compiler.c
+ * @author Derek Tan
+ * @brief Implements the AST to register bytecode compiler.
+ * @date 2023-08-12
+ */
+
+#include "backend/compiler/compiler.h"
+
+/// SECTION: Compiler utils
+
+int compiler_init(Compiler *compiler, BcProgram *program)
+{
+    compiler->program = program;
+    compiler->proc = NULL;
+    compiler->in_proc = 0;
+    compiler->error_count = 0;
+    compiler->stmt_num = 0;
+    compiler->frame_size = 0;
+    compiler->next_reg = 0;
+    compiler->loop_depth = 0;
+    compiler->patch_count = 0;
+    compiler->patch_capacity = COMPILER_PATCHES_MIN_SZ;
+    compiler->break_patches = malloc(sizeof(unsigned int) * COMPILER_PATCHES_MIN_SZ);
+
+    if (!compiler->break_patches)
+    {
+        compiler_dispose(compiler);
+        return 0;
+    }
+
+    return 1;
+}
+
+void compiler_dispose(Compiler *compiler)
+{
+    free(compiler->break_patches);
+    compiler->break_patches = NULL;
+    compiler->patch_count = 0;
+    compiler->patch_capacity = 0;
+
+    // NOTE: the program is owned by the caller.
+    compiler->program = NULL;
+    compiler->proc = NULL;
+}
+
+void compiler_log_err(Compiler *compiler, const char *msg)
+{
+    compiler->error_count++;
+
+    if (compiler->in_proc)
+        fprintf(stderr, "CompileError at stmt %u in proc %s: %s\n", compiler->stmt_num, compiler->proc->name, msg);
+    else
+        fprintf(stderr, "CompileError at stmt %u: %s\n", compiler->stmt_num, msg);
+}
+
+static unsigned short compiler_alloc_reg(Compiler *compiler)
+{
+    unsigned short reg = compiler->next_reg;
+
+    if (reg == COMPILER_NO_REG)
+    {
+        compiler_log_err(compiler, "Too many registers needed.");
+        return COMPILER_NO_REG;
+    }
+
+    compiler->next_reg++;
+
+    if (compiler->next_reg > compiler->proc->reg_count) compiler->proc->reg_count = compiler->next_reg;
+
+    return reg;
+}
+
+static int compiler_emit(Compiler *compiler, BcOpCode op, unsigned char aux, unsigned short a, unsigned short b, unsigned short c)
+{
+    if (bcproc_emit(compiler->proc, op, aux, a, b, c) > BC_OPERAND_MAX)
+    {
+        compiler_log_err(compiler, "Proc is too long or memory ran out.");
+        return 0;
+    }
+
+    return 1;
+}
+
+static void compiler_patch_jump(Compiler *compiler, unsigned int jump_pos)
+{
+    compiler->proc->code[jump_pos].b = (unsigned short)compiler->proc->count;
+}
+
+/**
+ * @brief Checks if a variable node is outside the current frame. Only procs can see another frame, the globals.
+ */
+static int compiler_is_global(const Compiler *compiler, unsigned short depth)
+{
+    return compiler->in_proc && depth > 0;
+}
+
+/// SECTION: Expression Compiling
+
+unsigned short compile_operand(Compiler *compiler, Expression *expr)
+{
+    unsigned short temp_reg = COMPILER_NO_REG;
+
+    if (!expr)
+    {
+        compiler_log_err(compiler, "Missing expression.");
+        return COMPILER_NO_REG;
+    }
+
+    // NOTE: frame variables can be used in place without a copy.
+    if (expr->type == VAR_USAGE && !compiler_is_global(compiler, expr->syntax.variable.depth)) return expr->syntax.variable.slot;
+
+    temp_reg = compiler_alloc_reg(compiler);
+
+    if (temp_reg == COMPILER_NO_REG) return temp_reg;
+
+    if (!compile_expr(compiler, expr, temp_reg)) return COMPILER_NO_REG;
+
+    return temp_reg;
+}
+
+/**
+ * @brief Puts a literal's value into the constant table.
+ * @return int The constant's index or -1 on failure, which is logged.
+ */
+static int compiler_add_literal(Compiler *compiler, const Expression *expr)
+{
+    VarValue value;
+    int const_index = -1;
+
+    switch (expr->type)
+    {
+    case BOOL_LITERAL:
+        value = (VarValue){.type = BOOL_TYPE, .is_const = 1, .data.bool_val.flag = expr->syntax.bool_literal.flag};
+        break;
+    case INT_LITERAL:
+        value = (VarValue){.type = INT_TYPE, .is_const = 1, .data.int_val.value = expr->syntax.int_literal.value};
+        break;
+    case REAL_LITERAL:
+        value = (VarValue){.type = REAL_TYPE, .is_const = 1, .data.real_val.value = expr->syntax.real_literal.value};
+        break;
+    case STR_LITERAL:
+        value = (VarValue){.type = STR_TYPE, .is_const = 1, .data.str_type.value = expr->syntax.str_literal.str_obj};
+        break;
+    case LIST_LITERAL:
+        value = (VarValue){.type = LIST_TYPE, .is_const = 1, .data.list_type.value = expr->syntax.list_literal.list_obj};
+        break;
+    default:
+        compiler_log_err(compiler, "Invalid literal.");
+        return -1;
+    }
+
+    const_index = bcprogram_add_const(compiler->program, value);
+
+    if (const_index < 0) compiler_log_err(compiler, "Too many constants.");
+
+    return const_index;
+}
+
+int compile_literal(Compiler *compiler, Expression *expr, unsigned short dest)
+{
+    int const_index = compiler_add_literal(compiler, expr);
+
+    if (const_index < 0) return 0;
+
+    return compiler_emit(compiler, BC_LOADK, 0, dest, (unsigned short)const_index, 0);
+}
+
+int compile_var_usage(Compiler *compiler, Expression *expr, unsigned short dest)
+{
+    unsigned short var_reg = expr->syntax.variable.slot;
+
+    if (compiler_is_global(compiler, expr->syntax.variable.depth)) return compiler_emit(compiler, BC_GETGLOBAL, 0, dest, var_reg, 0);
+
+    if (var_reg == dest) return 1;
+
+    return compiler_emit(compiler, BC_MOVE, 0, dest, var_reg, 0);
+}
+
+/**
+ * @brief Emits a call with its args in contiguous registers from dest upwards when possible. A BC_TAILCALL result is never moved since the frame ends with it.
+ */
+static int compile_call_op(Compiler *compiler, Expression *expr, unsigned short dest, BcOpCode opcode)
+{
+    unsigned short reg_mark = compiler->next_reg;
+    unsigned int argc = expr->syntax.fn_call.argc;
+    unsigned short base_reg = dest;
+    unsigned short arg_reg = COMPILER_NO_REG;
+    int name_index = bcprogram_add_name(compiler->program, expr->syntax.fn_call.func_name);
+
+    if (name_index < 0 || argc > 255)
+    {
+        compiler_log_err(compiler, "Bad call name or too many arguments.");
+        return 0;
+    }
+
+    // NOTE: the callee's frame begins at the base register, so a destination on top of the frame can hold args and the result without a move.
+    if (dest + 1 != compiler->next_reg) base_reg = COMPILER_NO_REG;
+
+    for (unsigned int i = 0; i < argc; i++)
+    {
+        arg_reg = (i == 0 && base_reg != COMPILER_NO_REG) ? base_reg : compiler_alloc_reg(compiler);
+
+        if (arg_reg == COMPILER_NO_REG) return 0;
+
+        if (base_reg == COMPILER_NO_REG) base_reg = arg_reg;
+
+        if (!compile_expr(compiler, expr->syntax.fn_call.args[i], arg_reg)) return 0;
+
+        // NOTE: drop argument temporaries so the next argument stays contiguous.
+        compiler->next_reg = arg_reg + 1;
+    }
+
+    if (base_reg == COMPILER_NO_REG) base_reg = compiler_alloc_reg(compiler);
+
+    if (base_reg == COMPILER_NO_REG) return 0;
+
+    if (!compiler_emit(compiler, opcode, (unsigned char)argc, base_reg, (unsigned short)name_index, 0)) return 0;
+
+    compiler->next_reg = reg_mark;
+
+    if (base_reg == dest || opcode == BC_TAILCALL) return 1;
+
+    return compiler_emit(compiler, BC_MOVE, 0, dest, base_reg, 0);
+}
+
+int compile_call(Compiler *compiler, Expression *expr, unsigned short dest)
+{
+    return compile_call_op(compiler, expr, dest, BC_CALL);
+}
+
+int compile_unary(Compiler *compiler, Expression *expr, unsigned short dest)
+{
+    unsigned short reg_mark = compiler->next_reg;
+    unsigned short inner_reg = COMPILER_NO_REG;
+
+    if (expr->syntax.unary_op.op != OP_NEG)
+    {
+        compiler_log_err(compiler, "Unsupported unary operator.");
+        return 0;
+    }
+
+    inner_reg = compile_operand(compiler, expr->syntax.unary_op.expr);
+
+    if (inner_reg == COMPILER_NO_REG) return 0;
+
+    compiler->next_reg = reg_mark;
+
+    return compiler_emit(compiler, BC_NEG, 0, dest, inner_reg, 0);
+}
+
+int compile_binary(Compiler *compiler, Expression *expr, unsigned short dest)
+{
+    unsigned short reg_mark = compiler->next_reg;
+    unsigned short left_reg = COMPILER_NO_REG;
+    unsigned short right_reg = COMPILER_NO_REG;
+    BcOpCode opcode = BC_NOP;
+
+    switch (expr->syntax.binary_op.op)
+    {
+    case OP_ADD: opcode = BC_ADD; break;
+    case OP_SUB: opcode = BC_SUB; break;
+    case OP_MUL: opcode = BC_MUL; break;
+    case OP_DIV: opcode = BC_DIV; break;
+    case OP_EQ: opcode = BC_EQ; break;
+    case OP_NEQ: opcode = BC_NEQ; break;
+    case OP_LT: opcode = BC_LT; break;
+    case OP_LTE: opcode = BC_LTE; break;
+    case OP_GT: opcode = BC_GT; break;
+    case OP_GTE: opcode = BC_GTE; break;
+    default:
+        compiler_log_err(compiler, "Unsupported binary operator.");
+        return 0;
+    }
+
+    // NOTE: math on proven operand types skips the type checks.
+    if (opcode >= BC_ADD && opcode <= BC_DIV && expr->syntax.binary_op.operand_type == INT_TYPE) opcode = opcode - BC_ADD + BC_IADD;
+    else if (opcode >= BC_ADD && opcode <= BC_DIV && expr->syntax.binary_op.operand_type == REAL_TYPE) opcode = opcode - BC_ADD + BC_RADD;
+
+    left_reg = compile_operand(compiler, expr->syntax.binary_op.left);
+
+    if (left_reg == COMPILER_NO_REG) return 0;
+
+    right_reg = compile_operand(compiler, expr->syntax.binary_op.right);
+
+    if (right_reg == COMPILER_NO_REG) return 0;
+
+    compiler->next_reg = reg_mark;
+
+    return compiler_emit(compiler, opcode, 0, dest, left_reg, right_reg);
+}
+
+int compile_expr(Compiler *compiler, Expression *expr, unsigned short dest)
+{
+    if (!expr)
+    {
+        compiler_log_err(compiler, "Missing expression.");
+        return 0;
+    }
+
+    switch (expr->type)
+    {
+    case BOOL_LITERAL:
+    case INT_LITERAL:
+    case REAL_LITERAL:
+    case STR_LITERAL:
+    case LIST_LITERAL:
+        return compile_literal(compiler, expr, dest);
+    case VAR_USAGE:
+        return compile_var_usage(compiler, expr, dest);
+    case FUNC_CALL:
+        return compile_call(compiler, expr, dest);
+    case UNARY_OP:
+        return compile_unary(compiler, expr, dest);
+    case BINARY_OP:
+        return compile_binary(compiler, expr, dest);
+    default:
+        break;
+    }
+
+    compiler_log_err(compiler, "Unknown expression.");
+
+    return 0;
+}
+
+/// SECTION: Statement Compiling
+
+int compile_var_decl(Compiler *compiler, Statement *stmt)
+{
+    Expression *rvalue = stmt->syntax.var_decl.rvalue;
+    unsigned short var_reg = stmt->syntax.var_decl.slot;
+
+    // NOTE: the resolver gave the variable its frame slot, which doubles as its register.
+    if (!compile_expr(compiler, rvalue, var_reg)) return 0;
+
+    // NOTE: only calls can yield none here, since operators already fail on it. Like the walker, declaring none is an error.
+    if (rvalue->type == FUNC_CALL) return compiler_emit(compiler, BC_CHECKVAL, 0, var_reg, 0, 0);
+
+    return 1;
+}
+
+/**
+ * @brief Gets the step of a "set x = x + k" or "set x = x - k" on a frame variable, where k is an int literal small enough for BC_ADDI.
+ * @return int 1 if the assignment has that form.
+ */
+static int compiler_match_step(const Compiler *compiler, const Statement *stmt, int *step)
+{
+    const Expression *rvalue = stmt->syntax.var_assign.rvalue;
+    const Expression *left = NULL;
+    const Expression *right = NULL;
+    OpType op;
+    long long value = 0;
+
+    if (compiler_is_global(compiler, stmt->syntax.var_assign.depth) || rvalue->type != BINARY_OP) return 0;
+
+    op = rvalue->syntax.binary_op.op;
+    left = rvalue->syntax.binary_op.left;
+    right = rvalue->syntax.binary_op.right;
+
+    // NOTE: int adds commute, so "set x = k + x" is a step too. Type errors stay the same either way.
+    if (op == OP_ADD && left->type == INT_LITERAL && right->type == VAR_USAGE)
+    {
+        const Expression *temp = left;
+        left = right;
+        right = temp;
+    }
+
+    if ((op != OP_ADD && op != OP_SUB) || left->type != VAR_USAGE || right->type != INT_LITERAL) return 0;
+
+    if (left->syntax.variable.depth != stmt->syntax.var_assign.depth || left->syntax.variable.slot != stmt->syntax.var_assign.slot) return 0;
+
+    value = right->syntax.int_literal.value;
+
+    if (op == OP_SUB) value = -value;
+
+    if (value < BC_IMM_MIN || value > BC_IMM_MAX) return 0;
+
+    *step = (int)value;
+
+    return 1;
+}
+
+int compile_var_assign(Compiler *compiler, Statement *stmt)
+{
+    unsigned short var_reg = stmt->syntax.var_assign.slot;
+    unsigned short value_reg = COMPILER_NO_REG;
+    int step = 0;
+
+    if (compiler_match_step(compiler, stmt, &step)) return compiler_emit(compiler, BC_ADDI, 0, var_reg, (unsigned short)(short)step, 0);
+
+    value_reg = compile_operand(compiler, stmt->syntax.var_assign.rvalue);
+
+    if (value_reg == COMPILER_NO_REG) return 0;
+
+    if (compiler_is_global(compiler, stmt->syntax.var_assign.depth)) return compiler_emit(compiler, BC_SETGLOBAL, 0, var_reg, value_reg, 0);
+
+    return compiler_emit(compiler, BC_ASSIGN, 0, var_reg, value_reg, 0);
+}
+
+int compile_func_decl(Compiler *compiler, Statement *stmt)
+{
+    unsigned short fn_arity = stmt->syntax.func_decl.argc;
+    BcProc *fn_proc = NULL;
+    int proc_index = -1;
+    int compile_ok = 1;
+
+    if (compiler->in_proc)
+    {
+        compiler_log_err(compiler, "Procs cannot be nested.");
+        return 0;
+    }
+
+    fn_proc = bcproc_create(stmt->syntax.func_decl.func_name, fn_arity);
+
+    if (!fn_proc)
+    {
+        compiler_log_err(compiler, "Out of memory for proc.");
+        return 0;
+    }
+
+    // switch to the proc's own frame: parameters and locals take the first registers
+    BcProc *outer_proc = compiler->proc;
+    unsigned short outer_frame_size = compiler->frame_size;
+    unsigned short outer_next_reg = compiler->next_reg;
+
+    compiler->proc = fn_proc;
+    compiler->in_proc = 1;
+    compiler->frame_size = stmt->syntax.func_decl.frame_size;
+    compiler->next_reg = compiler->frame_size;
+    fn_proc->reg_count = compiler->frame_size;
+
+    compile_ok = compile_block(compiler, stmt->syntax.func_decl.stmts);
+
+    if (compile_ok) compile_ok = compiler_emit(compiler, BC_RETNONE, 0, 0, 0, 0);
+
+    compiler->proc = outer_proc;
+    compiler->in_proc = 0;
+    compiler->frame_size = outer_frame_size;
+    compiler->next_reg = outer_next_reg;
+
+    if (compile_ok) proc_index = bcprogram_add_proc(compiler->program, fn_proc);
+
+    if (proc_index < 0)
+    {
+        if (compile_ok) compiler_log_err(compiler, "Too many procs.");
+
+        bcproc_dispose(fn_proc);
+        free(fn_proc);
+        return 0;
+    }
+
+    return compiler_emit(compiler, BC_DEFPROC, 0, 0, (unsigned short)proc_index, 0);
+}
+
+/**
+ * @brief Emits the jump taken when a condition is false. A comparison becomes one compare-jump whose right side may be a constant, so no bool temporary is made.
+ * @param jump_pos Gets the jump's index for compiler_patch_jump.
+ */
+static int compile_false_jump(Compiler *compiler, Expression *condition, unsigned int *jump_pos)
+{
+    unsigned short reg_mark = compiler->next_reg;
+    unsigned short left_reg = COMPILER_NO_REG;
+    unsigned short right_operand = COMPILER_NO_REG;
+    unsigned char right_is_const = 0;
+    const Expression *right = NULL;
+    BcOpCode opcode = BC_NOP;
+    int const_index = -1;
+
+    if (condition && condition->type == BINARY_OP)
+    {
+        switch (condition->syntax.binary_op.op)
+        {
+        case OP_EQ: opcode = BC_EQJMPF; break;
+        case OP_NEQ: opcode = BC_NEQJMPF; break;
+        case OP_LT: opcode = BC_LTJMPF; break;
+        case OP_LTE: opcode = BC_LTEJMPF; break;
+        case OP_GT: opcode = BC_GTJMPF; break;
+        case OP_GTE: opcode = BC_GTEJMPF; break;
+        default: break;
+        }
+    }
+
+    if (opcode == BC_NOP)
+    {
+        left_reg = compile_operand(compiler, condition);
+
+        if (left_reg == COMPILER_NO_REG) return 0;
+
+        compiler->next_reg = reg_mark;
+        *jump_pos = compiler->proc->count;
+
+        return compiler_emit(compiler, BC_JMPF, 0, left_reg, 0, 0);
+    }
+
+    if (condition->syntax.binary_op.operand_type == INT_TYPE) opcode = opcode - BC_EQJMPF + BC_IEQJMPF;
+
+    right = condition->syntax.binary_op.right;
+    left_reg = compile_operand(compiler, condition->syntax.binary_op.left);
+
+    if (left_reg == COMPILER_NO_REG) return 0;
+
+    if (right->type == BOOL_LITERAL || right->type == INT_LITERAL || right->type == REAL_LITERAL)
+    {
+        const_index = compiler_add_literal(compiler, right);
+
+        if (const_index < 0) return 0;
+
+        right_operand = (unsigned short)const_index;
+        right_is_const = 1;
+    }
+    else
+    {
+        right_operand = compile_operand(compiler, condition->syntax.binary_op.right);
+
+        if (right_operand == COMPILER_NO_REG) return 0;
+    }
+
+    compiler->next_reg = reg_mark;
+    *jump_pos = compiler->proc->count;
+
+    return compiler_emit(compiler, opcode, right_is_const, left_reg, 0, right_operand);
+}
+
+int compile_while(Compiler *compiler, Statement *stmt)
+{
+    unsigned int loop_start = compiler->proc->count;
+    unsigned int exit_jump = 0;
+    unsigned int outer_patch_count = compiler->patch_count;
+
+    if (!compile_false_jump(compiler, stmt->syntax.while_stmt.condition, &exit_jump)) return 0;
+
+    compiler->loop_depth++;
+
+    int body_ok = compile_block(compiler, stmt->syntax.while_stmt.stmts);
+
+    compiler->loop_depth--;
+
+    if (!body_ok || !compiler_emit(compiler, BC_JMP, 0, 0, (unsigned short)loop_start, 0)) return 0;
+
+    compiler_patch_jump(compiler, exit_jump);
+
+    // NOTE: any break in this loop's body exits here too.
+    while (compiler->patch_count > outer_patch_count)
+    {
+        compiler->patch_count--;
+        compiler_patch_jump(compiler, compiler->break_patches[compiler->patch_count]);
+    }
+
+    return 1;
+}
+
+int compile_ifotherwise(Compiler *compiler, Statement *stmt)
+{
+    Statement *other_stmt = stmt->syntax.if_stmt.other;
+    unsigned int else_jump = 0;
+    unsigned int end_jump = 0;
+
+    if (!compile_false_jump(compiler, stmt->syntax.if_stmt.condition, &else_jump)) return 0;
+
+    if (!compile_block(compiler, stmt->syntax.if_stmt.first)) return 0;
+
+    if (!other_stmt)
+    {
+        compiler_patch_jump(compiler, else_jump);
+        return 1;
+    }
+
+    end_jump = compiler->proc->count;
+
+    if (!compiler_emit(compiler, BC_JMP, 0, 0, 0, 0)) return 0;
+
+    compiler_patch_jump(compiler, else_jump);
+
+    if (!compile_block(compiler, other_stmt->syntax.otherwise_stmt.stmts)) return 0;
+
+    compiler_patch_jump(compiler, end_jump);
+
+    return 1;
+}
+
+int compile_break(Compiler *compiler, Statement *stmt)
+{
+    unsigned int new_capacity = compiler->patch_capacity << 1;
+
+    if (compiler->loop_depth == 0)
+    {
+        compiler_log_err(compiler, "Break outside of a loop.");
+        return 0;
+    }
+
+    if (compiler->patch_count == compiler->patch_capacity)
+    {
+        unsigned int *temp_patches = realloc(compiler->break_patches, sizeof(unsigned int) * new_capacity);
+
+        if (!temp_patches)
+        {
+            compiler_log_err(compiler, "Out of memory for jumps.");
+            return 0;
+        }
+
+        compiler->break_patches = temp_patches;
+        compiler->patch_capacity = new_capacity;
+    }
+
+    compiler->break_patches[compiler->patch_count] = compiler->proc->count;
+    compiler->patch_count++;
+
+    return compiler_emit(compiler, BC_JMP, 0, 0, 0, 0);
+}
+
+int compile_return(Compiler *compiler, Statement *stmt)
+{
+    unsigned short result_reg = COMPILER_NO_REG;
+
+    if (!compiler->in_proc)
+    {
+        compiler_log_err(compiler, "Return outside of a proc.");
+        return 0;
+    }
+
+    // NOTE: the call's args go on top of the frame, so the VM can slide them down over the finished proc's registers.
+    if (stmt->syntax.return_stmt.is_tail_call)
+    {
+        result_reg = compiler_alloc_reg(compiler);
+
+        if (result_reg == COMPILER_NO_REG) return 0;
+
+        if (!compile_call_op(compiler, stmt->syntax.return_stmt.result, result_reg, BC_TAILCALL)) return 0;
+
+        return compiler_emit(compiler, BC_RET, 0, result_reg, 0, 0);
+    }
+
+    result_reg = compile_operand(compiler, stmt->syntax.return_stmt.result);
+
+    if (result_reg == COMPILER_NO_REG) return 0;
+
+    return compiler_emit(compiler, BC_RET, 0, result_reg, 0, 0);
+}
+
+int compile_block(Compiler *compiler, Statement *stmt)
+{
+    Statement **stmt_cursor = NULL;
+    unsigned int block_len = 0;
+
+    if (!stmt) return 1;
+
+    if (stmt->type != BLOCK_STMT) return compile_stmt(compiler, stmt);
+
+    stmt_cursor = stmt->syntax.block.stmts;
+    block_len = stmt->syntax.block.count;
+
+    for (unsigned int i = 0; i < block_len; i++)
+    {
+        if (*stmt_cursor != NULL && !compile_stmt(compiler, *stmt_cursor)) return 0;
+
+        stmt_cursor++;
+    }
+
+    return 1;
+}
+
+int compile_stmt(Compiler *compiler, Statement *stmt)
+{
+    int module_index = -1;
+    int compile_ok = 0;
+
+    switch (stmt->type)
+    {
+    case EXPR_STMT:
+        // NOTE: like the tree walker, only lone calls are worth running since other values are unused.
+        if (stmt->syntax.expr_stmt.expr->type != FUNC_CALL) return 1;
+
+        compile_ok = compile_operand(compiler, stmt->syntax.expr_stmt.expr) != COMPILER_NO_REG;
+        break;
+    case MODULE_DEF:
+        compiler_log_err(compiler, "Module declarations are not implemented.");
+        break;
+    case MODULE_USE:
+        module_index = bcprogram_add_name(compiler->program, stmt->syntax.module_usage.module_name);
+        compile_ok = module_index >= 0 && compiler_emit(compiler, BC_USE, 0, 0, (unsigned short)module_index, 0);
+        break;
+    case VAR_DECL:
+        compile_ok = compile_var_decl(compiler, stmt);
+        break;
+    case VAR_ASSIGN:
+        compile_ok = compile_var_assign(compiler, stmt);
+        break;
+    case BLOCK_STMT:
+        compile_ok = compile_block(compiler, stmt);
+        break;
+    case FUNC_DECL:
+        compile_ok = compile_func_decl(compiler, stmt);
+        break;
+    case WHILE_STMT:
+        compile_ok = compile_while(compiler, stmt);
+        break;
+    case IF_STMT:
+        compile_ok = compile_ifotherwise(compiler, stmt);
+        break;
+    case BREAK_STMT:
+        compile_ok = compile_break(compiler, stmt);
+        break;
+    case RETURN_STMT:
+        compile_ok = compile_return(compiler, stmt);
+        break;
+    default:
+        compiler_log_err(compiler, "Unexpected statement.");
+        break;
+    }
+
+    // NOTE: temporaries never outlive a statement.
+    compiler->next_reg = compiler->frame_size;
+
+    return compile_ok;
+}
+
+int compile_script(Compiler *compiler, Script *script)
+{
+    Statement *stmt = NULL;
+    BcProc *script_proc = bcproc_create(NULL, 0);
+
+    if (!script_proc || bcprogram_add_proc(compiler->program, script_proc) != 0)
+    {
+        compiler_log_err(compiler, "Out of memory for script.");
+        free(script_proc);
+        return 0;
+    }
+
+    compiler->proc = script_proc;
+
+    // NOTE: top-level variables own the first registers of the main frame.
+    compiler->frame_size = script->global_count;
+    compiler->next_reg = script->global_count;
+    script_proc->reg_count = script->global_count;
+
+    for (unsigned int i = 0; i < script->count; i++)
+    {
+        stmt = script->stmts[i];
+        compiler->stmt_num = i;
+
+        if (!stmt) continue;
+
+        if (!compiler_emit(compiler, BC_STMT, 0, 0, (unsigned short)(i & 0xFFFF), (unsigned short)(i >> 16))) break;
+
+        compile_stmt(compiler, stmt);
+    }
+
+    compiler_emit(compiler, BC_HALT, 0, 0, 0, 0);
+
+    return compiler->error_count == 0;
+}
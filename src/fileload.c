@@ -1,37 +1,163 @@
 /**
  * @file fileload.c
  * @author Derek Tan
- * @brief Implements file reader function.
+ * @brief Implements script loading by file mapping or buffered reads.
  * @date 2023-07-23
  */
 
+#define _DEFAULT_SOURCE // mmap and sysconf under -std=c11
+
+#include <string.h>
 #include "frontend/fileload.h"
 
-char *load_file(const char *file_path)
+#ifdef FILELOAD_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Reads a stream to its end into a buffer that doubles when full.
+ */
+static int source_read(SourceText *source, FILE *freader)
+{
+    size_t capacity = FILELOAD_CHUNK_SZ;
+    size_t length = 0;
+    size_t copy_count = 0;
+    char *buffer = malloc(capacity + 1);
+    char *temp_buffer = NULL;
+
+    if (!buffer) return 0;
+
+    while ((copy_count = fread(buffer + length, 1, capacity - length, freader)) > 0)
+    {
+        length += copy_count;
+
+        if (length < capacity) continue;
+
+        temp_buffer = realloc(buffer, (capacity << 1) + 1);
+
+        if (!temp_buffer)
+        {
+            free(buffer);
+            return 0;
+        }
+
+        buffer = temp_buffer;
+        capacity <<= 1;
+    }
+
+    buffer[length] = '\0';
+
+    source->text = buffer;
+    source->length = length;
+    source->map_size = 0;
+
+    return 1;
+}
+
+#ifdef FILELOAD_MMAP
+
+/**
+ * @brief Maps a regular file with at least one zeroed byte after it.
+ */
+static int source_map(SourceText *source, int fd, size_t file_len)
 {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t map_size = (file_len / page_size + 1) * page_size;
+    void *reserved = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (reserved == MAP_FAILED) return 0;
+
+    // NOTE: the file's pages go over the front of a zeroed reservation, so a NUL follows the text even when it fills its last page.
+    if (mmap(reserved, file_len, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        munmap(reserved, map_size);
+        return 0;
+    }
+
+    // NOTE: the lexer reads the text once from front to back.
+    madvise(reserved, file_len, MADV_SEQUENTIAL);
+
+    source->text = reserved;
+    source->length = file_len;
+    source->map_size = map_size;
+
+    return 1;
+}
+
+#endif
+
+int load_source(SourceText *source, const char *file_path)
+{
+    FILE *freader = NULL;
+    int load_ok = 0;
+
+    source->text = NULL;
+    source->length = 0;
+    source->map_size = 0;
+    source->is_stream = 0;
+
     // Check if file can be read.
-    if (file_path == NULL) return NULL;
+    if (file_path == NULL) return 0;
+
+    if (strcmp(file_path, FILELOAD_STDIN_NAME) == 0)
+    {
+        source->is_stream = 1;
+        return source_read(source, stdin);
+    }
+
+#ifdef FILELOAD_MMAP
+    struct stat file_info;
+    int fd = open(file_path, O_RDONLY);
+
+    if (fd < 0) return 0;
 
-    FILE *freader = fopen(file_path, "r");
+    if (fstat(fd, &file_info) != 0)
+    {
+        close(fd);
+        return 0;
+    }
 
-    if (!freader) return NULL;
+    // NOTE: pipes and devices cannot be mapped, and empty files have nothing to map. Both are read instead.
+    source->is_stream = !S_ISREG(file_info.st_mode);
 
-    size_t file_len = 0;
-    char *result = NULL;
+    if (!source->is_stream && file_info.st_size > 0 && source_map(source, fd, (size_t)file_info.st_size))
+    {
+        close(fd);
+        return 1;
+    }
 
-    // Get file length to know how much to read as a c-string.
-    fseek(freader, 0, SEEK_END);
-    file_len = ftell(freader);
-    fseek(freader, 0, SEEK_SET);
+    freader = fdopen(fd, "r");
 
-    result = malloc(file_len + 1);
+    if (!freader)
+    {
+        close(fd);
+        return 0;
+    }
+#else
+    freader = fopen(file_path, "r");
 
-    // Read N bytes or characters...
-    size_t copy_count = fread(result, 1, file_len, freader);
-    result[copy_count] = '\0';
+    if (!freader) return 0;
+#endif
 
+    load_ok = source_read(source, freader);
     fclose(freader);
-    freader = NULL;
 
-    return result;
+    return load_ok;
+}
+
+void unload_source(SourceText *source)
+{
+#ifdef FILELOAD_MMAP
+    if (source->map_size > 0) munmap(source->text, source->map_size);
+    else free(source->text);
+#else
+    free(source->text);
+#endif
+
+    source->text = NULL;
+    source->length = 0;
+    source->map_size = 0;
 }
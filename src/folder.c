@@ -0,0 +1,347 @@
+/**
+ * @file folder.c
+ * @author Derek Tan
+ * @brief Implements the constant folding pass.
+ * @date 2023-08-19
+ */
+
+#include <limits.h>
+#include "frontend/folder.h"
+#include "frontend/resolver.h"
+
+/// SECTION: Folder utils
+
+int folder_init(Folder *folder, Script *script)
+{
+    folder->arena = &script->arena;
+    folder->in_proc = 0;
+    folder->global_count = script->global_count;
+    folder->folded_count = 0;
+    folder->propagated_count = 0;
+    folder->pruned_count = 0;
+    folder->const_globals = calloc((script->global_count > 0) ? script->global_count : 1, sizeof(Expression *));
+
+    return folder->const_globals != NULL;
+}
+
+void folder_dispose(Folder *folder)
+{
+    free(folder->const_globals);
+    folder->const_globals = NULL;
+    folder->arena = NULL;
+}
+
+static int folder_is_literal(const Expression *expr)
+{
+    return expr->type == BOOL_LITERAL || expr->type == INT_LITERAL || expr->type == REAL_LITERAL;
+}
+
+/**
+ * @brief Replaces a use of a const global by a copy of its literal. Literal nodes own nothing, so copying them is enough.
+ */
+static void folder_propagate(Folder *folder, Expression *expr)
+{
+    unsigned short depth = expr->syntax.variable.depth;
+    unsigned short slot = expr->syntax.variable.slot;
+    int is_global = (folder->in_proc) ? depth == RESOLVE_DEPTH_GLOBAL : depth == RESOLVE_DEPTH_LOCAL;
+
+    if (!is_global || slot >= folder->global_count || folder->const_globals[slot] == NULL) return;
+
+    *expr = *folder->const_globals[slot];
+    folder->propagated_count++;
+}
+
+/// SECTION: Expression folding
+/// NOTE: these follow eval_unary, compare_primitives and math_primitives, so a folded value is the one the engines would make.
+
+static void fold_unary(Folder *folder, Expression *expr)
+{
+    Expression *inner = expr->syntax.unary_op.expr;
+
+    if (expr->syntax.unary_op.op != OP_NEG) return;
+
+    if (inner->type == INT_LITERAL)
+    {
+        int value = inner->syntax.int_literal.value;
+
+        expr->type = INT_LITERAL;
+        expr->syntax.int_literal.value = INT_WRAP_SUB(0, value);
+    }
+    else if (inner->type == REAL_LITERAL)
+    {
+        float value = inner->syntax.real_literal.value;
+
+        expr->type = REAL_LITERAL;
+        expr->syntax.real_literal.value = 0 - value;
+    }
+    else
+    {
+        return;
+    }
+
+    folder->folded_count++;
+}
+
+static int fold_comparison(OpType op, const Expression *left, const Expression *right)
+{
+    int pre_eq, pre_gt, pre_lt;
+
+    if (left->type == REAL_LITERAL)
+    {
+        pre_eq = left->syntax.real_literal.value == right->syntax.real_literal.value;
+        pre_gt = left->syntax.real_literal.value > right->syntax.real_literal.value;
+        pre_lt = left->syntax.real_literal.value < right->syntax.real_literal.value;
+    }
+    else
+    {
+        // NOTE: bools and ints share their compare rules.
+        int left_n = (left->type == BOOL_LITERAL) ? left->syntax.bool_literal.flag : left->syntax.int_literal.value;
+        int right_n = (right->type == BOOL_LITERAL) ? right->syntax.bool_literal.flag : right->syntax.int_literal.value;
+
+        pre_eq = left_n == right_n;
+        pre_gt = left_n > right_n;
+        pre_lt = left_n < right_n;
+    }
+
+    if (op == OP_EQ) return pre_eq;
+    if (op == OP_NEQ) return !pre_eq;
+    if (op == OP_GT) return pre_gt;
+    if (op == OP_GTE) return pre_gt || pre_eq;
+    if (op == OP_LT) return pre_lt;
+
+    return pre_lt || pre_eq;
+}
+
+static void fold_binary(Folder *folder, Expression *expr)
+{
+    OpType op = expr->syntax.binary_op.op;
+    Expression *left = expr->syntax.binary_op.left;
+    Expression *right = expr->syntax.binary_op.right;
+    int is_compare = op == OP_EQ || op == OP_NEQ || op == OP_GT || op == OP_GTE || op == OP_LT || op == OP_LTE;
+    int is_math = op == OP_ADD || op == OP_SUB || op == OP_MUL || op == OP_DIV;
+
+    // NOTE: mixed types are runtime errors, so they are kept for the engines to report.
+    if (!folder_is_literal(left) || !folder_is_literal(right) || left->type != right->type) return;
+
+    if (is_compare)
+    {
+        int flag = fold_comparison(op, left, right);
+
+        expr->type = BOOL_LITERAL;
+        expr->syntax.bool_literal.flag = flag;
+    }
+    else if (is_math && left->type == INT_LITERAL)
+    {
+        int left_int = left->syntax.int_literal.value;
+        int right_int = right->syntax.int_literal.value;
+        int value = 0;
+
+        // NOTE: INT_MIN / -1 traps on the host just like division by zero, so both are left to the engines.
+        if (op == OP_DIV && (right_int == 0 || (right_int == -1 && left_int == INT_MIN))) return;
+
+        // NOTE: this wraps like the engines do, so a folded result is the one they would give.
+        if (op == OP_ADD) value = INT_WRAP_ADD(left_int, right_int);
+        else if (op == OP_SUB) value = INT_WRAP_SUB(left_int, right_int);
+        else if (op == OP_MUL) value = INT_WRAP_MUL(left_int, right_int);
+        else value = left_int / right_int;
+
+        expr->type = INT_LITERAL;
+        expr->syntax.int_literal.value = value;
+    }
+    else if (is_math && left->type == REAL_LITERAL)
+    {
+        float left_flt = left->syntax.real_literal.value;
+        float right_flt = right->syntax.real_literal.value;
+        float value = 0;
+
+        if (op == OP_DIV && right_flt == 0) return;
+
+        if (op == OP_ADD) value = left_flt + right_flt;
+        else if (op == OP_SUB) value = left_flt - right_flt;
+        else if (op == OP_MUL) value = left_flt * right_flt;
+        else value = left_flt / right_flt;
+
+        expr->type = REAL_LITERAL;
+        expr->syntax.real_literal.value = value;
+    }
+    else
+    {
+        return;
+    }
+
+    folder->folded_count++;
+}
+
+void fold_expr(Folder *folder, Expression *expr)
+{
+    switch (expr->type)
+    {
+    case VAR_USAGE:
+        folder_propagate(folder, expr);
+        break;
+    case FUNC_CALL:
+        for (unsigned int i = 0; i < expr->syntax.fn_call.argc; i++) fold_expr(folder, expr->syntax.fn_call.args[i]);
+        break;
+    case UNARY_OP:
+        fold_expr(folder, expr->syntax.unary_op.expr);
+        fold_unary(folder, expr);
+        break;
+    case BINARY_OP:
+        fold_expr(folder, expr->syntax.binary_op.left);
+        fold_expr(folder, expr->syntax.binary_op.right);
+        fold_binary(folder, expr);
+        break;
+    default:
+        break; // NOTE: literals are already folded.
+    }
+}
+
+/// SECTION: Statement folding
+
+/**
+ * @brief Tells if a statement can be replaced by the statements of one of its branches, or by none at all.
+ */
+static int folder_is_decided(const Statement *stmt)
+{
+    const Expression *condition = NULL;
+
+    if (stmt->type == IF_STMT) condition = stmt->syntax.if_stmt.condition;
+    else if (stmt->type == WHILE_STMT) condition = stmt->syntax.while_stmt.condition;
+    else return 0;
+
+    if (condition->type != BOOL_LITERAL) return 0;
+
+    // NOTE: a loop that always runs may still end by a return, so only loops that never run are dropped.
+    return stmt->type == IF_STMT || !condition->syntax.bool_literal.flag;
+}
+
+/**
+ * @brief Appends the statements that a decided if or while would run to a new block.
+ */
+static int folder_splice(Folder *folder, Statement *dest_block, const Statement *stmt)
+{
+    const Statement *branch = NULL;
+
+    if (stmt->type == IF_STMT && stmt->syntax.if_stmt.condition->syntax.bool_literal.flag) branch = stmt->syntax.if_stmt.first;
+    else if (stmt->type == IF_STMT && stmt->syntax.if_stmt.other != NULL) branch = stmt->syntax.if_stmt.other->syntax.otherwise_stmt.stmts;
+
+    folder->pruned_count++;
+
+    if (!branch) return 1;
+
+    if (branch->type != BLOCK_STMT) return grow_block_stmt(folder->arena, dest_block, (Statement *)branch);
+
+    for (unsigned int i = 0; i < branch->syntax.block.count; i++)
+    {
+        if (!grow_block_stmt(folder->arena, dest_block, branch->syntax.block.stmts[i])) return 0;
+    }
+
+    return 1;
+}
+
+int fold_block(Folder *folder, Statement *stmt)
+{
+    Statement *new_block = NULL;
+    Statement *curr_stmt = NULL;
+    int has_decided = 0;
+
+    if (!stmt) return 1;
+
+    if (stmt->type != BLOCK_STMT) return fold_stmt(folder, stmt);
+
+    for (unsigned int i = 0; i < stmt->syntax.block.count; i++)
+    {
+        if (!fold_stmt(folder, stmt->syntax.block.stmts[i])) return 0;
+
+        if (folder_is_decided(stmt->syntax.block.stmts[i])) has_decided = 1;
+    }
+
+    if (!has_decided) return 1;
+
+    // NOTE: branches were folded above, so their statements move into a new vector as they are. The old vector is left in the arena.
+    new_block = create_block_stmt(folder->arena);
+
+    if (!new_block) return 0;
+
+    for (unsigned int i = 0; i < stmt->syntax.block.count; i++)
+    {
+        curr_stmt = stmt->syntax.block.stmts[i];
+
+        if (folder_is_decided(curr_stmt))
+        {
+            if (!folder_splice(folder, new_block, curr_stmt)) return 0;
+        }
+        else if (!grow_block_stmt(folder->arena, new_block, curr_stmt))
+        {
+            return 0;
+        }
+    }
+
+    stmt->syntax.block = new_block->syntax.block;
+
+    return 1;
+}
+
+int fold_stmt(Folder *folder, Statement *stmt)
+{
+    Statement *other_stmt = NULL;
+    Expression *rvalue = NULL;
+    int fold_ok = 1;
+
+    switch (stmt->type)
+    {
+    case EXPR_STMT:
+        fold_expr(folder, stmt->syntax.expr_stmt.expr);
+        break;
+    case VAR_DECL:
+        rvalue = stmt->syntax.var_decl.rvalue;
+        fold_expr(folder, rvalue);
+
+        // NOTE: top-level declarations run once and in order, so code folded after this one only runs after the const is set.
+        if (!folder->in_proc && stmt->syntax.var_decl.is_const && (folder_is_literal(rvalue) || rvalue->type == STR_LITERAL))
+            folder->const_globals[stmt->syntax.var_decl.slot] = rvalue;
+        break;
+    case VAR_ASSIGN:
+        fold_expr(folder, stmt->syntax.var_assign.rvalue);
+        break;
+    case BLOCK_STMT:
+        fold_ok = fold_block(folder, stmt);
+        break;
+    case FUNC_DECL:
+        folder->in_proc = 1;
+        fold_ok = fold_block(folder, stmt->syntax.func_decl.stmts);
+        folder->in_proc = 0;
+        break;
+    case WHILE_STMT:
+        fold_expr(folder, stmt->syntax.while_stmt.condition);
+        fold_ok = fold_block(folder, stmt->syntax.while_stmt.stmts);
+        break;
+    case IF_STMT:
+        other_stmt = stmt->syntax.if_stmt.other;
+        fold_expr(folder, stmt->syntax.if_stmt.condition);
+        fold_ok = fold_block(folder, stmt->syntax.if_stmt.first);
+
+        if (fold_ok && other_stmt != NULL) fold_ok = fold_block(folder, other_stmt->syntax.otherwise_stmt.stmts);
+        break;
+    case RETURN_STMT:
+        fold_expr(folder, stmt->syntax.return_stmt.result);
+        break;
+    case MODULE_DEF:
+    case MODULE_USE:
+    case BREAK_STMT:
+    default:
+        break;
+    }
+
+    return fold_ok;
+}
+
+int fold_script(Folder *folder, Script *script)
+{
+    for (unsigned int i = 0; i < script->count; i++)
+    {
+        if (script->stmts[i] != NULL && !fold_stmt(folder, script->stmts[i])) return 0;
+    }
+
+    return 1;
+}
@@ -9,84 +9,21 @@
 
 /// SECTION: Args Impl.
 
-FuncArgs *funcargs_create(unsigned short argc)
+void funcargs_init(FuncArgs *argv, unsigned short argc, VarValue *args)
 {
     unsigned short checked_argc = argc;
 
     if (checked_argc > FUNC_ARGV_MAX_SZ) checked_argc = FUNC_ARGV_MAX_SZ;
 
-    FuncArgs *argv = malloc(sizeof(FuncArgs));
-
-    if (argv != NULL)
-    {
-        VarValue **temp_args = malloc(sizeof(VarValue *) * checked_argc);
-
-        for (unsigned short i = 0; i < checked_argc; i++)
-        {
-            temp_args[i] = NULL;
-        }
-
-        argv->args = temp_args;
-        argv->argc = checked_argc;
-    }
-
-    return argv;
-}
-
-void funcargs_dispose(FuncArgs *argv)
-{
-    if (argv->args != NULL)
-    {
-        free(argv->args);
-        argv->args = NULL;
-    }
-
-    argv->argc = 0;
-}
-
-void funcargs_destroy(FuncArgs *argv)
-{
-    unsigned short count = argv->argc;
-    VarValue **target_cursor = argv->args;
-    VarValue *target = NULL;
-
-    for (unsigned short i = 0; i < count; i++)
-    {
-        target = *target_cursor;
-
-        switch (target->type)
-        {
-        case STR_TYPE:
-            destroy_str_obj(target->data.str_type.value);
-            target->data.str_type.value = NULL;
-            break;
-        case LIST_TYPE:
-            destroy_list_obj(target->data.list_type.value);
-            target->data.list_type.value = NULL;
-            break;
-        default:
-            break;
-        }
-
-        target_cursor++;
-    }
-    
-}
-
-int funcargs_set_at(FuncArgs *argv, unsigned short index, VarValue *arg)
-{
-    if (index >= argv->argc) return 0;
-
-    argv->args[index] = arg;
-
-    return 1;
+    argv->argc = checked_argc;
+    argv->args = args;
 }
 
 VarValue *funcargs_get_at(const FuncArgs *argv, unsigned short index)
 {
     if (index >= argv->argc) return NULL;
 
-    return argv->args[index];
+    return argv->args + index;
 }
 
 
@@ -205,14 +142,15 @@ FuncObj *func_native_create(char *name, int arity, NativeFunc fn_ptr)
     {
         fn_obj->type = FUNC_NATIVE;
         fn_obj->arity = arity;
-        fn_obj->name = name;
+        fn_obj->frame_size = 0;
+        fn_obj->name = intern_cstr(name); // NOTE: native names are C literals, so give them the pooled address scripts use.
         fn_obj->content.fn_ptr = fn_ptr;
     }
 
     return fn_obj;
 }
 
-FuncObj *func_ast_create(char *name, int arity, Expression **param_exprs, Statement *fn_ast)
+FuncObj *func_ast_create(char *name, int arity, unsigned short frame_size, Expression **param_exprs, Statement *fn_ast)
 {
     FuncObj *fn_obj = malloc(sizeof(FuncObj));
 
@@ -220,6 +158,7 @@ FuncObj *func_ast_create(char *name, int arity, Expression **param_exprs, Statem
     {
         fn_obj->type = FUNC_NORMAL;
         fn_obj->arity = arity;
+        fn_obj->frame_size = frame_size;
         fn_obj->name = name;
         fn_obj->param_exprs = param_exprs;
         fn_obj->content.fn_ast = fn_ast;
@@ -228,14 +167,28 @@ FuncObj *func_ast_create(char *name, int arity, Expression **param_exprs, Statem
     return fn_obj;
 }
 
-void func_dispose(FuncObj *fn_obj)
+FuncObj *func_bytecode_create(char *name, int arity, const struct st_bc_proc *fn_code)
 {
-    if (fn_obj->name != NULL && fn_obj->type != FUNC_NATIVE)
+    FuncObj *fn_obj = malloc(sizeof(FuncObj));
+
+    if (fn_obj != NULL)
     {
-        free(fn_obj->name);
-        fn_obj->name = NULL;
+        fn_obj->type = FUNC_BYTECODE;
+        fn_obj->arity = arity;
+        fn_obj->frame_size = 0;
+        fn_obj->name = name;
+        fn_obj->param_exprs = NULL;
+        fn_obj->content.fn_code = fn_code;
     }
 
+    return fn_obj;
+}
+
+void func_dispose(FuncObj *fn_obj)
+{
+    // NOTE: names are interned, so the pool owns them.
+    fn_obj->name = NULL;
+
     switch (fn_obj->type)
     {
     case FUNC_NORMAL:
@@ -244,6 +197,9 @@ void func_dispose(FuncObj *fn_obj)
     case FUNC_NATIVE:
         fn_obj->content.fn_ptr = NULL;
         break;
+    case FUNC_BYTECODE:
+        fn_obj->content.fn_code = NULL; // NOTE: the BcProgram owns compiled procs.
+        break;
     default:
         break;
     }
@@ -255,39 +211,27 @@ void func_dispose(FuncObj *fn_obj)
 
 FuncGroup *funcgroup_create(char *name, unsigned int buckets)
 {
-    FuncObj **temp_buckets = NULL;
     FuncGroup *fn_group = malloc(sizeof(FuncGroup));
+    size_t capacity = hash_capacity_for((buckets < FUNC_GROUP_SIZE) ? FUNC_GROUP_SIZE : buckets);
 
-    if (fn_group != NULL)
-    {
-        temp_buckets = malloc(sizeof(FuncObj *) * buckets);
-    }
+    if (!fn_group) return NULL;
 
-    if (!temp_buckets)
-    {
-        fn_group->fn_buckets = NULL;
-        fn_group->count = 0;
-        fn_group->name = name;
-        fn_group->used = 0;
-        return fn_group;
-    }
-
-    for (size_t i = 0; i < buckets; i++) temp_buckets[i] = NULL;
-
-    fn_group->fn_buckets = temp_buckets;
-    fn_group->count = buckets;
-    fn_group->name = name;
+    fn_group->used = 0;
+    fn_group->name = intern_cstr(name); // NOTE: module names are compared by address in funcenv_fetch.
+    fn_group->count = 0;
+    fn_group->fn_buckets = calloc(capacity, sizeof(FuncObj *));
+    fn_group->capacity = (fn_group->fn_buckets != NULL) ? capacity : 0;
 
     return fn_group;
 }
 
 void funcgroup_dispose(FuncGroup *fn_group)
 {
-    fn_group->name = NULL; // TODO: add check for module's nativeness before unbind OR freeing the name string.
+    fn_group->name = NULL; // NOTE: the intern pool owns the name.
 
-    size_t fn_count = fn_group->count;
+    size_t fn_capacity = fn_group->capacity;
 
-    for (size_t i = 0; i < fn_count; i++)
+    for (size_t i = 0; i < fn_capacity; i++)
     {
         FuncObj *fn_ref = fn_group->fn_buckets[i];
 
@@ -301,11 +245,10 @@ void funcgroup_dispose(FuncGroup *fn_group)
         fn_group->fn_buckets[i] = NULL;
     }
 
-    if (fn_group->count >= 1)
-    {
-        free(fn_group->fn_buckets);
-        fn_group->fn_buckets = NULL;
-    }
+    free(fn_group->fn_buckets);
+    fn_group->fn_buckets = NULL;
+    fn_group->capacity = 0;
+    fn_group->count = 0;
 }
 
 void funcgroup_mark_used(FuncGroup *fn_group, int flag)
@@ -318,28 +261,66 @@ int funcgroup_is_used(const FuncGroup *fn_group)
     return fn_group->used;
 }
 
-int funcgroup_put(FuncGroup *fn_group, FuncObj *fn_obj)
+/**
+ * @brief Finds the bucket holding the name, or the free bucket where it would go.
+ */
+static size_t funcgroup_probe(FuncObj **fn_buckets, size_t capacity, const char *fn_name)
 {
-    if (!fn_obj || fn_group->count == 0) return 0;
+    size_t mask = capacity - 1;
+    size_t index = intern_hash(fn_name) & mask;
 
-    size_t bucket_index = hash_key(fn_obj->name) % fn_group->count;
+    while (fn_buckets[index] != NULL && fn_buckets[index]->name != fn_name)
+        index = (index + 1) & mask;
 
-    if (!fn_group->fn_buckets[bucket_index])
+    return index;
+}
+
+static int funcgroup_grow(FuncGroup *fn_group)
+{
+    size_t new_capacity = (size_t)fn_group->capacity << 1;
+    FuncObj **new_buckets = calloc(new_capacity, sizeof(FuncObj *));
+    FuncObj *fn_ref = NULL;
+
+    if (!new_buckets) return 0;
+
+    for (size_t i = 0; i < fn_group->capacity; i++)
     {
-        fn_group->fn_buckets[bucket_index] = fn_obj;
-        return 1;
+        fn_ref = fn_group->fn_buckets[i];
+
+        if (fn_ref != NULL) new_buckets[funcgroup_probe(new_buckets, new_capacity, fn_ref->name)] = fn_ref;
     }
 
-    return 0;
+    free(fn_group->fn_buckets);
+    fn_group->fn_buckets = new_buckets;
+    fn_group->capacity = new_capacity;
+
+    return 1;
 }
 
-const FuncObj *funcgroup_get(const FuncGroup *fn_group, const char *fn_name)
+int funcgroup_put(FuncGroup *fn_group, FuncObj *fn_obj)
 {
-    if (!fn_name || fn_group->count == 0) return NULL;
+    size_t bucket_index = 0;
+
+    if (!fn_obj || !fn_obj->name || fn_group->capacity == 0) return 0;
+
+    if ((fn_group->count + 1) * 4 > fn_group->capacity * 3 && !funcgroup_grow(fn_group)) return 0;
+
+    bucket_index = funcgroup_probe(fn_group->fn_buckets, fn_group->capacity, fn_obj->name);
 
-    size_t bucket_index = hash_key(fn_name) % fn_group->count;
+    // NOTE: procs cannot be redefined within a module.
+    if (fn_group->fn_buckets[bucket_index] != NULL) return 0;
 
-    return fn_group->fn_buckets[bucket_index];
+    fn_group->fn_buckets[bucket_index] = fn_obj;
+    fn_group->count++;
+
+    return 1;
+}
+
+const FuncObj *funcgroup_get(const FuncGroup *fn_group, const char *fn_name)
+{
+    if (!fn_name || fn_group->capacity == 0) return NULL;
+
+    return fn_group->fn_buckets[funcgroup_probe(fn_group->fn_buckets, fn_group->capacity, fn_name)];
 }
 
 FuncEnv *funcenv_create(unsigned int capacity)
@@ -347,10 +328,14 @@ FuncEnv *funcenv_create(unsigned int capacity)
     FuncGroup **temp_fn_groups = NULL;
     FuncEnv *fenv = malloc(sizeof(FuncEnv));
 
-    if (fenv != NULL)
-    {
-        temp_fn_groups = malloc(sizeof(FuncGroup *) * capacity);
-    }
+    if (!fenv) return NULL;
+
+    temp_fn_groups = malloc(sizeof(FuncGroup *) * capacity);
+
+    fenv->index = calloc(FUNC_GROUP_SIZE, sizeof(FuncObj *));
+    fenv->index_capacity = (fenv->index != NULL) ? FUNC_GROUP_SIZE : 0;
+    fenv->index_count = 0;
+    fenv->generation = 1; // NOTE: 0 marks an empty call site cache.
 
     if (!temp_fn_groups)
     {
@@ -374,10 +359,16 @@ FuncEnv *funcenv_create(unsigned int capacity)
 
 void funcenv_dispose(FuncEnv *fenv)
 {
-    if (fenv->count == 0) return;
-
     size_t fn_group_count = fenv->count;
 
+    // NOTE: the index only borrows function objects from the groups.
+    free(fenv->index);
+    fenv->index = NULL;
+    fenv->index_capacity = 0;
+    fenv->index_count = 0;
+
+    if (fenv->count == 0) return;
+
     for (size_t i = 0; i < fn_group_count; i++)
     {
         funcgroup_dispose(fenv->func_groups[i]);
@@ -398,11 +389,14 @@ int funcenv_append(FuncEnv *fenv, FuncGroup *fn_group_obj)
 
     if (!fn_group_obj) return 0;
 
-    if (next_spot <= curr_capacity - 1)
+    fenv->generation++;
+
+    if (next_spot < curr_capacity)
     {
         fenv->func_groups[next_spot] = fn_group_obj;
         fenv->count++;
-        return 1;
+
+        return !funcgroup_is_used(fn_group_obj) || funcenv_rebuild_index(fenv);
     }
 
     FuncGroup **temp_group_array = realloc(fenv->func_groups, sizeof(FuncGroup *) * new_capacity);
@@ -419,7 +413,7 @@ int funcenv_append(FuncEnv *fenv, FuncGroup *fn_group_obj)
     fenv->count++;
     fenv->capacity = new_capacity;
 
-    return 1;
+    return !funcgroup_is_used(fn_group_obj) || funcenv_rebuild_index(fenv);
 }
 
 FuncGroup *funcenv_fetch(const FuncEnv *fenv, const char *group_name)
@@ -432,12 +426,9 @@ FuncGroup *funcenv_fetch(const FuncEnv *fenv, const char *group_name)
     {
         result = *search_ptr;
 
-        if (result->name != NULL)
+        if (result->name != NULL && result->name == group_name)
         {
-            if (strcmp(result->name, group_name) == 0)
-            {
-                return result;
-            }
+            return result;
         }
 
         countdown--;
@@ -446,3 +437,107 @@ FuncGroup *funcenv_fetch(const FuncEnv *fenv, const char *group_name)
 
     return NULL;
 }
+
+static size_t funcenv_index_probe(const FuncObj **index, size_t capacity, const char *fn_name)
+{
+    size_t mask = capacity - 1;
+    size_t slot = intern_hash(fn_name) & mask;
+
+    while (index[slot] != NULL && index[slot]->name != fn_name)
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+static int funcenv_index_grow(FuncEnv *fenv)
+{
+    size_t new_capacity = (size_t)fenv->index_capacity << 1;
+    const FuncObj **new_index = calloc(new_capacity, sizeof(FuncObj *));
+    const FuncObj *fn_ref = NULL;
+
+    if (!new_index) return 0;
+
+    for (size_t i = 0; i < fenv->index_capacity; i++)
+    {
+        fn_ref = fenv->index[i];
+
+        if (fn_ref != NULL) new_index[funcenv_index_probe(new_index, new_capacity, fn_ref->name)] = fn_ref;
+    }
+
+    free(fenv->index);
+    fenv->index = new_index;
+    fenv->index_capacity = new_capacity;
+
+    return 1;
+}
+
+/**
+ * @brief Indexes a function. An indexed name is only replaced when override is set.
+ */
+static int funcenv_index_add(FuncEnv *fenv, const FuncObj *fn_obj, int override)
+{
+    size_t slot = 0;
+
+    if (fenv->index_capacity == 0) return 0;
+
+    if ((fenv->index_count + 1) * 4 > fenv->index_capacity * 3 && !funcenv_index_grow(fenv)) return 0;
+
+    slot = funcenv_index_probe(fenv->index, fenv->index_capacity, fn_obj->name);
+
+    if (!fenv->index[slot]) fenv->index_count++;
+    else if (!override) return 1;
+
+    fenv->index[slot] = fn_obj;
+
+    return 1;
+}
+
+int funcenv_rebuild_index(FuncEnv *fenv)
+{
+    const FuncGroup *group_ref = NULL;
+
+    for (size_t i = 0; i < fenv->index_capacity; i++) fenv->index[i] = NULL;
+
+    fenv->index_count = 0;
+
+    for (unsigned int i = 0; i < fenv->count; i++)
+    {
+        group_ref = fenv->func_groups[i];
+
+        if (!funcgroup_is_used(group_ref)) continue;
+
+        for (unsigned int j = 0; j < group_ref->capacity; j++)
+        {
+            if (group_ref->fn_buckets[j] != NULL && !funcenv_index_add(fenv, group_ref->fn_buckets[j], 0)) return 0;
+        }
+    }
+
+    return 1;
+}
+
+int funcenv_use_group(FuncEnv *fenv, FuncGroup *fn_group)
+{
+    // NOTE: using a module twice changes nothing, so skip the rebuild.
+    if (funcgroup_is_used(fn_group)) return 1;
+
+    funcgroup_mark_used(fn_group, 1);
+    fenv->generation++;
+
+    return funcenv_rebuild_index(fenv);
+}
+
+int funcenv_define(FuncEnv *fenv, FuncObj *fn_obj)
+{
+    if (fenv->count == 0 || !funcgroup_put(fenv->func_groups[0], fn_obj)) return 0;
+
+    fenv->generation++;
+
+    return funcenv_index_add(fenv, fn_obj, 1);
+}
+
+const FuncObj *funcenv_lookup(const FuncEnv *fenv, const char *fn_name)
+{
+    if (!fn_name || fenv->index_capacity == 0) return NULL;
+
+    return fenv->index[funcenv_index_probe(fenv->index, fenv->index_capacity, fn_name)];
+}
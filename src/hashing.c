@@ -9,15 +9,34 @@
 
 size_t hash_key(const char *key)
 {
-    size_t key_len = strlen(key);
-    size_t base = 1;
-    size_t hash_num = 0;
+    return hash_key_n(key, strlen(key));
+}
+
+size_t hash_key_n(const char *key, size_t key_len)
+{
+    uint64_t hash_num = HASH_FNV_OFFSET;
 
     for (size_t i = 0; i < key_len; i++)
     {
-        hash_num += base * key[i];
-        base *= THE_HASHING_PRIME;
+        hash_num ^= (unsigned char)key[i];
+        hash_num *= HASH_FNV_PRIME;
     }
 
-    return hash_num;
+    // NOTE: FNV's low bits mix poorly for short keys, so finish with the murmur3 mixer.
+    hash_num ^= hash_num >> 33;
+    hash_num *= 0xff51afd7ed558ccdULL;
+    hash_num ^= hash_num >> 33;
+    hash_num *= 0xc4ceb9fe1a85ec53ULL;
+    hash_num ^= hash_num >> 33;
+
+    return (size_t)hash_num;
+}
+
+size_t hash_capacity_for(size_t count)
+{
+    size_t capacity = 1;
+
+    while (capacity < count) capacity <<= 1;
+
+    return capacity;
 }
@@ -0,0 +1,308 @@
+/**
+ * @file heap.c
+ * @author Derek Tan
+ * @brief Implements the generational heap for strings and lists.
+ * @date 2023-08-17
+ */
+
+#include "backend/values/heap.h"
+
+// NOTE: lists cannot be changed by scripts once made, so an old value never points to a younger one and minor collections need no write barrier.
+static GcHeap the_heap;
+
+/// SECTION: Heap utils
+
+static void heap_free_object(GcObject *obj)
+{
+    ListObj *list = NULL;
+
+    if (obj->kind == GC_KIND_STR)
+    {
+        destroy_str_obj((StringObj *)obj);
+        pool_free(&the_heap.str_pool, obj);
+        return;
+    }
+
+    // NOTE: nested lists and strings are tracked by themselves, so only the item buffer goes with the list.
+    list = (ListObj *)obj;
+    free(list->store.items);
+    pool_free(&the_heap.list_pool, list);
+}
+
+static void heap_free_space(GcObject *head)
+{
+    GcObject *next = NULL;
+
+    while (head != NULL)
+    {
+        next = head->next;
+        heap_free_object(head);
+        head = next;
+    }
+}
+
+int heap_init(size_t nursery_limit)
+{
+    the_heap = (GcHeap){.ready = 1, .young = NULL, .old = NULL, .pinned = NULL, .young_bytes = 0, .old_bytes = 0, .cycle = GC_CYCLE_NONE};
+    the_heap.nursery_limit = (nursery_limit > 0) ? nursery_limit : GC_NURSERY_SZ;
+    the_heap.old_limit = GC_OLD_MIN_SZ;
+    pool_init(&the_heap.str_pool, sizeof(StringObj), 0);
+    pool_init(&the_heap.list_pool, sizeof(ListObj), 0);
+
+    return 1;
+}
+
+void heap_dispose()
+{
+    heap_free_space(the_heap.young);
+    heap_free_space(the_heap.old);
+    heap_free_space(the_heap.pinned);
+    pool_dispose(&the_heap.str_pool);
+    pool_dispose(&the_heap.list_pool);
+
+    the_heap.young = NULL;
+    the_heap.old = NULL;
+    the_heap.pinned = NULL;
+    the_heap.young_bytes = 0;
+    the_heap.old_bytes = 0;
+    the_heap.ready = 0;
+}
+
+void *heap_alloc(GcKind kind)
+{
+    // NOTE: values made without a heap are never tracked, so their owners free them with plain free.
+    if (!the_heap.ready) return malloc((kind == GC_KIND_STR) ? sizeof(StringObj) : sizeof(ListObj));
+
+    return pool_alloc((kind == GC_KIND_STR) ? &the_heap.str_pool : &the_heap.list_pool);
+}
+
+void heap_track(GcObject *obj, GcKind kind, size_t bytes)
+{
+    obj->kind = kind;
+    obj->bytes = bytes;
+    obj->marked = 0;
+    obj->age = 0;
+    obj->next = NULL;
+
+    if (!the_heap.ready)
+    {
+        obj->space = GC_UNTRACKED;
+        return;
+    }
+
+    obj->space = GC_YOUNG;
+    obj->next = the_heap.young;
+    the_heap.young = obj;
+    the_heap.young_bytes += bytes;
+}
+
+void heap_resize(GcObject *obj, size_t bytes)
+{
+    if (obj->space == GC_YOUNG) the_heap.young_bytes = the_heap.young_bytes - obj->bytes + bytes;
+    else if (obj->space == GC_OLD) the_heap.old_bytes = the_heap.old_bytes - obj->bytes + bytes;
+
+    obj->bytes = bytes;
+}
+
+void heap_pin(GcObject *obj)
+{
+    if (obj->space != GC_YOUNG) return;
+
+    // NOTE: it stays in the nursery list until the next sweep moves it, but it no longer counts towards collections.
+    obj->space = GC_PINNED;
+    the_heap.young_bytes -= obj->bytes;
+}
+
+/// SECTION: Collection
+
+GcCycle heap_wants_collect()
+{
+    if (!the_heap.ready || the_heap.young_bytes < the_heap.nursery_limit) return GC_CYCLE_NONE;
+
+    return (the_heap.old_bytes >= the_heap.old_limit) ? GC_CYCLE_MAJOR : GC_CYCLE_MINOR;
+}
+
+void heap_begin_collect()
+{
+    the_heap.cycle = (the_heap.old_bytes >= the_heap.old_limit) ? GC_CYCLE_MAJOR : GC_CYCLE_MINOR;
+    timespec_get(&the_heap.began, TIME_UTC);
+}
+
+/**
+ * @brief Tells if a value outlives the current collection. Minor collections never scan the old space, so it all counts as live.
+ */
+static int heap_is_live(const GcObject *obj)
+{
+    if (obj->space == GC_UNTRACKED || obj->space == GC_PINNED || obj->marked) return 1;
+
+    return obj->space == GC_OLD && the_heap.cycle == GC_CYCLE_MINOR;
+}
+
+static void heap_mark_object(GcObject *obj)
+{
+    ListObj *list = NULL;
+
+    if (obj->marked || obj->space == GC_UNTRACKED || obj->space == GC_PINNED) return;
+
+    if (obj->space == GC_OLD && the_heap.cycle == GC_CYCLE_MINOR) return;
+
+    obj->marked = 1;
+
+    if (obj->kind != GC_KIND_LIST) return;
+
+    list = (ListObj *)obj;
+
+    // NOTE: packed lists hold no references.
+    if (list->kind != LIST_MIXED) return;
+
+    for (size_t i = 0; i < list->count; i++) heap_mark_value(list->store.items + i);
+}
+
+void heap_mark_value(const VarValue *value)
+{
+    if (value->type == STR_TYPE) heap_mark_object(&value->data.str_type.value->gc);
+    else if (value->type == LIST_TYPE) heap_mark_object(&value->data.list_type.value->gc);
+}
+
+/**
+ * @brief Drops the string references of dead lists before anything is freed, so strings that live on can be changed in place again.
+ */
+static void heap_finalize_space(GcObject *head)
+{
+    ListObj *list = NULL;
+    StringObj *str = NULL;
+
+    for (GcObject *obj = head; obj != NULL; obj = obj->next)
+    {
+        if (obj->kind != GC_KIND_LIST || heap_is_live(obj)) continue;
+
+        list = (ListObj *)obj;
+
+        if (list->kind != LIST_MIXED) continue;
+
+        for (size_t i = 0; i < list->count; i++)
+        {
+            if (list->store.items[i].type != STR_TYPE) continue;
+
+            str = list->store.items[i].data.str_type.value;
+
+            if (heap_is_live(&str->gc)) release_str_obj(str);
+        }
+    }
+}
+
+static void heap_sweep_old()
+{
+    GcObject **link = &the_heap.old;
+    GcObject *obj = NULL;
+
+    while (*link != NULL)
+    {
+        obj = *link;
+
+        if (obj->marked)
+        {
+            obj->marked = 0;
+            link = &obj->next;
+            continue;
+        }
+
+        *link = obj->next;
+        the_heap.old_bytes -= obj->bytes;
+        the_heap.stats.objects_freed++;
+        the_heap.stats.bytes_freed += obj->bytes;
+        heap_free_object(obj);
+    }
+}
+
+static void heap_sweep_young()
+{
+    GcObject **link = &the_heap.young;
+    GcObject *obj = NULL;
+
+    while (*link != NULL)
+    {
+        obj = *link;
+
+        if (obj->space == GC_PINNED)
+        {
+            *link = obj->next;
+            obj->next = the_heap.pinned;
+            the_heap.pinned = obj;
+            continue;
+        }
+
+        if (!obj->marked)
+        {
+            *link = obj->next;
+            the_heap.young_bytes -= obj->bytes;
+            the_heap.stats.objects_freed++;
+            the_heap.stats.bytes_freed += obj->bytes;
+            heap_free_object(obj);
+            continue;
+        }
+
+        obj->marked = 0;
+        obj->age++;
+
+        if (obj->age < GC_PROMOTE_AGE)
+        {
+            link = &obj->next;
+            continue;
+        }
+
+        *link = obj->next;
+        the_heap.young_bytes -= obj->bytes;
+        the_heap.old_bytes += obj->bytes;
+        the_heap.stats.bytes_promoted += obj->bytes;
+        obj->space = GC_OLD;
+        obj->next = the_heap.old;
+        the_heap.old = obj;
+    }
+}
+
+void heap_finish_collect()
+{
+    struct timespec ended;
+    double pause_ms = 0.0;
+
+    heap_finalize_space(the_heap.young);
+
+    // NOTE: the old space is swept first, so values promoted by this collection are not swept twice.
+    if (the_heap.cycle == GC_CYCLE_MAJOR)
+    {
+        heap_finalize_space(the_heap.old);
+        heap_sweep_old();
+    }
+
+    heap_sweep_young();
+
+    if (the_heap.cycle == GC_CYCLE_MAJOR)
+    {
+        the_heap.old_limit = (the_heap.old_bytes * 2 > GC_OLD_MIN_SZ) ? the_heap.old_bytes * 2 : GC_OLD_MIN_SZ;
+        the_heap.stats.major_count++;
+    }
+    else
+    {
+        the_heap.stats.minor_count++;
+    }
+
+    timespec_get(&ended, TIME_UTC);
+    pause_ms = (double)(ended.tv_sec - the_heap.began.tv_sec) * 1e3 + (double)(ended.tv_nsec - the_heap.began.tv_nsec) / 1e6;
+
+    the_heap.stats.total_pause_ms += pause_ms;
+
+    if (pause_ms > the_heap.stats.max_pause_ms) the_heap.stats.max_pause_ms = pause_ms;
+
+    the_heap.cycle = GC_CYCLE_NONE;
+}
+
+const GcStats *heap_get_stats()
+{
+    return &the_heap.stats;
+}
+
+size_t heap_live_bytes()
+{
+    return the_heap.young_bytes + the_heap.old_bytes;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file intern.c
+ * @author Derek Tan
+ * @brief Implements the global name intern pool.
+ * @date 2023-08-15
+ */
+
+#include <stdlib.h>
+#include "utils/intern.h"
+
+static InternPool the_pool = {.capacity = 0, .count = 0, .buckets = NULL};
+
+/// SECTION: Pool utils
+
+int intern_pool_init(void)
+{
+    if (the_pool.buckets != NULL) return 1;
+
+    the_pool.buckets = calloc(INTERN_POOL_SIZE, sizeof(InternEntry *));
+
+    if (!the_pool.buckets) return 0;
+
+    the_pool.capacity = INTERN_POOL_SIZE;
+    the_pool.count = 0;
+
+    return 1;
+}
+
+void intern_pool_dispose(void)
+{
+    InternEntry *entry = NULL;
+    InternEntry *next_entry = NULL;
+
+    for (size_t i = 0; i < the_pool.capacity; i++)
+    {
+        entry = the_pool.buckets[i];
+
+        while (entry != NULL)
+        {
+            next_entry = entry->next;
+            free(entry);
+            entry = next_entry;
+        }
+    }
+
+    free(the_pool.buckets);
+    the_pool.buckets = NULL;
+    the_pool.capacity = 0;
+    the_pool.count = 0;
+}
+
+/**
+ * @brief Doubles the bucket array, moving entries by their stored hashes.
+ */
+static int intern_pool_grow(void)
+{
+    size_t new_capacity = the_pool.capacity << 1;
+    InternEntry **new_buckets = calloc(new_capacity, sizeof(InternEntry *));
+    InternEntry *entry = NULL;
+    InternEntry *next_entry = NULL;
+
+    if (!new_buckets) return 0;
+
+    for (size_t i = 0; i < the_pool.capacity; i++)
+    {
+        entry = the_pool.buckets[i];
+
+        while (entry != NULL)
+        {
+            next_entry = entry->next;
+            entry->next = new_buckets[entry->hash % new_capacity];
+            new_buckets[entry->hash % new_capacity] = entry;
+            entry = next_entry;
+        }
+    }
+
+    free(the_pool.buckets);
+    the_pool.buckets = new_buckets;
+    the_pool.capacity = new_capacity;
+
+    return 1;
+}
+
+/// SECTION: Interning
+
+char *intern_string(const char *str, size_t length)
+{
+    size_t hash = 0;
+    InternEntry *entry = NULL;
+
+    if (!str || (!the_pool.buckets && !intern_pool_init())) return NULL;
+
+    hash = hash_key_n(str, length);
+
+    for (entry = the_pool.buckets[hash % the_pool.capacity]; entry != NULL; entry = entry->next)
+    {
+        if (entry->hash == hash && entry->length == length && memcmp(entry->text, str, length) == 0)
+            return entry->text;
+    }
+
+    // NOTE: keep chains short by growing once the pool is as full as it is wide.
+    if (the_pool.count >= the_pool.capacity && !intern_pool_grow()) return NULL;
+
+    entry = malloc(sizeof(InternEntry) + length + 1);
+
+    if (!entry) return NULL;
+
+    entry->hash = hash;
+    entry->length = length;
+    memcpy(entry->text, str, length);
+    entry->text[length] = '\0';
+
+    entry->next = the_pool.buckets[hash % the_pool.capacity];
+    the_pool.buckets[hash % the_pool.capacity] = entry;
+    the_pool.count++;
+
+    return entry->text;
+}
+
+char *intern_cstr(const char *str)
+{
+    if (!str) return NULL;
+
+    return intern_string(str, strlen(str));
+}
+
+size_t intern_hash(const char *interned)
+{
+    const InternEntry *entry = (const InternEntry *)(interned - offsetof(InternEntry, text));
+
+    return entry->hash;
+}
+
+size_t intern_count(void)
+{
+    return the_pool.count;
+}
@@ -7,23 +7,109 @@
 
 #include "backend/runner/interpreter.h"
 
-int interpreter_init(Interpreter *runner, Script *program)
+int interpreter_init(Interpreter *runner, Script *program, RunMode mode)
 {
     if (!runner || !program) return 0;
 
-    int ctx_ok = ctx_init(&runner->context, program);
+    Resolver resolver;
+    Compiler compiler;
+    int resolve_ok = 0;
+    int fold_ok = 0;
+    int type_ok = 0;
+    int ctx_ok = 0;
+    int compile_ok = 0;
     
+    runner->mode = mode;
     runner->script_ref = program;
 
-    return ctx_ok;
+    // NOTE: both engines use the variable slots from the resolver, and the global frame size is only known after it.
+    if (!resolver_init(&resolver)) return 0;
+
+    resolve_ok = resolve_script(&resolver, program);
+    resolver_dispose(&resolver);
+
+    if (!resolve_ok) return 0;
+
+    // NOTE: folding needs the slots, and both engines then run the folded tree.
+    if (!folder_init(&runner->folder, program)) return 0;
+
+    fold_ok = fold_script(&runner->folder, program);
+    folder_dispose(&runner->folder);
+
+    if (!fold_ok) return 0;
+
+    // NOTE: folded literals prove more types, and static type errors stop the script before it runs.
+    if (!typer_init(&runner->typer, program)) return 0;
+
+    type_ok = type_script(&runner->typer, program);
+    typer_dispose(&runner->typer);
+
+    if (!type_ok) return 0;
+
+    ctx_ok = ctx_init(&runner->context, program);
+
+    if (!ctx_ok || mode == RUN_TREE_WALK) return ctx_ok;
+
+    if (!bcprogram_init(&runner->program, program->name)) return 0;
+
+    if (compiler_init(&compiler, &runner->program))
+    {
+        compile_ok = compile_script(&compiler, program);
+        compiler_dispose(&compiler);
+    }
+
+    if (!compile_ok || !vm_init(&runner->vm, &runner->context, &runner->program))
+    {
+        bcprogram_dispose(&runner->program);
+        return 0;
+    }
+
+    return 1;
+}
+
+int interpreter_init_cached(Interpreter *runner, const char *name, const char *cache_path, uint64_t source_hash)
+{
+    unsigned short global_count = 0;
+    unsigned int stmt_count = 0;
+
+    runner->mode = RUN_BYTECODE;
+    runner->script_ref = NULL;
+
+    if (!bccache_load(&runner->program, name, cache_path, source_hash, &global_count, &stmt_count)) return 0;
+
+    // NOTE: the context only needs the script's sizes, which the cache kept.
+    if (!ctx_init_sized(&runner->context, global_count, stmt_count))
+    {
+        bccache_unload(&runner->program);
+        bcprogram_dispose(&runner->program);
+        return 0;
+    }
+
+    if (!vm_init(&runner->vm, &runner->context, &runner->program))
+    {
+        ctx_destroy(&runner->context);
+        bccache_unload(&runner->program);
+        bcprogram_dispose(&runner->program);
+        return 0;
+    }
+
+    return 1;
 }
 
 void interpreter_dispose(Interpreter *runner)
 {
     if (!runner) return;
 
-    dispose_script(runner->script_ref);
+    if (runner->mode == RUN_BYTECODE)
+    {
+        vm_dispose(&runner->vm);
+        bccache_unload(&runner->program);
+        bcprogram_dispose(&runner->program);
+    }
+
+    // NOTE: function objects borrow their names from the script arena, so the script goes last.
     ctx_destroy(&runner->context);
+    dispose_script(runner->script_ref);
 }
 
 int interpreter_load_natives(Interpreter *runner, FuncGroup *native_module)
@@ -49,6 +135,9 @@ void interpreter_log_err(Interpreter *runner, unsigned int top_stmt_num, RunStat
     case ERR_NO_IMPL:
         printf("NoImplErr at stmt %u: %s\n", top_stmt_num, "Item not found in scope.");
         break;
+    case ERR_DEPTH:
+        printf("DepthErr at stmt %u: %s\n", top_stmt_num, "Too many nested proc calls.");
+        break;
     case ERR_GENERAL:
         printf("BaseRunErr at stmt %u: %s\n", top_stmt_num, "Unknown runtime error.");
         break;
@@ -60,17 +149,29 @@ void interpreter_log_err(Interpreter *runner, unsigned int top_stmt_num, RunStat
 void interpreter_run(Interpreter *runner)
 {
     RunnerContext *ctx_ref = &(runner->context); // interpreter context
-    unsigned int prgm_len = runner->script_ref->count; // top-level statement count
-    Statement **prgm_stmts = runner->script_ref->stmts; // statement vector
+    unsigned int prgm_len = 0; // top-level statement count
+    Statement **prgm_stmts = NULL; // statement vector
     Statement *stmt_ref = NULL; // current top-level statement to do
     RunStatus status = OK_IDLE;
 
+    // NOTE: a cached program has no Script, so the VM never reads it.
+    if (runner->mode == RUN_BYTECODE)
+    {
+        status = vm_run(&runner->vm);
+        interpreter_log_err(runner, runner->vm.stmt_num, status);
+        return;
+    }
+
+    prgm_len = runner->script_ref->count;
+    prgm_stmts = runner->script_ref->stmts;
+
     for (unsigned int i = 0; (i < prgm_len) && (status <= OK_ENDED); i++)
     {
         stmt_ref = *prgm_stmts;
 
         status = exec_stmt(ctx_ref, stmt_ref);
         interpreter_log_err(runner, i, status);
+        ctx_collect_garbage(ctx_ref);
 
         prgm_stmts++;
     }
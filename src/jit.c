@@ -0,0 +1,768 @@
+/**
+ * @file jit.c
+ * @author Derek Tan
+ * @brief Implements the baseline template JIT for x86-64 Linux.
+ * @date 2023-08-21
+ */
+
+#define _DEFAULT_SOURCE // mmap and sysconf under -std=c11
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "backend/compiler/jit.h"
+
+#ifdef JIT_X64_LINUX
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/// SECTION: Code buffer
+
+/**
+ * @brief A rel32 operand to patch once all code is placed. It points at a bytecode pc or at the deopt stub of one.
+ */
+typedef struct st_jit_fixup
+{
+    size_t pos;
+    unsigned int pc;
+    int is_deopt;
+} JitFixup;
+
+typedef struct st_jit_buffer
+{
+    unsigned char *bytes;
+    size_t count;
+    size_t capacity;
+    JitFixup *fixups;
+    size_t fixup_count;
+    size_t fixup_capacity;
+    int failed;
+} JitBuffer;
+
+// NOTE: only caller-saved registers are used, so the code needs no prologue.
+#define JIT_RAX 0
+#define JIT_RCX 1
+#define JIT_RDX 2
+#define JIT_RSI 6 // globals
+#define JIT_RDI 7 // registers of the running frame
+
+#define JIT_CC_B 0x2
+#define JIT_CC_AE 0x3
+#define JIT_CC_E 0x4
+#define JIT_CC_NE 0x5
+#define JIT_CC_BE 0x6
+#define JIT_CC_A 0x7
+#define JIT_CC_P 0xA
+#define JIT_CC_L 0xC
+#define JIT_CC_GE 0xD
+#define JIT_CC_LE 0xE
+#define JIT_CC_G 0xF
+
+#define JIT_SLOT(reg) ((int32_t)((reg) * sizeof(VarValue)))
+#define JIT_TYPE_OFF ((int32_t)offsetof(VarValue, type))
+#define JIT_CONST_OFF ((int32_t)offsetof(VarValue, is_const))
+#define JIT_DATA_OFF ((int32_t)offsetof(VarValue, data))
+
+_Static_assert(sizeof(VarValue) == 16, "the JIT copies values as two quadwords");
+
+// NOTE: condition codes for compares from BC_EQ to BC_GTE, where reals use the unsigned ones that ucomiss sets. The codes of their negations differ in the lowest bit.
+static const unsigned char jit_int_ccs[] = {JIT_CC_E, JIT_CC_NE, JIT_CC_L, JIT_CC_LE, JIT_CC_G, JIT_CC_GE};
+static const unsigned char jit_real_ccs[] = {JIT_CC_E, JIT_CC_NE, JIT_CC_B, JIT_CC_BE, JIT_CC_A, JIT_CC_AE};
+
+static int jit_buffer_init(JitBuffer *buf)
+{
+    buf->bytes = malloc(JIT_CODE_MIN_SZ);
+    buf->count = 0;
+    buf->capacity = JIT_CODE_MIN_SZ;
+    buf->fixups = malloc(sizeof(JitFixup) * JIT_CODE_MIN_SZ);
+    buf->fixup_count = 0;
+    buf->fixup_capacity = JIT_CODE_MIN_SZ;
+    buf->failed = !buf->bytes || !buf->fixups;
+
+    return !buf->failed;
+}
+
+static void jit_buffer_dispose(JitBuffer *buf)
+{
+    free(buf->bytes);
+    free(buf->fixups);
+    buf->bytes = NULL;
+    buf->fixups = NULL;
+}
+
+static void jit_emit_u8(JitBuffer *buf, unsigned char byte)
+{
+    unsigned char *temp_bytes = NULL;
+
+    if (buf->failed) return;
+
+    if (buf->count == buf->capacity)
+    {
+        temp_bytes = realloc(buf->bytes, buf->capacity << 1);
+
+        if (!temp_bytes)
+        {
+            buf->failed = 1;
+            return;
+        }
+
+        buf->bytes = temp_bytes;
+        buf->capacity <<= 1;
+    }
+
+    buf->bytes[buf->count] = byte;
+    buf->count++;
+}
+
+static void jit_emit_u32(JitBuffer *buf, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) jit_emit_u8(buf, (unsigned char)(value >> (i * 8)));
+}
+
+static void jit_emit_u64(JitBuffer *buf, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) jit_emit_u8(buf, (unsigned char)(value >> (i * 8)));
+}
+
+/**
+ * @brief Emits a ModRM byte for [base + disp32] and its displacement. Neither base used here needs a SIB byte.
+ */
+static void jit_emit_mem(JitBuffer *buf, int reg, int base, int32_t disp)
+{
+    jit_emit_u8(buf, (unsigned char)(0x80 | (reg << 3) | base));
+    jit_emit_u32(buf, (uint32_t)disp);
+}
+
+static void jit_add_fixup(JitBuffer *buf, unsigned int pc, int is_deopt)
+{
+    JitFixup *temp_fixups = NULL;
+
+    if (buf->failed) return;
+
+    if (buf->fixup_count == buf->fixup_capacity)
+    {
+        temp_fixups = realloc(buf->fixups, sizeof(JitFixup) * (buf->fixup_capacity << 1));
+
+        if (!temp_fixups)
+        {
+            buf->failed = 1;
+            return;
+        }
+
+        buf->fixups = temp_fixups;
+        buf->fixup_capacity <<= 1;
+    }
+
+    buf->fixups[buf->fixup_count] = (JitFixup){.pos = buf->count, .pc = pc, .is_deopt = is_deopt};
+    buf->fixup_count++;
+    jit_emit_u32(buf, 0);
+}
+
+/// SECTION: Instruction templates
+
+static void jit_jcc(JitBuffer *buf, unsigned char cc, unsigned int pc, int is_deopt)
+{
+    jit_emit_u8(buf, 0x0F);
+    jit_emit_u8(buf, 0x80 | cc);
+    jit_add_fixup(buf, pc, is_deopt);
+}
+
+static void jit_jmp(JitBuffer *buf, unsigned int pc, int is_deopt)
+{
+    jit_emit_u8(buf, 0xE9);
+    jit_add_fixup(buf, pc, is_deopt);
+}
+
+/**
+ * @brief Emits a forward jump within one template. jit_bind_here points it at the next emitted byte.
+ * @return size_t Position of the rel32 to patch.
+ */
+static size_t jit_jcc_local(JitBuffer *buf, unsigned char cc)
+{
+    jit_emit_u8(buf, 0x0F);
+    jit_emit_u8(buf, 0x80 | cc);
+    jit_emit_u32(buf, 0);
+
+    return buf->count - 4;
+}
+
+static size_t jit_jmp_local(JitBuffer *buf)
+{
+    jit_emit_u8(buf, 0xE9);
+    jit_emit_u32(buf, 0);
+
+    return buf->count - 4;
+}
+
+static void jit_bind_here(JitBuffer *buf, size_t pos)
+{
+    uint32_t rel = (uint32_t)(buf->count - (pos + 4));
+
+    if (buf->failed) return;
+
+    memcpy(buf->bytes + pos, &rel, sizeof(rel));
+}
+
+static void jit_load32(JitBuffer *buf, int reg, int base, int32_t disp)
+{
+    jit_emit_u8(buf, 0x8B);
+    jit_emit_mem(buf, reg, base, disp);
+}
+
+static void jit_store32(JitBuffer *buf, int reg, int base, int32_t disp)
+{
+    jit_emit_u8(buf, 0x89);
+    jit_emit_mem(buf, reg, base, disp);
+}
+
+static void jit_store_imm32(JitBuffer *buf, int base, int32_t disp, uint32_t imm)
+{
+    jit_emit_u8(buf, 0xC7);
+    jit_emit_mem(buf, 0, base, disp);
+    jit_emit_u32(buf, imm);
+}
+
+/**
+ * @brief Emits "op dword [base + disp], imm32" for a group 1 op: 0 is add and 7 is cmp.
+ */
+static void jit_group1_imm32(JitBuffer *buf, int op_ext, int base, int32_t disp, uint32_t imm)
+{
+    jit_emit_u8(buf, 0x81);
+    jit_emit_mem(buf, op_ext, base, disp);
+    jit_emit_u32(buf, imm);
+}
+
+static void jit_copy_value(JitBuffer *buf, int dest_base, unsigned short dest_reg, int src_base, unsigned short src_reg)
+{
+    for (int32_t half = 0; half < 16; half += 8)
+    {
+        jit_emit_u8(buf, 0x48); // mov rax, [src]
+        jit_emit_u8(buf, 0x8B);
+        jit_emit_mem(buf, JIT_RAX, src_base, JIT_SLOT(src_reg) + half);
+        jit_emit_u8(buf, 0x48); // mov [dest], rax
+        jit_emit_u8(buf, 0x89);
+        jit_emit_mem(buf, JIT_RAX, dest_base, JIT_SLOT(dest_reg) + half);
+    }
+}
+
+/**
+ * @brief Leaves the native code for the VM at pc unless a register has the given type.
+ */
+static void jit_guard_type(JitBuffer *buf, unsigned short reg, DataType type, unsigned int pc)
+{
+    jit_group1_imm32(buf, 7, JIT_RDI, JIT_SLOT(reg) + JIT_TYPE_OFF, (uint32_t)type);
+    jit_jcc(buf, JIT_CC_NE, pc, 1);
+}
+
+static void jit_store_result(JitBuffer *buf, unsigned short reg, DataType type)
+{
+    jit_store_imm32(buf, JIT_RDI, JIT_SLOT(reg) + JIT_TYPE_OFF, (uint32_t)type);
+    jit_store_imm32(buf, JIT_RDI, JIT_SLOT(reg) + JIT_CONST_OFF, 1);
+}
+
+/**
+ * @brief Emits "a = b op c" for ints. Division leaves zero and -1 divisors to the VM, since x86 traps on INT_MIN / -1.
+ */
+static void jit_int_math(JitBuffer *buf, BcOpCode op, const BcInstr *instr, unsigned int pc)
+{
+    int32_t right_disp = JIT_SLOT(instr->c) + JIT_DATA_OFF;
+
+    if (op == BC_DIV)
+    {
+        jit_group1_imm32(buf, 7, JIT_RDI, right_disp, 0);
+        jit_jcc(buf, JIT_CC_E, pc, 1);
+        jit_group1_imm32(buf, 7, JIT_RDI, right_disp, 0xFFFFFFFFu);
+        jit_jcc(buf, JIT_CC_E, pc, 1);
+    }
+
+    jit_load32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->b) + JIT_DATA_OFF);
+
+    if (op == BC_ADD)
+    {
+        jit_emit_u8(buf, 0x03); // add eax, [c]
+        jit_emit_mem(buf, JIT_RAX, JIT_RDI, right_disp);
+    }
+    else if (op == BC_SUB)
+    {
+        jit_emit_u8(buf, 0x2B); // sub eax, [c]
+        jit_emit_mem(buf, JIT_RAX, JIT_RDI, right_disp);
+    }
+    else if (op == BC_MUL)
+    {
+        jit_emit_u8(buf, 0x0F); // imul eax, [c]
+        jit_emit_u8(buf, 0xAF);
+        jit_emit_mem(buf, JIT_RAX, JIT_RDI, right_disp);
+    }
+    else
+    {
+        jit_emit_u8(buf, 0x99); // cdq
+        jit_emit_u8(buf, 0xF7); // idiv dword [c]
+        jit_emit_mem(buf, 7, JIT_RDI, right_disp);
+    }
+
+    jit_store32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->a) + JIT_DATA_OFF);
+    jit_store_result(buf, instr->a, INT_TYPE);
+}
+
+/**
+ * @brief Emits "a = b op c" for reals with SSE. Division leaves zero or unordered divisors to the VM.
+ */
+static void jit_real_math(JitBuffer *buf, BcOpCode op, const BcInstr *instr, unsigned int pc)
+{
+    int32_t right_disp = JIT_SLOT(instr->c) + JIT_DATA_OFF;
+    unsigned char sse_op = 0x58; // addss
+
+    if (op == BC_SUB) sse_op = 0x5C;
+    else if (op == BC_MUL) sse_op = 0x59;
+    else if (op == BC_DIV) sse_op = 0x5E;
+
+    if (op == BC_DIV)
+    {
+        jit_emit_u8(buf, 0x0F); // xorps xmm1, xmm1
+        jit_emit_u8(buf, 0x57);
+        jit_emit_u8(buf, 0xC9);
+        jit_emit_u8(buf, 0x0F); // ucomiss xmm1, [c]
+        jit_emit_u8(buf, 0x2E);
+        jit_emit_mem(buf, 1, JIT_RDI, right_disp);
+        jit_jcc(buf, JIT_CC_E, pc, 1);
+    }
+
+    jit_emit_u8(buf, 0xF3); // movss xmm0, [b]
+    jit_emit_u8(buf, 0x0F);
+    jit_emit_u8(buf, 0x10);
+    jit_emit_mem(buf, 0, JIT_RDI, JIT_SLOT(instr->b) + JIT_DATA_OFF);
+    jit_emit_u8(buf, 0xF3); // op xmm0, [c]
+    jit_emit_u8(buf, 0x0F);
+    jit_emit_u8(buf, sse_op);
+    jit_emit_mem(buf, 0, JIT_RDI, right_disp);
+    jit_emit_u8(buf, 0xF3); // movss [a], xmm0
+    jit_emit_u8(buf, 0x0F);
+    jit_emit_u8(buf, 0x11);
+    jit_emit_mem(buf, 0, JIT_RDI, JIT_SLOT(instr->a) + JIT_DATA_OFF);
+    jit_store_result(buf, instr->a, REAL_TYPE);
+}
+
+/**
+ * @brief Emits an int compare of register a against register c, or against an int constant.
+ */
+static void jit_int_compare(JitBuffer *buf, unsigned short left_reg, const VarValue *right_const, unsigned short right_reg)
+{
+    if (right_const != NULL)
+    {
+        jit_group1_imm32(buf, 7, JIT_RDI, JIT_SLOT(left_reg) + JIT_DATA_OFF, (uint32_t)right_const->data.int_val.value);
+        return;
+    }
+
+    jit_load32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(left_reg) + JIT_DATA_OFF);
+    jit_emit_u8(buf, 0x3B); // cmp eax, [c]
+    jit_emit_mem(buf, JIT_RAX, JIT_RDI, JIT_SLOT(right_reg) + JIT_DATA_OFF);
+}
+
+/**
+ * @brief Emits a real compare of register a against register c, or against a real constant. Unordered operands go back to the VM.
+ */
+static void jit_real_compare(JitBuffer *buf, unsigned short left_reg, const VarValue *right_const, unsigned short right_reg, unsigned int pc)
+{
+    uint32_t right_bits = 0;
+
+    jit_emit_u8(buf, 0xF3); // movss xmm0, [a]
+    jit_emit_u8(buf, 0x0F);
+    jit_emit_u8(buf, 0x10);
+    jit_emit_mem(buf, 0, JIT_RDI, JIT_SLOT(left_reg) + JIT_DATA_OFF);
+
+    if (right_const != NULL)
+    {
+        memcpy(&right_bits, &right_const->data.real_val.value, sizeof(right_bits));
+        jit_emit_u8(buf, 0xB8); // mov eax, imm32
+        jit_emit_u32(buf, right_bits);
+        jit_emit_u8(buf, 0x66); // movd xmm1, eax
+        jit_emit_u8(buf, 0x0F);
+        jit_emit_u8(buf, 0x6E);
+        jit_emit_u8(buf, 0xC8);
+        jit_emit_u8(buf, 0x0F); // ucomiss xmm0, xmm1
+        jit_emit_u8(buf, 0x2E);
+        jit_emit_u8(buf, 0xC1);
+    }
+    else
+    {
+        jit_emit_u8(buf, 0x0F); // ucomiss xmm0, [c]
+        jit_emit_u8(buf, 0x2E);
+        jit_emit_mem(buf, 0, JIT_RDI, JIT_SLOT(right_reg) + JIT_DATA_OFF);
+    }
+
+    jit_jcc(buf, JIT_CC_P, pc, 1);
+}
+
+static void jit_cmp_eax(JitBuffer *buf, uint32_t imm)
+{
+    jit_emit_u8(buf, 0x3D);
+    jit_emit_u32(buf, imm);
+}
+
+/**
+ * @brief Starts an untyped op on two registers: both must have one type, which stays in eax.
+ * @return size_t The local jump taken when that type is not an int.
+ */
+static size_t jit_split_types(JitBuffer *buf, unsigned short left_reg, unsigned short right_reg, unsigned int pc)
+{
+    jit_load32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(left_reg) + JIT_TYPE_OFF);
+    jit_emit_u8(buf, 0x3B); // cmp eax, [c].type
+    jit_emit_mem(buf, JIT_RAX, JIT_RDI, JIT_SLOT(right_reg) + JIT_TYPE_OFF);
+    jit_jcc(buf, JIT_CC_NE, pc, 1);
+    jit_cmp_eax(buf, (uint32_t)INT_TYPE);
+
+    return jit_jcc_local(buf, JIT_CC_NE);
+}
+
+/**
+ * @brief Binds the non-int path of an untyped op, where anything but reals goes back to the VM.
+ */
+static void jit_real_path(JitBuffer *buf, size_t not_int, unsigned int pc)
+{
+    jit_bind_here(buf, not_int);
+    jit_cmp_eax(buf, (uint32_t)REAL_TYPE);
+    jit_jcc(buf, JIT_CC_NE, pc, 1);
+}
+
+static void jit_return(JitBuffer *buf)
+{
+    jit_emit_u8(buf, 0xB8); // mov eax, JIT_RETURNED
+    jit_emit_u32(buf, (uint32_t)JIT_RETURNED);
+    jit_emit_u8(buf, 0xC3);
+}
+
+/**
+ * @brief Emits one bytecode instruction.
+ * @return int 0 if the opcode is left to the VM, which rejects the whole proc.
+ */
+static int jit_emit_instr(JitBuffer *buf, const BcInstr *instr, unsigned int pc, const VarValue *consts)
+{
+    const VarValue *right_const = NULL;
+    uint64_t halves[2];
+    BcOpCode op = instr->op;
+    size_t not_int = 0;
+    size_t done = 0;
+    unsigned char false_cc = 0;
+    int is_typed = 0;
+
+    switch (op)
+    {
+    case BC_NOP:
+        break;
+    case BC_LOADK:
+        memcpy(halves, consts + instr->b, sizeof(halves));
+
+        for (int i = 0; i < 2; i++)
+        {
+            jit_emit_u8(buf, 0x48); // mov rax, imm64
+            jit_emit_u8(buf, 0xB8);
+            jit_emit_u64(buf, halves[i]);
+            jit_emit_u8(buf, 0x48); // mov [a], rax
+            jit_emit_u8(buf, 0x89);
+            jit_emit_mem(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->a) + i * 8);
+        }
+        break;
+    case BC_MOVE:
+        jit_copy_value(buf, JIT_RDI, instr->a, JIT_RDI, instr->b);
+        break;
+    case BC_GETGLOBAL:
+        jit_copy_value(buf, JIT_RDI, instr->a, JIT_RSI, instr->b);
+        break;
+    case BC_ASSIGN:
+    case BC_SETGLOBAL:
+    {
+        // NOTE: like vm_assign, a missing value or a type change is left for the VM to report.
+        int dest_base = (op == BC_ASSIGN) ? JIT_RDI : JIT_RSI;
+
+        jit_load32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->b) + JIT_TYPE_OFF);
+        jit_emit_u8(buf, 0x3D); // cmp eax, NONE_TYPE
+        jit_emit_u32(buf, (uint32_t)NONE_TYPE);
+        jit_jcc(buf, JIT_CC_E, pc, 1);
+        jit_emit_u8(buf, 0x3B); // cmp eax, [a].type
+        jit_emit_mem(buf, JIT_RAX, dest_base, JIT_SLOT(instr->a) + JIT_TYPE_OFF);
+        jit_jcc(buf, JIT_CC_NE, pc, 1);
+        jit_emit_u8(buf, 0x48); // mov rax, [b].data
+        jit_emit_u8(buf, 0x8B);
+        jit_emit_mem(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->b) + JIT_DATA_OFF);
+        jit_emit_u8(buf, 0x48); // mov [a].data, rax
+        jit_emit_u8(buf, 0x89);
+        jit_emit_mem(buf, JIT_RAX, dest_base, JIT_SLOT(instr->a) + JIT_DATA_OFF);
+        break;
+    }
+    case BC_NEG:
+        jit_load32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->b) + JIT_TYPE_OFF);
+        jit_cmp_eax(buf, (uint32_t)INT_TYPE);
+        not_int = jit_jcc_local(buf, JIT_CC_NE);
+        jit_load32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->b) + JIT_DATA_OFF);
+        jit_emit_u8(buf, 0xF7); // neg eax
+        jit_emit_u8(buf, 0xD8);
+        jit_store32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->a) + JIT_DATA_OFF);
+        jit_store_result(buf, instr->a, INT_TYPE);
+        done = jit_jmp_local(buf);
+        jit_real_path(buf, not_int, pc);
+        jit_load32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->b) + JIT_DATA_OFF);
+        jit_emit_u8(buf, 0x35); // xor eax, sign bit
+        jit_emit_u32(buf, 0x80000000u);
+        jit_store32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->a) + JIT_DATA_OFF);
+        jit_store_result(buf, instr->a, REAL_TYPE);
+        jit_bind_here(buf, done);
+        break;
+    case BC_ADD:
+    case BC_SUB:
+    case BC_MUL:
+    case BC_DIV:
+        not_int = jit_split_types(buf, instr->b, instr->c, pc);
+        jit_int_math(buf, op, instr, pc);
+        done = jit_jmp_local(buf);
+        jit_real_path(buf, not_int, pc);
+        jit_real_math(buf, op, instr, pc);
+        jit_bind_here(buf, done);
+        break;
+    case BC_IADD:
+    case BC_ISUB:
+    case BC_IMUL:
+    case BC_IDIV:
+        jit_int_math(buf, op - BC_IADD + BC_ADD, instr, pc);
+        break;
+    case BC_RADD:
+    case BC_RSUB:
+    case BC_RMUL:
+    case BC_RDIV:
+        jit_real_math(buf, op - BC_RADD + BC_ADD, instr, pc);
+        break;
+    case BC_ADDI:
+        jit_guard_type(buf, instr->a, INT_TYPE, pc);
+        jit_group1_imm32(buf, 0, JIT_RDI, JIT_SLOT(instr->a) + JIT_DATA_OFF, (uint32_t)(int32_t)(short)instr->b);
+        break;
+    case BC_EQ:
+    case BC_NEQ:
+    case BC_LT:
+    case BC_LTE:
+    case BC_GT:
+    case BC_GTE:
+        // NOTE: bools are compared by the VM.
+        not_int = jit_split_types(buf, instr->b, instr->c, pc);
+        jit_int_compare(buf, instr->b, NULL, instr->c);
+        jit_emit_u8(buf, 0x0F); // setcc al
+        jit_emit_u8(buf, 0x90 | jit_int_ccs[op - BC_EQ]);
+        jit_emit_u8(buf, 0xC0);
+        done = jit_jmp_local(buf);
+        jit_real_path(buf, not_int, pc);
+        jit_real_compare(buf, instr->b, NULL, instr->c, pc);
+        jit_emit_u8(buf, 0x0F); // setcc al
+        jit_emit_u8(buf, 0x90 | jit_real_ccs[op - BC_EQ]);
+        jit_emit_u8(buf, 0xC0);
+        jit_bind_here(buf, done);
+        jit_emit_u8(buf, 0x0F); // movzx eax, al
+        jit_emit_u8(buf, 0xB6);
+        jit_emit_u8(buf, 0xC0);
+        jit_store32(buf, JIT_RAX, JIT_RDI, JIT_SLOT(instr->a) + JIT_DATA_OFF);
+        jit_store_result(buf, instr->a, BOOL_TYPE);
+        break;
+    case BC_JMP:
+        jit_jmp(buf, instr->b, 0);
+        break;
+    case BC_JMPF:
+        jit_guard_type(buf, instr->a, BOOL_TYPE, pc);
+        jit_group1_imm32(buf, 7, JIT_RDI, JIT_SLOT(instr->a) + JIT_DATA_OFF, 0);
+        jit_jcc(buf, JIT_CC_E, instr->b, 0);
+        break;
+    case BC_IEQJMPF:
+    case BC_INEQJMPF:
+    case BC_ILTJMPF:
+    case BC_ILTEJMPF:
+    case BC_IGTJMPF:
+    case BC_IGTEJMPF:
+        is_typed = 1;
+        op = op - BC_IEQJMPF + BC_EQJMPF;
+        // fall through
+    case BC_EQJMPF:
+    case BC_NEQJMPF:
+    case BC_LTJMPF:
+    case BC_LTEJMPF:
+    case BC_GTJMPF:
+    case BC_GTEJMPF:
+        if (instr->aux) right_const = consts + instr->c;
+
+        false_cc = jit_int_ccs[op - BC_EQJMPF] ^ 1;
+
+        if (is_typed && right_const != NULL && right_const->type != INT_TYPE)
+        {
+            jit_jmp(buf, pc, 1);
+        }
+        else if (is_typed || (right_const != NULL && right_const->type == INT_TYPE))
+        {
+            if (!is_typed) jit_guard_type(buf, instr->a, INT_TYPE, pc);
+
+            jit_int_compare(buf, instr->a, right_const, instr->c);
+            jit_jcc(buf, false_cc, instr->b, 0);
+        }
+        else if (right_const != NULL && right_const->type == REAL_TYPE)
+        {
+            jit_guard_type(buf, instr->a, REAL_TYPE, pc);
+            jit_real_compare(buf, instr->a, right_const, 0, pc);
+            jit_jcc(buf, jit_real_ccs[op - BC_EQJMPF] ^ 1, instr->b, 0);
+        }
+        else if (right_const != NULL)
+        {
+            // NOTE: other constants always go back to the VM, which compares any types.
+            jit_jmp(buf, pc, 1);
+        }
+        else
+        {
+            not_int = jit_split_types(buf, instr->a, instr->c, pc);
+            jit_int_compare(buf, instr->a, NULL, instr->c);
+            jit_jcc(buf, false_cc, instr->b, 0);
+            done = jit_jmp_local(buf);
+            jit_real_path(buf, not_int, pc);
+            jit_real_compare(buf, instr->a, NULL, instr->c, pc);
+            jit_jcc(buf, jit_real_ccs[op - BC_EQJMPF] ^ 1, instr->b, 0);
+            jit_bind_here(buf, done);
+        }
+        break;
+    case BC_RET:
+        // NOTE: the callee's first register is the caller's call register, as in the VM.
+        if (instr->a != 0) jit_copy_value(buf, JIT_RDI, 0, JIT_RDI, instr->a);
+
+        jit_return(buf);
+        break;
+    case BC_RETNONE:
+        jit_store_imm32(buf, JIT_RDI, JIT_TYPE_OFF, (uint32_t)NONE_TYPE);
+        jit_return(buf);
+        break;
+    default:
+        return 0;
+    }
+
+    return 1;
+}
+
+/// SECTION: Compiling
+
+/**
+ * @brief Copies finished code into pages that are made executable but no longer writable.
+ */
+static JitCode *jit_install(const JitBuffer *buf)
+{
+    long page_size = sysconf(_SC_PAGESIZE);
+    size_t page_bytes = 0;
+    JitCode *code = NULL;
+    void *pages = NULL;
+
+    if (page_size <= 0) page_size = 4096;
+
+    page_bytes = (buf->count + (size_t)page_size - 1) & ~((size_t)page_size - 1);
+    pages = mmap(NULL, page_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (pages == MAP_FAILED) return NULL;
+
+    memcpy(pages, buf->bytes, buf->count);
+
+    code = malloc(sizeof(JitCode));
+
+    if (!code || mprotect(pages, page_bytes, PROT_READ | PROT_EXEC) != 0)
+    {
+        free(code);
+        munmap(pages, page_bytes);
+        return NULL;
+    }
+
+    code->entry = (JitEntry)pages;
+    code->pages = pages;
+    code->page_bytes = page_bytes;
+
+    return code;
+}
+
+JitCode *jit_compile(const BcProc *proc, const VarValue *consts)
+{
+    JitBuffer buf;
+    JitCode *code = NULL;
+    size_t *pc_offsets = NULL;
+    size_t *stub_offsets = NULL;
+    const JitFixup *fixup = NULL;
+    size_t target = 0;
+    int compile_ok = 1;
+
+    if (proc->count == 0 || !jit_buffer_init(&buf))
+    {
+        jit_buffer_dispose(&buf);
+        return NULL;
+    }
+
+    pc_offsets = malloc(sizeof(size_t) * proc->count);
+    stub_offsets = malloc(sizeof(size_t) * proc->count);
+    compile_ok = pc_offsets != NULL && stub_offsets != NULL;
+
+    for (unsigned int pc = 0; pc < proc->count && compile_ok; pc++)
+    {
+        pc_offsets[pc] = buf.count;
+        stub_offsets[pc] = SIZE_MAX;
+        compile_ok = jit_emit_instr(&buf, proc->code + pc, pc, consts);
+    }
+
+    // NOTE: each pc that can leave the native code gets a stub that gives it back to the VM.
+    for (size_t i = 0; i < buf.fixup_count && compile_ok; i++)
+    {
+        fixup = buf.fixups + i;
+
+        if (fixup->pc >= proc->count)
+        {
+            compile_ok = 0;
+            break;
+        }
+
+        if (!fixup->is_deopt || stub_offsets[fixup->pc] != SIZE_MAX) continue;
+
+        stub_offsets[fixup->pc] = buf.count;
+        jit_emit_u8(&buf, 0xB8); // mov eax, pc
+        jit_emit_u32(&buf, fixup->pc);
+        jit_emit_u8(&buf, 0xC3);
+    }
+
+    compile_ok = compile_ok && !buf.failed;
+
+    for (size_t i = 0; i < buf.fixup_count && compile_ok; i++)
+    {
+        fixup = buf.fixups + i;
+        target = (fixup->is_deopt) ? stub_offsets[fixup->pc] : pc_offsets[fixup->pc];
+
+        uint32_t rel = (uint32_t)((int64_t)target - (int64_t)(fixup->pos + 4));
+        memcpy(buf.bytes + fixup->pos, &rel, sizeof(rel));
+    }
+
+    if (compile_ok) code = jit_install(&buf);
+
+    free(pc_offsets);
+    free(stub_offsets);
+    jit_buffer_dispose(&buf);
+
+    return code;
+}
+
+void jit_code_dispose(JitCode *code)
+{
+    if (!code) return;
+
+    munmap(code->pages, code->page_bytes);
+    free(code);
+}
+
+#else
+
+JitCode *jit_compile(const BcProc *proc, const VarValue *consts)
+{
+    // NOTE: other platforms always run procs in the VM.
+    (void)proc;
+    (void)consts;
+
+    return NULL;
+}
+
+void jit_code_dispose(JitCode *code)
+{
+    free(code);
+}
+
+#endif
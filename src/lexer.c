@@ -7,11 +7,11 @@
  * @date 2023-07-22
  */
 
-void lexer_init(Lexer *lexer, char *source)
+void lexer_init(Lexer *lexer, const char *source, size_t length)
 {
     lexer->src = source;
     lexer->pos = 0;
-    lexer->limit = strlen(source);
+    lexer->limit = length;
     lexer->line = 1;
 }
 
@@ -20,7 +20,7 @@ Token lexer_lex_wspace(Lexer *lexer)
     char c;
     size_t begin = lexer->pos;
     size_t span = 0;
-    char *src_cursor = lexer->src + begin;
+    const char *src_cursor = lexer->src + begin;
 
     while (span <= lexer->limit)
     {
@@ -44,7 +44,7 @@ Token lexer_lex_comment(Lexer *lexer)
     char c;
     size_t begin = lexer->pos;
     size_t span = 0;
-    char *src_cursor = lexer->src + begin;
+    const char *src_cursor = lexer->src + begin;
 
     while (span <= lexer->limit)
     {
@@ -78,7 +78,7 @@ Token lexer_lex_keyword(Lexer *lexer, const char *keyword)
     size_t begin = lexer->pos;
     size_t span = 0;
     size_t kw_span = strlen(keyword);
-    char *src_cursor = lexer->src + begin;
+    const char *src_cursor = lexer->src + begin;
     const char *kw_cursor = keyword;
     int mismatch = 0;
 
@@ -113,7 +113,7 @@ Token lexer_lex_identifier(Lexer *lexer)
     char c;
     size_t begin = lexer->pos;
     size_t span = 0;
-    char *src_cursor = lexer->src + begin;
+    const char *src_cursor = lexer->src + begin;
 
     while (span <= lexer->limit)
     {
@@ -168,7 +168,7 @@ Token lexer_lex_number(Lexer *lexer)
     char c;
     size_t begin = lexer->pos;
     size_t span = 0;
-    char *src_cursor = lexer->src + begin;
+    const char *src_cursor = lexer->src + begin;
     int dot_count = 0;
 
     while (span <= lexer->limit)
@@ -177,7 +177,7 @@ Token lexer_lex_number(Lexer *lexer)
 
         if (MATCH_CHAR(c, '.')) dot_count++;
 
-        if (!(IS_NUMERIC(c)) || MATCH_CHAR(c, '\0')) break;
+        if (!(IS_NUMERIC(c) || MATCH_CHAR(c, '.')) || MATCH_CHAR(c, '\0')) break;
 
         src_cursor++;
         span++;
@@ -204,7 +204,7 @@ Token lexer_lex_string(Lexer *lexer)
     char c;
     size_t begin = lexer->pos;
     size_t span = 0;
-    char *src_cursor = lexer->src + begin;
+    const char *src_cursor = lexer->src + begin;
     int invalid_closing = 0;
 
     while (span <= lexer->limit)
@@ -237,7 +237,7 @@ Token lexer_lex_operator(Lexer *lexer)
     char c;
     size_t begin = lexer->pos;
     size_t span = 0;
-    char *src_cursor = lexer->src + begin;
+    const char *src_cursor = lexer->src + begin;
 
     while (span <= lexer->limit)
     {
@@ -0,0 +1,417 @@
+/**
+ * @file listkernels.c
+ * @author Derek Tan
+ * @brief Implements the packed list kernels. The AVX2 bodies are compiled with a target attribute, so the rest of the build keeps its default flags and older CPUs take the scalar loops.
+ * @date 2023-08-16
+ */
+
+#include "backend/values/listkernels.h"
+
+#if LIST_KERNELS_AVX2
+#include <immintrin.h>
+
+#define KERNEL_AVX2 __attribute__((target("avx2")))
+#define KERNEL_LANES 8
+#endif
+
+/// SECTION: Dispatch
+
+int kernels_have_avx2()
+{
+#if LIST_KERNELS_AVX2
+    static int checked = 0;
+    static int has_avx2 = 0;
+
+    if (!checked)
+    {
+        __builtin_cpu_init();
+        has_avx2 = __builtin_cpu_supports("avx2") != 0;
+        checked = 1;
+    }
+
+    return has_avx2;
+#else
+    return 0;
+#endif
+}
+
+/// SECTION: Scalar kernels
+
+// NOTE: int math goes through uint32_t so overflow wraps instead of being undefined.
+
+static int32_t sum_i32_scalar(const int32_t *data, size_t count)
+{
+    uint32_t total = 0;
+
+    for (size_t i = 0; i < count; i++) total += (uint32_t)data[i];
+
+    return (int32_t)total;
+}
+
+static float sum_f32_scalar(const float *data, size_t count)
+{
+    float total = 0.0f;
+
+    for (size_t i = 0; i < count; i++) total += data[i];
+
+    return total;
+}
+
+static int32_t extreme_i32_scalar(const int32_t *data, size_t count, int want_max)
+{
+    int32_t best = data[0];
+
+    for (size_t i = 1; i < count; i++)
+    {
+        if (want_max ? data[i] > best : data[i] < best) best = data[i];
+    }
+
+    return best;
+}
+
+static float extreme_f32_scalar(const float *data, size_t count, int want_max)
+{
+    float best = data[0];
+
+    for (size_t i = 1; i < count; i++)
+    {
+        if (want_max ? data[i] > best : data[i] < best) best = data[i];
+    }
+
+    return best;
+}
+
+static int32_t dot_i32_scalar(const int32_t *left, const int32_t *right, size_t count)
+{
+    uint32_t total = 0;
+
+    for (size_t i = 0; i < count; i++) total += (uint32_t)left[i] * (uint32_t)right[i];
+
+    return (int32_t)total;
+}
+
+static float dot_f32_scalar(const float *left, const float *right, size_t count)
+{
+    float total = 0.0f;
+
+    for (size_t i = 0; i < count; i++) total += left[i] * right[i];
+
+    return total;
+}
+
+static long index_i32_scalar(const int32_t *data, size_t begin, size_t count, int32_t target)
+{
+    for (size_t i = begin; i < count; i++)
+    {
+        if (data[i] == target) return (long)i;
+    }
+
+    return -1;
+}
+
+static long index_f32_scalar(const float *data, size_t begin, size_t count, float target)
+{
+    for (size_t i = begin; i < count; i++)
+    {
+        if (data[i] == target) return (long)i;
+    }
+
+    return -1;
+}
+
+static void scale_i32_scalar(int32_t *dest, const int32_t *src, size_t begin, size_t count, int32_t factor)
+{
+    for (size_t i = begin; i < count; i++) dest[i] = (int32_t)((uint32_t)src[i] * (uint32_t)factor);
+}
+
+static void scale_f32_scalar(float *dest, const float *src, size_t begin, size_t count, float factor)
+{
+    for (size_t i = begin; i < count; i++) dest[i] = src[i] * factor;
+}
+
+/// SECTION: AVX2 kernels
+
+#if LIST_KERNELS_AVX2
+
+// NOTE: the horizontal helpers fold the 8 lanes into one: high half onto low half, then pairs within the 4 lanes left.
+
+KERNEL_AVX2 static int32_t hsum_epi32(__m256i lanes)
+{
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return _mm_cvtsi128_si32(half);
+}
+
+KERNEL_AVX2 static int32_t hextreme_epi32(__m256i lanes, int want_max)
+{
+    __m128i lo = _mm256_castsi256_si128(lanes);
+    __m128i hi = _mm256_extracti128_si256(lanes, 1);
+    __m128i half = want_max ? _mm_max_epi32(lo, hi) : _mm_min_epi32(lo, hi);
+    __m128i swapped = _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2));
+
+    half = want_max ? _mm_max_epi32(half, swapped) : _mm_min_epi32(half, swapped);
+    swapped = _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1));
+    half = want_max ? _mm_max_epi32(half, swapped) : _mm_min_epi32(half, swapped);
+
+    return _mm_cvtsi128_si32(half);
+}
+
+KERNEL_AVX2 static float hextreme_ps(__m256 lanes, int want_max)
+{
+    __m128 lo = _mm256_castps256_ps128(lanes);
+    __m128 hi = _mm256_extractf128_ps(lanes, 1);
+    __m128 half = want_max ? _mm_max_ps(lo, hi) : _mm_min_ps(lo, hi);
+    __m128 swapped = _mm_movehl_ps(half, half);
+
+    half = want_max ? _mm_max_ps(half, swapped) : _mm_min_ps(half, swapped);
+    swapped = _mm_shuffle_ps(half, half, _MM_SHUFFLE(1, 1, 1, 1));
+    half = want_max ? _mm_max_ss(half, swapped) : _mm_min_ss(half, swapped);
+
+    return _mm_cvtss_f32(half);
+}
+
+KERNEL_AVX2 static int32_t sum_i32_avx2(const int32_t *data, size_t count)
+{
+    __m256i lanes = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + KERNEL_LANES <= count; i += KERNEL_LANES)
+        lanes = _mm256_add_epi32(lanes, _mm256_loadu_si256((const __m256i *)(data + i)));
+
+    return (int32_t)((uint32_t)hsum_epi32(lanes) + (uint32_t)sum_i32_scalar(data + i, count - i));
+}
+
+KERNEL_AVX2 static int32_t extreme_i32_avx2(const int32_t *data, size_t count, int want_max)
+{
+    __m256i lanes = _mm256_loadu_si256((const __m256i *)data);
+    __m256i next;
+    int32_t best, rest;
+    size_t i = KERNEL_LANES;
+
+    for (; i + KERNEL_LANES <= count; i += KERNEL_LANES)
+    {
+        next = _mm256_loadu_si256((const __m256i *)(data + i));
+        lanes = want_max ? _mm256_max_epi32(lanes, next) : _mm256_min_epi32(lanes, next);
+    }
+
+    best = hextreme_epi32(lanes, want_max);
+
+    if (i == count) return best;
+
+    rest = extreme_i32_scalar(data + i, count - i, want_max);
+
+    return (want_max ? rest > best : rest < best) ? rest : best;
+}
+
+KERNEL_AVX2 static float extreme_f32_avx2(const float *data, size_t count, int want_max)
+{
+    __m256 lanes = _mm256_loadu_ps(data);
+    __m256 next;
+    float best, rest;
+    size_t i = KERNEL_LANES;
+
+    for (; i + KERNEL_LANES <= count; i += KERNEL_LANES)
+    {
+        next = _mm256_loadu_ps(data + i);
+        lanes = want_max ? _mm256_max_ps(lanes, next) : _mm256_min_ps(lanes, next);
+    }
+
+    best = hextreme_ps(lanes, want_max);
+
+    if (i == count) return best;
+
+    rest = extreme_f32_scalar(data + i, count - i, want_max);
+
+    return (want_max ? rest > best : rest < best) ? rest : best;
+}
+
+KERNEL_AVX2 static int32_t dot_i32_avx2(const int32_t *left, const int32_t *right, size_t count)
+{
+    __m256i lanes = _mm256_setzero_si256();
+    __m256i products;
+    size_t i = 0;
+
+    for (; i + KERNEL_LANES <= count; i += KERNEL_LANES)
+    {
+        products = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(left + i)), _mm256_loadu_si256((const __m256i *)(right + i)));
+        lanes = _mm256_add_epi32(lanes, products);
+    }
+
+    return (int32_t)((uint32_t)hsum_epi32(lanes) + (uint32_t)dot_i32_scalar(left + i, right + i, count - i));
+}
+
+KERNEL_AVX2 static long index_i32_avx2(const int32_t *data, size_t count, int32_t target)
+{
+    __m256i needle = _mm256_set1_epi32(target);
+    __m256i hits;
+    int mask;
+    size_t i = 0;
+
+    for (; i + KERNEL_LANES <= count; i += KERNEL_LANES)
+    {
+        hits = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i)), needle);
+        mask = _mm256_movemask_ps(_mm256_castsi256_ps(hits));
+
+        if (mask != 0) return (long)(i + (size_t)__builtin_ctz((unsigned int)mask));
+    }
+
+    return index_i32_scalar(data, i, count, target);
+}
+
+KERNEL_AVX2 static long index_f32_avx2(const float *data, size_t count, float target)
+{
+    __m256 needle = _mm256_set1_ps(target);
+    int mask;
+    size_t i = 0;
+
+    for (; i + KERNEL_LANES <= count; i += KERNEL_LANES)
+    {
+        mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+
+        if (mask != 0) return (long)(i + (size_t)__builtin_ctz((unsigned int)mask));
+    }
+
+    return index_f32_scalar(data, i, count, target);
+}
+
+KERNEL_AVX2 static void scale_i32_avx2(int32_t *dest, const int32_t *src, size_t count, int32_t factor)
+{
+    __m256i times = _mm256_set1_epi32(factor);
+    size_t i = 0;
+
+    for (; i + KERNEL_LANES <= count; i += KERNEL_LANES)
+        _mm256_storeu_si256((__m256i *)(dest + i), _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)(src + i)), times));
+
+    scale_i32_scalar(dest, src, i, count, factor);
+}
+
+KERNEL_AVX2 static void scale_f32_avx2(float *dest, const float *src, size_t count, float factor)
+{
+    __m256 times = _mm256_set1_ps(factor);
+    size_t i = 0;
+
+    for (; i + KERNEL_LANES <= count; i += KERNEL_LANES)
+        _mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), times));
+
+    scale_f32_scalar(dest, src, i, count, factor);
+}
+
+#endif
+
+/// SECTION: Reductions
+
+int32_t kernel_sum_i32(const int32_t *data, size_t count)
+{
+#if LIST_KERNELS_AVX2
+    if (kernels_have_avx2()) return sum_i32_avx2(data, count);
+#endif
+
+    return sum_i32_scalar(data, count);
+}
+
+float kernel_sum_f32(const float *data, size_t count)
+{
+    // NOTE: lanes would reorder the adds, so real sums stay a left to right loop on every CPU.
+    return sum_f32_scalar(data, count);
+}
+
+int32_t kernel_min_i32(const int32_t *data, size_t count)
+{
+#if LIST_KERNELS_AVX2
+    if (count >= KERNEL_LANES && kernels_have_avx2()) return extreme_i32_avx2(data, count, 0);
+#endif
+
+    return extreme_i32_scalar(data, count, 0);
+}
+
+int32_t kernel_max_i32(const int32_t *data, size_t count)
+{
+#if LIST_KERNELS_AVX2
+    if (count >= KERNEL_LANES && kernels_have_avx2()) return extreme_i32_avx2(data, count, 1);
+#endif
+
+    return extreme_i32_scalar(data, count, 1);
+}
+
+float kernel_min_f32(const float *data, size_t count)
+{
+#if LIST_KERNELS_AVX2
+    if (count >= KERNEL_LANES && kernels_have_avx2()) return extreme_f32_avx2(data, count, 0);
+#endif
+
+    return extreme_f32_scalar(data, count, 0);
+}
+
+float kernel_max_f32(const float *data, size_t count)
+{
+#if LIST_KERNELS_AVX2
+    if (count >= KERNEL_LANES && kernels_have_avx2()) return extreme_f32_avx2(data, count, 1);
+#endif
+
+    return extreme_f32_scalar(data, count, 1);
+}
+
+int32_t kernel_dot_i32(const int32_t *left, const int32_t *right, size_t count)
+{
+#if LIST_KERNELS_AVX2
+    if (kernels_have_avx2()) return dot_i32_avx2(left, right, count);
+#endif
+
+    return dot_i32_scalar(left, right, count);
+}
+
+float kernel_dot_f32(const float *left, const float *right, size_t count)
+{
+    return dot_f32_scalar(left, right, count);
+}
+
+/// SECTION: Search
+
+long kernel_index_i32(const int32_t *data, size_t count, int32_t target)
+{
+#if LIST_KERNELS_AVX2
+    if (kernels_have_avx2()) return index_i32_avx2(data, count, target);
+#endif
+
+    return index_i32_scalar(data, 0, count, target);
+}
+
+long kernel_index_f32(const float *data, size_t count, float target)
+{
+#if LIST_KERNELS_AVX2
+    if (kernels_have_avx2()) return index_f32_avx2(data, count, target);
+#endif
+
+    return index_f32_scalar(data, 0, count, target);
+}
+
+/// SECTION: Maps
+
+void kernel_scale_i32(int32_t *dest, const int32_t *src, size_t count, int32_t factor)
+{
+#if LIST_KERNELS_AVX2
+    if (kernels_have_avx2())
+    {
+        scale_i32_avx2(dest, src, count, factor);
+        return;
+    }
+#endif
+
+    scale_i32_scalar(dest, src, 0, count, factor);
+}
+
+void kernel_scale_f32(float *dest, const float *src, size_t count, float factor)
+{
+#if LIST_KERNELS_AVX2
+    if (kernels_have_avx2())
+    {
+        scale_f32_avx2(dest, src, count, factor);
+        return;
+    }
+#endif
+
+    scale_f32_scalar(dest, src, 0, count, factor);
+}
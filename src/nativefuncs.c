@@ -9,14 +9,13 @@
 
 /// SECTION: module io
 
-VarValue *rubel_print(FuncArgs *args)
+VarValue rubel_print(FuncArgs *args)
 {
     VarValue *arg1 = funcargs_get_at(args, 0);
-    DataType arg1_type = arg1->type;
 
-    if (!arg1) return NULL;
+    if (!arg1) return make_none_varval();
 
-    switch (arg1_type)
+    switch (arg1->type)
     {
     case INT_TYPE:
         printf("%i", arg1->data.int_val.value);
@@ -38,17 +37,16 @@ VarValue *rubel_print(FuncArgs *args)
         break;
     }
 
-    return NULL; // return the argument if it existed anyways... tells interpreter that print was OK
+    return make_none_varval(); // NOTE: print has no result value.
 }
 
-VarValue *rubel_println(FuncArgs *args)
+VarValue rubel_println(FuncArgs *args)
 {
     VarValue *arg1 = funcargs_get_at(args, 0);
-    DataType arg_type = varval_get_type(arg1);
 
-    if (!arg1) return NULL;
+    if (!arg1) return make_none_varval();
 
-    switch (arg_type)
+    switch (arg1->type)
     {
     case INT_TYPE:
         printf("%i\n", arg1->data.int_val.value);
@@ -70,56 +68,244 @@ VarValue *rubel_println(FuncArgs *args)
         break;
     }
 
-    return NULL;
+    return make_none_varval();
 }
 
-VarValue *rubel_input(FuncArgs *args)
+VarValue rubel_input(FuncArgs *args)
 {
-    char *input_buffer = malloc(sizeof(char) * (RUBEL_INPUT_READ_MAX + 1));
-
-    if (!input_buffer) return NULL; // NULL to signal memory or execution error
+    char input_buffer[RUBEL_INPUT_READ_MAX + 1];
+    StringObj *input_str = NULL;
 
     memset(input_buffer, '\0', RUBEL_INPUT_READ_MAX + 1);
-    
-    if (!fgets(input_buffer, RUBEL_INPUT_READ_MAX, stdin))
-    {
-        free(input_buffer);
-        return NULL;
-    }
 
-    StringObj *input_str = create_str_obj(input_buffer);
-    VarValue *varval_result = create_str_varval(0, input_str);
+    if (!fgets(input_buffer, RUBEL_INPUT_READ_MAX, stdin)) return make_none_varval(); // NONE to signal memory or execution error
 
-    if (!varval_result)
-    {
-        destroy_str_obj(input_str);
-        free(input_str);
-        return NULL;
-    }
+    // NOTE: the line is read on the stack, so short answers only cost the StringObj itself.
+    input_str = create_str_obj_n(input_buffer, strlen(input_buffer));
+
+    if (!input_str) return make_none_varval();
 
-    return varval_result;
+    return make_str_varval(0, input_str);
 }
 
 /// SECTION: module lists
 
-VarValue *rubel_list_len(FuncArgs *args)
+VarValue rubel_list_len(FuncArgs *args)
 {
     VarValue *arg1 = funcargs_get_at(args, 0);
-    DataType arg1_type = arg1->type;
 
-    if (arg1_type != LIST_TYPE) return NULL;
+    if (!arg1 || arg1->type != LIST_TYPE) return make_none_varval();
+
+    return make_int_varval(0, arg1->data.list_type.value->count);
+}
+
+VarValue rubel_list_at(FuncArgs *args)
+{
+    VarValue *arg1 = funcargs_get_at(args, 0);
+    VarValue *arg2 = funcargs_get_at(args, 1);
+    VarValue item;
+
+    if (!arg1 || !arg2) return make_none_varval();
+
+    if (arg1->type != LIST_TYPE || arg2->type != INT_TYPE) return make_none_varval();
+
+    if (arg2->data.int_val.value < 0) return make_none_varval();
+
+    // NOTE: a copy of the item's value, so the list keeps its own.
+    if (!get_at_list_obj(arg1->data.list_type.value, (size_t)arg2->data.int_val.value, &item)) return make_none_varval();
+
+    return item;
+}
+
+/**
+ * @brief Gets a list argument, or NULL if the argument is not a list.
+ */
+static ListObj *rubel_list_arg(FuncArgs *args, int index)
+{
+    VarValue *arg = funcargs_get_at(args, index);
+
+    if (!arg || arg->type != LIST_TYPE) return NULL;
+
+    return arg->data.list_type.value;
+}
+
+VarValue rubel_list_sum(FuncArgs *args)
+{
+    ListObj *list = rubel_list_arg(args, 0);
+
+    if (!list) return make_none_varval();
+
+    if (list->kind == LIST_INTS) return make_int_varval(0, kernel_sum_i32(list->store.ints, list->count));
+    else if (list->kind == LIST_REALS) return make_real_varval(0, kernel_sum_f32(list->store.reals, list->count));
+    else if (list->kind == LIST_EMPTY) return make_int_varval(0, 0);
+
+    return make_none_varval(); // NOTE: mixed lists have no numeric sum.
+}
+
+static VarValue rubel_list_extreme(FuncArgs *args, int want_max)
+{
+    ListObj *list = rubel_list_arg(args, 0);
+
+    if (!list) return make_none_varval();
+
+    if (list->kind == LIST_INTS)
+        return make_int_varval(0, want_max ? kernel_max_i32(list->store.ints, list->count) : kernel_min_i32(list->store.ints, list->count));
+    else if (list->kind == LIST_REALS)
+        return make_real_varval(0, want_max ? kernel_max_f32(list->store.reals, list->count) : kernel_min_f32(list->store.reals, list->count));
+
+    return make_none_varval();
+}
+
+VarValue rubel_list_min(FuncArgs *args)
+{
+    return rubel_list_extreme(args, 0);
+}
+
+VarValue rubel_list_max(FuncArgs *args)
+{
+    return rubel_list_extreme(args, 1);
+}
+
+VarValue rubel_list_index_of(FuncArgs *args)
+{
+    ListObj *list = rubel_list_arg(args, 0);
+    VarValue *target = funcargs_get_at(args, 1);
+    VarValue *item = NULL;
+
+    if (!list || !target) return make_none_varval();
+
+    if (list->kind == LIST_INTS && target->type == INT_TYPE)
+        return make_int_varval(0, (int)kernel_index_i32(list->store.ints, list->count, target->data.int_val.value));
+    else if (list->kind == LIST_REALS && target->type == REAL_TYPE)
+        return make_int_varval(0, (int)kernel_index_f32(list->store.reals, list->count, target->data.real_val.value));
+    else if (list->kind != LIST_MIXED)
+        return make_int_varval(0, -1);
+
+    // NOTE: boxed lists are searched one item at a time, and only same typed items can match.
+    for (size_t i = 0; i < list->count; i++)
+    {
+        item = list->store.items + i;
+
+        if (item->type != target->type) continue;
 
-    return create_int_varval(0, arg1->data.list_type.value->count);
+        if ((item->type == BOOL_TYPE && item->data.bool_val.flag == target->data.bool_val.flag)
+            || (item->type == INT_TYPE && item->data.int_val.value == target->data.int_val.value)
+            || (item->type == REAL_TYPE && item->data.real_val.value == target->data.real_val.value)
+            || (item->type == STR_TYPE && strcmp(item->data.str_type.value->source, target->data.str_type.value->source) == 0))
+            return make_int_varval(0, (int)i);
+    }
+
+    return make_int_varval(0, -1);
+}
+
+VarValue rubel_list_dot(FuncArgs *args)
+{
+    ListObj *left = rubel_list_arg(args, 0);
+    ListObj *right = rubel_list_arg(args, 1);
+
+    if (!left || !right || left->count != right->count) return make_none_varval();
+
+    if (left->kind == LIST_EMPTY && right->kind == LIST_EMPTY) return make_int_varval(0, 0);
+
+    if (left->kind != right->kind) return make_none_varval();
+
+    if (left->kind == LIST_INTS) return make_int_varval(0, kernel_dot_i32(left->store.ints, right->store.ints, left->count));
+    else if (left->kind == LIST_REALS) return make_real_varval(0, kernel_dot_f32(left->store.reals, right->store.reals, left->count));
+
+    return make_none_varval();
+}
+
+VarValue rubel_list_scale(FuncArgs *args)
+{
+    ListObj *list = rubel_list_arg(args, 0);
+    VarValue *factor = funcargs_get_at(args, 1);
+    ListObj *result = NULL;
+    size_t item_size = 0;
+
+    if (!list || !factor) return make_none_varval();
+
+    if (list->kind == LIST_INTS && factor->type == INT_TYPE) item_size = sizeof(int32_t);
+    else if (list->kind == LIST_REALS && factor->type == REAL_TYPE) item_size = sizeof(float);
+    else if (list->kind != LIST_EMPTY) return make_none_varval();
+
+    result = create_list_obj();
+
+    if (!result) return make_none_varval();
+
+    if (list->kind == LIST_EMPTY) return make_list_varval(0, result);
+
+    // NOTE: the new list is in the nursery already, so the heap frees it even if this fails.
+    result->store.items = malloc(item_size * list->count);
+
+    if (!result->store.items) return make_none_varval();
+
+    result->kind = list->kind;
+    result->count = list->count;
+    result->capacity = list->count;
+    heap_resize(&result->gc, sizeof(ListObj) + item_size * list->count);
+
+    if (list->kind == LIST_INTS) kernel_scale_i32(result->store.ints, list->store.ints, list->count, factor->data.int_val.value);
+    else kernel_scale_f32(result->store.reals, list->store.reals, list->count, factor->data.real_val.value);
+
+    return make_list_varval(0, result);
+}
+
+/// SECTION: module strings
+
+VarValue rubel_str_builder(FuncArgs *args)
+{
+    StringObj *builder = create_str_builder();
+
+    if (!builder) return make_none_varval();
+
+    return make_str_varval(0, builder);
 }
 
-VarValue *rubel_list_at(FuncArgs *args)
+VarValue rubel_str_append(FuncArgs *args)
 {
     VarValue *arg1 = funcargs_get_at(args, 0);
     VarValue *arg2 = funcargs_get_at(args, 1);
-    DataType arg1_type = arg1->type;
-    DataType arg2_type = arg2->type;
+    char format_buf[RUBEL_FORMAT_BUF_SZ];
+    StringObj piece;
+    StringObj *result = NULL;
+
+    if (!arg1 || !arg2 || arg1->type != STR_TYPE) return make_none_varval();
+
+    switch (arg2->type)
+    {
+    case STR_TYPE:
+        result = concat_str_obj(arg1->data.str_type.value, arg2->data.str_type.value);
+        break;
+    case INT_TYPE:
+    case REAL_TYPE:
+    case BOOL_TYPE:
+        // NOTE: printed like the io natives do, then appended from a borrowed stack string.
+        if (arg2->type == INT_TYPE) piece.length = (size_t)snprintf(format_buf, RUBEL_FORMAT_BUF_SZ, "%i", arg2->data.int_val.value);
+        else if (arg2->type == REAL_TYPE) piece.length = (size_t)snprintf(format_buf, RUBEL_FORMAT_BUF_SZ, "%f", arg2->data.real_val.value);
+        else piece.length = (size_t)snprintf(format_buf, RUBEL_FORMAT_BUF_SZ, "%s", arg2->data.bool_val.flag ? "boolean($T)" : "boolean($F)");
+
+        piece.source = format_buf;
+        result = concat_str_obj(arg1->data.str_type.value, &piece);
+        break;
+    default:
+        break;
+    }
+
+    if (!result) return make_none_varval();
+
+    return make_str_varval(0, result);
+}
+
+VarValue rubel_str_build(FuncArgs *args)
+{
+    VarValue *arg1 = funcargs_get_at(args, 0);
+    StringObj *result = NULL;
+
+    if (!arg1 || arg1->type != STR_TYPE) return make_none_varval();
+
+    result = copy_str_obj(arg1->data.str_type.value);
 
-    if (arg1_type != LIST_TYPE || arg2_type != INT_TYPE) return NULL;
+    if (!result) return make_none_varval();
 
-    return get_at_list_obj(arg1->data.list_type.value, (size_t)arg2->data.int_val.value);
+    return make_str_varval(0, result);
 }
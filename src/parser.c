@@ -9,11 +9,12 @@
 
 #include "frontend/parser.h"
 
-void parser_init(Parser *parser, char *src)
+void parser_init(Parser *parser, const char *src, size_t length)
 {
     parser->src_copy_ptr = src;
     parser->ready_flag = src != NULL;
-    lexer_init(&parser->lexer, src);
+    parser->arena = NULL;
+    lexer_init(&parser->lexer, src, length);
     token_init(&parser->previous, UNKNOWN, 0, 0, 0);
     token_init(&parser->current, UNKNOWN, 0, 0, 0);
     parser_advance(parser);
@@ -77,7 +78,26 @@ char *parser_stringify_token(Parser *parser, Token *token_ptr)
     if (!token_ptr)
         return NULL;
 
-    return token_as_txt(token_ptr, parser->src_copy_ptr);
+    // NOTE: lexemes kept by the AST live in the script's arena, so nodes never free them.
+    return arena_strndup(parser->arena, parser->src_copy_ptr + token_ptr->begin, token_ptr->span);
+}
+
+char *parser_intern_token(Parser *parser, Token *token_ptr)
+{
+    if (!token_ptr)
+        return NULL;
+
+    // NOTE: names are pooled once, so the runtime tables can compare them by address.
+    return intern_string(parser->src_copy_ptr + token_ptr->begin, token_ptr->span);
+}
+
+int parser_match_lexeme(Parser *parser, const Token *token_ptr, const char *word)
+{
+    size_t word_len = strlen(word);
+
+    if (token_ptr->span != word_len) return 0;
+
+    return strncmp(parser->src_copy_ptr + token_ptr->begin, word, word_len) == 0;
 }
 
 /// SECTION: Expressions
@@ -85,32 +105,32 @@ char *parser_stringify_token(Parser *parser, Token *token_ptr)
 Expression *parse_primitive(Parser *parser)
 {
     Token token = parser_peek_curr(parser);
-    char *lexeme = parser_stringify_token(parser, &token);
+    const char *lexeme = parser->src_copy_ptr + token.begin; // NOTE: numbers end at a non-digit, so the source can be read in place.
+    StringObj *str_obj = NULL;
     Expression *expr = NULL;
 
-    if (!lexeme) return expr;
-
     switch (token.type)
     {
     case BOOLEAN:
-        expr = create_bool(strncmp(lexeme, "$T", 2) == 0);
-        free(lexeme);
+        expr = create_bool(parser->arena, parser_match_lexeme(parser, &token, "$T"));
         break;
     case INTEGER:
-        expr = create_int(atoi(lexeme));
-        free(lexeme);
+        expr = create_int(parser->arena, atoi(lexeme));
         break;
     case REAL:
-        expr = create_real(strtof(lexeme, NULL));
-        free(lexeme);
+        expr = create_real(parser->arena, strtof(lexeme, NULL));
         break;
     case STRBODY:
-        expr = create_str(create_str_obj(lexeme));
-        // NOTE: StringObj now owns the lexeme content. No free needed yet.
+        // NOTE: string literals are arena data too, so no value may free them.
+        str_obj = arena_alloc_node(parser->arena, sizeof(StringObj));
+
+        if (!str_obj) break;
+
+        init_pinned_str_obj(str_obj, parser_stringify_token(parser, &token), token.span);
+        expr = create_str(parser->arena, str_obj);
         break;
     default:
         parser_log_err(parser, token.line, "Expected primitive value.");
-        free(lexeme);
         break;
     }
 
@@ -141,6 +161,9 @@ Expression *parse_list(Parser *parser)
 
     if (!list_val) return expr;
 
+    // NOTE: list literals belong to the AST, so the heap keeps them until it is disposed.
+    heap_pin(&list_val->gc);
+
     // consume 1st literal and so on...
     while (!parser_at_end(parser))
     {
@@ -159,42 +182,30 @@ Expression *parse_list(Parser *parser)
         {
         case BOOLEAN:
             literal = parse_primitive(parser);
-            append_list_obj(list_val, create_bool_varval(0, literal->syntax.bool_literal.flag));
-
-            destroy_expr(literal);
-            free(literal);
+            append_list_obj(list_val, make_bool_varval(0, literal->syntax.bool_literal.flag));
 
             break;
         case INTEGER:
             literal = parse_primitive(parser);
-            append_list_obj(list_val, create_int_varval(0, literal->syntax.int_literal.value));
-
-            destroy_expr(literal);
-            free(literal);
+            append_list_obj(list_val, make_int_varval(0, literal->syntax.int_literal.value));
 
             comma_expected = 1;
             break;
         case REAL:
             literal = parse_primitive(parser);
-            append_list_obj(list_val, create_real_varval(0, literal->syntax.real_literal.value));
-
-            destroy_expr(literal);
-            free(literal);
+            append_list_obj(list_val, make_real_varval(0, literal->syntax.real_literal.value));
 
             comma_expected = 1;
             break;
         case STRBODY:
             literal = parse_primitive(parser);
-            append_list_obj(list_val, create_str_varval(0, (StringObj *)(literal->syntax.str_literal.str_obj)));
-
-            free(literal);
+            append_list_obj(list_val, make_str_varval(0, (StringObj *)(literal->syntax.str_literal.str_obj)));
 
             comma_expected = 1;
             break;
         case LBRACK:
             literal = parse_list(parser);
-            append_list_obj(list_val, create_list_varval(0, literal->syntax.list_literal.list_obj));
-            free(literal);
+            append_list_obj(list_val, make_list_varval(0, literal->syntax.list_literal.list_obj));
 
             comma_expected = 1;
             break;
@@ -214,16 +225,11 @@ Expression *parse_list(Parser *parser)
     if (bad_comma)
     {
         parser_log_err(parser, tok.line, "Unexpected comma nearby.");
-        destroy_expr(expr);
-        free(expr);
-        expr = NULL;
 
-        destroy_list_obj(list_val);
-        free(list_val);
-        return expr;
+        return expr; // NOTE: the pinned list is freed with the heap.
     }
 
-    expr = create_list(list_val);
+    expr = create_list(parser->arena, list_val);
 
     return expr;
 }
@@ -243,8 +249,6 @@ Expression *parse_literal(Parser *parser)
 
         if (token.type != RPAREN)
         {
-            destroy_expr(expr);
-            free(expr);
             expr = NULL;
         }
         else
@@ -263,7 +267,7 @@ Expression *parse_literal(Parser *parser)
         expr = parse_list(parser);
         break;
     case IDENTIFIER:
-        expr = create_var(0, parser_stringify_token(parser, &token));
+        expr = create_var(parser->arena, 0, parser_intern_token(parser, &token));
         parser_advance(parser);
         break;
     default:
@@ -296,15 +300,15 @@ Expression *parse_call(Parser *parser)
     // handle case of lone identifier usage (a variable!)
     if (tok.type != LPAREN)
     {
-        lexeme = parser_stringify_token(parser, &prev);
-        expr = create_var(0, lexeme);
+        lexeme = parser_intern_token(parser, &prev);
+        expr = create_var(parser->arena, 0, lexeme);
 
         return expr;
     }
 
     // prepare call expression node with identifier string
-    lexeme = parser_stringify_token(parser, &prev);
-    expr = create_call(lexeme);
+    lexeme = parser_intern_token(parser, &prev);
+    expr = create_call(parser->arena, lexeme);
 
     // process argument listing until ')'
     parser_advance(parser);
@@ -323,7 +327,7 @@ Expression *parse_call(Parser *parser)
 
         if (tok.type != COMMA)
         {
-            add_arg_call(expr, parse_expr(parser));
+            add_arg_call(parser->arena, expr, parse_expr(parser));
         }
         else
         {
@@ -337,8 +341,6 @@ Expression *parse_call(Parser *parser)
 
     if (bad_comma)
     {
-        destroy_expr(expr);
-        free(expr);
         expr = NULL;
     }
 
@@ -354,7 +356,7 @@ Expression *parse_unary(Parser *parser)
     if (tok.type == OPERATOR && tok.span == 1 && operator_symbol == '-')
     {
         parser_advance(parser);
-        expr = create_unary(OP_NEG, parse_literal(parser));
+        expr = create_unary(parser->arena, OP_NEG, parse_literal(parser));
     }
     else if (tok.type == IDENTIFIER)
     {
@@ -390,7 +392,7 @@ Expression *parse_factor(Parser *parser)
 
         char operator_symbol = parser->src_copy_ptr[tok.begin];
 
-        if (tok.span != 1 || (tok.type == OPERATOR && operator_symbol != '*' && operator_symbol != '/'))
+        if (tok.type == OPERATOR && (tok.span != 1 || (operator_symbol != '*' && operator_symbol != '/')))
         {
             return expr;
         }
@@ -408,8 +410,9 @@ Expression *parse_factor(Parser *parser)
         else
         {
             right = parse_unary(parser);
-            temp = create_binary(operation, expr, right);
+            temp = create_binary(parser->arena, operation, expr, right);
             expr = temp;
+            valid_oper = 0; // NOTE: an operand must be followed by another operator to continue.
         }
     }
 
@@ -435,7 +438,7 @@ Expression *parse_term(Parser *parser)
 
         char operator_symbol = parser->src_copy_ptr[tok.begin];
 
-        if (tok.span != 1 || (tok.type == OPERATOR && operator_symbol != '+' && operator_symbol != '-'))
+        if (tok.type == OPERATOR && (tok.span != 1 || (operator_symbol != '+' && operator_symbol != '-')))
         {
             return expr;
         }
@@ -452,8 +455,9 @@ Expression *parse_term(Parser *parser)
         else
         {
             right = parse_factor(parser);
-            temp = create_binary(operation, expr, right);
+            temp = create_binary(parser->arena, operation, expr, right);
             expr = temp;
+            valid_oper = 0; // NOTE: an operand must be followed by another operator to continue.
         }
     }
 
@@ -477,27 +481,25 @@ Expression *parse_comparison(Parser *parser)
 
         if (tok.type != OPERATOR && !valid_oper) return expr;
 
-        char *lexeme = parser_stringify_token(parser, &tok);
-
-        if (tok.type == OPERATOR && strncmp(lexeme, ">=", 2) == 0)
+        if (tok.type == OPERATOR && parser_match_lexeme(parser, &tok, ">="))
         {
             operation = OP_GTE;
             valid_oper = 1;
             parser_advance(parser);
         }
-        else if (tok.type == OPERATOR && strncmp(lexeme, "<=", 2) == 0)
+        else if (tok.type == OPERATOR && parser_match_lexeme(parser, &tok, "<="))
         {
             operation = OP_LTE;
             valid_oper = 1;
             parser_advance(parser);
         }
-        else if (tok.type == OPERATOR && strncmp(lexeme, ">", 1) == 0)
+        else if (tok.type == OPERATOR && parser_match_lexeme(parser, &tok, ">"))
         {
             operation = OP_GT;
             valid_oper = 1;
             parser_advance(parser);
         }
-        else if (tok.type == OPERATOR && strncmp(lexeme, "<", 1) == 0)
+        else if (tok.type == OPERATOR && parser_match_lexeme(parser, &tok, "<"))
         {
             operation = OP_LT;
             valid_oper = 1;
@@ -506,7 +508,7 @@ Expression *parse_comparison(Parser *parser)
         else if (valid_oper)
         {
             right = parse_term(parser);
-            temp = create_binary(operation, expr, right);
+            temp = create_binary(parser->arena, operation, expr, right);
             expr = temp;
             valid_oper = 0;
         }
@@ -523,15 +525,10 @@ Expression *parse_comparison(Parser *parser)
             // NOTE: a malformed expr should be discarded... not runnable anyways
             parser_log_err(parser, tok.line, "Invalid operator or token in expr.");
 
-            free(lexeme);
-            destroy_expr(expr);
-            free(expr);
-
             expr = NULL;
             return expr;
         }
 
-        free(lexeme);
     }
 
     return expr;
@@ -554,15 +551,13 @@ Expression *parse_equality(Parser *parser)
 
         if (tok.type != OPERATOR && !valid_oper) return expr;
 
-        char *lexeme = parser_stringify_token(parser, &tok);
-
-        if (strncmp(lexeme, "!=", 2) == 0)
+        if (parser_match_lexeme(parser, &tok, "!="))
         {
             operation = OP_NEQ;
             valid_oper = 1;
             parser_advance(parser);
         }
-        else if (strncmp(lexeme, "==", 2) == 0)
+        else if (parser_match_lexeme(parser, &tok, "=="))
         {
             operation = OP_EQ;
             valid_oper = 1;
@@ -571,7 +566,7 @@ Expression *parse_equality(Parser *parser)
         else if (valid_oper)
         {
             right = parse_comparison(parser);
-            temp = create_binary(operation, expr, right);
+            temp = create_binary(parser->arena, operation, expr, right);
             expr = temp;
             valid_oper = 0;
         }
@@ -587,15 +582,11 @@ Expression *parse_equality(Parser *parser)
         {
             parser_log_err(parser, tok.line, "Invalid operator or token in expr.");
 
-            free(lexeme);
-            destroy_expr(expr);
-            free(expr);
             expr = NULL;
 
             return expr;
         }
 
-        free(lexeme);
     }
 
     return expr;
@@ -620,15 +611,13 @@ Expression *parse_equality(Parser *parser)
         if (tok.type != OPERATOR && !valid_oper)
             return expr;
 
-        char *lexeme = parser_stringify_token(parser, &tok);
-
-        if (strncmp(lexeme, "||", 2) == 0)
+        if (parser_match_lexeme(parser, &tok, "||"))
         {
             operation = OP_OR;
             valid_oper = 1;
             parser_advance(parser);
         }
-        else if (strncmp(lexeme, "&&", 2) == 0)
+        else if (parser_match_lexeme(parser, &tok, "&&"))
         {
             operation = OP_AND;
             valid_oper = 1;
@@ -637,7 +626,7 @@ Expression *parse_equality(Parser *parser)
         else if (valid_oper)
         {
             right = parse_equality(parser);
-            temp = create_binary(operation, expr, right);
+            temp = create_binary(parser->arena, operation, expr, right);
             expr = temp;
         }
         else if (tok.type == RPAREN)
@@ -648,15 +637,11 @@ Expression *parse_equality(Parser *parser)
         {
             parser_log_err(parser, tok.line, "Invalid operator or token in expr.");
 
-            free(lexeme);
-            destroy_expr(expr);
-            free(expr);
             expr = NULL;
 
             return expr;
         }
 
-        free(lexeme);
     }
 
     return expr;
@@ -674,7 +659,6 @@ Expression *parse_expr(Parser *parser)
 Statement *parse_var_decl(Parser *parser)
 {
     Token tok = parser_peek_curr(parser);
-    char *lexeme = NULL;
     Statement *var_decl = NULL;
     int is_const = 0;
 
@@ -684,25 +668,20 @@ Statement *parse_var_decl(Parser *parser)
         return var_decl;
     }
 
-    lexeme = parser_stringify_token(parser, &tok);
-
     // check whether to parse as const variable or not!
-    if (strcmp(lexeme, "let") == 0)
+    if (parser_match_lexeme(parser, &tok, "let"))
     {
         is_const = 0;
-        free(lexeme);
     }
-    else if (strcmp(lexeme, "const") == 0)
+    else if (parser_match_lexeme(parser, &tok, "const"))
     {
         is_const = 1;
-        free(lexeme);  // dispose temp keyword string
     }
     else
     {
         // reject invalid var declarations as NULL AST nodes
         parser_log_err(parser, tok.line, "Expected 'let' or 'const'.");
         is_const = -1;
-        free(lexeme);
         return var_decl;
     }
 
@@ -713,9 +692,7 @@ Statement *parse_var_decl(Parser *parser)
     if (tok.type != IDENTIFIER)
         return var_decl;
 
-    lexeme = parser_stringify_token(parser, &tok);
-    var_decl = create_var_decl(is_const, lexeme, NULL);
-    lexeme = NULL;
+    var_decl = create_var_decl(parser->arena, is_const, parser_intern_token(parser, &tok), NULL);
 
     // check possible assignment token
     parser_advance(parser);
@@ -724,8 +701,6 @@ Statement *parse_var_decl(Parser *parser)
     if (tok.type != OPERATOR || parser->src_copy_ptr[tok.begin] != '=')
     {
         parser_log_err(parser, tok.line, "Expected '='.");
-        destroy_stmt(var_decl);
-        free(var_decl);
         var_decl = NULL;
 
         return var_decl; // reject uninitialized vars by my varDecl rule!
@@ -743,19 +718,15 @@ Statement *parse_var_assign(Parser *parser)
 {
     // NOTE: assignments are considered statements since they cause side effects.
     Token tok = parser_peek_curr(parser);
-    char *lexeme = parser_stringify_token(parser, &tok);
     Statement *assign_stmt = NULL;
     Expression *rvalue = NULL;
 
     // validate keyword "set" to enforce syntax
-    if (tok.type != KEYWORD || (tok.type == KEYWORD && strncmp(lexeme, "set", 3) != 0))
+    if (tok.type != KEYWORD || (tok.type == KEYWORD && !parser_match_lexeme(parser, &tok, "set")))
     {
-        free(lexeme);
         return assign_stmt;
     }
 
-    free(lexeme);
-
     // consume and validate possible identifier
     parser_advance(parser);
     tok = parser_peek_curr(parser);
@@ -763,9 +734,7 @@ Statement *parse_var_assign(Parser *parser)
     if (tok.type != IDENTIFIER) return assign_stmt;
 
     // prepare assignment syntax node
-    lexeme = parser_stringify_token(parser, &tok);
-    assign_stmt = create_var_assign(lexeme, NULL);
-    lexeme = NULL;
+    assign_stmt = create_var_assign(parser->arena, parser_intern_token(parser, &tok), NULL);
 
     // consume and validate possible '='
     parser_advance(parser);
@@ -773,8 +742,6 @@ Statement *parse_var_assign(Parser *parser)
 
     if (tok.type != OPERATOR || (tok.type == OPERATOR && parser->src_copy_ptr[tok.begin] != '='))
     {
-        destroy_stmt(assign_stmt);
-        free(assign_stmt);
         return NULL;
     }
 
@@ -785,10 +752,6 @@ Statement *parse_var_assign(Parser *parser)
     // reject prepared assign node if expr parse fails since an invalid node cannot be evaluated anyways
     if (!rvalue)
     {
-        destroy_expr(rvalue);
-        free(rvalue);
-        destroy_stmt(assign_stmt);
-        free(assign_stmt);
         return NULL;
     }
 
@@ -800,24 +763,18 @@ Statement *parse_var_assign(Parser *parser)
 Statement *parse_otherwise_stmt(Parser *parser)
 {
     Token tok = parser_peek_curr(parser);
-    char *lexeme = NULL;
     Statement *block_stmt = NULL;
     Statement *otherwise_stmt = NULL;
 
     // check for "otherwise" keyword to validate stmt
     if (tok.type != KEYWORD) return otherwise_stmt;
 
-    lexeme = parser_stringify_token(parser, &tok);
-
-    if (strncmp(lexeme, "otherwise", 9) != 0)
+    // NOTE: an if without an otherwise is fine, so just leave the next keyword alone.
+    if (!parser_match_lexeme(parser, &tok, "otherwise"))
     {
-        parser_log_err(parser, tok.line, "Expected 'otherwise'.");
-        free(lexeme);
         return otherwise_stmt;
     }
 
-    free(lexeme);
-
     // advance to otherwise body!
     parser_advance(parser);
 
@@ -827,7 +784,7 @@ Statement *parse_otherwise_stmt(Parser *parser)
     // reject failed parses of otherwise blocks!
     if (!block_stmt) return otherwise_stmt;
 
-    otherwise_stmt = create_otherwise_stmt(block_stmt);
+    otherwise_stmt = create_otherwise_stmt(parser->arena, block_stmt);
 
     return otherwise_stmt;
 }
@@ -835,24 +792,19 @@ Statement *parse_otherwise_stmt(Parser *parser)
 Statement *parse_if_stmt(Parser *parser)
 {
     Token tok = parser_peek_curr(parser);
-    char *lexeme = NULL;
     Statement *if_stmt = NULL;
     Statement *first_block = NULL;
 
     // check for starting keyword "if" to validate stmt
     if (tok.type != KEYWORD) return if_stmt;
 
-    lexeme = parser_stringify_token(parser, &tok);
     
-    if (strncmp(lexeme, "if", 2) != 0)
+    if (!parser_match_lexeme(parser, &tok, "if"))
     {
         parser_log_err(parser, tok.line, "Expected 'if'.");
-        free(lexeme);
         return if_stmt;
     }
 
-    free(lexeme);
-
     // parse conditional expr and then if block!
     parser_advance(parser);
 
@@ -862,14 +814,12 @@ Statement *parse_if_stmt(Parser *parser)
     {
         // reject malformed if stmts since condition is needed!
         parser_log_err(parser, tok.line, "Expected conditions.");
-        destroy_stmt(if_stmt);
-        free(if_stmt);
         if_stmt = NULL;
 
         return if_stmt;
     }
 
-    if_stmt = create_if_stmt(cond, NULL, NULL);
+    if_stmt = create_if_stmt(parser->arena, cond, NULL, NULL);
 
     first_block = parse_block_stmt(parser);
 
@@ -877,8 +827,6 @@ Statement *parse_if_stmt(Parser *parser)
     {
         // reject malformed if stmts since if block is needed!
         parser_log_err(parser, tok.line, "Could not find stmt block.");
-        destroy_stmt(if_stmt);
-        free(if_stmt);
         if_stmt = NULL;
 
         return if_stmt;
@@ -893,7 +841,6 @@ Statement *parse_if_stmt(Parser *parser)
 Statement *parse_while_stmt(Parser *parser)
 {
     Token tok = parser_peek_curr(parser);
-    char *lexeme = NULL;
     Statement *while_stmt = NULL;
     Statement *loop_block = NULL;
 
@@ -903,20 +850,16 @@ Statement *parse_while_stmt(Parser *parser)
         return while_stmt;
     }
     
-    lexeme = parser_stringify_token(parser, &tok);
     
-    if (strncmp(lexeme, "while", 5) != 0)
+    if (!parser_match_lexeme(parser, &tok, "while"))
     {
         parser_log_err(parser, tok.line, "Expected 'while'.");
-        free(lexeme);
         return while_stmt;
     }
 
-    free(lexeme);
-
     // parse loop conditional
     parser_advance(parser);
-    while_stmt = create_while_stmt(NULL, NULL);
+    while_stmt = create_while_stmt(parser->arena, NULL, NULL);
 
     while_stmt->syntax.while_stmt.condition = parse_expr(parser);
     loop_block = parse_block_stmt(parser);
@@ -925,8 +868,6 @@ Statement *parse_while_stmt(Parser *parser)
     {
         tok = parser_peek_curr(parser);
         parser_log_err(parser, tok.line, "Could not parse loop block.");
-        destroy_stmt(while_stmt);
-        free(while_stmt);
         while_stmt = NULL;
 
         return while_stmt;
@@ -940,20 +881,16 @@ Statement *parse_while_stmt(Parser *parser)
 Statement *parse_return_stmt(Parser *parser)
 {
     Token tok = parser_peek_curr(parser);
-    char *lexeme = parser_stringify_token(parser, &tok);
     Expression *result_expr = NULL;
     Statement *ret_stmt = NULL;
 
     // validate starting "return" token
-    if (tok.type != KEYWORD && strncmp(lexeme, "return", 6) != 0)
+    if (tok.type != KEYWORD && !parser_match_lexeme(parser, &tok, "return"))
     {
         parser_log_err(parser, tok.line, "Expected 'return'.");
-        free(lexeme);
         return ret_stmt;
     }
 
-    free(lexeme);
-
     // parse result expr
     parser_advance(parser);
 
@@ -965,7 +902,7 @@ Statement *parse_return_stmt(Parser *parser)
         return ret_stmt;
     }
 
-    ret_stmt = create_return_stmt(result_expr);
+    ret_stmt = create_return_stmt(parser->arena, result_expr);
 
     return ret_stmt;
 }
@@ -973,43 +910,39 @@ Statement *parse_return_stmt(Parser *parser)
 Statement *parse_block_stmt(Parser *parser)
 {
     Token checked_tok;
-    char *lexeme = NULL;
     Statement *temp_stmt = NULL;
-    Statement *block_stmt = create_block_stmt();
+    Statement *block_stmt = create_block_stmt(parser->arena);
 
     while (!parser_at_end(parser))
     {
         checked_tok = parser_peek_curr(parser);
-        lexeme = parser_stringify_token(parser, &checked_tok);
 
-        if (strncmp(lexeme, "while", 5) == 0)
+        if (parser_match_lexeme(parser, &checked_tok, "while"))
         {
             temp_stmt = parse_while_stmt(parser);
         }
-        else if (strncmp(lexeme, "if", 2) == 0)
+        else if (parser_match_lexeme(parser, &checked_tok, "if"))
         {
             temp_stmt = parse_if_stmt(parser);
         }
-        else if (strncmp(lexeme, "otherwise", 9) == 0)
+        else if (parser_match_lexeme(parser, &checked_tok, "otherwise"))
         {
-            free(lexeme);  // NOTE: discard "otherwise" token AND do not advance in this case... "otherwise" starts a stmt!
             break;
         }
-        else if (strncmp(lexeme, "end", 3) == 0)
+        else if (parser_match_lexeme(parser, &checked_tok, "end"))
         {
-            free(lexeme); // NOTE; discard "end" token as it's a block end mark
             parser_advance(parser);
             break;
         }
-        else if (strncmp(lexeme, "return", 6) == 0)
+        else if (parser_match_lexeme(parser, &checked_tok, "return"))
         {
             temp_stmt = parse_return_stmt(parser);
         }
-        else if (strncmp(lexeme, "let", 3) == 0 || strncmp(lexeme, "const", 5) == 0)
+        else if (parser_match_lexeme(parser, &checked_tok, "let") || parser_match_lexeme(parser, &checked_tok, "const"))
         {
             temp_stmt = parse_var_decl(parser);
         }
-        else if (strncmp(lexeme, "set", 3) == 0)
+        else if (parser_match_lexeme(parser, &checked_tok, "set"))
         {
             temp_stmt = parse_var_assign(parser);
         }
@@ -1018,13 +951,9 @@ Statement *parse_block_stmt(Parser *parser)
             temp_stmt = parse_expr_stmt(parser);
         }
 
-        free(lexeme);
-
-        if (!grow_block_stmt(block_stmt, temp_stmt))
+        if (!grow_block_stmt(parser->arena, block_stmt, temp_stmt))
         {
             parser_log_err(parser, checked_tok.line, "Could not construct stmt block by bad alloc.");
-            destroy_stmt(block_stmt);
-            free(block_stmt);
             block_stmt = NULL;
 
             break;
@@ -1039,28 +968,22 @@ Statement *parse_func_stmt(Parser *parser)
     int bad_syntax = 0;
     int comma_expected = 0;
     Token tok = parser_peek_curr(parser);
-    char *lexeme = NULL;
     Expression *param_expr = NULL;
     Statement *fn_stmt = NULL;
 
     // check starting keyword "proc"
     if (tok.type != KEYWORD) return fn_stmt;
 
-    lexeme = parser_stringify_token(parser, &tok);
-
-    if (strncmp(lexeme, "proc", 4) != 0)
+    if (!parser_match_lexeme(parser, &tok, "proc"))
     {
         parser_log_err(parser, tok.line, "Expected 'proc'.");
-        free(lexeme);
         return fn_stmt;
     }
 
     // parse identifier: check parse order of ident, lparen, etc!
     parser_advance(parser);
     tok = parser_peek_curr(parser);
-    lexeme = parser_stringify_token(parser, &tok);
-    fn_stmt = create_func_stmt(lexeme, NULL);
-    lexeme = NULL;
+    fn_stmt = create_func_stmt(parser->arena, parser_intern_token(parser, &tok), NULL);
 
     // parse args
     parser_advance(parser);
@@ -1093,7 +1016,7 @@ Statement *parse_func_stmt(Parser *parser)
         else
         {
             param_expr = parse_literal(parser);
-            put_arg_func_stmt(fn_stmt, param_expr);
+            put_arg_func_stmt(parser->arena, fn_stmt, param_expr);
             comma_expected = 1;
         }
 
@@ -1107,8 +1030,6 @@ Statement *parse_func_stmt(Parser *parser)
     if (bad_syntax)
     {
         parser_log_err(parser, tok.line, "Unexpected comma.");
-        destroy_stmt(fn_stmt);
-        free(fn_stmt);
         fn_stmt = NULL;
 
         return fn_stmt;
@@ -1120,8 +1041,6 @@ Statement *parse_func_stmt(Parser *parser)
     if (!fn_body)
     {
         parser_log_err(parser, tok.line, "Failed to find function body.");
-        destroy_stmt(fn_stmt);
-        free(fn_stmt);
         fn_stmt = NULL;
 
         return fn_stmt;
@@ -1135,24 +1054,18 @@ Statement *parse_func_stmt(Parser *parser)
 Statement *parse_module_stmt(Parser *parser)
 {
     Token tok = parser_peek_curr(parser);
-    char *lexeme = parser_stringify_token(parser, &tok);
     Statement *use_stmt = NULL;
 
-    if (tok.type != KEYWORD || strncmp(lexeme, "module", 6) != 0)
+    if (tok.type != KEYWORD || !parser_match_lexeme(parser, &tok, "module"))
     {
         parser_log_err(parser, tok.line, "Expected 'module'.");
-        free(lexeme);
         return use_stmt;
     }
 
-    free(lexeme);
-
     // check identifier
     parser_advance(parser);
     tok = parser_peek_curr(parser);
-    lexeme = parser_stringify_token(parser, &tok);
-    use_stmt = create_module_def(lexeme);
-    lexeme = NULL;
+    use_stmt = create_module_def(parser->arena, parser_intern_token(parser, &tok));
 
     parser_advance(parser);
 
@@ -1162,24 +1075,18 @@ Statement *parse_module_stmt(Parser *parser)
 Statement *parse_use_stmt(Parser *parser)
 {
     Token tok = parser_peek_curr(parser);
-    char *lexeme = parser_stringify_token(parser, &tok);
     Statement *use_stmt = NULL;
 
-    if (tok.type != KEYWORD || strncmp(lexeme, "use", 3) != 0)
+    if (tok.type != KEYWORD || !parser_match_lexeme(parser, &tok, "use"))
     {
         parser_log_err(parser, tok.line, "Expected 'use'.");
-        free(lexeme);
         return use_stmt;
     }
 
-    free(lexeme);
-
     // check identifier
     parser_advance(parser);
     tok = parser_peek_curr(parser);
-    lexeme = parser_stringify_token(parser, &tok);
-    use_stmt = create_module_usage(lexeme);
-    lexeme = NULL;
+    use_stmt = create_module_usage(parser->arena, parser_intern_token(parser, &tok));
 
     parser_advance(parser);
 
@@ -1192,25 +1099,22 @@ Statement *parse_expr_stmt(Parser *parser)
 
     if (!inner_expr) return NULL;
 
-    return create_expr_stmt(inner_expr);
+    return create_expr_stmt(parser->arena, inner_expr);
 }
 
 Statement *parse_stmt(Parser *parser)
 {
     Token tok = parser_peek_curr(parser);
-    char *lexeme = parser_stringify_token(parser, &tok);
     Statement *stmt = NULL;
 
     if (tok.type == IDENTIFIER) stmt = parse_expr_stmt(parser);
-    else if (strncmp(lexeme, "use", 3) == 0) stmt = parse_use_stmt(parser);
-    else if (strncmp(lexeme, "module", 6) == 0) stmt = parse_module_stmt(parser);
-    else if (strncmp(lexeme, "proc", 4) == 0) stmt = parse_func_stmt(parser);
-    else if (strncmp(lexeme, "let", 3) == 0 || strncmp(lexeme, "const", 5) == 0) stmt = parse_var_decl(parser);
-    else if (strncmp(lexeme, "set", 3) == 0) stmt = parse_var_assign(parser);
+    else if (parser_match_lexeme(parser, &tok, "use")) stmt = parse_use_stmt(parser);
+    else if (parser_match_lexeme(parser, &tok, "module")) stmt = parse_module_stmt(parser);
+    else if (parser_match_lexeme(parser, &tok, "proc")) stmt = parse_func_stmt(parser);
+    else if (parser_match_lexeme(parser, &tok, "let") || parser_match_lexeme(parser, &tok, "const")) stmt = parse_var_decl(parser);
+    else if (parser_match_lexeme(parser, &tok, "set")) stmt = parse_var_assign(parser);
     else;
 
-    free(lexeme);
-
     return stmt;
 }
 
@@ -1223,9 +1127,13 @@ Script *parser_parse_all(Parser *parser, const char *script_name)
 
     int done_flag = 0;
     Script *program = malloc(sizeof(Script));
-    init_script(program, script_name, 4);
     Statement *temp = NULL;
 
+    if (!program) return NULL;
+
+    init_script(program, script_name, 4);
+    parser->arena = &program->arena;
+
     while (!done_flag)
     {
         temp = parse_stmt(parser);
@@ -1239,10 +1147,17 @@ Script *parser_parse_all(Parser *parser, const char *script_name)
             break;
         }
 
-        grow_script(program, temp);
+        if (!grow_script(program, temp))
+        {
+            dispose_script(program);
+            free(program);
+            program = NULL;
+            break;
+        }
     }
 
     parser->src_copy_ptr = NULL; // NOTE: unbind source string when done!
+    parser->arena = NULL;
 
     return program;
 }
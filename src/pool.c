@@ -0,0 +1,117 @@
+/**
+ * @file pool.c
+ * @author Derek Tan
+ * @brief Implements the fixed size object pool.
+ * @date 2023-08-18
+ */
+
+#include "utils/pool.h"
+
+/// SECTION: Pool utils
+
+void pool_init(Pool *pool, size_t item_size, size_t slab_items)
+{
+    size_t checked_size = (item_size > sizeof(PoolItem)) ? item_size : sizeof(PoolItem);
+
+    pool->item_size = (checked_size + (POOL_ALIGN - 1)) & ~((size_t)POOL_ALIGN - 1);
+    pool->slab_items = (slab_items > 0) ? slab_items : POOL_SLAB_ITEMS;
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->bump = NULL;
+    pool->bump_end = NULL;
+    pool->live_count = 0;
+    pool->slab_count = 0;
+}
+
+void pool_dispose(Pool *pool)
+{
+    PoolSlab *slab = pool->slabs;
+    PoolSlab *next_slab = NULL;
+
+    while (slab != NULL)
+    {
+        next_slab = slab->next;
+        free(slab);
+        slab = next_slab;
+    }
+
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->bump = NULL;
+    pool->bump_end = NULL;
+    pool->live_count = 0;
+    pool->slab_count = 0;
+}
+
+/// SECTION: Allocation
+
+#ifdef RUBEL_NO_POOLS
+
+void *pool_alloc(Pool *pool)
+{
+    void *item = malloc(pool->item_size);
+
+    if (item != NULL) pool->live_count++;
+
+    return item;
+}
+
+void pool_free(Pool *pool, void *item)
+{
+    if (!item) return;
+
+    free(item);
+    pool->live_count--;
+}
+
+#else
+
+static int pool_add_slab(Pool *pool)
+{
+    size_t slab_bytes = pool->item_size * pool->slab_items;
+    PoolSlab *slab = malloc(sizeof(PoolSlab) + slab_bytes);
+
+    if (!slab) return 0;
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->bump = slab->data;
+    pool->bump_end = slab->data + slab_bytes;
+    pool->slab_count++;
+
+    return 1;
+}
+
+void *pool_alloc(Pool *pool)
+{
+    PoolItem *item = pool->free_list;
+
+    if (item != NULL)
+    {
+        pool->free_list = item->next;
+        pool->live_count++;
+        return item;
+    }
+
+    // NOTE: freed items are reused first, so a new slab is only bumped once all older ones are in use.
+    if (pool->bump == pool->bump_end && !pool_add_slab(pool)) return NULL;
+
+    item = (PoolItem *)pool->bump;
+    pool->bump += pool->item_size;
+    pool->live_count++;
+
+    return item;
+}
+
+void pool_free(Pool *pool, void *item)
+{
+    PoolItem *freed = item;
+
+    if (!freed) return;
+
+    freed->next = pool->free_list;
+    pool->free_list = freed;
+    pool->live_count--;
+}
+
+#endif
@@ -0,0 +1,369 @@
+/**
+ * @file resolver.c
+ * @author Derek Tan
+ * @brief Implements the variable resolver pass.
+ * @date 2023-08-13
+ */
+
+#include "frontend/resolver.h"
+
+/// SECTION: Resolver utils
+
+int resolver_init(Resolver *resolver)
+{
+    resolver->in_proc = 0;
+    resolver->error_count = 0;
+    resolver->stmt_num = 0;
+    resolver->proc_name = NULL;
+    resolver->local_count = 0;
+
+    if (!varenv_init(&resolver->globals, VAR_ENV_SIZE)) return 0;
+
+    if (!varenv_init(&resolver->locals, VAR_ENV_SIZE))
+    {
+        varenv_destroy(&resolver->globals);
+        return 0;
+    }
+
+    return 1;
+}
+
+void resolver_dispose(Resolver *resolver)
+{
+    varenv_destroy(&resolver->globals);
+    varenv_destroy(&resolver->locals);
+    resolver->proc_name = NULL;
+}
+
+void resolver_log_err(Resolver *resolver, const char *msg)
+{
+    resolver->error_count++;
+
+    if (resolver->in_proc)
+        fprintf(stderr, "ResolveError at stmt %u in proc %s: %s\n", resolver->stmt_num, resolver->proc_name, msg);
+    else
+        fprintf(stderr, "ResolveError at stmt %u: %s\n", resolver->stmt_num, msg);
+}
+
+/**
+ * @brief Finds a visible variable. Proc locals shadow globals.
+ */
+static const Variable *resolver_lookup(Resolver *resolver, const char *name, unsigned short *depth)
+{
+    const Variable *var_ref = NULL;
+
+    *depth = RESOLVE_DEPTH_LOCAL;
+
+    if (resolver->in_proc)
+    {
+        var_ref = varenv_get_var_ref(&resolver->locals, name);
+
+        if (var_ref != NULL) return var_ref;
+
+        *depth = RESOLVE_DEPTH_GLOBAL;
+    }
+
+    return varenv_get_var_ref(&resolver->globals, name);
+}
+
+/**
+ * @brief Gives a name the next slot of the current proc frame.
+ * @return int The slot or -1 on failure.
+ */
+static int resolver_declare_local(Resolver *resolver, char *name, int is_const)
+{
+    Variable *var_obj = NULL;
+
+    if (varenv_get_var_ref(&resolver->locals, name) != NULL)
+    {
+        resolver_log_err(resolver, "Redeclared variable.");
+        return -1;
+    }
+
+    if (resolver->local_count == RESOLVER_SLOT_MAX)
+    {
+        resolver_log_err(resolver, "Too many variables in proc.");
+        return -1;
+    }
+
+    var_obj = variable_create(name, is_const, make_none_varval());
+
+    if (!var_obj) return -1;
+
+    var_obj->slot = resolver->local_count;
+
+    if (!varenv_set_var_ref(&resolver->locals, var_obj))
+    {
+        free(var_obj);
+        resolver_log_err(resolver, "Out of memory for variables.");
+        return -1;
+    }
+
+    resolver->local_count++;
+
+    return var_obj->slot;
+}
+
+/// SECTION: Resolving
+
+int resolve_expr(Resolver *resolver, Expression *expr)
+{
+    const Variable *var_ref = NULL;
+    unsigned short depth = RESOLVE_DEPTH_LOCAL;
+    int resolve_ok = 1;
+
+    if (!expr)
+    {
+        resolver_log_err(resolver, "Missing expression.");
+        return 0;
+    }
+
+    switch (expr->type)
+    {
+    case VAR_USAGE:
+        var_ref = resolver_lookup(resolver, expr->syntax.variable.var_name, &depth);
+
+        if (!var_ref)
+        {
+            resolver_log_err(resolver, (resolver->in_proc) ? "Undefined variable. Procs only see their own locals and globals, not their caller's locals." : "Undefined variable.");
+            return 0;
+        }
+
+        expr->syntax.variable.depth = depth;
+        expr->syntax.variable.slot = var_ref->slot;
+        break;
+    case FUNC_CALL:
+        for (unsigned int i = 0; i < expr->syntax.fn_call.argc && resolve_ok; i++)
+            resolve_ok = resolve_expr(resolver, expr->syntax.fn_call.args[i]);
+        break;
+    case UNARY_OP:
+        resolve_ok = resolve_expr(resolver, expr->syntax.unary_op.expr);
+        break;
+    case BINARY_OP:
+        resolve_ok = resolve_expr(resolver, expr->syntax.binary_op.left) && resolve_expr(resolver, expr->syntax.binary_op.right);
+        break;
+    default:
+        break; // NOTE: literals have nothing to resolve.
+    }
+
+    return resolve_ok;
+}
+
+int resolve_var_decl(Resolver *resolver, Statement *stmt)
+{
+    int slot = -1;
+
+    // NOTE: the initializer is resolved first, so it cannot see the variable it makes.
+    if (!resolve_expr(resolver, stmt->syntax.var_decl.rvalue)) return 0;
+
+    // NOTE: top-level variables already got their slots, see resolve_script.
+    if (!resolver->in_proc) return 1;
+
+    slot = resolver_declare_local(resolver, stmt->syntax.var_decl.var_name, stmt->syntax.var_decl.is_const);
+
+    if (slot < 0) return 0;
+
+    stmt->syntax.var_decl.slot = (unsigned short)slot;
+
+    return 1;
+}
+
+int resolve_var_assign(Resolver *resolver, Statement *stmt)
+{
+    unsigned short depth = RESOLVE_DEPTH_LOCAL;
+    const Variable *var_ref = resolver_lookup(resolver, stmt->syntax.var_assign.var_name, &depth);
+
+    if (!var_ref)
+    {
+        resolver_log_err(resolver, (resolver->in_proc) ? "Undefined variable. Procs only see their own locals and globals, not their caller's locals." : "Undefined variable.");
+        return 0;
+    }
+
+    if (var_ref->is_const)
+    {
+        resolver_log_err(resolver, "Cannot set a const variable.");
+        return 0;
+    }
+
+    stmt->syntax.var_assign.depth = depth;
+    stmt->syntax.var_assign.slot = var_ref->slot;
+
+    return resolve_expr(resolver, stmt->syntax.var_assign.rvalue);
+}
+
+int resolve_func_decl(Resolver *resolver, Statement *stmt)
+{
+    unsigned short fn_arity = stmt->syntax.func_decl.argc;
+    Expression **fn_params = stmt->syntax.func_decl.func_params;
+    Expression *param = NULL;
+    int slot = -1;
+    int resolve_ok = 1;
+
+    if (resolver->in_proc)
+    {
+        resolver_log_err(resolver, "Procs cannot be nested.");
+        return 0;
+    }
+
+    // switch to the proc's own frame: parameters take the first slots
+    resolver->in_proc = 1;
+    resolver->proc_name = stmt->syntax.func_decl.func_name;
+    resolver->local_count = 0;
+
+    for (unsigned short i = 0; i < fn_arity && resolve_ok; i++)
+    {
+        param = fn_params[i];
+
+        if (param->type != VAR_USAGE)
+        {
+            resolver_log_err(resolver, "Invalid parameter.");
+            resolve_ok = 0;
+            break;
+        }
+
+        slot = resolver_declare_local(resolver, param->syntax.variable.var_name, 0);
+        resolve_ok = slot >= 0;
+
+        param->syntax.variable.depth = RESOLVE_DEPTH_LOCAL;
+        param->syntax.variable.slot = (unsigned short)slot;
+    }
+
+    if (resolve_ok) resolve_ok = resolve_block(resolver, stmt->syntax.func_decl.stmts);
+
+    stmt->syntax.func_decl.frame_size = resolver->local_count;
+
+    // NOTE: locals die with the proc, so its table is rebuilt for the next one.
+    varenv_destroy(&resolver->locals);
+
+    if (!varenv_init(&resolver->locals, VAR_ENV_SIZE))
+    {
+        resolver_log_err(resolver, "Out of memory for variables.");
+        resolve_ok = 0;
+    }
+
+    resolver->in_proc = 0;
+    resolver->proc_name = NULL;
+    resolver->local_count = 0;
+
+    return resolve_ok;
+}
+
+int resolve_block(Resolver *resolver, Statement *stmt)
+{
+    Statement **stmt_cursor = NULL;
+    unsigned int block_len = 0;
+    int resolve_ok = 1;
+
+    if (!stmt) return 1;
+
+    if (stmt->type != BLOCK_STMT) return resolve_stmt(resolver, stmt);
+
+    stmt_cursor = stmt->syntax.block.stmts;
+    block_len = stmt->syntax.block.count;
+
+    // NOTE: keep going after errors to report the rest of them.
+    for (unsigned int i = 0; i < block_len; i++)
+    {
+        if (*stmt_cursor != NULL && !resolve_stmt(resolver, *stmt_cursor)) resolve_ok = 0;
+
+        stmt_cursor++;
+    }
+
+    return resolve_ok;
+}
+
+int resolve_stmt(Resolver *resolver, Statement *stmt)
+{
+    Statement *other_stmt = NULL;
+    int resolve_ok = 1;
+
+    switch (stmt->type)
+    {
+    case EXPR_STMT:
+        resolve_ok = resolve_expr(resolver, stmt->syntax.expr_stmt.expr);
+        break;
+    case VAR_DECL:
+        resolve_ok = resolve_var_decl(resolver, stmt);
+        break;
+    case VAR_ASSIGN:
+        resolve_ok = resolve_var_assign(resolver, stmt);
+        break;
+    case BLOCK_STMT:
+        resolve_ok = resolve_block(resolver, stmt);
+        break;
+    case FUNC_DECL:
+        resolve_ok = resolve_func_decl(resolver, stmt);
+        break;
+    case WHILE_STMT:
+        resolve_ok = resolve_expr(resolver, stmt->syntax.while_stmt.condition);
+        resolve_ok = resolve_block(resolver, stmt->syntax.while_stmt.stmts) && resolve_ok;
+        break;
+    case IF_STMT:
+        other_stmt = stmt->syntax.if_stmt.other;
+        resolve_ok = resolve_expr(resolver, stmt->syntax.if_stmt.condition);
+        resolve_ok = resolve_block(resolver, stmt->syntax.if_stmt.first) && resolve_ok;
+
+        if (other_stmt != NULL) resolve_ok = resolve_block(resolver, other_stmt->syntax.otherwise_stmt.stmts) && resolve_ok;
+        break;
+    case RETURN_STMT:
+        resolve_ok = resolve_expr(resolver, stmt->syntax.return_stmt.result);
+
+        // NOTE: nothing runs in a proc after its return, so a returned call can take over the proc's frame.
+        if (resolve_ok && resolver->in_proc) stmt->syntax.return_stmt.is_tail_call = stmt->syntax.return_stmt.result->type == FUNC_CALL;
+        break;
+    case MODULE_DEF:
+    case MODULE_USE:
+    case BREAK_STMT:
+    default:
+        break;
+    }
+
+    return resolve_ok;
+}
+
+int resolve_script(Resolver *resolver, Script *script)
+{
+    Statement *stmt = NULL;
+    Variable *var_obj = NULL;
+    unsigned short global_count = 0;
+
+    // give each top-level variable its slot first, so procs declared before it can still use it
+    for (unsigned int i = 0; i < script->count; i++)
+    {
+        stmt = script->stmts[i];
+        resolver->stmt_num = i;
+
+        if (!stmt || stmt->type != VAR_DECL) continue;
+
+        if (varenv_get_var_ref(&resolver->globals, stmt->syntax.var_decl.var_name) != NULL)
+        {
+            resolver_log_err(resolver, "Redeclared variable.");
+            continue;
+        }
+
+        var_obj = variable_create(stmt->syntax.var_decl.var_name, stmt->syntax.var_decl.is_const, make_none_varval());
+
+        if (global_count == RESOLVER_SLOT_MAX || !var_obj || !varenv_set_var_ref(&resolver->globals, var_obj))
+        {
+            free(var_obj);
+            resolver_log_err(resolver, "Too many top-level variables.");
+            return 0;
+        }
+
+        var_obj->slot = global_count;
+        stmt->syntax.var_decl.slot = global_count;
+        global_count++;
+    }
+
+    script->global_count = global_count;
+
+    for (unsigned int i = 0; i < script->count; i++)
+    {
+        stmt = script->stmts[i];
+        resolver->stmt_num = i;
+
+        if (stmt != NULL) resolve_stmt(resolver, stmt);
+    }
+
+    return resolver->error_count == 0;
+}
@@ -1,5 +1,6 @@
 #include "frontend/parser.h"
 #include "backend/runner/interpreter.h"
+#include "backend/compiler/cemit.h"
 
 /**
  * @file main.c 
@@ -41,9 +42,27 @@
 
 int main(int argc, char *argv[])
 {
+    RunMode run_mode = RUN_BYTECODE;
+    int dump_only = 0;
+    int dump_ast = 0;
+    int stats_only = 0;
+    int str_stats = 0;
+    int gc_stats = 0;
+    int fused_stats = 0;
+    int jit_stats = 0;
+    int use_jit = 1;
+    int emit_c = 0;
+    const char *nursery_knob = getenv(GC_NURSERY_KNOB);
+    const char *jit_calls_knob = getenv(JIT_CALLS_KNOB);
+    const char *no_cache_knob = getenv(BCCACHE_KNOB);
+    char cache_path[BCCACHE_PATH_MAX];
+    int use_cache = 0;
+    int from_cache = 0;
+    uint64_t source_hash = 0;
+
     if (argc < 2)
     {
-        printf("argc = %i, usage: rubel --[version | run] ?<file name>", argc);
+        printf("argc = %i, usage: rubel --[version | run | walk | dump-bc | dump-ast | parse-stats | str-stats | gc-stats | fused-stats | no-jit | jit-stats | emit-c] ?<file name | ->", argc);
         return 1;
     }
 
@@ -53,42 +72,92 @@ int main(int argc, char *argv[])
         return 0;
     }
 
-    if (strcmp(argv[1], "--run") != 0)
+    // NOTE: --walk runs the old AST walker, and --dump-bc lists the compiled bytecode without running it. --dump-ast shows the tree before and after constant folding and typing without running it. --parse-stats only shows the AST arena counters, and --str-stats, --gc-stats --fused-stats or --jit-stats run the script before showing the heap string, collector, fused loop op or JIT counters. --no-jit runs the VM without compiling hot procs to native code. --emit-c prints the script compiled to a C program instead of running it.
+    if (strcmp(argv[1], "--walk") == 0) run_mode = RUN_TREE_WALK;
+    else if (strcmp(argv[1], "--dump-bc") == 0) dump_only = 1;
+    else if (strcmp(argv[1], "--dump-ast") == 0) dump_ast = 1;
+    else if (strcmp(argv[1], "--parse-stats") == 0) stats_only = 1;
+    else if (strcmp(argv[1], "--str-stats") == 0) str_stats = 1;
+    else if (strcmp(argv[1], "--gc-stats") == 0) gc_stats = 1;
+    else if (strcmp(argv[1], "--fused-stats") == 0) fused_stats = 1;
+    else if (strcmp(argv[1], "--jit-stats") == 0) jit_stats = 1;
+    else if (strcmp(argv[1], "--no-jit") == 0) use_jit = 0;
+    else if (strcmp(argv[1], "--emit-c") == 0) emit_c = 1;
+    else if (strcmp(argv[1], "--run") != 0)
     {
         puts("Invalid argument passed to Rubel.");
         return 1;
     }
 
-    // Load script file.
-    char *source = load_file(argv[2]);
+    // Load script file. It is mapped when possible, and "-" reads stdin.
+    SourceText source;
 
-    if (!source)
+    if (!load_source(&source, argv[2]))
     {
         printf("Failed to read source file %s\n", argv[2]);
         return 1;
     }
 
-    // Use Parser.
-    Parser parser;
-    parser_init(&parser, source);
+    // NOTE: only VM runs use the .rubelc cache next to the script, since other modes need the tree. RUBEL_NO_CACHE turns it off. Caches are keyed by the source's hash, so an edited script is compiled again.
+    use_cache = run_mode == RUN_BYTECODE && !dump_ast && !stats_only && !emit_c && no_cache_knob == NULL && !source.is_stream && bccache_path_for(argv[2], cache_path, sizeof(cache_path));
 
-    Script *program = parser_parse_all(&parser, argv[2]);
+    if (use_cache) source_hash = hash_key_n(source.text, source.length);
 
-    // Discard old copied source code string.
-    free(source);
-    source = NULL;
+    // Names are pooled for the whole run, so every table compares them by address.
+    if (!intern_pool_init())
+    {
+        unload_source(&source);
+        return 1;
+    }
 
-    if (!program)
+    // Values get a heap before parsing, since list literals are pinned in it. RUBEL_NURSERY_KB sets the nursery size.
+    if (!heap_init((nursery_knob != NULL) ? strtoul(nursery_knob, NULL, 10) * 1024 : GC_NURSERY_SZ))
+    {
+        unload_source(&source);
+        intern_pool_dispose();
+        return 1;
+    }
+
+    Interpreter prgm_runner;
+    Script *program = NULL;
+
+    // Use a cached program if one matches, else parse the script.
+    if (use_cache) from_cache = interpreter_init_cached(&prgm_runner, argv[2], cache_path, source_hash);
+
+    if (!from_cache)
+    {
+        Parser parser;
+        parser_init(&parser, source.text, source.length);
+
+        program = parser_parse_all(&parser, argv[2]);
+    }
+
+    // Discard the source text, since the AST copied or interned every lexeme it keeps.
+    unload_source(&source);
+
+    if (!from_cache && !program)
     {
         printf("Failed to parse program. :(\n");
-        free(source);
+        intern_pool_dispose();
+        heap_dispose();
         return 1;
     }
 
-    // for (size_t i = 0; i < program->count; i++)
-    // {
-    //     print_stmt(program->stmts[i]);
-    // }
+    if (stats_only)
+    {
+        printf("statements: %u\nnodes: %u\narena bytes used: %zu\narena bytes reserved: %zu\narena chunks: %u\ninterned names: %zu\n", program->count, program->arena.node_count, program->arena.bytes_used, program->arena.bytes_reserved, program->arena.chunk_count, intern_count());
+        dispose_script(program);
+        free(program);
+        intern_pool_dispose();
+        heap_dispose();
+        return 0;
+    }
+
+    if (dump_ast)
+    {
+        puts("before folding:");
+        print_script(program);
+    }
 
     /// Make and bind native modules.
     FuncGroup *io_module = funcgroup_create("io", 4);
@@ -96,31 +165,108 @@ int main(int argc, char *argv[])
     funcgroup_put(io_module, func_native_create("println", 1, rubel_println));
     funcgroup_put(io_module, func_native_create("input", 0, rubel_input));
 
-    FuncGroup *lists_module = funcgroup_create("lists", 4);
+    FuncGroup *lists_module = funcgroup_create("lists", 8);
     funcgroup_put(lists_module, func_native_create("at", 2, rubel_list_at));
     funcgroup_put(lists_module, func_native_create("length", 1, rubel_list_len));
+    funcgroup_put(lists_module, func_native_create("sum", 1, rubel_list_sum));
+    funcgroup_put(lists_module, func_native_create("min", 1, rubel_list_min));
+    funcgroup_put(lists_module, func_native_create("max", 1, rubel_list_max));
+    funcgroup_put(lists_module, func_native_create("indexOf", 2, rubel_list_index_of));
+    funcgroup_put(lists_module, func_native_create("dot", 2, rubel_list_dot));
+    funcgroup_put(lists_module, func_native_create("scale", 2, rubel_list_scale));
 
-    Interpreter prgm_runner;
-    if (!interpreter_init(&prgm_runner, program))
+    FuncGroup *strings_module = funcgroup_create("strings", 4);
+    funcgroup_put(strings_module, func_native_create("builder", 0, rubel_str_builder));
+    funcgroup_put(strings_module, func_native_create("append", 2, rubel_str_append));
+    funcgroup_put(strings_module, func_native_create("build", 1, rubel_str_build));
+
+    // NOTE: emitted C only needs the typed tree, so no bytecode is made for it.
+    if (emit_c) run_mode = RUN_TREE_WALK;
+
+    if (!from_cache && !interpreter_init(&prgm_runner, program, run_mode))
     {
         puts("Failed to init interpreter.");
+        dispose_script(program);
+        free(program);
+        intern_pool_dispose();
+        heap_dispose();
         return 1;
     }
 
+    // NOTE: a failed save only costs the next run a compile, so it is not reported.
+    if (use_cache && !from_cache) bccache_save(&prgm_runner.program, cache_path, source_hash, program->global_count, program->count);
+
     int loaded_io = interpreter_load_natives(&prgm_runner, io_module);
     int loaded_lists = interpreter_load_natives(&prgm_runner, lists_module);
+    int loaded_strings = interpreter_load_natives(&prgm_runner, strings_module);
 
     // Check if needed modules were loaded so execution is a bit safer.
-    if (!loaded_io || !loaded_lists)
+    if (!loaded_io || !loaded_lists || !loaded_strings)
     {
         interpreter_dispose(&prgm_runner);
+        free(program);
+        intern_pool_dispose();
+        heap_dispose();
         return 1;
     }
 
+    // RUBEL_JIT_CALLS sets how many calls make a proc hot.
+    prgm_runner.vm.jit_enabled = use_jit;
+
+    if (jit_calls_knob != NULL) prgm_runner.vm.jit_hot_calls = strtoul(jit_calls_knob, NULL, 10);
+
     /// Test run interpreter.
-    interpreter_run(&prgm_runner);
+    if (dump_ast)
+    {
+        puts("after folding and typing:");
+        print_script(program);
+        printf("folded ops: %u\npropagated consts: %u\npruned branches: %u\nspecialized ops: %u\n", prgm_runner.folder.folded_count, prgm_runner.folder.propagated_count, prgm_runner.folder.pruned_count, prgm_runner.typer.specialized_count);
+    }
+    else if (dump_only)
+    {
+        bcprogram_dump(&prgm_runner.program);
+    }
+    else if (emit_c)
+    {
+        CEmitter emitter;
+
+        if (!cemitter_init(&emitter, stdout) || !cemit_script(&emitter, program)) puts("Failed to emit C code.");
+
+        cemitter_dispose(&emitter);
+    }
+    else
+    {
+        interpreter_run(&prgm_runner);
+    }
+
+    if (str_stats)
+    {
+        const StrObjStats *stats = get_str_obj_stats();
+        printf("\nstring allocs: %zu\nstring frees: %zu\nstring copies: %zu\nin-place appends: %zu\ninline strings: %zu\n", stats->allocs, stats->frees, stats->copies, stats->appends_in_place, stats->inline_strings);
+    }
+
+    if (gc_stats)
+    {
+        const GcStats *stats = heap_get_stats();
+        printf("\nminor collections: %zu\nmajor collections: %zu\nobjects freed: %zu\nbytes freed: %zu\nbytes promoted: %zu\ntotal pause ms: %.3f\nmax pause ms: %.3f\nlive bytes: %zu\n", stats->minor_count, stats->major_count, stats->objects_freed, stats->bytes_freed, stats->bytes_promoted, stats->total_pause_ms, stats->max_pause_ms, heap_live_bytes());
+    }
+
+    if (fused_stats)
+    {
+        const FusedStats *stats = &prgm_runner.context.fused;
+        printf("\nfused increments: %zu\nfused compare-jumps: %zu\n", stats->incr_count, stats->cmp_jump_count);
+    }
+
+    if (jit_stats)
+    {
+        const JitStats *stats = &prgm_runner.vm.jit_stats;
+        printf("\ncompiled procs: %zu\nrejected procs: %zu\nnative calls: %zu\nnative deopts: %zu\n", stats->compiled_count, stats->rejected_count, stats->native_calls, stats->deopt_count);
+    }
 
     interpreter_dispose(&prgm_runner);
+    free(program);
+    intern_pool_dispose();
+    heap_dispose();
 
     return 0;
 }
\ No newline at end of file
@@ -11,25 +11,35 @@
 /// SECTION: Context utils
 
 int ctx_init(RunnerContext *ctx, Script *program)
+{
+    if (!program) return 0;
+
+    return ctx_init_sized(ctx, program->global_count, program->count);
+}
+
+int ctx_init_sized(RunnerContext *ctx, unsigned short global_count, unsigned int stmt_count)
 {
     ctx_set_status(ctx, OK_IDLE);
     FuncEnv *script_fenv = funcenv_create(4);
     int flag_success = 0;
-    int fenv_ok, global_scope_ok;
-    
-    if (!program || !script_fenv) return 0;
 
-    if (!scopestack_init(&ctx->scopes, SCOPE_STACK_SIZE))
+    ctx->arg_count = 0;
+    ctx->arg_capacity = CTX_ARGS_MIN_SZ;
+    ctx->arg_stack = malloc(sizeof(VarValue) * CTX_ARGS_MIN_SZ);
+    ctx->tail_callee = NULL;
+    ctx->tail_arg_base = 0;
+    ctx->fused.incr_count = 0;
+    ctx->fused.cmp_jump_count = 0;
+
+    if (!script_fenv || !ctx->arg_stack)
     {
-        funcenv_dispose(script_fenv);
+        free(ctx->arg_stack);
+        ctx->arg_stack = NULL;
         free(script_fenv);
-        ctx_set_status(ctx, ERR_MEMORY);
-        return flag_success;
+        return 0;
     }
 
-    RubelScope *script_scope = scope_create(NULL);
-    
-    if(!script_scope)
+    if (!framestack_init(&ctx->frames, global_count))
     {
         funcenv_dispose(script_fenv);
         free(script_fenv);
@@ -37,13 +47,13 @@ int ctx_init(RunnerContext *ctx, Script *program)
         return flag_success;
     }
 
-    FuncGroup *script_funcs = funcgroup_create(NULL, program->count);
+    FuncGroup *script_funcs = funcgroup_create(NULL, stmt_count);
 
     if (!script_funcs)
     {
         funcenv_dispose(script_fenv);
         free(script_fenv);
-        scopestack_destroy(&ctx->scopes);
+        framestack_dispose(&ctx->frames);
         ctx_set_status(ctx, ERR_MEMORY);
         return flag_success;
     }
@@ -51,10 +61,8 @@ int ctx_init(RunnerContext *ctx, Script *program)
     // NOTE: global (no-name) module is always "used"!
     funcgroup_mark_used(script_funcs, 1);
 
-    fenv_ok = funcenv_append(script_fenv, script_funcs);
     ctx->function_env = script_fenv;
-    global_scope_ok = scopestack_push_scope(&ctx->scopes, script_scope);
-    flag_success = fenv_ok && global_scope_ok;
+    flag_success = funcenv_append(script_fenv, script_funcs);
 
     return flag_success;
 }
@@ -65,8 +73,13 @@ void ctx_destroy(RunnerContext *ctx)
     free(ctx->function_env);
     ctx->function_env = NULL;
 
-    scopestack_destroy(&ctx->scopes);
+    framestack_dispose(&ctx->frames);
     ctx_set_status(ctx, OK_ENDED);
+
+    free(ctx->arg_stack);
+    ctx->arg_stack = NULL;
+    ctx->arg_count = 0;
+    ctx->arg_capacity = 0;
 }
 
 void ctx_set_status(RunnerContext *ctx, RunStatus status)
@@ -83,48 +96,57 @@ int ctx_load_funcgroup(RunnerContext *ctx, FuncGroup *module)
     return funcenv_append(ctx->function_env, module);
 }
 
-/// SECTION: function helpers
-
-const FuncObj *ctx_get_func(const RunnerContext *ctx, const char *fn_name)
+void ctx_collect_garbage(RunnerContext *ctx)
 {
-    if (!fn_name) return NULL;
+    if (heap_wants_collect() == GC_CYCLE_NONE) return;
 
-    FuncGroup **fenv_cursor = ctx->function_env->func_groups;
-    FuncGroup *module_ref = NULL;
-    const FuncObj *result_fn = NULL;
-    size_t fenv_len = ctx->function_env->count;
+    heap_begin_collect();
 
-    // NOTE: brute force search for function decl... poor Big-O (n^2?) but will work for uniquely named ones for now.
-    for (size_t i = 0; i < fenv_len; i++)
-    {
-        module_ref = *fenv_cursor;
+    // NOTE: the frames are back to back, so every live slot is below the top.
+    for (size_t i = 0; i < ctx->frames.top; i++) heap_mark_value(ctx->frames.slots + i);
 
-        if (!funcgroup_is_used(module_ref)) break; // NOTE: this should ignore unused function modules.
+    for (size_t i = 0; i < ctx->arg_count; i++) heap_mark_value(ctx->arg_stack + i);
 
-        result_fn = funcgroup_get(module_ref, fn_name);
+    heap_finish_collect();
+}
 
-        if (result_fn != NULL)
-        {
-            if (strcmp(result_fn->name, fn_name) == 0) return result_fn;
-        }
+/**
+ * @brief Pushes an evaluated argument where collections can see it.
+ */
+static int ctx_push_arg(RunnerContext *ctx, VarValue arg)
+{
+    size_t new_capacity = ctx->arg_capacity << 1;
+    VarValue *temp_args = NULL;
 
-        fenv_cursor++;
+    if (ctx->arg_count == ctx->arg_capacity)
+    {
+        temp_args = realloc(ctx->arg_stack, sizeof(VarValue) * new_capacity);
+
+        if (!temp_args) return 0;
+
+        ctx->arg_stack = temp_args;
+        ctx->arg_capacity = new_capacity;
     }
 
-    return NULL;
+    ctx->arg_stack[ctx->arg_count] = arg;
+    ctx->arg_count++;
+
+    return 1;
 }
 
-VarValue *ctx_call_func(RunnerContext *ctx, unsigned short argc, const char *fn_name, FuncArgs *args)
+/// SECTION: function helpers
+
+const FuncObj *ctx_get_func(const RunnerContext *ctx, const char *fn_name)
 {
-    if (!fn_name)
-    {
-        ctx_set_status(ctx, ERR_NULL_VAL);
-        return NULL;
-    }
+    // NOTE: the merged index already holds the visible function of each used module.
+    return funcenv_lookup(ctx->function_env, fn_name);
+}
 
-    // prepare and check callee first!
-    const FuncObj *callee_ref = ctx_get_func(ctx, fn_name);
-    VarValue *result = NULL;
+VarValue ctx_call_func(RunnerContext *ctx, const FuncObj *callee_ref, unsigned short argc, VarValue *args)
+{
+    size_t old_base = 0;
+    FuncArgs native_args;
+    VarValue result = make_none_varval();
 
     // reject unknown callees in the context!
     if (!callee_ref)
@@ -133,297 +155,244 @@ VarValue *ctx_call_func(RunnerContext *ctx, unsigned short argc, const char *fn_
         return result;
     }
 
-    FuncType callee_type = callee_ref->type;
-    unsigned short callee_argc = callee_ref->arity;
-
     // reject wrong argument array length since the function decl cannot match it!
-    if (callee_argc != argc)
+    if (callee_ref->arity != argc)
     {
         ctx_set_status(ctx, ERR_NO_IMPL);
         return result;
     }
 
-    // NOTE: check for native function to avoid making an interpreter scope for it since ISA/machine-code handles native vars scope!
-    if (callee_type == FUNC_NATIVE)
+    // NOTE: natives only borrow the caller's argument values, so nothing is copied or freed for them.
+    if (callee_ref->type == FUNC_NATIVE)
     {
-        result = callee_ref->content.fn_ptr(args);
+        funcargs_init(&native_args, argc, args);
 
-        funcargs_destroy(args); // NOTE: still, free up args!
-        free(args);
-
-        return result;
+        return callee_ref->content.fn_ptr(&native_args);
     }
 
-    // push current call scope to the scope stack for tracking!
-    RubelScope *parent_scope = ctx->scopes.scopes[ctx->scopes.stack_ptr];
-    RubelScope *call_scope = scope_create(parent_scope);
-
-    if (!call_scope)
+    if (callee_ref->type != FUNC_NORMAL)
     {
-        ctx_set_status(ctx, ERR_MEMORY);
+        ctx_set_status(ctx, ERR_GENERAL);
         return result;
     }
 
-    // NOTE: populate scope with parameters before pushing it to stack for tracking!
-    for (unsigned short i = 0; i < argc; i++)
+    if (ctx->frames.depth >= CTX_CALL_DEPTH_MAX)
     {
-        Expression *fn_decl_param = callee_ref->param_exprs[i];
-        scope_put_var(call_scope, variable_create(fn_decl_param->syntax.variable.var_name, 0, args->args[i]));
+        ctx_set_status(ctx, ERR_DEPTH);
+        return result;
     }
 
-    if (!scopestack_push_scope(&ctx->scopes, call_scope))
+    // NOTE: procs are only declared at top-level, so their frames see the globals and not the caller's locals.
+    if (!framestack_push(&ctx->frames, callee_ref->frame_size, &old_base))
     {
-        // NOTE: check scope stack "fullness" to prevent excessive recursion?
-        scope_destroy(call_scope);
-        free(call_scope);
-
-        ctx_set_status(ctx, ERR_GENERAL);
+        ctx_set_status(ctx, ERR_MEMORY);
         return result;
     }
 
-    // NOTE: here, the function will be non-native, so we can run it with interpreter scope!
-    result = exec_block(ctx, callee_ref->content.fn_ast);
-
-    // NOTE: dispose & free args first...
-    funcargs_dispose(args);
-    free(args);
+    // NOTE: the resolver gives parameters the first slots, so copy the args there.
+    for (unsigned short i = 0; i < argc; i++) ctx->frames.slots[ctx->frames.base + i] = args[i];
 
-    // NOTE: destroy call entry in scope stack for cleanup!
-    call_scope = scopestack_pop_scope(&ctx->scopes);
-    scope_destroy(call_scope);
-    free(call_scope);
-    ctx_set_status(ctx, OK_RAN_CMD);
+    // NOTE: the arguments are in the new frame now, so a collection here sees all of them.
+    ctx_collect_garbage(ctx);
 
-    return result;
-}
+    // NOTE: here, the function will be non-native, so we can run it with interpreter scope!
+    result = exec_block(ctx, callee_ref->content.fn_ast);
 
-/// SECTION: Variable helpers
+    // NOTE: a tail call replaces the finished proc, so its frame is reused and the C stack does not grow.
+    while (ctx->tail_callee != NULL)
+    {
+        callee_ref = ctx->tail_callee;
+        ctx->tail_callee = NULL;
 
-Variable *ctx_get_var(const RunnerContext *ctx, const char *var_name)
-{
-    RubelScope *curr_scope = ctx->scopes.scopes[ctx->scopes.stack_ptr];
-    Variable *temp_var_ref = NULL;
+        if (!framestack_reuse(&ctx->frames, callee_ref->frame_size))
+        {
+            ctx->arg_count = ctx->tail_arg_base;
+            ctx_set_status(ctx, ERR_MEMORY);
+            break;
+        }
 
-    while (curr_scope->parent != NULL)
-    {
-        temp_var_ref = scope_get_var_ref(curr_scope, var_name);
+        // NOTE: exec_return already checked the arity, and the args stay GC roots until they are in the frame.
+        for (unsigned short i = 0; i < callee_ref->arity; i++) ctx->frames.slots[ctx->frames.base + i] = ctx->arg_stack[ctx->tail_arg_base + i];
 
-        if (temp_var_ref != NULL) return temp_var_ref;
+        ctx->arg_count = ctx->tail_arg_base;
+        ctx_set_status(ctx, OK_RAN_CMD);
+        ctx_collect_garbage(ctx);
 
-        curr_scope = curr_scope->parent;
+        result = exec_block(ctx, callee_ref->content.fn_ast);
     }
 
-    return NULL;
-}
+    framestack_pop(&ctx->frames, old_base);
 
-int ctx_create_var(RunnerContext *ctx, char *var_name, int is_const, VarValue *var_val)
-{
-    if (!var_name || !var_val) return 0;
+    // NOTE: the return is consumed by this call, but errors must keep bubbling up.
+    if (ctx->status <= OK_ENDED) ctx_set_status(ctx, OK_RAN_CMD);
 
-    RubelScope *curr_scope = ctx->scopes.scopes[ctx->scopes.stack_ptr];
-    Variable *new_var = variable_create(var_name, is_const, var_val);
+    return result;
+}
 
-    if (!new_var) return 0;
+/// SECTION: Variable helpers
 
-    return scope_put_var(curr_scope, new_var);
+VarValue *ctx_get_var(const RunnerContext *ctx, unsigned short depth, unsigned short slot)
+{
+    return framestack_get_slot(&ctx->frames, depth, slot);
 }
 
-int ctx_update_var(RunnerContext *ctx, Variable *var_ref, VarValue *var_val)
+int ctx_update_var(RunnerContext *ctx, VarValue *var_ref, const VarValue *var_val)
 {
-    // NOTE: fail execution on: undefined vars, const rewrites...
+    // NOTE: fail execution on: bad slots, type changes... Const rewrites were already rejected by the resolver.
     if (!var_ref || !var_val) return 0;
 
-    DataType lval_type = var_ref->value->type;
-    DataType rval_type = var_val->type;
-    StringObj *optional_str = NULL;
-    ListObj *optional_list = NULL;
-
-    if (var_ref->is_const) return 0;
+    if (var_ref->type != var_val->type) return 0;
 
-    if (lval_type != rval_type) return 0;
-
-    switch (lval_type)
-    {
-    case INT_TYPE:
-        var_ref->value->data.int_val.value = var_val->data.int_val.value;
-        varval_destroy(var_val);
-        free(var_val);
-        break;
-    case REAL_TYPE:
-        var_ref->value->data.real_val.value = var_val->data.real_val.value;
-        varval_destroy(var_val);
-        free(var_val);
-        break;
-    case BOOL_TYPE:
-        var_ref->value->data.bool_val.flag = var_val->data.bool_val.flag;
-        varval_destroy(var_val);
-        free(var_val);
-        break;
-    case STR_TYPE:
-        // clear old string
-        optional_str = var_ref->value->data.str_type.value;
-        destroy_str_obj(optional_str);
-        free(optional_str);
-
-        // set new one
-        var_ref->value->data.str_type.value = var_val->data.str_type.value;
-        break;
-    case LIST_TYPE:
-        // clear old list
-        optional_list = var_ref->value->data.list_type.value;
-        destroy_list_obj(optional_list);
-        free(optional_list);
-
-        var_ref->value->data.list_type.value = var_val->data.list_type.value;
-        break;
-    default:
-        return 0;
-    }
+    // NOTE: strings and lists are borrowed, so only the reference gets replaced.
+    var_ref->data = var_val->data;
 
     return 1;
 }
 
 /// SECTION: Expr. helpers
 
-VarValue *eval_literal(RunnerContext *ctx, Expression *expr)
+VarValue eval_literal(RunnerContext *ctx, Expression *expr)
 {
-    VarValue *result = NULL;
-    ExpressionType expr_type = expr->type;
+    VarValue result = make_none_varval();
 
-    switch (expr_type)
+    switch (expr->type)
     {
     case BOOL_LITERAL:
-        result = create_bool_varval(1, expr->syntax.bool_literal.flag);
+        result = make_bool_varval(1, expr->syntax.bool_literal.flag);
         break;
     case INT_LITERAL:
-        result = create_int_varval(1, expr->syntax.int_literal.value);
+        result = make_int_varval(1, expr->syntax.int_literal.value);
         break;
     case REAL_LITERAL:
-        result = create_real_varval(1, expr->syntax.real_literal.value);
+        result = make_real_varval(1, expr->syntax.real_literal.value);
         break;
     case STR_LITERAL:
-        result = create_str_varval(1, copy_str_obj(expr->syntax.str_literal.str_obj)); // NOTE: to avoid accidental auto-free, treat literals as pass by value copy.
+        result = make_str_varval(1, expr->syntax.str_literal.str_obj); // NOTE: literal strings and lists stay owned by the AST.
         break;
     case LIST_LITERAL:
-        result = create_list_varval(1, expr->syntax.list_literal.list_obj);
+        result = make_list_varval(1, expr->syntax.list_literal.list_obj);
         break;
     case VAR_USAGE:
         result = eval_var_usage(ctx, expr);
+        break;
     default:
+        ctx_set_status(ctx, ERR_TYPE);
         break;
     }
 
     return result;
 }
 
-VarValue *eval_var_usage(RunnerContext *ctx, Expression *expr)
+VarValue eval_var_usage(RunnerContext *ctx, Expression *expr)
 {
-    RubelScope *curr_scope = ctx->scopes.scopes[ctx->scopes.stack_ptr];
-    Variable *var_ref = NULL;
-    VarValue *result = NULL;
-    const char *var_name = expr->syntax.variable.var_name; 
-
-    var_ref = scope_get_var_ref(curr_scope, var_name);
+    VarValue *var_ref = ctx_get_var(ctx, expr->syntax.variable.depth, expr->syntax.variable.slot);
 
     if (!var_ref)
     {
-        ctx->status = ERR_MEMORY;
-        return result;
-    }
-
-    switch (var_ref->value->type)
-    {
-    case BOOL_LITERAL:
-        result = create_bool_varval(1, var_ref->value->data.bool_val.flag);
-        ctx_set_status(ctx, OK_RAN_CMD);
-        break;
-    case INT_LITERAL:
-        result = create_int_varval(1, var_ref->value->data.int_val.value);
-        ctx_set_status(ctx, OK_RAN_CMD);
-        break;
-    case REAL_LITERAL:
-        result = create_real_varval(1, var_ref->value->data.real_val.value);
-        ctx_set_status(ctx, OK_RAN_CMD);
-        break;
-    case STR_LITERAL:
-        result = create_str_varval(1, var_ref->value->data.str_type.value);
-        ctx_set_status(ctx, OK_RAN_CMD);
-        break;
-    case LIST_LITERAL:
-        result = create_list_varval(1, var_ref->value->data.list_type.value);
-        ctx_set_status(ctx, OK_RAN_CMD);
-        break;
-    default:
-        ctx_set_status(ctx, ERR_TYPE);
-        break;
+        ctx_set_status(ctx, ERR_NO_IMPL);
+        return make_none_varval();
     }
 
-    return result;
+    return *var_ref;
 }
 
-VarValue *eval_call(RunnerContext *ctx, Expression *expr)
+/**
+ * @brief Evaluates a call's args onto the context's arg stack. On failure, the stack is reset and the status tells why.
+ */
+static int ctx_push_call_args(RunnerContext *ctx, Expression *expr)
 {
-    const char *fn_name = expr->syntax.fn_call.func_name;
     unsigned short argc = (unsigned short)(expr->syntax.fn_call.argc);
-    FuncArgs *call_args = funcargs_create(argc);
-    VarValue *fn_result = NULL; // function return value!
-    
-    if (!call_args)
+    size_t arg_base = ctx->arg_count;
+    VarValue arg_value;
+
+    if (argc > FUNC_ARGV_MAX_SZ)
     {
-        ctx_set_status(ctx, ERR_MEMORY);
-        return fn_result;
+        ctx_set_status(ctx, ERR_GENERAL);
+        return 0;
     }
 
     // populate args to later bind to callee scope
-    for(unsigned short arg_index = 0; arg_index < argc; arg_index++)
+    for (unsigned short arg_index = 0; arg_index < argc; arg_index++)
     {
-        Expression *arg_expr = expr->syntax.fn_call.args[arg_index];
-        VarValue *temp_arg = eval_expr(ctx, arg_expr);
+        arg_value = eval_expr(ctx, expr->syntax.fn_call.args[arg_index]);
+
+        if (ctx->status <= OK_ENDED && !ctx_push_arg(ctx, arg_value)) ctx_set_status(ctx, ERR_MEMORY);
 
-        if (!funcargs_set_at(call_args, arg_index, temp_arg)) break;
+        if (ctx->status > OK_ENDED)
+        {
+            ctx->arg_count = arg_base;
+            return 0;
+        }
     }
 
-    fn_result = ctx_call_func(ctx, argc, fn_name, call_args);
+    return 1;
+}
+
+static const FuncObj *ctx_cached_callee(RunnerContext *ctx, Expression *expr)
+{
+    const FuncEnv *fenv = ctx->function_env;
 
-    ctx->status = (ctx->status <= OK_ENDED) ? ctx->status : ERR_GENERAL;
+    // NOTE: reuse the callee found last time unless a proc or module changed the visible functions since.
+    if (expr->syntax.fn_call.cache_gen != fenv->generation)
+    {
+        expr->syntax.fn_call.cached_fn = ctx_get_func(ctx, expr->syntax.fn_call.func_name);
+        expr->syntax.fn_call.cache_gen = fenv->generation;
+    }
 
-    return fn_result;
+    return expr->syntax.fn_call.cached_fn;
 }
 
-VarValue *eval_unary(RunnerContext *ctx, Expression *expr)
+VarValue eval_call(RunnerContext *ctx, Expression *expr)
+{
+    unsigned short argc = (unsigned short)(expr->syntax.fn_call.argc);
+    size_t arg_base = ctx->arg_count; // NOTE: args live on the context's stack and callees get copies of them.
+    const FuncObj *callee_ref = NULL;
+    VarValue result;
+
+    if (!ctx_push_call_args(ctx, expr)) return make_none_varval();
+
+    callee_ref = ctx_cached_callee(ctx, expr);
+
+    // NOTE: nested calls may have grown the stack, so the args are found from their base only now.
+    result = ctx_call_func(ctx, callee_ref, argc, ctx->arg_stack + arg_base);
+    ctx->arg_count = arg_base;
+
+    return result;
+}
+
+VarValue eval_unary(RunnerContext *ctx, Expression *expr)
 {
-    VarValue *result = NULL;
-    ExpressionType expr_type = expr->type;
     OpType operation = expr->syntax.unary_op.op;
+    VarValue operand;
 
     if (operation != OP_NEG)
     {
-        ctx->status = ERR_GENERAL;
-        return result;
+        ctx_set_status(ctx, ERR_GENERAL);
+        return make_none_varval();
     }
 
-    switch (expr_type)
+    operand = eval_expr(ctx, expr->syntax.unary_op.expr);
+
+    if (ctx->status > OK_ENDED) return make_none_varval();
+
+    switch (operand.type)
     {
-    case INT_LITERAL:
-        result = create_int_varval(1, 0 - expr->syntax.int_literal.value);
-        ctx_set_status(ctx, OK_RAN_CMD);
-        break;
-    case REAL_LITERAL:
-        result = create_real_varval(1, 0 - expr->syntax.real_literal.value);
-        ctx_set_status(ctx, OK_RAN_CMD);
+    case INT_TYPE:
+        return make_int_varval(1, INT_WRAP_SUB(0, operand.data.int_val.value));
+    case REAL_TYPE:
+        return make_real_varval(1, 0 - operand.data.real_val.value);
+    case NONE_TYPE:
+        ctx_set_status(ctx, ERR_NULL_VAL);
         break;
-    case BOOL_LITERAL:
-    case STR_LITERAL:
-    case LIST_LITERAL:
     default:
         ctx_set_status(ctx, ERR_TYPE);
         break;
     }
 
-    return result;
+    return make_none_varval();
 }
 
-int compare_primitives(OpType op, VarValue *left_val, VarValue *right_val)
+int compare_primitives(OpType op, const VarValue *left_val, const VarValue *right_val)
 {
     DataType left_type = left_val->type; // NOTE: assumed to be same type as right value since this is called after a type check! 
     int left_n, right_n;
@@ -469,14 +438,14 @@ int compare_primitives(OpType op, VarValue *left_val, VarValue *right_val)
     return -2; // NOTE: mark invalid operation type!
 }
 
-VarValue *math_primitives(OpType op, VarValue *left_val, VarValue *right_val)
+VarValue math_primitives(OpType op, const VarValue *left_val, const VarValue *right_val)
 {
-    DataType left_type = left_val->type;
-    VarValue *result = NULL;
+    VarValue result = make_none_varval();
     int left_int, right_int;
     float left_flt, right_flt;
 
-    switch (left_type)
+    // NOTE: a NONE result marks bad operand types or a division by zero.
+    switch (left_val->type)
     {
     case INT_TYPE:
         left_int = left_val->data.int_val.value;
@@ -484,16 +453,16 @@ VarValue *math_primitives(OpType op, VarValue *left_val, VarValue *right_val)
         switch (op)
         {
         case OP_ADD:
-            result = create_int_varval(1, left_int + right_int);
+            result = make_int_varval(1, INT_WRAP_ADD(left_int, right_int));
             break;
         case OP_SUB:
-            result = create_int_varval(1, left_int - right_int);
+            result = make_int_varval(1, INT_WRAP_SUB(left_int, right_int));
             break;
         case OP_MUL:
-            result = create_int_varval(1, left_int * right_int);
+            result = make_int_varval(1, INT_WRAP_MUL(left_int, right_int));
             break;
         case OP_DIV:
-            if (right_int != 0) result = create_int_varval(1, left_int / right_int);
+            if (right_int != 0) result = make_int_varval(1, INT_WRAP_DIV(left_int, right_int));
             break;
         default:
             break;
@@ -505,16 +474,16 @@ VarValue *math_primitives(OpType op, VarValue *left_val, VarValue *right_val)
         switch (op)
         {
         case OP_ADD:
-            result = create_real_varval(1, left_flt + right_flt);
+            result = make_real_varval(1, left_flt + right_flt);
             break;
         case OP_SUB:
-            result = create_real_varval(1, left_flt - right_flt);
+            result = make_real_varval(1, left_flt - right_flt);
             break;
         case OP_MUL:
-            result = create_real_varval(1, left_flt * right_flt);
+            result = make_real_varval(1, left_flt * right_flt);
             break;
         case OP_DIV:
-            if (right_flt != 0) result = create_real_varval(1, left_flt / right_flt);
+            if (right_flt != 0) result = make_real_varval(1, left_flt / right_flt);
             break;
         default:
             break;
@@ -527,35 +496,54 @@ VarValue *math_primitives(OpType op, VarValue *left_val, VarValue *right_val)
     return result;
 }
 
-VarValue *eval_comparison(RunnerContext *ctx, OpType op, VarValue *left_val, VarValue *right_val)
+VarValue eval_comparison(RunnerContext *ctx, OpType op, const VarValue *left_val, const VarValue *right_val)
 {
-    int flag = 0;
-    VarValue *result = NULL;
+    int flag = compare_primitives(op, left_val, right_val);
 
-    if (left_val->type != right_val->type)
+    // reject invalid flags from bad types, etc.
+    if (flag < 0)
     {
         ctx_set_status(ctx, ERR_TYPE);
-        return result;
+        return make_none_varval();
     }
 
-    flag = compare_primitives(op, left_val, right_val);
+    return make_bool_varval(1, flag);
+}
 
-    // reject invalid flags from bad type mismatches, etc.
-    if (flag < 0)
-    {
-        ctx_set_status(ctx, ERR_GENERAL);
-        return result;
+/**
+ * @brief Runs an operator on two ints the typer proved, so only division by zero is checked.
+ */
+static VarValue eval_int_binary(RunnerContext *ctx, OpType op, int left_int, int right_int)
+{
+    switch (op)
+    {
+    case OP_EQ: return make_bool_varval(1, left_int == right_int);
+    case OP_NEQ: return make_bool_varval(1, left_int != right_int);
+    case OP_GT: return make_bool_varval(1, left_int > right_int);
+    case OP_GTE: return make_bool_varval(1, left_int >= right_int);
+    case OP_LT: return make_bool_varval(1, left_int < right_int);
+    case OP_LTE: return make_bool_varval(1, left_int <= right_int);
+    case OP_ADD: return make_int_varval(1, INT_WRAP_ADD(left_int, right_int));
+    case OP_SUB: return make_int_varval(1, INT_WRAP_SUB(left_int, right_int));
+    case OP_MUL: return make_int_varval(1, INT_WRAP_MUL(left_int, right_int));
+    default:
+        break;
     }
 
-    return create_bool_varval(1, flag);
+    if (right_int != 0) return make_int_varval(1, INT_WRAP_DIV(left_int, right_int));
+
+    ctx_set_status(ctx, ERR_NULL_VAL);
+
+    return make_none_varval();
 }
 
-VarValue *eval_binary(RunnerContext *ctx, Expression *expr)
+VarValue eval_binary(RunnerContext *ctx, Expression *expr)
 {
     Expression *left = expr->syntax.binary_op.left;
     Expression *right = expr->syntax.binary_op.right;
     OpType operation = expr->syntax.binary_op.op;
-    VarValue *result = NULL;
+    VarValue left_val, right_val;
+    VarValue result = make_none_varval();
 
     if (!left || !right)
     {
@@ -563,26 +551,50 @@ VarValue *eval_binary(RunnerContext *ctx, Expression *expr)
         return result;
     }
 
-    VarValue *left_val = eval_expr(ctx, left);
-    VarValue *right_val = eval_expr(ctx, right);
+    left_val = eval_expr(ctx, left);
+
+    if (ctx->status > OK_ENDED) return result;
+
+    right_val = eval_expr(ctx, right);
+
+    if (ctx->status > OK_ENDED) return result;
+
+    if (expr->syntax.binary_op.operand_type == INT_TYPE) return eval_int_binary(ctx, operation, left_val.data.int_val.value, right_val.data.int_val.value);
+
+    if (left_val.type == NONE_TYPE || right_val.type == NONE_TYPE)
+    {
+        ctx_set_status(ctx, ERR_NULL_VAL);
+        return result;
+    }
+
+    if (left_val.type != right_val.type)
+    {
+        ctx_set_status(ctx, ERR_TYPE);
+        return result;
+    }
 
     if (operation == OP_EQ || operation == OP_NEQ || operation == OP_GT || operation == OP_GTE || operation == OP_LT || operation == OP_LTE)
     {
-        result = eval_comparison(ctx, operation, left_val, right_val);
+        result = eval_comparison(ctx, operation, &left_val, &right_val);
     }
     else if (operation == OP_ADD || operation == OP_SUB || operation == OP_MUL || operation == OP_DIV)
     {
-        result = math_primitives(operation, left_val, right_val);
-    }
+        result = math_primitives(operation, &left_val, &right_val);
 
-    ctx_set_status(ctx, OK_RAN_CMD);
+        // NOTE: numbers only fail here on division by zero.
+        if (result.type == NONE_TYPE) ctx_set_status(ctx, (left_val.type == INT_TYPE || left_val.type == REAL_TYPE) ? ERR_NULL_VAL : ERR_TYPE);
+    }
+    else
+    {
+        ctx_set_status(ctx, ERR_NO_IMPL);
+    }
 
     return result;
 }
 
-VarValue *eval_expr(RunnerContext *ctx, Expression *expr)
+VarValue eval_expr(RunnerContext *ctx, Expression *expr)
 {
-    VarValue *expr_result = NULL;
+    VarValue expr_result = make_none_varval();
 
     switch (expr->type)
     {
@@ -622,180 +634,281 @@ RunStatus exec_module_decl(RunnerContext *ctx, Statement *stmt)
 
 RunStatus exec_module_usage(RunnerContext *ctx, Statement *stmt)
 {
-    const FuncEnv *ctx_modules = ctx->function_env;
+    FuncEnv *ctx_modules = ctx->function_env;
     const char *module_name = stmt->syntax.module_usage.module_name;
 
     FuncGroup *module_ref = funcenv_fetch(ctx_modules, module_name);
 
     if (!module_ref) return ERR_NO_IMPL;
 
-    funcgroup_mark_used(module_ref, 1);
+    if (!funcenv_use_group(ctx_modules, module_ref)) return ERR_MEMORY;
 
     return OK_RAN_CMD;
 }
 
 RunStatus exec_var_decl(RunnerContext *ctx, Statement *stmt)
 {
-    RubelScope *curr_scope = ctx->scopes.scopes[ctx->scopes.stack_ptr];
-    char *var_name = stmt->syntax.var_decl.var_name;
-    int is_const = stmt->syntax.var_decl.is_const;
-    Expression *rvalue_expr = stmt->syntax.var_decl.rvalue;
-    VarValue *var_decl_val = NULL;
-    Variable *var_decl_result = NULL;
+    VarValue *var_ref = NULL;
+    VarValue var_decl_val = eval_expr(ctx, stmt->syntax.var_decl.rvalue);
 
-    // NOTE: reject re-declarations as they're bad practice!
-    if (scope_get_var_ref(curr_scope, var_name) != NULL) return ERR_GENERAL;
+    if (ctx->status > OK_ENDED) return ctx->status;
 
-    var_decl_val = eval_expr(ctx, rvalue_expr);
+    if (var_decl_val.type == NONE_TYPE) return ERR_NULL_VAL;
 
-    if (!var_decl_val) return ERR_MEMORY;
+    // NOTE: calls in the rvalue may grow the frame stack, so the slot is only found after it runs.
+    var_ref = ctx_get_var(ctx, 0, stmt->syntax.var_decl.slot);
 
-    var_decl_result = variable_create(var_name, is_const, var_decl_val);
+    if (!var_ref) return ERR_NO_IMPL;
 
-    if (!scope_put_var(curr_scope, var_decl_result)) return ERR_MEMORY;
+    // NOTE: the resolver already rejected re-declarations, so running a declaration again just resets its slot.
+    *var_ref = var_decl_val;
+    var_ref->is_const = stmt->syntax.var_decl.is_const;
 
     return OK_RAN_CMD;
 }
 
+/**
+ * @brief Runs "set x = x + k" or "set x = x - k" for an int literal k in the slot of x, like the VM's BC_ADDI.
+ * @return int 0 if the assignment has another form, so it needs a full evaluation.
+ */
+static int ctx_try_step(RunnerContext *ctx, const Statement *stmt, RunStatus *status)
+{
+    const Expression *rvalue = stmt->syntax.var_assign.rvalue;
+    const Expression *left = NULL;
+    const Expression *right = NULL;
+    VarValue *var_ref = NULL;
+    OpType op;
+
+    if (rvalue->type != BINARY_OP) return 0;
+
+    op = rvalue->syntax.binary_op.op;
+    left = rvalue->syntax.binary_op.left;
+    right = rvalue->syntax.binary_op.right;
+
+    // NOTE: int adds commute, so "set x = k + x" is a step too.
+    if (op == OP_ADD && left->type == INT_LITERAL && right->type == VAR_USAGE)
+    {
+        left = rvalue->syntax.binary_op.right;
+        right = rvalue->syntax.binary_op.left;
+    }
+
+    if ((op != OP_ADD && op != OP_SUB) || left->type != VAR_USAGE || right->type != INT_LITERAL) return 0;
+
+    if (left->syntax.variable.depth != stmt->syntax.var_assign.depth || left->syntax.variable.slot != stmt->syntax.var_assign.slot) return 0;
+
+    var_ref = ctx_get_var(ctx, stmt->syntax.var_assign.depth, stmt->syntax.var_assign.slot);
+
+    if (!var_ref) return 0;
+
+    ctx->fused.incr_count++;
+
+    // NOTE: these are the errors eval_binary and ctx_update_var would give.
+    if (var_ref->type != INT_TYPE)
+    {
+        *status = (var_ref->type == NONE_TYPE) ? ERR_NULL_VAL : ERR_TYPE;
+        return 1;
+    }
+
+    if (op == OP_ADD) var_ref->data.int_val.value = INT_WRAP_ADD(var_ref->data.int_val.value, right->syntax.int_literal.value);
+    else var_ref->data.int_val.value = INT_WRAP_SUB(var_ref->data.int_val.value, right->syntax.int_literal.value);
+
+    *status = OK_RAN_CMD;
+
+    return 1;
+}
+
 RunStatus exec_var_assign(RunnerContext *ctx, Statement *stmt)
 {
-    char *lvalue_name = stmt->syntax.var_assign.var_name;
-    Expression *rvalue_expr = stmt->syntax.var_assign.rvalue;
-    Variable *lvalue_ref = ctx_get_var(ctx, lvalue_name);
-    VarValue *new_value = NULL;
+    VarValue *lvalue_ref = NULL;
+    VarValue new_value;
+    RunStatus step_status = OK_RAN_CMD;
+
+    if (ctx_try_step(ctx, stmt, &step_status)) return step_status;
+
+    new_value = eval_expr(ctx, stmt->syntax.var_assign.rvalue);
+
+    if (ctx->status > OK_ENDED) return ctx->status;
 
-    new_value = eval_expr(ctx, rvalue_expr);
+    if (new_value.type == NONE_TYPE) return ERR_NULL_VAL;
 
-    // NOTE: value allocation failures are fatal... Exit!
-    if (!new_value) return ERR_MEMORY;
+    lvalue_ref = ctx_get_var(ctx, stmt->syntax.var_assign.depth, stmt->syntax.var_assign.slot);
 
-    if (!ctx_update_var(ctx, lvalue_ref, new_value)) return ERR_TYPE; // NOTE: type mismatches are fatal errors... Exit!
+    if (!lvalue_ref) return ERR_NO_IMPL;
+
+    if (!ctx_update_var(ctx, lvalue_ref, &new_value)) return ERR_TYPE; // NOTE: type mismatches are fatal errors... Exit!
 
     return OK_RAN_CMD;
 }
 
 RunStatus exec_func_decl(RunnerContext *ctx, Statement *stmt)
 {
-    FuncGroup *script_module = ctx->function_env->func_groups[0];
     unsigned short fn_arity = stmt->syntax.func_decl.argc;
+    unsigned short fn_frame_size = stmt->syntax.func_decl.frame_size;
     char *fn_name = stmt->syntax.func_decl.func_name;
     Expression **fn_params = stmt->syntax.func_decl.func_params;
     Statement *fn_block = stmt->syntax.func_decl.stmts;
 
-    FuncObj *fn_obj = func_ast_create(fn_name, fn_arity, fn_params, fn_block);
+    FuncObj *fn_obj = func_ast_create(fn_name, fn_arity, fn_frame_size, fn_params, fn_block);
 
     if (!fn_obj) return ERR_MEMORY;
-    
-    if (!funcgroup_put(script_module, fn_obj)) return ERR_MEMORY;
+
+    if (!funcenv_define(ctx->function_env, fn_obj))
+    {
+        free(fn_obj);
+        return ERR_MEMORY;
+    }
 
     return OK_RAN_CMD;
 }
 
-VarValue *exec_while(RunnerContext *ctx, Statement *stmt)
+/**
+ * @brief Gets a variable's slot or a number literal's value without evaluating it.
+ * @return const VarValue* The operand's value, or NULL if it needs a full evaluation.
+ */
+static const VarValue *ctx_peek_operand(const RunnerContext *ctx, const Expression *expr, VarValue *scratch)
 {
-    Expression *while_condition = stmt->syntax.while_stmt.condition;
-    Statement *while_block = stmt->syntax.while_stmt.stmts;
-    VarValue *expr_value = eval_expr(ctx, while_condition);
-    VarValue *optional_result = NULL;
-    RunStatus status = OK_RAN_CMD;
-    int flag = expr_value->data.bool_val.flag;
+    switch (expr->type)
+    {
+    case VAR_USAGE:
+        return ctx_get_var(ctx, expr->syntax.variable.depth, expr->syntax.variable.slot);
+    case BOOL_LITERAL:
+        *scratch = make_bool_varval(1, expr->syntax.bool_literal.flag);
+        return scratch;
+    case INT_LITERAL:
+        *scratch = make_int_varval(1, expr->syntax.int_literal.value);
+        return scratch;
+    case REAL_LITERAL:
+        *scratch = make_real_varval(1, expr->syntax.real_literal.value);
+        return scratch;
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief Checks an if or while condition. A comparison of variables and literals is tested on their slots like the VM's compare-jumps.
+ * @return int 1 or 0 for the condition, or -1 after setting an error status.
+ */
+static int ctx_check_condition(RunnerContext *ctx, Expression *condition)
+{
+    const VarValue *left_ref = NULL;
+    const VarValue *right_ref = NULL;
+    VarValue left_scratch, right_scratch, check_result;
+    OpType op = (condition->type == BINARY_OP) ? condition->syntax.binary_op.op : OP_NEG;
+    int flag = 0;
 
-    while(flag && status < OK_ENDED)
+    // NOTE: other expressions never have a compare op, as OP_NEG is only unary.
+    if (op == OP_EQ || op == OP_NEQ || op == OP_GT || op == OP_GTE || op == OP_LT || op == OP_LTE)
     {
-        // NOTE: these guard returns will also leave a tiny memory leak, but this error is fatal anyways... Exit!
-        if (!expr_value)
-        {
-            status = ERR_MEMORY;
-            break;
-        }
+        left_ref = ctx_peek_operand(ctx, condition->syntax.binary_op.left, &left_scratch);
+
+        if (left_ref != NULL) right_ref = ctx_peek_operand(ctx, condition->syntax.binary_op.right, &right_scratch);
+    }
+
+    if (right_ref != NULL && condition->syntax.binary_op.operand_type == INT_TYPE)
+    {
+        ctx->fused.cmp_jump_count++;
+        check_result = eval_int_binary(ctx, op, left_ref->data.int_val.value, right_ref->data.int_val.value);
+
+        return check_result.data.bool_val.flag;
+    }
+
+    if (right_ref != NULL)
+    {
+        ctx->fused.cmp_jump_count++;
 
-        if (expr_value->type != BOOL_TYPE)
+        // NOTE: these are the errors eval_binary would give.
+        if (left_ref->type == NONE_TYPE || right_ref->type == NONE_TYPE)
         {
-            status = ERR_TYPE;
-            break;
+            ctx_set_status(ctx, ERR_NULL_VAL);
+            return -1;
         }
 
+        flag = (left_ref->type == right_ref->type) ? compare_primitives(op, left_ref, right_ref) : -1;
+
+        if (flag < 0) ctx_set_status(ctx, ERR_TYPE);
+
+        return flag;
+    }
+
+    check_result = eval_expr(ctx, condition);
+
+    if (ctx->status > OK_ENDED) return -1;
+
+    if (check_result.type != BOOL_TYPE)
+    {
+        ctx_set_status(ctx, (check_result.type == NONE_TYPE) ? ERR_NULL_VAL : ERR_TYPE);
+        return -1;
+    }
+
+    return check_result.data.bool_val.flag;
+}
+
+VarValue exec_while(RunnerContext *ctx, Statement *stmt)
+{
+    Expression *while_condition = stmt->syntax.while_stmt.condition;
+    Statement *while_block = stmt->syntax.while_stmt.stmts;
+    VarValue optional_result = make_none_varval();
+
+    while (1)
+    {
+        ctx_collect_garbage(ctx);
+
+        // NOTE: a false condition or an error ends the loop.
+        if (ctx_check_condition(ctx, while_condition) <= 0) break;
+
         // run block of loop for true checks...
         optional_result = exec_block(ctx, while_block);
 
-        if (optional_result != NULL)
+        // NOTE: a break only exits this loop, but returns and errors bubble out!
+        if (ctx->status == OK_CTRL_BREAK)
         {
-            // NOTE: since loops can ONLY be in functions, treat the presence of result as a function return!
-            status = OK_CTRL_RETURN;
+            ctx_set_status(ctx, OK_RAN_CMD);
             break;
         }
 
-        if (ctx->status > OK_ENDED)
-        {
-            // NOTE: quit loop execution on bubbled error within the loop block!
-            status = ctx->status;
-            break;
-        }
-
-        // clean up temp condition value
-        varval_destroy(expr_value);
-        free(expr_value);
-
-        expr_value = eval_expr(ctx, while_condition);
-        flag = expr_value->data.bool_val.flag;
+        if (ctx->status == OK_CTRL_RETURN || ctx->status > OK_ENDED) break;
     }
 
-    varval_destroy(expr_value);
-    free(expr_value);
-
-    ctx_set_status(ctx, status);
-
     return optional_result;
 }
 
-VarValue *exec_block(RunnerContext *ctx, Statement *stmt)
+VarValue exec_block(RunnerContext *ctx, Statement *stmt)
 {
     unsigned int block_len = stmt->syntax.block.count;
     Statement **stmt_cursor = stmt->syntax.block.stmts;
     Statement *curr_stmt = NULL;
-    VarValue *optional_value = NULL; // possible return value if in a function!
+    VarValue optional_value = make_none_varval(); // possible return value if in a function!
     RunStatus exec_status = OK_RAN_CMD;
 
     for (unsigned int i = 0; i < block_len; i++)
     {
         curr_stmt = *stmt_cursor;
 
-        // NOTE: return statements are ONLY parsed within function blocks, so I can assume that the return value of a block must be exiting a function.
-        if (curr_stmt->type == RETURN_STMT)
-        {
-            optional_value = exec_return(ctx, curr_stmt);
-            break;
-        }
-        else if (curr_stmt->type == IF_STMT)
+        switch (curr_stmt->type)
         {
+        case RETURN_STMT:
+            // NOTE: return statements are ONLY parsed within function blocks, so a return always exits the current call.
+            return exec_return(ctx, curr_stmt);
+        case BREAK_STMT:
+            ctx_set_status(ctx, exec_break(ctx, curr_stmt));
+            return optional_value;
+        case IF_STMT:
             optional_value = exec_ifotherwise(ctx, curr_stmt);
-        }
-        else if (curr_stmt->type == WHILE_STMT)
-        {
+            break;
+        case WHILE_STMT:
             optional_value = exec_while(ctx, curr_stmt);
-        }
-
-        // NOTE: a present optional_value from a function's composite stmt return should be bubbled out!
-        if (optional_value != NULL)
-        {
-            ctx_set_status(ctx, OK_CTRL_RETURN);
             break;
-        }
-
-        exec_status = exec_stmt(ctx, curr_stmt);
+        default:
+            exec_status = exec_stmt(ctx, curr_stmt);
 
-        if (exec_status == OK_CTRL_BREAK)
-        {
-            ctx_set_status(ctx, exec_status);
+            // NOTE: bail out of a block on errors!
+            if (exec_status > OK_ENDED) ctx_set_status(ctx, exec_status);
             break;
         }
 
-        // NOTE: bail out of a block on errors!
-        if (exec_status > OK_ENDED)
-        {
-            ctx_set_status(ctx, exec_status);
-            return NULL;
-        }
+        // NOTE: returns, breaks, and errors from nested blocks should be bubbled out!
+        if (ctx->status == OK_CTRL_RETURN || ctx->status == OK_CTRL_BREAK || ctx->status > OK_ENDED) break;
 
         stmt_cursor++;
     }
@@ -803,32 +916,18 @@ VarValue *exec_block(RunnerContext *ctx, Statement *stmt)
     return optional_value;
 }
 
-VarValue *exec_ifotherwise(RunnerContext *ctx, Statement *stmt)
+VarValue exec_ifotherwise(RunnerContext *ctx, Statement *stmt)
 {
     Expression *condition_expr = stmt->syntax.if_stmt.condition;
-    VarValue *check_result = NULL;
-    VarValue *optional_result = NULL;
     Statement *if_stmt = stmt->syntax.if_stmt.first;
     Statement *other_stmt = stmt->syntax.if_stmt.other;
+    VarValue optional_result = make_none_varval();
+    int check_flag = ctx_check_condition(ctx, condition_expr);
 
-    check_result = eval_expr(ctx, condition_expr);
-
-    if (!check_result)
-    {
-        ctx_set_status(ctx, ERR_MEMORY);
-        return optional_result;
-    }
-
-    if (check_result->type != BOOL_TYPE)
-    {
-        ctx_set_status(ctx, ERR_TYPE);
-        return optional_result;
-    }
-
-    if (check_result->data.bool_val.flag) optional_result = exec_block(ctx, if_stmt);
-    else optional_result = exec_block(ctx, other_stmt->syntax.otherwise_stmt.stmts);
+    if (check_flag < 0) return optional_result;
 
-    ctx->status = (ctx->status <= OK_ENDED) ? ctx->status : ERR_GENERAL;
+    if (check_flag) optional_result = exec_block(ctx, if_stmt);
+    else if (other_stmt != NULL) optional_result = exec_block(ctx, other_stmt->syntax.otherwise_stmt.stmts);
 
     return optional_result;
 }
@@ -838,39 +937,55 @@ RunStatus exec_break(RunnerContext *ctx, Statement *stmt)
     return OK_CTRL_BREAK;
 }
 
-VarValue *exec_return(RunnerContext *ctx, Statement *stmt)
+VarValue exec_return(RunnerContext *ctx, Statement *stmt)
 {
     // todo: don't call in top level exec_stmt!
     Expression *expr_ref = stmt->syntax.return_stmt.result;
-    VarValue *expr_val = eval_expr(ctx, expr_ref);
+    size_t arg_base = ctx->arg_count;
+    const FuncObj *callee_ref = NULL;
+    VarValue expr_val;
 
-    if (!expr_val)
+    if (stmt->syntax.return_stmt.is_tail_call)
     {
-        ctx_set_status(ctx, ERR_MEMORY);
-        return NULL;
+        if (!ctx_push_call_args(ctx, expr_ref)) return make_none_varval();
+
+        callee_ref = ctx_cached_callee(ctx, expr_ref);
+
+        // NOTE: natives and bad calls gain nothing from a frame, so they are just called here.
+        if (callee_ref != NULL && callee_ref->type == FUNC_NORMAL && callee_ref->arity == expr_ref->syntax.fn_call.argc)
+        {
+            ctx->tail_callee = callee_ref;
+            ctx->tail_arg_base = arg_base;
+            ctx_set_status(ctx, OK_CTRL_RETURN);
+            return make_none_varval();
+        }
+
+        expr_val = ctx_call_func(ctx, callee_ref, (unsigned short)(expr_ref->syntax.fn_call.argc), ctx->arg_stack + arg_base);
+        ctx->arg_count = arg_base;
+    }
+    else
+    {
+        expr_val = eval_expr(ctx, expr_ref);
     }
 
-    ctx_set_status(ctx, OK_RAN_CMD);
+    if (ctx->status > OK_ENDED) return make_none_varval();
+
+    ctx_set_status(ctx, OK_CTRL_RETURN);
+
     return expr_val;
 }
 
 RunStatus exec_expr_stmt(RunnerContext *ctx, Statement *stmt)
 {
-    // NOTE: results may be destroyed in exec_stmt, as expr_stmts usually should be lone function calls like print("hi").
+    // NOTE: expr_stmts usually should be lone function calls like print("hi"), so their values are just dropped.
     Expression *expr = stmt->syntax.expr_stmt.expr;
-    ExpressionType expr_type = expr->type;
-    VarValue *discarded_val = NULL;
 
-    // NOTE: only discard values from alone function calls since unused expression values in expr. statements will be useless.
-    if (expr_type != FUNC_CALL) return OK_UNUSED_VAL;
+    // NOTE: only run alone function calls since unused expression values in expr. statements will be useless.
+    if (expr->type != FUNC_CALL) return OK_UNUSED_VAL;
 
-    discarded_val = eval_expr(ctx, expr);
+    eval_expr(ctx, expr);
 
-    if (discarded_val != NULL)
-    {
-        varval_destroy(discarded_val);
-        free(discarded_val);
-    }
+    if (ctx->status > OK_ENDED) return ctx->status;
 
     return OK_RAN_CMD;
 }
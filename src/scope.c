@@ -1,114 +1,116 @@
 /**
  * @file scope.c
  * @author Derek Tan
- * @brief Implements Scope for Rubel interpreter.
+ * @brief Implements the frame stack for the Rubel tree walker.
  * @date 2023-07-30
  */
 
 #include "backend/values/scope.h"
 
-/// SECTION: Scope Impl.
+/// SECTION: Frame Stack Impl.
 
-RubelScope *scope_create(RubelScope *parent)
+int framestack_init(FrameStack *stack, unsigned short global_count)
 {
-    RubelScope *scope = malloc(sizeof(RubelScope));
+    size_t checked_capacity = FRAME_STACK_MIN_SZ;
 
-    if (!scope) return NULL;
+    while (checked_capacity < global_count) checked_capacity <<= 1;
 
-    scope->parent = parent;
+    stack->slots = malloc(sizeof(VarValue) * checked_capacity);
+    stack->base = 0;
+    stack->top = 0;
+    stack->global_count = global_count;
+    stack->depth = 0;
 
-    if (!varenv_init(&scope->venv, VAR_ENV_SIZE))
+    if (!stack->slots)
     {
-        free(scope);
-        scope = NULL;
+        stack->capacity = 0;
+        return 0;
     }
 
-    return scope;
-}
+    stack->capacity = checked_capacity;
 
-void scope_destroy(RubelScope *scope)
-{
-    varenv_destroy(&scope->venv);
-}
+    for (unsigned short i = 0; i < global_count; i++) stack->slots[i] = make_none_varval();
 
-Variable *scope_get_var_ref(const RubelScope *scope, const char *var_name)
-{
-    return varenv_get_var_ref(&scope->venv, var_name);
+    stack->top = global_count;
+
+    return 1;
 }
 
-int scope_put_var(RubelScope *scope, Variable *var_obj)
+void framestack_dispose(FrameStack *stack)
 {
-    return varenv_set_var_ref(&scope->venv, var_obj);
+    // NOTE: string and list payloads are borrowed, so only the slot array is freed.
+    free(stack->slots);
+    stack->slots = NULL;
+    stack->capacity = 0;
+    stack->base = 0;
+    stack->top = 0;
+    stack->depth = 0;
 }
 
-/// SECTION: Scope Stack Impl.
-
-int scopestack_init(ScopeStack *stack, int capacity)
+/**
+ * @brief Makes room for needed_slots slots in all, doubling the capacity like other stacks.
+ */
+static int framestack_reserve(FrameStack *stack, size_t needed_slots)
 {
-    int checked_capacity = capacity;
+    size_t new_capacity = stack->capacity;
+    VarValue *temp_slots = NULL;
 
-    if (checked_capacity < SCOPE_STACK_SIZE) checked_capacity = SCOPE_STACK_SIZE;
+    while (new_capacity < needed_slots) new_capacity <<= 1;
 
-    RubelScope **temp_scopes = malloc(sizeof(RubelScope *) * checked_capacity);
+    if (new_capacity == stack->capacity) return 1;
 
-    if (!temp_scopes)
-    {
-        stack->stack_ptr = -1;
-        stack->scopes = NULL;
-        stack->capacity = 0;
-        return 0;
-    }
-    
-    for (size_t i = 0; i < checked_capacity; i++) temp_scopes[i] = NULL;
+    temp_slots = realloc(stack->slots, sizeof(VarValue) * new_capacity);
 
-    stack->stack_ptr = -1;
-    stack->scopes = temp_scopes;
-    stack->capacity = checked_capacity;
+    if (!temp_slots) return 0;
+
+    stack->slots = temp_slots;
+    stack->capacity = new_capacity;
 
     return 1;
 }
 
-void scopestack_destroy(ScopeStack *stack)
+int framestack_push(FrameStack *stack, unsigned short slot_count, size_t *old_base)
 {
-    if (stack->capacity == 0) return;
+    size_t needed_slots = stack->top + slot_count;
 
-    RubelScope *target = NULL;
+    if (!framestack_reserve(stack, needed_slots)) return 0;
 
-    do
-    {
-        target = scopestack_pop_scope(stack);
+    for (size_t i = stack->top; i < needed_slots; i++) stack->slots[i] = make_none_varval();
 
-        scope_destroy(target);
-        free(target);
-    } while (!scopestack_is_empty(stack));
-}
+    *old_base = stack->base;
+    stack->base = stack->top;
+    stack->top = needed_slots;
+    stack->depth++;
 
-int scopestack_is_full(const ScopeStack *stack)
-{
-    return stack->stack_ptr == stack->capacity - 1;
+    return 1;
 }
 
-int scopestack_is_empty(const ScopeStack *stack)
+int framestack_reuse(FrameStack *stack, unsigned short slot_count)
 {
-    return stack->stack_ptr == -1;
-}
+    size_t needed_slots = stack->base + slot_count;
 
-int scopestack_push_scope(ScopeStack *stack, RubelScope *scope)
-{
-    if (!scope || scopestack_is_full(stack)) return 0;
+    if (!framestack_reserve(stack, needed_slots)) return 0;
 
-    stack->stack_ptr++;
-    stack->scopes[stack->stack_ptr] = scope;
+    for (size_t i = stack->base; i < needed_slots; i++) stack->slots[i] = make_none_varval();
+
+    stack->top = needed_slots;
 
     return 1;
 }
 
-RubelScope *scopestack_pop_scope(ScopeStack *stack)
+void framestack_pop(FrameStack *stack, size_t old_base)
 {
-    if (scopestack_is_empty(stack)) return NULL;
- 
-    RubelScope *scope_ref = stack->scopes[stack->stack_ptr];
-    stack->stack_ptr--;
+    stack->top = stack->base;
+    stack->base = old_base;
+    stack->depth--;
+}
+
+VarValue *framestack_get_slot(const FrameStack *stack, unsigned short depth, unsigned short slot)
+{
+    if (depth == 0) return (slot < stack->top - stack->base) ? stack->slots + stack->base + slot : NULL;
+
+    // NOTE: procs are only declared at top-level, so the one outer frame they see is the globals.
+    if (depth > 1 || stack->depth == 0 || slot >= stack->global_count) return NULL;
 
-    return scope_ref;
+    return stack->slots + slot;
 }
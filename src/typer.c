@@ -0,0 +1,311 @@
+/**
+ * @file typer.c
+ * @author Derek Tan
+ * @brief Implements the static type inference pass.
+ * @date 2023-08-20
+ */
+
+#include "frontend/typer.h"
+#include "frontend/resolver.h"
+
+/// SECTION: Typer utils
+
+int typer_init(Typer *typer, const Script *script)
+{
+    typer->in_proc = 0;
+    typer->error_count = 0;
+    typer->stmt_num = 0;
+    typer->proc_name = NULL;
+    typer->global_count = script->global_count;
+    typer->local_count = 0;
+    typer->decl_mark = 0;
+    typer->local_types = NULL;
+    typer->specialized_count = 0;
+    typer->global_types = malloc(sizeof(DataType) * ((script->global_count > 0) ? script->global_count : 1));
+
+    if (!typer->global_types) return 0;
+
+    for (unsigned short i = 0; i < script->global_count; i++) typer->global_types[i] = NONE_TYPE;
+
+    return 1;
+}
+
+void typer_dispose(Typer *typer)
+{
+    free(typer->global_types);
+    free(typer->local_types);
+    typer->global_types = NULL;
+    typer->local_types = NULL;
+    typer->proc_name = NULL;
+}
+
+void typer_log_err(Typer *typer, const char *msg)
+{
+    typer->error_count++;
+
+    if (typer->in_proc)
+        fprintf(stderr, "TypeError at stmt %u in proc %s: %s\n", typer->stmt_num, typer->proc_name, msg);
+    else
+        fprintf(stderr, "TypeError at stmt %u: %s\n", typer->stmt_num, msg);
+}
+
+/**
+ * @brief Gets the slot types of the frame being typed, which are the globals at top-level.
+ */
+static DataType *typer_frame_types(Typer *typer, unsigned short *slot_count)
+{
+    *slot_count = (typer->in_proc) ? typer->local_count : typer->global_count;
+
+    return (typer->in_proc) ? typer->local_types : typer->global_types;
+}
+
+static DataType typer_var_type(Typer *typer, unsigned short depth, unsigned short slot)
+{
+    unsigned short slot_count = 0;
+    DataType *slot_types = typer_frame_types(typer, &slot_count);
+
+    // NOTE: a proc may be called before a global it reads is declared, so globals seen from procs are never proven.
+    if (depth != RESOLVE_DEPTH_LOCAL || slot >= slot_count) return NONE_TYPE;
+
+    return slot_types[slot];
+}
+
+static void typer_declare(Typer *typer, unsigned short slot, DataType type)
+{
+    unsigned short slot_count = 0;
+    DataType *slot_types = typer_frame_types(typer, &slot_count);
+
+    if (slot >= slot_count) return;
+
+    slot_types[slot] = type;
+
+    if (slot >= typer->decl_mark) typer->decl_mark = slot + 1;
+}
+
+/**
+ * @brief Forgets the types of variables declared since decl_mark was old_mark, as the block declaring them may not have run.
+ * @note The resolver gives each declaration of a proc its own slot in source order, so these are exactly the slots from old_mark up.
+ */
+static void typer_forget_since(Typer *typer, unsigned short old_mark)
+{
+    unsigned short slot_count = 0;
+    DataType *slot_types = typer_frame_types(typer, &slot_count);
+
+    for (unsigned short i = old_mark; i < typer->decl_mark && i < slot_count; i++) slot_types[i] = NONE_TYPE;
+}
+
+/// SECTION: Expression typing
+/// NOTE: the errors found here are the ones eval_unary and eval_binary would give for the proven types.
+
+static DataType type_unary(Typer *typer, Expression *expr)
+{
+    DataType inner = type_expr(typer, expr->syntax.unary_op.expr);
+
+    if (expr->syntax.unary_op.op != OP_NEG) return NONE_TYPE;
+
+    if (inner == NONE_TYPE || inner == INT_TYPE || inner == REAL_TYPE) return inner;
+
+    typer_log_err(typer, "Invalid type for operator.");
+
+    return NONE_TYPE;
+}
+
+static DataType type_binary(Typer *typer, Expression *expr)
+{
+    OpType op = expr->syntax.binary_op.op;
+    DataType left = type_expr(typer, expr->syntax.binary_op.left);
+    DataType right = type_expr(typer, expr->syntax.binary_op.right);
+    int is_compare = op == OP_EQ || op == OP_NEQ || op == OP_GT || op == OP_GTE || op == OP_LT || op == OP_LTE;
+    int is_math = op == OP_ADD || op == OP_SUB || op == OP_MUL || op == OP_DIV;
+    int is_number = left == INT_TYPE || left == REAL_TYPE;
+
+    if (!is_compare && !is_math) return NONE_TYPE;
+
+    if (left == NONE_TYPE || right == NONE_TYPE)
+    {
+        // NOTE: both sides must have the same type to get past the operator, so one proven side is enough for the result.
+        if (is_compare) return BOOL_TYPE;
+
+        return (left != NONE_TYPE) ? left : right;
+    }
+
+    if (left != right || (is_math && !is_number) || (is_compare && !is_number && left != BOOL_TYPE))
+    {
+        typer_log_err(typer, "Invalid types for operator.");
+        return NONE_TYPE;
+    }
+
+    if (is_number)
+    {
+        expr->syntax.binary_op.operand_type = left;
+        typer->specialized_count++;
+    }
+
+    return (is_compare) ? BOOL_TYPE : left;
+}
+
+DataType type_expr(Typer *typer, Expression *expr)
+{
+    switch (expr->type)
+    {
+    case BOOL_LITERAL:
+        return BOOL_TYPE;
+    case INT_LITERAL:
+        return INT_TYPE;
+    case REAL_LITERAL:
+        return REAL_TYPE;
+    case STR_LITERAL:
+        return STR_TYPE;
+    case LIST_LITERAL:
+        return LIST_TYPE;
+    case VAR_USAGE:
+        return typer_var_type(typer, expr->syntax.variable.depth, expr->syntax.variable.slot);
+    case FUNC_CALL:
+        // NOTE: callees can be rebound while running, so their results stay unproven.
+        for (unsigned int i = 0; i < expr->syntax.fn_call.argc; i++) type_expr(typer, expr->syntax.fn_call.args[i]);
+        return NONE_TYPE;
+    case UNARY_OP:
+        return type_unary(typer, expr);
+    case BINARY_OP:
+        return type_binary(typer, expr);
+    default:
+        return NONE_TYPE;
+    }
+}
+
+/// SECTION: Statement typing
+
+static void type_condition(Typer *typer, Expression *condition)
+{
+    DataType type = type_expr(typer, condition);
+
+    if (type != NONE_TYPE && type != BOOL_TYPE) typer_log_err(typer, "Condition is not a boolean.");
+}
+
+/**
+ * @brief Types a block that may not run, so its declarations are unproven after it.
+ */
+static int type_branch(Typer *typer, Statement *stmt)
+{
+    unsigned short old_mark = typer->decl_mark;
+    int type_ok = type_block(typer, stmt);
+
+    typer_forget_since(typer, old_mark);
+
+    return type_ok;
+}
+
+static int type_func_decl(Typer *typer, Statement *stmt)
+{
+    unsigned short frame_size = stmt->syntax.func_decl.frame_size;
+    int type_ok = 1;
+
+    typer->local_types = malloc(sizeof(DataType) * ((frame_size > 0) ? frame_size : 1));
+
+    if (!typer->local_types)
+    {
+        typer_log_err(typer, "Out of memory for types.");
+        return 0;
+    }
+
+    // NOTE: parameters take any type, so only declared locals get proven.
+    for (unsigned short i = 0; i < frame_size; i++) typer->local_types[i] = NONE_TYPE;
+
+    typer->in_proc = 1;
+    typer->proc_name = stmt->syntax.func_decl.func_name;
+    typer->local_count = frame_size;
+    typer->decl_mark = stmt->syntax.func_decl.argc;
+
+    type_ok = type_block(typer, stmt->syntax.func_decl.stmts);
+
+    free(typer->local_types);
+    typer->local_types = NULL;
+    typer->in_proc = 0;
+    typer->proc_name = NULL;
+    typer->local_count = 0;
+    typer->decl_mark = 0;
+
+    return type_ok;
+}
+
+int type_block(Typer *typer, Statement *stmt)
+{
+    int type_ok = 1;
+
+    if (!stmt) return 1;
+
+    if (stmt->type != BLOCK_STMT) return type_stmt(typer, stmt);
+
+    // NOTE: keep going after errors to report the rest of them.
+    for (unsigned int i = 0; i < stmt->syntax.block.count; i++)
+    {
+        if (stmt->syntax.block.stmts[i] != NULL && !type_stmt(typer, stmt->syntax.block.stmts[i])) type_ok = 0;
+    }
+
+    return type_ok;
+}
+
+int type_stmt(Typer *typer, Statement *stmt)
+{
+    Statement *other_stmt = NULL;
+    DataType rvalue_type = NONE_TYPE;
+    DataType var_type = NONE_TYPE;
+    int type_ok = 1;
+
+    switch (stmt->type)
+    {
+    case EXPR_STMT:
+        type_expr(typer, stmt->syntax.expr_stmt.expr);
+        break;
+    case VAR_DECL:
+        rvalue_type = type_expr(typer, stmt->syntax.var_decl.rvalue);
+        stmt->syntax.var_decl.value_type = rvalue_type;
+        typer_declare(typer, stmt->syntax.var_decl.slot, rvalue_type);
+        break;
+    case VAR_ASSIGN:
+        var_type = typer_var_type(typer, stmt->syntax.var_assign.depth, stmt->syntax.var_assign.slot);
+        rvalue_type = type_expr(typer, stmt->syntax.var_assign.rvalue);
+
+        if (var_type != NONE_TYPE && rvalue_type != NONE_TYPE && var_type != rvalue_type) typer_log_err(typer, "Cannot change a variable's type.");
+        break;
+    case BLOCK_STMT:
+        type_ok = type_block(typer, stmt);
+        break;
+    case FUNC_DECL:
+        type_ok = type_func_decl(typer, stmt);
+        break;
+    case WHILE_STMT:
+        type_condition(typer, stmt->syntax.while_stmt.condition);
+        type_ok = type_branch(typer, stmt->syntax.while_stmt.stmts);
+        break;
+    case IF_STMT:
+        other_stmt = stmt->syntax.if_stmt.other;
+        type_condition(typer, stmt->syntax.if_stmt.condition);
+        type_ok = type_branch(typer, stmt->syntax.if_stmt.first);
+
+        if (other_stmt != NULL) type_ok = type_branch(typer, other_stmt->syntax.otherwise_stmt.stmts) && type_ok;
+        break;
+    case RETURN_STMT:
+        type_expr(typer, stmt->syntax.return_stmt.result);
+        break;
+    case MODULE_DEF:
+    case MODULE_USE:
+    case BREAK_STMT:
+    default:
+        break;
+    }
+
+    return type_ok;
+}
+
+int type_script(Typer *typer, Script *script)
+{
+    for (unsigned int i = 0; i < script->count; i++)
+    {
+        typer->stmt_num = i;
+
+        if (script->stmts[i] != NULL) type_stmt(typer, script->stmts[i]);
+    }
+
+    return typer->error_count == 0;
+}
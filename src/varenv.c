@@ -9,7 +9,7 @@
 
 /// SECTION: Variable impl.
 
-Variable *variable_create(char *var_name, int is_const, VarValue *var_value)
+Variable *variable_create(char *var_name, int is_const, VarValue var_value)
 {
     Variable *var_obj = malloc(sizeof(Variable));
 
@@ -17,6 +17,7 @@ Variable *variable_create(char *var_name, int is_const, VarValue *var_value)
     {
         var_obj->name = var_name;
         var_obj->is_const = is_const;
+        var_obj->slot = 0;
         var_obj->value = var_value;
     }
 
@@ -25,187 +26,98 @@ Variable *variable_create(char *var_name, int is_const, VarValue *var_value)
 
 void variable_destroy(Variable *var_obj)
 {
-    DataType val_type = var_obj->value->type;
-
-    free(var_obj->name);
+    // NOTE: the name belongs to the AST, and string or list payloads are borrowed from literals or natives.
     var_obj->name = NULL;
-
-    switch (val_type)
-    {
-    case STR_TYPE:
-        destroy_str_obj(var_obj->value->data.str_type.value);
-        var_obj->value->data.str_type.value = NULL;
-        break;
-    case LIST_TYPE:
-        destroy_list_obj(var_obj->value->data.list_type.value);
-        var_obj->value->data.list_type.value = NULL;
-        break;
-    default:
-        break;
-    }
+    var_obj->value.type = NONE_TYPE;
 }
 
-/// SECTION: Variable Table Bucket List
+/// SECTION: Variable Environment
 
-EnvBuckListNode *bucklistnode_create(Variable *var_obj, EnvBuckListNode *next_ptr)
+int varenv_init(VarEnv *venv, size_t buckets)
 {
-    EnvBuckListNode *node = malloc(sizeof(EnvBuckListNode));
+    size_t checked_count = hash_capacity_for((buckets < VAR_ENV_SIZE) ? VAR_ENV_SIZE : buckets);
+    Variable **temp_entries = calloc(checked_count, sizeof(Variable *));
 
-    if (node != NULL)
-    {
-        node->var = var_obj;
-        node->next = next_ptr;
-    }
+    if (!temp_entries) return 0;
 
-    return node;
-}
+    venv->entries = temp_entries;
+    venv->capacity = checked_count;
+    venv->count = 0;
 
-void bucklistnode_destroy(EnvBuckListNode *node)
-{
-    variable_destroy(node->var);
+    return 1;
 }
 
-EnvBuckList *envbucklist_create()
+void varenv_destroy(VarEnv *venv)
 {
-    EnvBuckList *bucklist = malloc(sizeof(EnvBuckList));
+    if (!venv->entries) return;
 
-    if (bucklist != NULL)
+    for (size_t i = 0; i < venv->capacity; i++)
     {
-        bucklist->count = 0;
-        bucklist->head = NULL;
-        bucklist->last = NULL;
+        if (venv->entries[i] != NULL)
+        {
+            variable_destroy(venv->entries[i]);
+            free(venv->entries[i]);
+        }
     }
 
-    return bucklist;
+    free(venv->entries);
+    venv->entries = NULL;
+    venv->capacity = 0;
+    venv->count = 0;
 }
 
-void envbucklist_destroy(EnvBuckList *bucklist)
+/**
+ * @brief Finds the slot holding the name, or the free slot where it would go.
+ */
+static size_t varenv_probe(Variable **entries, size_t capacity, const char *var_name)
 {
-    if (bucklist->count == 0 || !bucklist->head) return;
+    size_t mask = capacity - 1;
+    size_t index = intern_hash(var_name) & mask;
 
-    EnvBuckListNode *next_ptr = bucklist->head;
+    // NOTE: the load limit keeps a free slot around, so probing always stops.
+    while (entries[index] != NULL && entries[index]->name != var_name)
+        index = (index + 1) & mask;
 
-    while (bucklist->head != NULL)
-    {
-        next_ptr = next_ptr->next;
-        bucklistnode_destroy(bucklist->head);
-        free(bucklist->head);
-        bucklist->head = next_ptr;
-    }
+    return index;
 }
 
-const EnvBuckListNode *envbucklist_fetch(const EnvBuckList *bucklist, const char *var_name)
+static int varenv_grow(VarEnv *venv)
 {
-    EnvBuckListNode *node_ptr = bucklist->head;
+    size_t new_capacity = venv->capacity << 1;
+    Variable **new_entries = calloc(new_capacity, sizeof(Variable *));
+    Variable *var_ref = NULL;
 
-    if (bucklist->count == 0 || !node_ptr) return NULL;
+    if (!new_entries) return 0;
 
-    do
+    for (size_t i = 0; i < venv->capacity; i++)
     {
-        if (strcmp(var_name, node_ptr->var->name) == 0) return node_ptr;
-
-        node_ptr = node_ptr->next;
-    } while (node_ptr != NULL);
-    
-    return NULL;
-}
-
-int envbucklist_append(EnvBuckList *bucklist, EnvBuckListNode *node)
-{
-    if (!node) return 0;
+        var_ref = venv->entries[i];
 
-    if (bucklist->count == 0 || bucklist->head == NULL)
-    {
-        bucklist->head = node;
-        bucklist->last = node;
-        bucklist->count++;
-        return 1;
+        if (var_ref != NULL) new_entries[varenv_probe(new_entries, new_capacity, var_ref->name)] = var_ref;
     }
 
-    bucklist->last->next = node;
-    bucklist->last = bucklist->last->next;
-
-    return 1;
-}
-
-/// SECTION: Variable Environment
-
-int varenv_init(VarEnv *venv, size_t buckets)
-{
-    size_t checked_count = buckets;
-
-    if (checked_count < VAR_ENV_SIZE) checked_count = VAR_ENV_SIZE;
-
-    EnvBuckList **temp_entries = malloc(sizeof(EnvBuckList *) * checked_count);
-
-    if (!temp_entries) return 0;
-
-    for (size_t i = 0; i < checked_count; i++) temp_entries[i] = NULL;
-
-    venv->entries = temp_entries;
-    venv->count = checked_count;
+    free(venv->entries);
+    venv->entries = new_entries;
+    venv->capacity = new_capacity;
 
     return 1;
 }
 
-void varenv_destroy(VarEnv *venv)
-{
-    if (venv->count == 0 || !venv->entries) return;
-
-    EnvBuckList *target = NULL;
-    size_t bucket_count = venv->count;
-
-    for (size_t i = 0; i < bucket_count; i++)
-    {
-        target = venv->entries[i];
-
-        if (target != NULL)
-        {
-            envbucklist_destroy(target);
-            free(target);
-        }
-    }
-
-    free(venv->entries);
-    venv->entries = NULL;
-}
-
 Variable *varenv_get_var_ref(const VarEnv *venv, const char *var_name)
 {
-    size_t bucket_index = hash_key(var_name) % venv->count;
-    EnvBuckList *bucket_chain = venv->entries[bucket_index];
-
-    if (!bucket_chain) return NULL;
-
-    if (bucket_chain->count == 1) return bucket_chain->head->var;
+    if (!var_name || venv->capacity == 0) return NULL;
 
-    const EnvBuckListNode *chain_node = envbucklist_fetch(bucket_chain, var_name);
-
-    if (!chain_node) return NULL;
-
-    return chain_node->var;
+    return venv->entries[varenv_probe(venv->entries, venv->capacity, var_name)];
 }
 
 int varenv_set_var_ref(VarEnv *venv, Variable *var_obj)
 {
-    const char *var_obj_name = var_obj->name;
-    size_t bucket_index = hash_key(var_obj_name) % venv->count;
-    EnvBuckList *bucket_chain = venv->entries[bucket_index];
-    EnvBuckListNode *node = bucklistnode_create(var_obj, NULL);
-
-    if (!var_obj || !node) return 0; // NOTE: fail fast on NULL var or allocation failure for chained bucket node since NULL ptrs cannot be accessed anyway!
-
-    if (!bucket_chain)
-    {
-        EnvBuckList *temp = envbucklist_create();
-
-        if (!temp) return 0; // fail fast on allocation failure of bucket chain for same reason as node check 
+    if (!var_obj || venv->capacity == 0) return 0;
 
-        envbucklist_append(temp, node);
-        venv->entries[bucket_index] = temp;
+    if ((venv->count + 1) * 4 > venv->capacity * 3 && !varenv_grow(venv)) return 0;
 
-        return 1;
-    }
+    venv->entries[varenv_probe(venv->entries, venv->capacity, var_obj->name)] = var_obj;
+    venv->count++;
 
-    return envbucklist_append(bucket_chain, node);
+    return 1;
 }
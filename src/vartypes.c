@@ -5,261 +5,309 @@
  * @date 2023-07-25
  */
 
-#include "backend/values/vartypes.h"
+#include "backend/values/heap.h"
 
 /// SECTION: Variables
 
-VarValue *create_bool_varval(int is_const, int flag)
+VarValue make_bool_varval(int is_const, int flag)
 {
-    VarValue *boolvar = malloc(sizeof(VarValue));
-
-    if (boolvar != NULL)
-    {
-        boolvar->type = BOOL_TYPE;
-        boolvar->is_const = is_const;
-        boolvar->data.bool_val.flag = flag;
-    }
-
-    return boolvar;
+    return (VarValue){.type = BOOL_TYPE, .is_const = is_const, .data.bool_val.flag = flag};
 }
 
-VarValue *create_int_varval(int is_const, int value)
+VarValue make_int_varval(int is_const, int value)
 {
-    VarValue *intval = malloc(sizeof(VarValue));
+    return (VarValue){.type = INT_TYPE, .is_const = is_const, .data.int_val.value = value};
+}
 
-    if (intval != NULL)
-    {
-        intval->type = INT_TYPE;
-        intval->is_const = is_const;
-        intval->data.int_val.value = value;
-    }
+VarValue make_real_varval(int is_const, float value)
+{
+    return (VarValue){.type = REAL_TYPE, .is_const = is_const, .data.real_val.value = value};
+}
 
-    return intval;
+VarValue make_str_varval(int is_const, struct st_str_obj *value)
+{
+    return (VarValue){.type = STR_TYPE, .is_const = is_const, .data.str_type.value = value};
 }
 
-VarValue *create_real_varval(int is_const, float value)
+VarValue make_list_varval(int is_const, struct st_list_obj *value)
 {
-    VarValue *realval = malloc(sizeof(VarValue));
+    return (VarValue){.type = LIST_TYPE, .is_const = is_const, .data.list_type.value = value};
+}
 
-    if (realval != NULL)
-    {
-        realval->type = REAL_TYPE;
-        realval->is_const = is_const;
-        realval->data.real_val.value = value;
-    }
+VarValue make_none_varval()
+{
+    return (VarValue){.type = NONE_TYPE, .is_const = 1};
+}
 
-    return realval;
+DataType varval_get_type(const VarValue *variable)
+{
+    return variable->type;
 }
 
-VarValue *create_str_varval(int is_const, struct st_str_obj *value)
+int varval_is_const(const VarValue *variable)
 {
-    VarValue *strval = malloc(sizeof(VarValue));
+    return variable->is_const;
+}
 
-    if (strval != NULL)
-    {
-        strval->type = STR_TYPE;
-        strval->is_const = is_const;
-        strval->data.str_type.value = value;
-    }
+/// SECTION: StringObj
+
+static StrObjStats str_stats = {0, 0, 0, 0, 0};
 
-    return strval;
+// NOTE: one char strings from indexing are shared from here, so they are pinned and filled on first use.
+static StringObj char_strs[256];
+
+static int str_obj_is_inline(const StringObj *str)
+{
+    return str->source == str->inline_buf;
 }
 
-VarValue *create_list_varval(int is_const, struct st_list_obj *value)
+/**
+ * @brief Makes a counted string over a heap buffer of length chars.
+ */
+static StringObj *str_obj_wrap(char *source, size_t length)
 {
-    VarValue *strval = malloc(sizeof(VarValue));
+    StringObj *str_obj = heap_alloc(GC_KIND_STR);
 
-    if (strval != NULL)
+    if (str_obj != NULL)
     {
-        strval->type = LIST_TYPE;
-        strval->is_const = is_const;
-        strval->data.list_type.value = value;
+        str_obj->length = length;
+        str_obj->capacity = length;
+        str_obj->refs = 1;
+        str_obj->is_builder = 0;
+        str_obj->source = source;
+        str_stats.allocs++;
+        heap_track(&str_obj->gc, GC_KIND_STR, sizeof(StringObj) + ((source != NULL) ? length + 1 : 0));
     }
 
-    return strval;
+    return str_obj;
 }
 
-void varval_destroy(VarValue *value)
+void init_pinned_str_obj(StringObj *str, char *source, size_t length)
 {
-    switch (value->type)
-    {
-    case STR_TYPE:
-        destroy_str_obj(value->data.str_type.value);
-        free(value->data.str_type.value);
-        value->data.str_type.value = NULL;
-        break;
-    case LIST_TYPE:
-        destroy_list_obj(value->data.list_type.value);
-        free(value->data.list_type.value);
-        value->data.list_type.value = NULL;
-        break;
-    default:
-        break;
-    }
+    str->gc = (GcObject){.next = NULL, .bytes = 0, .kind = GC_KIND_STR, .space = GC_UNTRACKED, .marked = 0, .age = 0};
+    str->length = length;
+    str->capacity = length;
+    str->refs = STR_OBJ_PINNED;
+    str->is_builder = 0;
+    str->source = source;
 }
 
-DataType varval_get_type(const VarValue *variable)
+StringObj *create_str_obj(char *source)
 {
-    return variable->type;
+    return str_obj_wrap(source, strlen(source));
 }
 
-int varval_is_const(const VarValue *variable)
+StringObj *create_str_builder()
 {
-    return variable->is_const;
-}
+    StringObj *builder = create_str_obj_n("", 0);
 
-/// SECTION: StringObj
+    if (builder != NULL) builder->is_builder = 1;
 
-StringObj *create_str_obj(char *source)
+    return builder;
+}
+
+/**
+ * @brief Makes a counted string with room for length chars, inline when short. Only the terminator is written.
+ */
+static StringObj *str_obj_reserve(size_t length)
 {
-    StringObj *str_obj = malloc(sizeof(StringObj));
+    StringObj *str_obj = NULL;
+    char *buffer = NULL;
 
-    if (str_obj != NULL)
+    if (length > STR_OBJ_SSO_CAP)
     {
-        str_obj->source = source;
-        str_obj->length = strlen(source);
+        buffer = malloc(sizeof(char) * (length + 1));
+
+        if (!buffer) return NULL;
+
+        str_obj = str_obj_wrap(buffer, length);
+
+        if (!str_obj)
+        {
+            free(buffer);
+            return NULL;
+        }
+    }
+    else
+    {
+        str_obj = str_obj_wrap(NULL, length);
+
+        if (!str_obj) return NULL;
+
+        str_obj->source = str_obj->inline_buf;
+        str_obj->capacity = STR_OBJ_SSO_CAP;
+        str_stats.inline_strings++;
     }
 
+    str_obj->source[length] = '\0';
+
+    return str_obj;
+}
+
+StringObj *create_str_obj_n(const char *text, size_t length)
+{
+    StringObj *str_obj = str_obj_reserve(length);
+
+    if (str_obj != NULL) memcpy(str_obj->source, text, length);
+
     return str_obj;
 }
 
 void destroy_str_obj(StringObj *str)
 {
-    if (str->source != NULL)
-    {
-        free(str->source);
-        str->source = NULL;
-    }
+    if (str->source != NULL && !str_obj_is_inline(str)) free(str->source);
 
+    str->source = NULL;
     str->length = 0;
+    str->capacity = 0;
 }
 
-StringObj *copy_str_obj(const StringObj *str)
+StringObj *retain_str_obj(StringObj *str)
 {
-    StringObj *new_str = NULL;
+    if (str->refs != STR_OBJ_PINNED) str->refs++;
 
-    if (!str) return new_str;
+    return str;
+}
 
-    // create copy of other string contents
-    size_t copy_str_len = str->length;
-    char *copy_source = NULL;
+void release_str_obj(StringObj *str)
+{
+    if (str->refs == STR_OBJ_PINNED) return;
 
-    copy_source = malloc(sizeof(char) * (copy_str_len + 1));
+    // NOTE: the heap frees the strings it tracks, so their first reference is never given up.
+    if (str->gc.space != GC_UNTRACKED && str->refs == 1) return;
 
-    if (!copy_source) return new_str;
+    str->refs--;
 
-    memcpy(copy_source, str->source, copy_str_len);
-    copy_source[copy_str_len] = '\0';
+    if (str->refs > 0) return;
 
-    new_str = malloc(sizeof(StringObj));
+    destroy_str_obj(str);
+    free(str);
+    str_stats.frees++;
+}
 
-    if (new_str != NULL)
-    {
-        new_str->source = copy_source;
-        new_str->length = copy_str_len;
-    }
+StringObj *copy_str_obj(const StringObj *str)
+{
+    StringObj *new_str = NULL;
+
+    if (!str) return new_str;
+
+    new_str = create_str_obj_n(str->source, str->length);
+
+    if (new_str != NULL) str_stats.copies++;
 
     return new_str;
 }
 
-StringObj *index_str_obj(StringObj *str, size_t index)
+StringObj *index_str_obj(const StringObj *str, size_t index)
 {
-    size_t parent_length = str->length;
-    char *buffer = NULL;
-    StringObj *str_obj = NULL;
-
-    if (index >= parent_length)
-        return NULL;
-
-    buffer = malloc(sizeof(char) * 2);
+    StringObj *char_str = NULL;
 
-    if (!buffer)
+    if (index >= str->length)
         return NULL;
 
-    str_obj = malloc(sizeof(StringObj));
+    char_str = char_strs + (unsigned char)str->source[index];
 
-    if (str_obj != NULL)
+    if (!char_str->source)
     {
-        str_obj->length = 1;
-        buffer[0] = str->source[index];
-        buffer[1] = '\0';
-        str_obj->source = buffer;
+        char_str->length = 1;
+        char_str->capacity = 1;
+        char_str->refs = STR_OBJ_PINNED;
+        char_str->inline_buf[0] = str->source[index];
+        char_str->inline_buf[1] = '\0';
+        char_str->source = char_str->inline_buf;
     }
 
-    return str_obj;
+    return char_str;
 }
 
-StringObj *concat_str_obj(StringObj *str, StringObj *other)
+StringObj *concat_str_obj(StringObj *str, const StringObj *other)
 {
     size_t target_length = str->length;
-    size_t total_length = target_length + other->length;
+    size_t other_length = other->length;
+    size_t total_length = target_length + other_length;
+    size_t new_capacity = (str->capacity << 1 > total_length) ? str->capacity << 1 : total_length;
+    uintptr_t other_spot = (uintptr_t)other->source;
+    uintptr_t target_spot = (uintptr_t)str->source;
+    int other_in_str = other_spot >= target_spot && other_spot < target_spot + target_length;
+    const char *other_source = other->source;
     char *new_buffer = NULL;
+    StringObj *result = NULL;
 
     // don't reallocate for a zero-length string append
     if (total_length == target_length)
         return str;
 
-    new_buffer = realloc(str->source, total_length + 1);
-
-    if (!new_buffer)
-        return NULL; // NOTE: return null on any value errors for later null safety checks!
+    // NOTE: only builders change in place, since borrowed values of other strings are not counted.
+    if (str->is_builder)
+    {
+        if (total_length <= str->capacity)
+        {
+            new_buffer = str->source;
+        }
+        else if (str_obj_is_inline(str))
+        {
+            new_buffer = malloc(new_capacity + 1);
+
+            if (new_buffer != NULL) memcpy(new_buffer, str->inline_buf, target_length);
+        }
+        else
+        {
+            new_buffer = realloc(str->source, new_capacity + 1);
+        }
+
+        if (!new_buffer)
+            return NULL; // NOTE: return null on any value errors for later null safety checks!
+
+        // NOTE: a builder appended to itself is read from its new buffer, since growing may have freed the old one.
+        if (other_in_str) other_source = new_buffer + (other_spot - target_spot);
+
+        memcpy(new_buffer + target_length, other_source, other_length);
+        new_buffer[total_length] = '\0';
+
+        if (total_length > str->capacity)
+        {
+            str->capacity = new_capacity;
+            heap_resize(&str->gc, sizeof(StringObj) + new_capacity + 1);
+        }
+
+        str->source = new_buffer;
+        str->length = total_length;
+        str_stats.appends_in_place++;
 
-    strncpy(new_buffer + target_length, other->source, total_length);
-    new_buffer[total_length] = '\0';
+        return str;
+    }
 
-    return str;
-}
+    result = str_obj_reserve(total_length);
 
-/// SECTION: ListNodeObj
+    if (!result)
+        return NULL;
 
-ListNodeObj *create_listnode_obj(VarValue *data, ListNodeObj *next)
-{
-    ListNodeObj *node = malloc(sizeof(ListNodeObj));
+    memcpy(result->source, str->source, target_length);
+    memcpy(result->source + target_length, other_source, other_length);
 
-    if (node != NULL)
-    {
-        node->value = data;
-        node->next = next;
-    }
+    str_stats.copies++;
 
-    return node;
+    return result;
 }
 
-void destroy_listnode_obj(ListNodeObj *node)
+const StrObjStats *get_str_obj_stats()
 {
-    VarValue *data = node->value;
-
-    if (!data)
-        return;
-
-    switch (data->type)
-    {
-    case STR_TYPE:
-        destroy_str_obj(data->data.str_type.value);
-        free(data->data.str_type.value);
-        data->data.str_type.value = NULL;
-        break;
-    case LIST_TYPE:
-        destroy_list_obj(data->data.list_type.value);
-        free(data->data.list_type.value);
-        data->data.list_type.value = NULL;
-        break;
-    default:
-        break;
-    }
+    return &str_stats;
 }
 
 /// SECTION: ListObj
 
 ListObj *create_list_obj()
 {
-    ListObj *list = malloc(sizeof(ListObj));
+    ListObj *list = heap_alloc(GC_KIND_LIST);
 
     if (list != NULL)
     {
+        list->kind = LIST_EMPTY;
         list->count = 0;
-        list->head = NULL;
-        list->last = NULL;
+        list->capacity = 0;
+        list->store.items = NULL;
+        heap_track(&list->gc, GC_KIND_LIST, sizeof(ListObj));
     }
 
     return list;
@@ -269,82 +317,112 @@ ListObj *create_list_obj()
 
 void destroy_list_obj(ListObj *list)
 {
-    if (list->count < 1)
-        return;
-    
-    ListNodeObj *next_ptr = list->head;
+    VarValue *item = NULL;
 
-    do
+    // NOTE: nested lists belong to their parent, and strings were retained by append. Only boxed lists can hold either.
+    if (list->kind == LIST_MIXED)
     {
-        next_ptr = next_ptr->next;
-        destroy_listnode_obj(list->head);
-        free(list->head);
-        list->head = next_ptr;
-    } while (list->head != NULL);
+        for (size_t i = 0; i < list->count; i++)
+        {
+            item = list->store.items + i;
+
+            if (item->type == LIST_TYPE && item->data.list_type.value->gc.space == GC_UNTRACKED)
+            {
+                destroy_list_obj(item->data.list_type.value);
+                free(item->data.list_type.value);
+            }
+            else if (item->type == STR_TYPE)
+            {
+                release_str_obj(item->data.str_type.value);
+            }
+        }
+    }
 
-    list->last = NULL;
+    free(list->store.items);
+    list->store.items = NULL;
+    list->kind = LIST_EMPTY;
     list->count = 0;
+    list->capacity = 0;
 }
 
-int append_list_obj(ListObj *list, VarValue *data)
+static size_t list_item_size(ListKind kind)
 {
-    ListNodeObj *temp = create_listnode_obj(data, NULL);
-    
-    if (!temp)
-        return 0;
+    if (kind == LIST_INTS) return sizeof(int32_t);
+    else if (kind == LIST_REALS) return sizeof(float);
 
-    if (list->count == 0)
-    {
-        list->head = temp;
-        list->last = temp;
-        list->count++;
+    return sizeof(VarValue);
+}
+
+/**
+ * @brief Boxes the packed items of a list into a VarValue buffer of the same capacity.
+ */
+static int list_obj_unpack(ListObj *list)
+{
+    VarValue *boxed = malloc(sizeof(VarValue) * list->capacity);
 
-        return 1;
-    } 
+    if (!boxed) return 0;
 
-    list->last->next = temp;
-    list->last = list->last->next;
-    list->count++;
+    for (size_t i = 0; i < list->count; i++)
+    {
+        if (list->kind == LIST_INTS) boxed[i] = make_int_varval(0, list->store.ints[i]);
+        else boxed[i] = make_real_varval(0, list->store.reals[i]);
+    }
+
+    free(list->store.items);
+    list->store.items = boxed;
+    list->kind = LIST_MIXED;
+    heap_resize(&list->gc, sizeof(ListObj) + sizeof(VarValue) * list->capacity);
 
     return 1;
 }
 
-// VarValue *pop_list_obj(ListObj *list)
-// {
-//     if (list->count == 0 || !list->head) return NULL;
+int append_list_obj(ListObj *list, VarValue data)
+{
+    size_t new_capacity = (list->capacity > 0) ? list->capacity << 1 : LIST_OBJ_MIN_SZ;
+    void *temp_items = NULL;
+
+    if (list->kind == LIST_EMPTY)
+    {
+        if (data.type == INT_TYPE) list->kind = LIST_INTS;
+        else if (data.type == REAL_TYPE) list->kind = LIST_REALS;
+        else list->kind = LIST_MIXED;
+    }
+    else if ((list->kind == LIST_INTS && data.type != INT_TYPE) || (list->kind == LIST_REALS && data.type != REAL_TYPE))
+    {
+        if (list->capacity > 0 && !list_obj_unpack(list)) return 0;
 
-//     ListNodeObj *prev_ptr = list->head;
-//     ListNodeObj *target_ptr = list->head;
+        list->kind = LIST_MIXED;
+    }
 
-//     while (target_ptr->next != NULL)
-//     {
-//         prev_ptr = target_ptr;
-//         target_ptr = target_ptr->next;
-//     }
+    if (list->count == list->capacity)
+    {
+        temp_items = realloc(list->store.items, list_item_size(list->kind) * new_capacity);
 
-//     // remove last node
-//     prev_ptr->next = NULL;
-//     list->last = prev_ptr;
-//     list->count--;
+        if (!temp_items) return 0;
 
-//     return target_ptr;
-// }
+        list->store.items = temp_items;
+        list->capacity = new_capacity;
+        heap_resize(&list->gc, sizeof(ListObj) + list_item_size(list->kind) * new_capacity);
+    }
 
-VarValue *get_at_list_obj(const ListObj *list, size_t index)
-{
-    size_t countdown = index;
+    if (list->kind == LIST_INTS) list->store.ints[list->count] = data.data.int_val.value;
+    else if (list->kind == LIST_REALS) list->store.reals[list->count] = data.data.real_val.value;
+    else list->store.items[list->count] = data;
 
-    if (countdown >= list->count) return NULL;
+    if (data.type == STR_TYPE) retain_str_obj(data.data.str_type.value);
 
-    ListNodeObj *temp_ptr = list->head;
+    list->count++;
 
-    while (temp_ptr->next != NULL)
-    {
-        if (countdown == 0) break;
+    return 1;
+}
 
-        temp_ptr = temp_ptr->next;
-        countdown--;
-    }
+int get_at_list_obj(const ListObj *list, size_t index, VarValue *item)
+{
+    if (index >= list->count) return 0;
 
-    return temp_ptr->value;
+    if (list->kind == LIST_INTS) *item = make_int_varval(0, list->store.ints[index]);
+    else if (list->kind == LIST_REALS) *item = make_real_varval(0, list->store.reals[index]);
+    else *item = list->store.items[index];
+
+    return 1;
 }
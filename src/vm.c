@@ -0,0 +1,680 @@
+/**
+ * @file vm.c
+ * @author Derek Tan
+ * @brief Implements the register bytecode VM.
+ * @date 2023-08-12
+ */
+
+#include "backend/runner/vm.h"
+
+/// SECTION: VM utils
+
+int vm_init(RubelVM *vm, RunnerContext *ctx, const BcProgram *program)
+{
+    vm->ctx = ctx;
+    vm->program = program;
+    vm->stmt_num = 0;
+    vm->stack = malloc(sizeof(VarValue) * VM_STACK_MIN_SZ);
+    vm->frames = malloc(sizeof(BcFrame) * VM_FRAMES_MIN_SZ);
+    vm->stack_capacity = VM_STACK_MIN_SZ;
+    vm->frame_capacity = VM_FRAMES_MIN_SZ;
+    vm->frame_count = 0;
+    vm->call_cache = calloc((program->name_count > 0) ? program->name_count : 1, sizeof(BcCallCache));
+    vm->jit_slots = calloc((program->proc_count > 0) ? program->proc_count : 1, sizeof(BcJitSlot));
+    vm->jit_enabled = 1;
+    vm->jit_hot_calls = JIT_HOT_CALLS;
+    vm->jit_stats = (JitStats){.compiled_count = 0, .rejected_count = 0, .native_calls = 0, .deopt_count = 0};
+
+    if (!vm->stack || !vm->frames || !vm->call_cache || !vm->jit_slots)
+    {
+        vm_dispose(vm);
+        return 0;
+    }
+
+    return 1;
+}
+
+void vm_dispose(RubelVM *vm)
+{
+    free(vm->stack);
+    free(vm->frames);
+    free(vm->call_cache);
+
+    if (vm->jit_slots != NULL)
+    {
+        for (unsigned int i = 0; i < vm->program->proc_count; i++) jit_code_dispose(vm->jit_slots[i].code);
+    }
+
+    free(vm->jit_slots);
+
+    vm->stack = NULL;
+    vm->frames = NULL;
+    vm->call_cache = NULL;
+    vm->jit_slots = NULL;
+    vm->stack_capacity = 0;
+    vm->frame_capacity = 0;
+    vm->frame_count = 0;
+
+    // NOTE: the context and program are owned by the Interpreter.
+    vm->ctx = NULL;
+    vm->program = NULL;
+}
+
+/**
+ * @brief Makes room for needed_slots registers in all, doubling the capacity like other stacks.
+ */
+static int vm_reserve_stack(RubelVM *vm, size_t needed_slots)
+{
+    size_t new_stack_capacity = vm->stack_capacity;
+    VarValue *temp_stack = NULL;
+
+    while (new_stack_capacity < needed_slots) new_stack_capacity <<= 1;
+
+    if (new_stack_capacity == vm->stack_capacity) return 1;
+
+    temp_stack = realloc(vm->stack, sizeof(VarValue) * new_stack_capacity);
+
+    if (!temp_stack) return 0;
+
+    vm->stack = temp_stack;
+    vm->stack_capacity = new_stack_capacity;
+
+    return 1;
+}
+
+/**
+ * @brief Pushes a frame whose registers begin at base. Argument registers are kept while the rest are cleared.
+ */
+static int vm_push_frame(RubelVM *vm, const BcProc *proc, size_t base)
+{
+    size_t needed_slots = base + proc->reg_count;
+    int new_frame_capacity = vm->frame_capacity << 1;
+
+    if (vm->frame_count >= VM_CALL_DEPTH_MAX) return 0;
+
+    if (!vm_reserve_stack(vm, needed_slots)) return 0;
+
+    if (vm->frame_count == vm->frame_capacity)
+    {
+        BcFrame *temp_frames = realloc(vm->frames, sizeof(BcFrame) * new_frame_capacity);
+
+        if (!temp_frames) return 0;
+
+        vm->frames = temp_frames;
+        vm->frame_capacity = new_frame_capacity;
+    }
+
+    for (size_t i = base + proc->arity; i < needed_slots; i++) vm->stack[i].type = NONE_TYPE;
+
+    vm->frames[vm->frame_count] = (BcFrame){.proc = proc, .ip = proc->code, .base = base};
+    vm->frame_count++;
+
+    return 1;
+}
+
+/**
+ * @brief Runs proc in the top frame for a tail call. Its args are moved down from arg_reg first, so the frame does not grow.
+ */
+static int vm_reuse_frame(RubelVM *vm, const BcProc *proc, unsigned short arg_reg)
+{
+    BcFrame *frame = vm->frames + vm->frame_count - 1;
+    size_t needed_slots = frame->base + proc->reg_count;
+
+    // NOTE: the args sit above the slots they move to, so copying upwards never overwrites one before it is read.
+    for (unsigned short i = 0; i < proc->arity; i++) vm->stack[frame->base + i] = vm->stack[frame->base + arg_reg + i];
+
+    if (!vm_reserve_stack(vm, needed_slots)) return 0;
+
+    for (size_t i = frame->base + proc->arity; i < needed_slots; i++) vm->stack[i].type = NONE_TYPE;
+
+    frame->proc = proc;
+    frame->ip = proc->code;
+
+    return 1;
+}
+
+/**
+ * @brief Counts a call of a proc whose frame was just set up, and runs the proc's native code once it is hot.
+ * @return int JIT_RETURNED if native code ran the whole call, or else the pc to run the frame from.
+ */
+static int vm_enter_proc(RubelVM *vm, const BcProc *proc, VarValue *regs)
+{
+    BcJitSlot *slot = vm->jit_slots + proc->index;
+    int resume_pc = 0;
+
+    if (!vm->jit_enabled || slot->rejected) return 0;
+
+    if (!slot->code)
+    {
+        slot->call_count++;
+
+        if (slot->call_count < vm->jit_hot_calls) return 0;
+
+        slot->code = jit_compile(proc, vm->program->consts);
+
+        if (!slot->code)
+        {
+            slot->rejected = 1;
+            vm->jit_stats.rejected_count++;
+            return 0;
+        }
+
+        vm->jit_stats.compiled_count++;
+    }
+
+    // NOTE: native code only touches registers and globals, so the stack cannot move under it.
+    resume_pc = slot->code->entry(regs, vm->stack);
+    vm->jit_stats.native_calls++;
+
+    if (resume_pc != JIT_RETURNED) vm->jit_stats.deopt_count++;
+
+    return resume_pc;
+}
+
+static RunStatus vm_call_native(const FuncObj *callee, VarValue *arg_regs, unsigned short argc)
+{
+    FuncArgs args;
+
+    // NOTE: natives only borrow the argument registers, and the result goes into the call register.
+    funcargs_init(&args, argc, arg_regs);
+    *arg_regs = callee->content.fn_ptr(&args);
+
+    return OK_RAN_CMD;
+}
+
+static RunStatus vm_math(BcOpCode op, VarValue *dest, const VarValue *left, const VarValue *right)
+{
+    int left_int, right_int;
+    float left_flt, right_flt;
+
+    if (left->type == NONE_TYPE || right->type == NONE_TYPE) return ERR_NULL_VAL;
+
+    if (left->type != right->type) return ERR_TYPE;
+
+    switch (left->type)
+    {
+    case INT_TYPE:
+        left_int = left->data.int_val.value;
+        right_int = right->data.int_val.value;
+
+        if (op == BC_DIV && right_int == 0) return ERR_NULL_VAL;
+
+        dest->type = INT_TYPE;
+        dest->is_const = 1;
+
+        if (op == BC_ADD) dest->data.int_val.value = INT_WRAP_ADD(left_int, right_int);
+        else if (op == BC_SUB) dest->data.int_val.value = INT_WRAP_SUB(left_int, right_int);
+        else if (op == BC_MUL) dest->data.int_val.value = INT_WRAP_MUL(left_int, right_int);
+        else dest->data.int_val.value = INT_WRAP_DIV(left_int, right_int);
+        break;
+    case REAL_TYPE:
+        left_flt = left->data.real_val.value;
+        right_flt = right->data.real_val.value;
+
+        if (op == BC_DIV && right_flt == 0) return ERR_NULL_VAL;
+
+        dest->type = REAL_TYPE;
+        dest->is_const = 1;
+
+        if (op == BC_ADD) dest->data.real_val.value = left_flt + right_flt;
+        else if (op == BC_SUB) dest->data.real_val.value = left_flt - right_flt;
+        else if (op == BC_MUL) dest->data.real_val.value = left_flt * right_flt;
+        else dest->data.real_val.value = left_flt / right_flt;
+        break;
+    default:
+        return ERR_TYPE;
+    }
+
+    return OK_RAN_CMD;
+}
+
+/**
+ * @brief Compares two values by a compare opcode from BC_EQ to BC_GTE. Both compare ops and compare-jumps use it.
+ * @param flag Gets the compare's result.
+ */
+static RunStatus vm_test(BcOpCode op, const VarValue *left, const VarValue *right, int *flag)
+{
+    int pre_eq, pre_lt; // NOTE: precomputed compare flags like compare_primitives
+
+    if (left->type == NONE_TYPE || right->type == NONE_TYPE) return ERR_NULL_VAL;
+
+    if (left->type != right->type) return ERR_TYPE;
+
+    switch (left->type)
+    {
+    case BOOL_TYPE:
+        pre_eq = left->data.bool_val.flag == right->data.bool_val.flag;
+        pre_lt = left->data.bool_val.flag < right->data.bool_val.flag;
+        break;
+    case INT_TYPE:
+        pre_eq = left->data.int_val.value == right->data.int_val.value;
+        pre_lt = left->data.int_val.value < right->data.int_val.value;
+        break;
+    case REAL_TYPE:
+        pre_eq = left->data.real_val.value == right->data.real_val.value;
+        pre_lt = left->data.real_val.value < right->data.real_val.value;
+        break;
+    default:
+        return ERR_TYPE;
+    }
+
+    switch (op)
+    {
+    case BC_EQ: *flag = pre_eq; break;
+    case BC_NEQ: *flag = !pre_eq; break;
+    case BC_LT: *flag = pre_lt; break;
+    case BC_LTE: *flag = pre_lt || pre_eq; break;
+    case BC_GT: *flag = !pre_lt && !pre_eq; break;
+    default: *flag = !pre_lt; break;
+    }
+
+    return OK_RAN_CMD;
+}
+
+/**
+ * @brief Compares two ints by a compare-jump opcode from BC_IEQJMPF to BC_IGTEJMPF.
+ */
+static int vm_test_ints(BcOpCode op, int left, int right)
+{
+    switch (op)
+    {
+    case BC_IEQJMPF: return left == right;
+    case BC_INEQJMPF: return left != right;
+    case BC_ILTJMPF: return left < right;
+    case BC_ILTEJMPF: return left <= right;
+    case BC_IGTJMPF: return left > right;
+    default: return left >= right;
+    }
+}
+
+static RunStatus vm_compare(BcOpCode op, VarValue *dest, const VarValue *left, const VarValue *right)
+{
+    int flag = 0;
+    RunStatus status = vm_test(op, left, right, &flag);
+
+    if (status != OK_RAN_CMD) return status;
+
+    dest->type = BOOL_TYPE;
+    dest->is_const = 1;
+    dest->data.bool_val.flag = flag;
+
+    return OK_RAN_CMD;
+}
+
+static RunStatus vm_assign(VarValue *dest, const VarValue *src)
+{
+    if (src->type == NONE_TYPE) return ERR_NULL_VAL;
+
+    // NOTE: like ctx_update_var, variables cannot change their type.
+    if (dest->type != src->type) return ERR_TYPE;
+
+    dest->data = src->data;
+
+    return OK_RAN_CMD;
+}
+
+/**
+ * @brief Safe point of the VM: runs a due collection with the registers of all frames as roots. Temporaries are registers too, so every instruction boundary is safe.
+ */
+static void vm_collect_garbage(RubelVM *vm, const BcFrame *frame)
+{
+    size_t top = frame->base + frame->proc->reg_count;
+
+    if (heap_wants_collect() == GC_CYCLE_NONE) return;
+
+    heap_begin_collect();
+
+    for (size_t i = 0; i < top; i++) heap_mark_value(vm->stack + i);
+
+    heap_finish_collect();
+}
+
+/// SECTION: Dispatch loop
+/// NOTE: GCC and Clang builds jump from each handler straight to the next one through a label table, which gives every opcode its own predicted branch. Building with RUBEL_SWITCH_DISPATCH, or with another compiler, keeps the portable switch.
+
+#if defined(__GNUC__) && !defined(RUBEL_SWITCH_DISPATCH)
+#define VM_THREADED_DISPATCH
+#endif
+
+#ifdef VM_THREADED_DISPATCH
+#define VM_CASE(opcode) case opcode: label_##opcode
+#define VM_NEXT() do { if (status != OK_RAN_CMD) goto vm_stop; instr = ip++; goto *vm_labels[instr->op]; } while (0)
+#else
+#define VM_CASE(opcode) case opcode
+#define VM_NEXT() break
+#endif
+
+RunStatus vm_run(RubelVM *vm)
+{
+    const BcProgram *program = vm->program;
+    const VarValue *consts = program->consts;
+    const BcInstr *ip = NULL;
+    const BcInstr *instr = NULL;
+    const FuncObj *callee = NULL;
+    BcCallCache *cache_ref = NULL;
+    FuncGroup *module_ref = NULL;
+    BcFrame *frame = NULL;
+    VarValue *regs = NULL;
+    VarValue *cond = NULL;
+    const VarValue *cond_right = NULL;
+    FusedStats *fused = &vm->ctx->fused;
+    VarValue result;
+    int cond_flag = 0;
+    int jit_pc = 0;
+    RunStatus status = OK_RAN_CMD;
+#ifdef VM_THREADED_DISPATCH
+    // NOTE: this follows the order of BcOpCode.
+    static const void *const vm_labels[] = {
+        &&label_BC_NOP,
+        &&label_BC_STMT,
+        &&label_BC_LOADK,
+        &&label_BC_MOVE,
+        &&label_BC_ASSIGN,
+        &&label_BC_GETGLOBAL,
+        &&label_BC_SETGLOBAL,
+        &&label_BC_CHECKVAL,
+        &&label_BC_NEG,
+        &&label_BC_ADD,
+        &&label_BC_SUB,
+        &&label_BC_MUL,
+        &&label_BC_DIV,
+        &&label_BC_ADDI,
+        &&label_BC_IADD,
+        &&label_BC_ISUB,
+        &&label_BC_IMUL,
+        &&label_BC_IDIV,
+        &&label_BC_RADD,
+        &&label_BC_RSUB,
+        &&label_BC_RMUL,
+        &&label_BC_RDIV,
+        &&label_BC_EQ,
+        &&label_BC_NEQ,
+        &&label_BC_LT,
+        &&label_BC_LTE,
+        &&label_BC_GT,
+        &&label_BC_GTE,
+        &&label_BC_JMP,
+        &&label_BC_JMPF,
+        &&label_BC_EQJMPF,
+        &&label_BC_NEQJMPF,
+        &&label_BC_LTJMPF,
+        &&label_BC_LTEJMPF,
+        &&label_BC_GTJMPF,
+        &&label_BC_GTEJMPF,
+        &&label_BC_IEQJMPF,
+        &&label_BC_INEQJMPF,
+        &&label_BC_ILTJMPF,
+        &&label_BC_ILTEJMPF,
+        &&label_BC_IGTJMPF,
+        &&label_BC_IGTEJMPF,
+        &&label_BC_CALL,
+        &&label_BC_TAILCALL,
+        &&label_BC_RET,
+        &&label_BC_RETNONE,
+        &&label_BC_DEFPROC,
+        &&label_BC_USE,
+        &&label_BC_HALT
+    };
+
+    _Static_assert(sizeof(vm_labels) / sizeof(vm_labels[0]) == BC_HALT + 1, "vm_labels must list every opcode");
+#endif
+
+    if (!vm_push_frame(vm, program->procs[0], 0)) return ERR_MEMORY;
+
+    frame = vm->frames;
+    ip = frame->ip;
+    regs = vm->stack;
+
+    while (status == OK_RAN_CMD)
+    {
+        instr = ip;
+        ip++;
+
+        switch (instr->op)
+        {
+        VM_CASE(BC_NOP):
+            VM_NEXT();
+        VM_CASE(BC_STMT):
+            vm->stmt_num = instr->b | ((unsigned int)instr->c << 16);
+            vm_collect_garbage(vm, frame);
+            VM_NEXT();
+        VM_CASE(BC_LOADK):
+            regs[instr->a] = consts[instr->b];
+            VM_NEXT();
+        VM_CASE(BC_MOVE):
+            regs[instr->a] = regs[instr->b];
+            VM_NEXT();
+        VM_CASE(BC_ASSIGN):
+            status = vm_assign(regs + instr->a, regs + instr->b);
+            VM_NEXT();
+        VM_CASE(BC_GETGLOBAL):
+            regs[instr->a] = vm->stack[instr->b];
+            VM_NEXT();
+        VM_CASE(BC_SETGLOBAL):
+            status = vm_assign(vm->stack + instr->a, regs + instr->b);
+            VM_NEXT();
+        VM_CASE(BC_CHECKVAL):
+            if (regs[instr->a].type == NONE_TYPE) status = ERR_NULL_VAL;
+            VM_NEXT();
+        VM_CASE(BC_NEG):
+            if (regs[instr->b].type == INT_TYPE)
+                regs[instr->a] = (VarValue){.type = INT_TYPE, .is_const = 1, .data.int_val.value = INT_WRAP_SUB(0, regs[instr->b].data.int_val.value)};
+            else if (regs[instr->b].type == REAL_TYPE)
+                regs[instr->a] = (VarValue){.type = REAL_TYPE, .is_const = 1, .data.real_val.value = -regs[instr->b].data.real_val.value};
+            else
+                status = (regs[instr->b].type == NONE_TYPE) ? ERR_NULL_VAL : ERR_TYPE;
+            VM_NEXT();
+        VM_CASE(BC_ADD):
+        VM_CASE(BC_SUB):
+        VM_CASE(BC_MUL):
+        VM_CASE(BC_DIV):
+            status = vm_math(instr->op, regs + instr->a, regs + instr->b, regs + instr->c);
+            VM_NEXT();
+        VM_CASE(BC_ADDI):
+            cond = regs + instr->a;
+
+            // NOTE: the variable keeps its slot, so this only checks what BC_ADD and BC_ASSIGN would.
+            if (cond->type == INT_TYPE)
+                cond->data.int_val.value = INT_WRAP_ADD(cond->data.int_val.value, (short)instr->b);
+            else
+                status = (cond->type == NONE_TYPE) ? ERR_NULL_VAL : ERR_TYPE;
+
+            fused->incr_count++;
+            VM_NEXT();
+        VM_CASE(BC_IADD):
+            regs[instr->a] = (VarValue){.type = INT_TYPE, .is_const = 1, .data.int_val.value = INT_WRAP_ADD(regs[instr->b].data.int_val.value, regs[instr->c].data.int_val.value)};
+            VM_NEXT();
+        VM_CASE(BC_ISUB):
+            regs[instr->a] = (VarValue){.type = INT_TYPE, .is_const = 1, .data.int_val.value = INT_WRAP_SUB(regs[instr->b].data.int_val.value, regs[instr->c].data.int_val.value)};
+            VM_NEXT();
+        VM_CASE(BC_IMUL):
+            regs[instr->a] = (VarValue){.type = INT_TYPE, .is_const = 1, .data.int_val.value = INT_WRAP_MUL(regs[instr->b].data.int_val.value, regs[instr->c].data.int_val.value)};
+            VM_NEXT();
+        VM_CASE(BC_IDIV):
+            if (regs[instr->c].data.int_val.value == 0)
+                status = ERR_NULL_VAL;
+            else
+                regs[instr->a] = (VarValue){.type = INT_TYPE, .is_const = 1, .data.int_val.value = INT_WRAP_DIV(regs[instr->b].data.int_val.value, regs[instr->c].data.int_val.value)};
+            VM_NEXT();
+        VM_CASE(BC_RADD):
+            regs[instr->a] = (VarValue){.type = REAL_TYPE, .is_const = 1, .data.real_val.value = regs[instr->b].data.real_val.value + regs[instr->c].data.real_val.value};
+            VM_NEXT();
+        VM_CASE(BC_RSUB):
+            regs[instr->a] = (VarValue){.type = REAL_TYPE, .is_const = 1, .data.real_val.value = regs[instr->b].data.real_val.value - regs[instr->c].data.real_val.value};
+            VM_NEXT();
+        VM_CASE(BC_RMUL):
+            regs[instr->a] = (VarValue){.type = REAL_TYPE, .is_const = 1, .data.real_val.value = regs[instr->b].data.real_val.value * regs[instr->c].data.real_val.value};
+            VM_NEXT();
+        VM_CASE(BC_RDIV):
+            if (regs[instr->c].data.real_val.value == 0)
+                status = ERR_NULL_VAL;
+            else
+                regs[instr->a] = (VarValue){.type = REAL_TYPE, .is_const = 1, .data.real_val.value = regs[instr->b].data.real_val.value / regs[instr->c].data.real_val.value};
+            VM_NEXT();
+        VM_CASE(BC_EQ):
+        VM_CASE(BC_NEQ):
+        VM_CASE(BC_LT):
+        VM_CASE(BC_LTE):
+        VM_CASE(BC_GT):
+        VM_CASE(BC_GTE):
+            status = vm_compare(instr->op, regs + instr->a, regs + instr->b, regs + instr->c);
+            VM_NEXT();
+        VM_CASE(BC_JMP):
+            ip = frame->proc->code + instr->b;
+            vm_collect_garbage(vm, frame); // NOTE: loops jump back here, so long loops still collect.
+            VM_NEXT();
+        VM_CASE(BC_JMPF):
+            cond = regs + instr->a;
+
+            if (cond->type != BOOL_TYPE)
+                status = (cond->type == NONE_TYPE) ? ERR_NULL_VAL : ERR_TYPE;
+            else if (!cond->data.bool_val.flag)
+                ip = frame->proc->code + instr->b;
+            VM_NEXT();
+        VM_CASE(BC_EQJMPF):
+        VM_CASE(BC_NEQJMPF):
+        VM_CASE(BC_LTJMPF):
+        VM_CASE(BC_LTEJMPF):
+        VM_CASE(BC_GTJMPF):
+        VM_CASE(BC_GTEJMPF):
+            cond_right = (instr->aux) ? consts + instr->c : regs + instr->c;
+            status = vm_test((BcOpCode)(instr->op - BC_EQJMPF + BC_EQ), regs + instr->a, cond_right, &cond_flag);
+
+            if (status == OK_RAN_CMD && !cond_flag) ip = frame->proc->code + instr->b;
+
+            fused->cmp_jump_count++;
+            VM_NEXT();
+        VM_CASE(BC_IEQJMPF):
+        VM_CASE(BC_INEQJMPF):
+        VM_CASE(BC_ILTJMPF):
+        VM_CASE(BC_ILTEJMPF):
+        VM_CASE(BC_IGTJMPF):
+        VM_CASE(BC_IGTEJMPF):
+            cond_right = (instr->aux) ? consts + instr->c : regs + instr->c;
+
+            if (!vm_test_ints(instr->op, regs[instr->a].data.int_val.value, cond_right->data.int_val.value)) ip = frame->proc->code + instr->b;
+
+            fused->cmp_jump_count++;
+            VM_NEXT();
+        VM_CASE(BC_CALL):
+        VM_CASE(BC_TAILCALL):
+            cache_ref = vm->call_cache + instr->b;
+
+            if (cache_ref->generation != vm->ctx->function_env->generation)
+            {
+                cache_ref->callee = ctx_get_func(vm->ctx, program->names[instr->b]);
+                cache_ref->generation = vm->ctx->function_env->generation;
+            }
+
+            callee = cache_ref->callee;
+
+            if (!callee)
+            {
+                status = ERR_NULL_VAL;
+                VM_NEXT();
+            }
+
+            // reject wrong argument counts since the function decl cannot match it!
+            if (callee->arity != instr->aux)
+            {
+                status = ERR_NO_IMPL;
+                VM_NEXT();
+            }
+
+            if (callee->type == FUNC_NATIVE)
+            {
+                // NOTE: a native's tail call goes on to the BC_RET after it like a plain call.
+                status = vm_call_native(callee, regs + instr->a, instr->aux);
+                VM_NEXT();
+            }
+
+            if (callee->type != FUNC_BYTECODE)
+            {
+                status = ERR_GENERAL;
+                VM_NEXT();
+            }
+
+            if (instr->op == BC_TAILCALL)
+            {
+                if (!vm_reuse_frame(vm, callee->content.fn_code, instr->a))
+                {
+                    status = ERR_MEMORY;
+                    VM_NEXT();
+                }
+
+            }
+            else
+            {
+                // NOTE: the callee's frame overlaps the argument registers, so nothing is copied.
+                frame->ip = ip;
+
+                if (!vm_push_frame(vm, callee->content.fn_code, frame->base + instr->a))
+                {
+                    status = (vm->frame_count >= VM_CALL_DEPTH_MAX) ? ERR_DEPTH : ERR_MEMORY;
+                    VM_NEXT();
+                }
+
+                frame = vm->frames + vm->frame_count - 1;
+            }
+
+            regs = vm->stack + frame->base;
+            vm_collect_garbage(vm, frame);
+            jit_pc = vm_enter_proc(vm, frame->proc, regs);
+
+            if (jit_pc != JIT_RETURNED)
+            {
+                ip = frame->proc->code + jit_pc;
+                VM_NEXT();
+            }
+
+            // NOTE: native code already left the result in the call register like BC_RET, so only the frame goes.
+            vm->frame_count--;
+            frame = vm->frames + vm->frame_count - 1;
+            ip = frame->ip;
+            regs = vm->stack + frame->base;
+            VM_NEXT();
+        VM_CASE(BC_RET):
+        VM_CASE(BC_RETNONE):
+            if (instr->op == BC_RET) result = regs[instr->a];
+            else result.type = NONE_TYPE;
+
+            // NOTE: the callee's first register is the caller's call register.
+            vm->stack[frame->base] = result;
+            vm->frame_count--;
+
+            frame = vm->frames + vm->frame_count - 1;
+            ip = frame->ip;
+            regs = vm->stack + frame->base;
+            VM_NEXT();
+        VM_CASE(BC_DEFPROC):
+            callee = func_bytecode_create(program->procs[instr->b]->name, program->procs[instr->b]->arity, program->procs[instr->b]);
+
+            if (!callee || !funcenv_define(vm->ctx->function_env, (FuncObj *)callee))
+            {
+                free((FuncObj *)callee);
+                status = ERR_MEMORY;
+            }
+            VM_NEXT();
+        VM_CASE(BC_USE):
+            module_ref = funcenv_fetch(vm->ctx->function_env, program->names[instr->b]);
+
+            if (!module_ref) status = ERR_NO_IMPL;
+            else if (!funcenv_use_group(vm->ctx->function_env, module_ref)) status = ERR_MEMORY;
+            VM_NEXT();
+        VM_CASE(BC_HALT):
+            status = OK_ENDED;
+            VM_NEXT();
+        default:
+            status = ERR_NO_IMPL;
+            VM_NEXT();
+        }
+    }
+
+#ifdef VM_THREADED_DISPATCH
+vm_stop:
+#endif
+    vm->frame_count = 0;
+    ctx_set_status(vm->ctx, status);
+
+    return status;
+}